@@ -0,0 +1,84 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       cmsis_nvic_virtual.h
+//!
+//!   \brief      CMSIS virtual NVIC interface for the host build.
+//!               Included by core_cm3.h when CMSIS_NVIC_VIRTUAL is
+//!               defined. Interrupt enable, pending and priority state
+//!               is kept by the simulation, which also dispatches the
+//!               handlers.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _CMSIS_NVIC_VIRTUAL_H
+#define  _CMSIS_NVIC_VIRTUAL_H 1
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define NVIC_SetPriorityGrouping    __NVIC_SetPriorityGrouping
+#define NVIC_GetPriorityGrouping    __NVIC_GetPriorityGrouping
+#define NVIC_EnableIRQ              HostSim_NVIC_EnableIRQ
+#define NVIC_GetEnableIRQ           HostSim_NVIC_GetEnableIRQ
+#define NVIC_DisableIRQ             HostSim_NVIC_DisableIRQ
+#define NVIC_GetPendingIRQ          HostSim_NVIC_GetPendingIRQ
+#define NVIC_SetPendingIRQ          HostSim_NVIC_SetPendingIRQ
+#define NVIC_ClearPendingIRQ        HostSim_NVIC_ClearPendingIRQ
+#define NVIC_GetActive              HostSim_NVIC_GetActive
+#define NVIC_SetPriority            HostSim_NVIC_SetPriority
+#define NVIC_GetPriority            HostSim_NVIC_GetPriority
+#define NVIC_SystemReset            HostSim_NVIC_SystemReset
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+extern void HostSim_NVIC_EnableIRQ(IRQn_Type IRQn);
+extern uint32_t HostSim_NVIC_GetEnableIRQ(IRQn_Type IRQn);
+extern void HostSim_NVIC_DisableIRQ(IRQn_Type IRQn);
+extern uint32_t HostSim_NVIC_GetPendingIRQ(IRQn_Type IRQn);
+extern void HostSim_NVIC_SetPendingIRQ(IRQn_Type IRQn);
+extern void HostSim_NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+extern uint32_t HostSim_NVIC_GetActive(IRQn_Type IRQn);
+extern void HostSim_NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority);
+extern uint32_t HostSim_NVIC_GetPriority(IRQn_Type IRQn);
+extern void HostSim_NVIC_SystemReset(void) __attribute__((noreturn));
+
+#endif // _CMSIS_NVIC_VIRTUAL_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
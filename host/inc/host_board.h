@@ -0,0 +1,151 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_board.h
+//!
+//!   \brief      Host simulation board header file. The simulated board
+//!               drives the inputs of the ventilator into the resting
+//!               state: mains power present, no key pressed, motor at
+//!               home, no pressure and no flow. Plant models move the
+//!               motor, pressure and flow signals through the sensor and
+//!               actuator functions, which hold the board wiring and the
+//!               sensors transfer functions.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_BOARD_H
+#define  _HOST_BOARD_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+/**
+ * Motor H bridge output averaged over a PWM period
+ */
+typedef struct host_board_bridge_tag
+{
+   double drive;           /**< Mean voltage applied to the motor, -1.0 to 1.0. Positive compresses the bellows */
+   double closed;          /**< Fraction of the period the motor terminals are connected, 0.0 to 1.0 */
+} HostBoardBridgeType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Attach the default external circuitry to the simulated MCU.
+ *        Must be called after HostSim_Init().
+ *
+ * @param none
+ *
+ * @return none
+ */
+extern void HostBoard_Init(void);
+
+/**
+ * @brief Get the motor H bridge state from the direction outputs and the
+ *        PWM timer channels
+ *
+ * @param pBridge bridge state
+ *
+ * @return none
+ */
+extern void HostBoard_GetMotorBridge(HostBoardBridgeType *pBridge);
+
+/**
+ * @brief Move the quadrature encoder to a position. Every intermediate
+ *        step is output, one edge at a time.
+ *
+ * @param position encoder position in counts
+ *
+ * @return none
+ */
+extern void HostBoard_SetEncoderPosition(int32_t position);
+
+/**
+ * @brief Set the state of the motor home switch
+ *
+ * @param active TRUE when the mechanism is at the home position
+ *
+ * @return none
+ */
+extern void HostBoard_SetHomeSwitch(bool active);
+
+/**
+ * @brief Set the pressure applied to the airway pressure sensor
+ *
+ * @param pressure pressure in cmH2O
+ *
+ * @return none
+ */
+extern void HostBoard_SetPressure(double pressure);
+
+/**
+ * @brief Set the flow through the differential flow sensor
+ *
+ * @param flow flow in standard liters per minute. Positive towards the patient
+ *
+ * @return none
+ */
+extern void HostBoard_SetFlow(double flow);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_BOARD_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,92 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//********************************************************************
+//!
+//!   \file       host_enob.h
+//!
+//!   \brief      Host measurement of the effective resolution of the
+//!               filtered airway pressure reading.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_ENOB_H
+#define  _HOST_ENOB_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Drive the pressure input through levels a fraction of an ADC
+ *        count apart and compare the filtered reading of the firmware
+ *        with every level. The RMS error and the effective number of
+ *        bits are printed when the simulation ends. Must not be used
+ *        with the patient plant.
+ *
+ * @param none
+ *
+ * @return none
+ */
+extern void HostEnob_Init(void);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_ENOB_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
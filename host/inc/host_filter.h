@@ -0,0 +1,95 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_filter.h
+//!
+//!   \brief      Host check of the fixed point ADC filter against the
+//!               floating point reference design.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_FILTER_H
+#define  _HOST_FILTER_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_FILTER_MAX_ERROR       (1)      /**< Max difference accepted against the reference in ADC counts */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Feed steps, a frequency sweep and noise with the range of the
+ *        ADC through the q31 and the float 10Hz low pass filters and
+ *        compare the outputs sample by sample. The error is printed to
+ *        the stream.
+ *
+ * @param pReport stream receiving the results
+ *
+ * @return StatusType #E_OK if the outputs never differ more than
+ *                    #HOST_FILTER_MAX_ERROR counts\n
+ *                    #E_ERROR otherwise
+ */
+extern StatusType HostFilter_Check(FILE *pReport);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_FILTER_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,100 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//********************************************************************
+//!
+//!   \file       host_flow.h
+//!
+//!   \brief      Host check of the flow meter volume integrator with
+//!               known flow waveforms.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_FLOW_H
+#define  _HOST_FLOW_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_FLOW_MAX_ERROR_ML      (1)      /**< Max Vti and Vte difference accepted against the exact integral */
+#define HOST_FLOW_MAX_ERROR_FLOW    (50)     /**< Max end expiration flow difference accepted in ml/min */
+#define HOST_FLOW_MAX_ERROR_MV      (1)      /**< Max minute volume difference accepted in percent */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Convert every sensor reading and compare it with the floating
+ *        point conversion. Then replay breaths of known flow waveforms
+ *        through the sensor reading and the volume integrator, sampled
+ *        with jitter, and compare the volumes of every breath with the
+ *        exact integrals. The errors are printed to the stream.
+ *
+ * @param pReport stream receiving the results
+ *
+ * @return StatusType #E_OK if the readings convert within half a
+ *                    ml/min and the breath volumes, end expiration
+ *                    flow and minute volume are within
+ *                    #HOST_FLOW_MAX_ERROR_ML, #HOST_FLOW_MAX_ERROR_FLOW
+ *                    and #HOST_FLOW_MAX_ERROR_MV\n
+ *                    #E_ERROR otherwise
+ */
+extern StatusType HostFlow_Check(FILE *pReport);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_FLOW_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
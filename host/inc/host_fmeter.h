@@ -0,0 +1,102 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_fmeter.h
+//!
+//!   \brief      Host check of the turbine flow meter driver with a
+//!               simulated pulse train on its timer input.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_FMETER_H
+#define  _HOST_FMETER_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_FMETER_STEP_MS         (2000)   /**< Duration of every flow step */
+#define HOST_FMETER_SETTLE_MS       (100)    /**< The flow is checked this long before the step ends */
+#define HOST_FMETER_TOLERANCE_PCT   (1)      /**< Max flow error in percent */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Drive the flow meter input with the pulses of a turbine
+ *        through a series of flow steps of #HOST_FMETER_STEP_MS, the
+ *        last one with no flow and longer than the driver measure time. The flow read from the driver is
+ *        checked #HOST_FMETER_SETTLE_MS before the end of every step.
+ *        The main loop is held twice, less and more than the capture
+ *        ring lasts. When the simulation ends every step, the overruns
+ *        of every hold and the volume are printed, with the check
+ *        result: every flow within #HOST_FMETER_TOLERANCE_PCT of the
+ *        expected one plus the meter offset, no flow after the last
+ *        step, one overrun for the long hold only and the volume of
+ *        every pulse driven.
+ *
+ * @param none
+ *
+ * @return none
+ */
+extern void HostFMeter_Init(void);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_FMETER_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,120 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_hal_overrides.h
+//!
+//!   \brief      HAL and CMSIS overrides for the host build. This file
+//!               is force-included in every firmware and HAL translation
+//!               unit of the host build.
+//!
+//!               Peripheral registers are plain memory on the host, so
+//!               the status flags that the hardware clears on a write of
+//!               zero (rc_w0) or one (rc_w1) are cleared here with an
+//!               explicit read-modify-write. Core intrinsics that rely on
+//!               ARM instructions are routed to the simulation.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_HAL_OVERRIDES_H
+#define  _HOST_HAL_OVERRIDES_H 1
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+// Core intrinsics
+#undef __WFI
+#undef __WFE
+#undef __SEV
+#undef __BKPT
+#define __WFI()                  HostSim_WaitForInterrupt()
+#define __WFE()                  HostSim_WaitForInterrupt()
+#define __SEV()                  ((void)0)
+#define __BKPT(value)            __builtin_trap()
+#define __DSB()                  __sync_synchronize()
+#define __DMB()                  __sync_synchronize()
+#define __ISB()                  ((void)0)
+#define __enable_irq()           HostSim_SetPRIMASK(0)
+#define __disable_irq()          HostSim_SetPRIMASK(1)
+#define __get_PRIMASK()          HostSim_GetPRIMASK()
+#define __set_PRIMASK(priMask)   HostSim_SetPRIMASK(priMask)
+
+// Firmware code takes no virtual time, so the profiler measures the
+// host clock instead of the cycle counter
+#define PROFILER_GET_TICKS()     HostSim_GetProfilerTicks()
+#define PROFILER_TICKS_PER_US    (1000UL)
+
+// rc_w0 status registers
+#undef __HAL_TIM_CLEAR_FLAG
+#undef __HAL_TIM_CLEAR_IT
+#undef __HAL_UART_CLEAR_FLAG
+#undef __HAL_ADC_CLEAR_FLAG
+#undef __HAL_I2C_CLEAR_FLAG
+#define __HAL_TIM_CLEAR_FLAG(__HANDLE__, __FLAG__)       ((__HANDLE__)->Instance->SR &= ~(__FLAG__))
+#define __HAL_TIM_CLEAR_IT(__HANDLE__, __INTERRUPT__)    ((__HANDLE__)->Instance->SR &= ~(__INTERRUPT__))
+#define __HAL_UART_CLEAR_FLAG(__HANDLE__, __FLAG__)      ((__HANDLE__)->Instance->SR &= ~(__FLAG__))
+#define __HAL_ADC_CLEAR_FLAG(__HANDLE__, __FLAG__)       ((__HANDLE__)->Instance->SR &= ~(__FLAG__))
+#define __HAL_I2C_CLEAR_FLAG(__HANDLE__, __FLAG__)       ((__HANDLE__)->Instance->SR1 &= ~((__FLAG__) & I2C_FLAG_MASK))
+
+// The SR then DR read sequence clears every USART error flag and IDLE
+#undef __HAL_UART_CLEAR_PEFLAG
+#define __HAL_UART_CLEAR_PEFLAG(__HANDLE__) \
+   ((__HANDLE__)->Instance->SR &= ~(USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE | USART_SR_IDLE))
+
+// DMA IFCR is write 1 to clear. Each global flag clears the four flags
+// of its channel.
+#define HOST_DMA_IFCR_TO_ISR(__FLAG__)  ((__FLAG__) | (((__FLAG__) & 0x01111111UL) * 0xFUL))
+#undef __HAL_DMA_CLEAR_FLAG
+#define __HAL_DMA_CLEAR_FLAG(__HANDLE__, __FLAG__)       (DMA1->ISR &= ~HOST_DMA_IFCR_TO_ISR(__FLAG__))
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+extern void HostSim_WaitForInterrupt(void);
+extern uint32_t HostSim_GetPRIMASK(void);
+extern void HostSim_SetPRIMASK(uint32_t priMask);
+extern uint32_t HostSim_GetProfilerTicks(void);
+
+#endif // _HOST_HAL_OVERRIDES_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,103 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//********************************************************************
+//!
+//!   \file       host_i2c_bus.h
+//!
+//!   \brief      Host check of the I2C bus manager with several devices
+//!               sharing the flow sensor bus.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_I2C_BUS_H
+#define  _HOST_I2C_BUS_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_I2C_BUS_START_MS       (1000)   /**< The devices are scheduled once the firmware runs */
+#define HOST_I2C_BUS_STRETCH_MS     (4000)   /**< A device holds the clock too long */
+#define HOST_I2C_BUS_STRETCH_US     (50000)
+#define HOST_I2C_BUS_NACK_FROM_MS   (6000)   /**< A device does not answer */
+#define HOST_I2C_BUS_NACK_TO_MS     (6500)
+#define HOST_I2C_BUS_MIN_READS      (95)     /**< Min reads done in percent of the scheduled ones */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Attach simulated devices to the flow sensor bus and schedule
+ *        their reads on the bus manager at #HOST_I2C_BUS_START_MS. One
+ *        device stretches the clock for #HOST_I2C_BUS_STRETCH_US at
+ *        #HOST_I2C_BUS_STRETCH_MS and another one does not answer from
+ *        #HOST_I2C_BUS_NACK_FROM_MS to #HOST_I2C_BUS_NACK_TO_MS. When the
+ *        simulation ends the reads, errors and gaps of every device and
+ *        the bus statistics are printed, with the check result: every
+ *        read gets its own device data, the stretch gives one timeout
+ *        and one bus recovery, the bus reports every NACK served and
+ *        every device completes #HOST_I2C_BUS_MIN_READS of its reads.
+ *
+ * @param none
+ *
+ * @return none
+ */
+extern void HostI2CBus_Init(void);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_I2C_BUS_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
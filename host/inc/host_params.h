@@ -0,0 +1,97 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_params.h
+//!
+//!   \brief      Host check of the ventilator parameter engine against
+//!               the floating point calculation it replaces.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_PARAMS_H
+#define  _HOST_PARAMS_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Run every respiratory rate, tidal volume, IE ratio and
+ *        inspiratory time in the settings range, in both control
+ *        modes, through the parameter engine and through a copy of
+ *        the floating point calculation it replaces. The plateau time
+ *        is swept with the default tidal volume. The results are
+ *        printed to the stream.
+ *
+ * @param pReport stream receiving the results
+ *
+ * @return StatusType #E_OK if every set accepted by both gives the
+ *                    same parameters and the sets accepted by only one
+ *                    of them are the ones the engine rejects on purpose\n
+ *                    #E_ERROR otherwise
+ */
+extern StatusType HostParams_Check(FILE *pReport);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_PARAMS_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
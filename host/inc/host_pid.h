@@ -0,0 +1,107 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_pid.h
+//!
+//!   \brief      Host check of the step response of the PID controller
+//!               closing the pressure loop on the plant model.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_PID_H
+#define  _HOST_PID_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_PID_MAX_OVERSHOOT      (10.0)   /**< Max overshoot accepted in the pressure step, % of the step */
+#define HOST_PID_MAX_BUMP           (1)      /**< Max drive level change accepted on a gain change, PWM % */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Close the pressure loop on the plant model with the controller
+ *        of the firmware, its gains and the ADC filter on the feedback,
+ *        and measure the step response:
+ *        - a step from the PEEP to 20 cmH2O, with and without setpoint
+ *          weighting
+ *        - the same step after the bellows was held for 2 s, with every
+ *          anti-windup method
+ *        - a gain change in the middle of the step
+ *        - the drive level noise with noisy feedback, with and without
+ *          the derivative filter
+ *        The results are printed to the stream.
+ *
+ * @param pReport stream receiving the results
+ *
+ * @return StatusType #E_OK if the step is within #HOST_PID_MAX_OVERSHOOT,
+ *                    both anti-windup methods leave the drive level
+ *                    saturated past the setpoint for less time than none,
+ *                    the gain change moves the drive level at most
+ *                    #HOST_PID_MAX_BUMP and the derivative filter lowers
+ *                    the noise\n
+ *                    #E_ERROR otherwise
+ */
+extern StatusType HostPid_Check(FILE *pReport);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_PID_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
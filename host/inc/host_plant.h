@@ -0,0 +1,177 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_plant.h
+//!
+//!   \brief      Host simulation patient and bellows plant. Models the
+//!               motor and the bellows driven by the H bridge, a single
+//!               compartment lung behind the airway resistance and the
+//!               expiratory valve, and feeds the encoder, home switch,
+//!               pressure and flow sensors of the board. Every breath is
+//!               measured to report peak pressure, overshoot, rise time,
+//!               settling time and tidal volume error.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_PLANT_H
+#define  _HOST_PLANT_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_PLANT_STEP_US       (20)     /**< Time step of the plant model in us */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+/**
+ * Plant parameters
+ */
+typedef struct host_plant_params_tag
+{
+   double compliance;            /**< Lung compliance in mL/cmH2O */
+   double resistance;            /**< Airway resistance in cmH2O/(L/s) */
+   double expResistance;         /**< Expiratory valve resistance in cmH2O/(L/s) */
+   double peep;                  /**< Expiratory valve pressure in cmH2O */
+   double motorSpeed;            /**< No load motor speed at full drive in counts/s */
+   double motorTimeConstant;     /**< Motor mechanical time constant in seconds */
+   double motorFriction;         /**< Drive level needed to overcome friction, 0.0 to 1.0 */
+   double motorTorque;           /**< Bellows pressure times displacement (cmH2O mL/count) stalling the motor at full drive */
+   double startPosition;         /**< Initial position in counts from home */
+   double targetPressure;        /**< Inspiratory pressure setpoint for the metrics in cmH2O, 0 to disable */
+   double targetVolume;          /**< Tidal volume setpoint for the metrics in mL, 0 to disable */
+   FILE *pBreathLog;             /**< Stream receiving the metrics of every breath as CSV, NULL to disable */
+} HostPlantParamsType;
+
+/**
+ * Plant state
+ */
+typedef struct host_plant_state_tag
+{
+   double position;              /**< Motor position in counts from home */
+   double speed;                 /**< Motor speed in counts/s */
+   double bellowsVolume;         /**< Volume displaced by the bellows in mL */
+   double lungVolume;            /**< Lung volume over the expiratory valve pressure in mL */
+   double pressure;              /**< Airway pressure in cmH2O */
+   double inFlow;                /**< Flow from the bellows into the lung in mL/s */
+   double exFlow;                /**< Flow out through the expiratory valve in mL/s */
+   bool expiring;                /**< Patient valve open to the expiratory valve */
+} HostPlantStateType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Get the default plant parameters: an adult test lung on the
+ *        ventilator bellows
+ *
+ * @param pParams parameters
+ *
+ * @return none
+ */
+extern void HostPlant_GetDefaultParams(HostPlantParamsType *pParams);
+
+/**
+ * @brief Attach the plant to the simulated board. Must be called after
+ *        HostBoard_Init(). A summary of the breath metrics is printed to
+ *        stderr when the simulation ends.
+ *
+ * @param pParams plant parameters
+ *
+ * @return StatusType #E_OK if no error occurred\n
+ *                    #E_ERROR if a parameter is out of range
+ */
+extern StatusType HostPlant_Init(const HostPlantParamsType *pParams);
+
+/**
+ * @brief Set a plant state at rest: the motor stopped at the start
+ *        position and the lung at the expiratory valve pressure
+ *
+ * @param pParams plant parameters
+ * @param pState state
+ *
+ * @return none
+ */
+extern void HostPlant_InitState(const HostPlantParamsType *pParams, HostPlantStateType *pState);
+
+/**
+ * @brief Get the position where the finger meets the bellows: closer to
+ *        home the motor moves without displacing any volume
+ *
+ * @return double position in counts from home
+ */
+extern double HostPlant_GetContactPosition(void);
+
+/**
+ * @brief Advance a plant state by #HOST_PLANT_STEP_US. The simulated
+ *        board runs the same model; this lets a check drive the plant
+ *        without the firmware.
+ *
+ * @param pParams plant parameters
+ * @param pState state
+ * @param drive mean voltage applied to the motor, -1.0 to 1.0. Positive
+ *        compresses the bellows
+ * @param closed fraction of the period the motor terminals are connected,
+ *        0.0 to 1.0
+ *
+ * @return none
+ */
+extern void HostPlant_Step(const HostPlantParamsType *pParams, HostPlantStateType *pState, double drive, double closed);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_PLANT_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
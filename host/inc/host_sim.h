@@ -0,0 +1,345 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_sim.h
+//!
+//!   \brief      Host simulation APIs header file. The host build runs
+//!               the complete firmware as a Linux process on top of
+//!               register level models of the STM32F1 peripherals,
+//!               driven by a virtual core clock.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_SIM_H
+#define  _HOST_SIM_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_SIM_CORE_CLOCK_HZ         (72000000ULL)
+
+#define HOST_SIM_US_TO_CYCLES(us)      ((uint64_t)(us) * (HOST_SIM_CORE_CLOCK_HZ / 1000000ULL))
+#define HOST_SIM_MS_TO_CYCLES(ms)      ((uint64_t)(ms) * (HOST_SIM_CORE_CLOCK_HZ / 1000ULL))
+#define HOST_SIM_CYCLES_TO_US(cycles)  ((uint64_t)(cycles) / (HOST_SIM_CORE_CLOCK_HZ / 1000000ULL))
+
+#define HOST_SIM_ADC_CHANNELS          (18)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+/**
+ * Periodic process executed by the simulation at virtual time instants.
+ * Used to attach plant models and stimulus generators to the simulated
+ * board. The run function must not call firmware code other than getters
+ * that only read the firmware state.
+ */
+typedef struct host_sim_process_tag
+{
+   uint64_t period;                                    /**< Period in core cycles */
+   uint64_t next;                                      /**< Next activation in core cycles */
+   void (*run)(uint64_t now, void *pUserData);         /**< Process body */
+   void *pUserData;                                    /**< User data passed to run */
+   struct host_sim_process_tag *pNext;                 /**< Internal use */
+} HostSimProcessType;
+
+/**
+ * Simulated I2C slave device attached to a bus. The read and write
+ * functions are called once per transaction, when the transaction ends.
+ * Returning FALSE makes the device NACK the transaction. The device
+ * can stretch the clock of the transactions by stretchUs.
+ */
+typedef struct host_sim_i2c_device_tag
+{
+   uint8_t address;                                    /**< 7 bits slave address */
+   bool (*read)(struct host_sim_i2c_device_tag *pDev, uint8_t *pData, uint16_t size);
+   bool (*write)(struct host_sim_i2c_device_tag *pDev, const uint8_t *pData, uint16_t size);
+   void *pUserData;                                    /**< User data */
+   uint32_t stretchUs;                                 /**< Clock stretching added to every transaction */
+   struct host_sim_i2c_device_tag *pNext;              /**< Internal use */
+} HostSimI2CDeviceType;
+
+/**
+ * Analog source function. Returns the 12 bits conversion result of the
+ * given ADC channel at the given virtual time.
+ */
+typedef uint16_t (*HostSimAnalogSourceType)(uint8_t channel, uint64_t now);
+
+/**
+ * Step handler. Executed between every pair of instructions of the code
+ * being single stepped, to model an interrupt taken at any point.
+ */
+typedef void (*HostSimStepHandlerType)(void);
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Initialize the simulation. Maps the peripheral, SRAM and system
+ *        control regions at their physical addresses and resets all
+ *        peripheral models.
+ *
+ * @param none
+ *
+ * @return StatusType #E_OK if no error occurred\n
+ *                    #E_ERROR if the memory map couldn't be created
+ */
+extern StatusType HostSim_Init(void);
+
+/**
+ * @brief Run the firmware from its reset handler until the time limit
+ *        is reached. Never returns; the process exits through exit()
+ *        so atexit() reports are executed.
+ *
+ * @param limitMs Virtual time limit in milliseconds
+ *
+ * @return none
+ */
+extern void HostSim_Run(uint32_t limitMs);
+
+/**
+ * @brief Set the amount of core cycles consumed by each HAL_GetTick()
+ *        call. It models the time spent by polling loops.
+ *
+ * @param cycles Number of core cycles
+ *
+ * @return none
+ */
+extern void HostSim_SetTickQuantum(uint32_t cycles);
+
+/**
+ * @brief Hold the main loop: the next HAL_GetTick() called out of an
+ *        exception handler with the interrupts enabled advances the
+ *        virtual time by the given cycles, as a thread mode function
+ *        that takes that long would. The interrupts are dispatched
+ *        meanwhile.
+ *
+ * @param cycles Number of core cycles
+ *
+ * @return none
+ */
+extern void HostSim_Stall(uint64_t cycles);
+
+/**
+ * @brief Get the virtual time in core cycles
+ *
+ * @param none
+ *
+ * @return the number of core cycles elapsed since reset
+ */
+extern uint64_t HostSim_GetCycles(void);
+
+/**
+ * @brief Advance the virtual time, processing every peripheral event and
+ *        dispatching every interrupt that becomes pending meanwhile.
+ *
+ * @param cycles Number of core cycles to advance
+ *
+ * @return none
+ */
+extern void HostSim_Advance(uint64_t cycles);
+
+/**
+ * @brief Advance the virtual time up to the next peripheral event, i.e.
+ *        sleep until something happens. Used to implement __WFI().
+ *
+ * @param none
+ *
+ * @return none
+ */
+extern void HostSim_WaitForInterrupt(void);
+
+/**
+ * @brief Read the profiler time base. The host clock is used since the
+ *        firmware code takes no virtual time.
+ *
+ * @param none
+ *
+ * @return host monotonic time in ns, truncated to 32 bits
+ */
+extern uint32_t HostSim_GetProfilerTicks(void);
+
+/**
+ * @brief Check if the firmware is executing an exception handler
+ *
+ * @param none
+ *
+ * @return TRUE if an exception handler is active
+ */
+extern bool HostSim_InISR(void);
+
+/**
+ * @brief Single step the calling code, executing a handler after every
+ *        instruction. The handler runs on the signal stack with the
+ *        single step suspended, and may call firmware interrupt handlers
+ *        through HostSim_Advance(). A NULL handler stops the single step.
+ *
+ * @param pHandler step handler, NULL to stop
+ *
+ * @return none
+ */
+extern void HostSim_SetStepHandler(HostSimStepHandlerType pHandler);
+
+/**
+ * @brief Register a periodic process
+ *
+ * @param pProcess process descriptor. Must remain valid.
+ *
+ * @return none
+ */
+extern void HostSim_AddProcess(HostSimProcessType *pProcess);
+
+/**
+ * @brief Drive an external signal into a GPIO pin. The pin keeps the
+ *        level until it is changed again.
+ *
+ * @param port GPIO port
+ * @param pin  GPIO pin mask (GPIO_PIN_x)
+ * @param state pin level
+ *
+ * @return none
+ */
+extern void HostSim_SetPin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+
+/**
+ * @brief Read the level of a GPIO pin as seen by the outside world.
+ *
+ * @param port GPIO port
+ * @param pin  GPIO pin mask (GPIO_PIN_x)
+ *
+ * @return the pin level
+ */
+extern GPIO_PinState HostSim_GetPin(GPIO_TypeDef *port, uint16_t pin);
+
+/**
+ * @brief Set a constant value for an ADC channel
+ *
+ * @param channel ADC channel number
+ * @param value 12 bits conversion result
+ *
+ * @return none
+ */
+extern void HostSim_SetAnalogValue(uint8_t channel, uint16_t value);
+
+/**
+ * @brief Set a constant input level for an ADC channel. The level is
+ *        quantized on every conversion, after the noise is added.
+ *
+ * @param channel ADC channel number
+ * @param level input in 12 bits conversion counts, fractions allowed
+ *
+ * @return none
+ */
+extern void HostSim_SetAnalogLevel(uint8_t channel, double level);
+
+/**
+ * @brief Set the gaussian noise added to the constant input levels on
+ *        every conversion
+ *
+ * @param noise standard deviation in conversion counts. 0 disables it.
+ *
+ * @return none
+ */
+extern void HostSim_SetAnalogNoise(double noise);
+
+/**
+ * @brief Set the function used to sample every ADC channel. A NULL source
+ *        restores the constant values set through HostSim_SetAnalogValue().
+ *
+ * @param source analog source function
+ *
+ * @return none
+ */
+extern void HostSim_SetAnalogSource(HostSimAnalogSourceType source);
+
+/**
+ * @brief Attach a device to an I2C bus
+ *
+ * @param bus  I2C peripheral
+ * @param pDev device descriptor. Must remain valid.
+ *
+ * @return none
+ */
+extern void HostSim_AttachI2CDevice(I2C_TypeDef *bus, HostSimI2CDeviceType *pDev);
+
+/**
+ * @brief Set the stream that receives the bytes transmitted by an USART
+ *
+ * @param usart USART peripheral
+ * @param pFile output stream, NULL to discard the output
+ *
+ * @return none
+ */
+extern void HostSim_SetUsartOutput(USART_TypeDef *usart, FILE *pFile);
+
+/**
+ * @brief Schedule bytes to be received by an USART. The bytes are
+ *        received back to back at the configured baudrate starting at the
+ *        given virtual time.
+ *
+ * @param usart USART peripheral
+ * @param atMs  virtual time in milliseconds
+ * @param pData data to receive
+ * @param size  number of bytes
+ *
+ * @return StatusType #E_OK if no error occurred\n
+ *                    #E_ERROR if the input queue is full
+ */
+extern StatusType HostSim_UsartInput(USART_TypeDef *usart, uint32_t atMs, const uint8_t *pData, uint32_t size);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_SIM_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
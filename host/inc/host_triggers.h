@@ -0,0 +1,102 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_triggers.h
+//!
+//!   \brief      Host stress check of the ADC trigger table against the
+//!               DMA interrupt taken between every instruction.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_TRIGGERS_H
+#define  _HOST_TRIGGERS_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_TRIGGERS_ROUNDS        (40)    /**< Register, unregister and re-register rounds */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Run the ADC driver on the simulated board and, for
+ *        #HOST_TRIGGERS_ROUNDS rounds, register, unregister and
+ *        re-register triggers while a DMA block interrupt is taken
+ *        between every instruction of the driver calls. Every round
+ *        steps the input past the threshold of two triggers that stay
+ *        registered, or are unregistered and registered again, while a
+ *        third one is registered, removed and its slot reused by a
+ *        trigger that can never be raised. The results are printed to
+ *        the stream.
+ *
+ * @param pReport stream receiving the results
+ *
+ * @return StatusType #E_OK if every round raises the steady triggers
+ *                    exactly once, the reused slot never fires and
+ *                    every trigger keeps the uuid it was registered
+ *                    with\n
+ *                    #E_ERROR otherwise
+ */
+extern StatusType HostTriggers_Check(FILE *pReport);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_TRIGGERS_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,99 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_volume.h
+//!
+//!   \brief      Host check of the resampled tidal volume to finger
+//!               angle table against the source table.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_VOLUME_H
+#define  _HOST_VOLUME_H 1
+
+//********************************************************************
+//! @addtogroup host_sim_api
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_VOLUME_MAX_ERROR_ML    (1)      /**< Max volume difference accepted against the source table */
+#define HOST_VOLUME_MAX_ERROR_DEG   (1)      /**< Max angle difference accepted in 1/2^VENTILATOR_MGR_ANGLE_SHIFT degrees */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * @brief Convert every angle and every volume past both ends of the
+ *        source table with the resampled table and compare them with
+ *        the linear interpolation of the source table, extended with
+ *        its first and last segments. The errors are printed to the
+ *        stream.
+ *
+ * @param pReport stream receiving the results
+ *
+ * @return StatusType #E_OK if the source points convert exactly, both
+ *                    conversions never decrease and the errors are
+ *                    within #HOST_VOLUME_MAX_ERROR_ML and
+ *                    #HOST_VOLUME_MAX_ERROR_DEG\n
+ *                    #E_ERROR otherwise
+ */
+extern StatusType HostVolume_Check(FILE *pReport);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _HOST_VOLUME_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
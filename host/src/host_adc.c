@@ -0,0 +1,377 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_adc.c
+//!
+//!   \brief      Host simulation ADC1 model. Regular group conversions
+//!               in single or scan mode, single shot or continuous,
+//!               started by software or by a timer trigger. Conversion
+//!               time follows the programmed sample time and the ADC
+//!               clock prescaler. The analog levels are kept with more
+//!               resolution than the converter and gaussian noise can be
+//!               added before quantization, to exercise oversampling.
+//!               The interval between scans is measured and reported
+//!               when the simulation ends, to verify the sample rate.
+//!               Injected conversions and the analog watchdog are not
+//!               modeled.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_ADC_DMA_CHANNEL           (1)
+#define HOST_ADC_EXTSEL_SWSTART        (7)
+#define HOST_ADC_MAX_VALUE             (4095)
+
+// conversion time is the sample time plus 12.5 ADC clocks
+#define HOST_ADC_CONVERSION_HALF_CLOCKS   (25)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_adc_tag
+{
+   bool converting;
+   uint8_t rank;           // rank being converted
+   uint64_t convEnd;       // end of the conversion in progress
+   HostSimAnalogSourceType source;
+   double level[HOST_SIM_ADC_CHANNELS];   // input in counts, not quantized
+   double noise;           // noise standard deviation in counts
+   uint64_t seed;
+   uint64_t scans;         // scans started
+   uint64_t missed;        // triggers received while converting
+   uint64_t firstStart;
+   uint64_t lastStart;
+   uint64_t minPeriod;
+   uint64_t maxPeriod;
+} HostAdcType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static uint8_t host_adc_rank_channel(uint8_t rank);
+static uint8_t host_adc_ranks(void);
+static uint64_t host_adc_conversion_cycles(uint8_t channel);
+static uint32_t host_adc_quantize(uint8_t channel);
+static double host_adc_gaussian(void);
+static void host_adc_start(uint64_t now);
+static void host_adc_report(void);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+// sample times in half ADC clocks: 1.5, 7.5, 13.5, 28.5, 41.5, 55.5, 71.5 and 239.5
+static const uint16_t host_adc_sample_half_clocks[8] = { 3, 15, 27, 57, 83, 111, 143, 479 };
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostAdcType hostAdc;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostSim_SetAnalogValue(uint8_t channel, uint16_t value)
+{
+   HostSim_SetAnalogLevel(channel, value & 0x0FFF);
+}
+
+void HostSim_SetAnalogLevel(uint8_t channel, double level)
+{
+   if (channel < HOST_SIM_ADC_CHANNELS)
+      hostAdc.level[channel] = level;
+}
+
+void HostSim_SetAnalogNoise(double noise)
+{
+   hostAdc.noise = (noise > 0.0) ? noise : 0.0;
+}
+
+void HostSim_SetAnalogSource(HostSimAnalogSourceType source)
+{
+   hostAdc.source = source;
+}
+
+void HostAdc_Init(void)
+{
+   hostAdc.converting = FALSE;
+   hostAdc.rank = 0;
+   hostAdc.convEnd = 0;
+   hostAdc.scans = 0;
+   hostAdc.missed = 0;
+   hostAdc.minPeriod = UINT64_MAX;
+   hostAdc.maxPeriod = 0;
+   hostAdc.seed = 1;
+
+   atexit(host_adc_report);
+}
+
+void HostAdc_Sync(uint64_t now)
+{
+   uint32_t cr2 = ADC1->CR2;
+
+   // calibration completes instantly
+   if (0 != (cr2 & (ADC_CR2_RSTCAL | ADC_CR2_CAL)))
+      ADC1->CR2 = cr2 & ~(ADC_CR2_RSTCAL | ADC_CR2_CAL);
+
+   if (0 == (cr2 & ADC_CR2_ADON))
+   {
+      hostAdc.converting = FALSE;
+      return;
+   }
+
+   if (0 != (cr2 & ADC_CR2_SWSTART))
+   {
+      ADC1->CR2 &= ~ADC_CR2_SWSTART;
+      if ((0 != (cr2 & ADC_CR2_EXTTRIG)) &&
+          (HOST_ADC_EXTSEL_SWSTART == ((cr2 & ADC_CR2_EXTSEL) >> ADC_CR2_EXTSEL_Pos)))
+      {
+         host_adc_start(now);
+      }
+   }
+}
+
+uint64_t HostAdc_NextEvent(uint64_t now)
+{
+   return (FALSE != hostAdc.converting) ? hostAdc.convEnd : HOST_SIM_NO_EVENT;
+}
+
+void HostAdc_Process(uint64_t now)
+{
+   while ((FALSE != hostAdc.converting) && (hostAdc.convEnd <= now))
+   {
+      uint64_t convEnd = hostAdc.convEnd;
+      uint8_t channel = host_adc_rank_channel(hostAdc.rank);
+      uint32_t value;
+
+      value = (NULL != hostAdc.source) ? hostAdc.source(channel, convEnd) : host_adc_quantize(channel);
+      value &= 0x0FFF;
+      if (0 != (ADC1->CR2 & ADC_CR2_ALIGN))
+         value <<= 4;
+
+      ADC1->DR = value;
+      ADC1->SR |= ADC_SR_EOC | ADC_SR_STRT;
+
+      // reading DR through the DMA clears the end of conversion flag
+      if ((0 != (ADC1->CR2 & ADC_CR2_DMA)) && (FALSE != HostDma_Request(HOST_ADC_DMA_CHANNEL)))
+         ADC1->SR &= ~ADC_SR_EOC;
+
+      hostAdc.rank++;
+      if (hostAdc.rank >= host_adc_ranks())
+      {
+         hostAdc.rank = 0;
+         if (0 == (ADC1->CR2 & ADC_CR2_CONT))
+         {
+            hostAdc.converting = FALSE;
+            break;
+         }
+      }
+      hostAdc.convEnd = convEnd + host_adc_conversion_cycles(host_adc_rank_channel(hostAdc.rank));
+   }
+}
+
+void HostAdc_Commit(uint64_t now)
+{
+}
+
+bool HostAdc_IrqLevel(IRQn_Type irq)
+{
+   uint32_t sr = ADC1->SR;
+   uint32_t cr1 = ADC1->CR1;
+
+   return ((0 != (sr & ADC_SR_EOC)) && (0 != (cr1 & ADC_CR1_EOCIE))) ||
+          ((0 != (sr & ADC_SR_JEOC)) && (0 != (cr1 & ADC_CR1_JEOCIE))) ||
+          ((0 != (sr & ADC_SR_AWD)) && (0 != (cr1 & ADC_CR1_AWDIE)));
+}
+
+int32_t HostAdc_GetExternalTrigger(void)
+{
+   uint32_t cr2 = ADC1->CR2;
+   uint32_t extsel = (cr2 & ADC_CR2_EXTSEL) >> ADC_CR2_EXTSEL_Pos;
+
+   if ((0 == (cr2 & ADC_CR2_ADON)) || (0 == (cr2 & ADC_CR2_EXTTRIG)) || (HOST_ADC_EXTSEL_SWSTART == extsel))
+      return -1;
+
+   return (int32_t)extsel;
+}
+
+void HostAdc_Trigger(uint32_t extsel, uint64_t now)
+{
+   if ((int32_t)extsel == HostAdc_GetExternalTrigger())
+      host_adc_start(now);
+}
+
+static uint8_t host_adc_rank_channel(uint8_t rank)
+{
+   uint32_t sqr;
+
+   if (rank < 6)
+      sqr = ADC1->SQR3;
+   else if (rank < 12)
+      sqr = ADC1->SQR2;
+   else
+      sqr = ADC1->SQR1;
+
+   return (uint8_t)((sqr >> (5 * (rank % 6))) & 0x1F) % HOST_SIM_ADC_CHANNELS;
+}
+
+static uint8_t host_adc_ranks(void)
+{
+   if (0 == (ADC1->CR1 & ADC_CR1_SCAN))
+      return 1;
+
+   return (uint8_t)(((ADC1->SQR1 & ADC_SQR1_L) >> ADC_SQR1_L_Pos) + 1);
+}
+
+static uint64_t host_adc_conversion_cycles(uint8_t channel)
+{
+   uint32_t smp;
+
+   if (channel < 10)
+      smp = (ADC1->SMPR2 >> (3 * channel)) & 0x7;
+   else
+      smp = (ADC1->SMPR1 >> (3 * (channel - 10))) & 0x7;
+
+   return ((uint64_t)(host_adc_sample_half_clocks[smp] + HOST_ADC_CONVERSION_HALF_CLOCKS) *
+           HostRcc_GetAdcDivider()) / 2;
+}
+
+static uint32_t host_adc_quantize(uint8_t channel)
+{
+   double level = hostAdc.level[channel];
+
+   if (hostAdc.noise > 0.0)
+      level += hostAdc.noise * host_adc_gaussian();
+
+   level = floor(level + 0.5);
+   if (level < 0.0)
+      return 0;
+   if (level > HOST_ADC_MAX_VALUE)
+      return HOST_ADC_MAX_VALUE;
+
+   return (uint32_t)level;
+}
+
+static double host_adc_gaussian(void)
+{
+   double u1, u2;
+
+   // Box-Muller on a fixed seed, so runs can be repeated
+   hostAdc.seed = hostAdc.seed * 6364136223846793005ULL + 1442695040888963407ULL;
+   u1 = ((hostAdc.seed >> 11) + 1.0) / 9007199254740993.0;
+   hostAdc.seed = hostAdc.seed * 6364136223846793005ULL + 1442695040888963407ULL;
+   u2 = (hostAdc.seed >> 11) / 9007199254740992.0;
+
+   return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static void host_adc_start(uint64_t now)
+{
+   // triggers received while converting are ignored
+   if (FALSE != hostAdc.converting)
+   {
+      hostAdc.missed++;
+      return;
+   }
+
+   if (0 == hostAdc.scans)
+   {
+      hostAdc.firstStart = now;
+   }
+   else
+   {
+      uint64_t period = now - hostAdc.lastStart;
+
+      if (period < hostAdc.minPeriod)
+         hostAdc.minPeriod = period;
+      if (period > hostAdc.maxPeriod)
+         hostAdc.maxPeriod = period;
+   }
+   hostAdc.scans++;
+   hostAdc.lastStart = now;
+
+   hostAdc.converting = TRUE;
+   hostAdc.rank = 0;
+   hostAdc.convEnd = now + host_adc_conversion_cycles(host_adc_rank_channel(0));
+}
+
+static void host_adc_report(void)
+{
+   double mean;
+
+   if (hostAdc.scans < 2)
+      return;
+
+   mean = (double)(hostAdc.lastStart - hostAdc.firstStart) / (hostAdc.scans - 1);
+   fprintf(stderr, "host_adc: %llu scans, period %.2f us (min %.2f, max %.2f), %llu triggers missed\n",
+           (unsigned long long)hostAdc.scans, mean * 1e6 / HOST_SIM_CORE_CLOCK_HZ,
+           (double)hostAdc.minPeriod * 1e6 / HOST_SIM_CORE_CLOCK_HZ,
+           (double)hostAdc.maxPeriod * 1e6 / HOST_SIM_CORE_CLOCK_HZ,
+           (unsigned long long)hostAdc.missed);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,307 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_board.c
+//!
+//!   \brief      Host simulation default board. Drives the digital
+//!               inputs, the pressure sensor and the differential flow
+//!               sensor of the ventilator, and decodes the motor H bridge
+//!               outputs for the plant models.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_board.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_BOARD_PRESSURE_CHANNEL    (4)
+
+// pressure sensor range in mmH2O over the ADC full scale
+#define HOST_BOARD_PRESSURE_MIN        (-90.0)
+#define HOST_BOARD_PRESSURE_MAX        (1155.0)
+#define HOST_BOARD_ADC_FULL_SCALE      (4095.0)
+
+#define HOST_BOARD_SFM_ADDRESS         (0x49)
+#define HOST_BOARD_SFM_SERIAL          (0x12345678UL)
+#define HOST_BOARD_SFM_FULL_SCALE      (100.0)        // SLPM
+#define HOST_BOARD_SFM_CRC_POLYNOMIAL  (0x31)         // x^8 + x^5 + x^4 + 1
+
+#define HOST_BOARD_MOTOR_TIMER         (TIM2)
+#define HOST_BOARD_MOTOR_DIR_PORT      (GPIOC)
+#define HOST_BOARD_MOTOR_DIRA_PIN      (GPIO_PIN_14)
+#define HOST_BOARD_MOTOR_DIRB_PIN      (GPIO_PIN_15)
+
+#define HOST_BOARD_ENCODER_PORT        (GPIOB)
+#define HOST_BOARD_ENCODER_A_PIN       (GPIO_PIN_13)
+#define HOST_BOARD_ENCODER_B_PIN       (GPIO_PIN_14)
+#define HOST_BOARD_HOME_PORT           (GPIOB)
+#define HOST_BOARD_HOME_PIN            (GPIO_PIN_15)
+
+// output compare modes
+#define HOST_BOARD_OCM_PWM1            (6)
+#define HOST_BOARD_OCM_PWM2            (7)
+
+/**
+ * Digital inputs table.
+ * The input format is: X([port], [pin], [level])
+ */
+#define HOST_BOARD_INPUTS_CFG \
+   X(GPIOC, GPIO_PIN_10, GPIO_PIN_SET  )  /* keyboard row 0, released */ \
+   X(GPIOC, GPIO_PIN_11, GPIO_PIN_SET  )  /* keyboard row 2, released */ \
+   X(GPIOC, GPIO_PIN_12, GPIO_PIN_SET  )  /* keyboard row 1, released */ \
+   X(GPIOB, GPIO_PIN_1 , GPIO_PIN_RESET)  /* main power present */       \
+   X(GPIOB, GPIO_PIN_13, GPIO_PIN_SET  )  /* motor encoder A */          \
+   X(GPIOB, GPIO_PIN_14, GPIO_PIN_SET  )  /* motor encoder B */          \
+   X(GPIOB, GPIO_PIN_15, GPIO_PIN_RESET)  /* motor home switch */        \
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_board_sfm_tag
+{
+   uint8_t words;          // serial number words already read
+   uint16_t flow;          // raw flow code
+} HostBoardSfmType;
+
+typedef struct host_board_tag
+{
+   int32_t encoderPosition;
+} HostBoardType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static bool host_board_sfm_read(HostSimI2CDeviceType *pDev, uint8_t *pData, uint16_t size);
+static uint8_t host_board_sfm_crc8(uint16_t word);
+static double host_board_pwm_duty(uint32_t channel);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+// encoder A and B levels along the quadrature sequence
+static const uint8_t host_board_encoder_states[4] = { 0x3, 0x2, 0x0, 0x1 };
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostBoardType hostBoard;
+static HostBoardSfmType hostBoardSfm;
+
+static HostSimI2CDeviceType hostBoardSfmDevice =
+{
+   .address = HOST_BOARD_SFM_ADDRESS,
+   .read = host_board_sfm_read,
+   .write = NULL,
+   .pUserData = &hostBoardSfm,
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostBoard_Init(void)
+{
+#define X(port, pin, level) HostSim_SetPin(port, pin, level);
+   HOST_BOARD_INPUTS_CFG
+#undef X
+
+   hostBoard.encoderPosition = 0;
+   HostBoard_SetPressure(0.0);
+
+   hostBoardSfm.words = 0;
+   HostBoard_SetFlow(0.0);
+   HostSim_AttachI2CDevice(I2C2, &hostBoardSfmDevice);
+}
+
+void HostBoard_GetMotorBridge(HostBoardBridgeType *pBridge)
+{
+   double dutyA = host_board_pwm_duty(0);
+   double dutyB = host_board_pwm_duty(1);
+   uint32_t odr = HOST_BOARD_MOTOR_DIR_PORT->ODR;
+   int32_t dirA = (0 != (odr & HOST_BOARD_MOTOR_DIRA_PIN)) ? 1 : 0;
+   int32_t dirB = (0 != (odr & HOST_BOARD_MOTOR_DIRB_PIN)) ? 1 : 0;
+
+   // Each half bridge drives its direction level while its PWM input is
+   // high and leaves the output floating otherwise. Both channels start the
+   // period together, so the motor is connected while both are high.
+   pBridge->closed = (dutyA < dutyB) ? dutyA : dutyB;
+   pBridge->drive = pBridge->closed * (dirA - dirB);
+}
+
+void HostBoard_SetEncoderPosition(int32_t position)
+{
+   while (hostBoard.encoderPosition != position)
+   {
+      uint8_t state;
+
+      hostBoard.encoderPosition += (position > hostBoard.encoderPosition) ? 1 : -1;
+      state = host_board_encoder_states[hostBoard.encoderPosition & 0x3];
+
+      // a single channel changes on every step
+      HostSim_SetPin(HOST_BOARD_ENCODER_PORT, HOST_BOARD_ENCODER_A_PIN, (0 != (state & 0x2)) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+      HostSim_SetPin(HOST_BOARD_ENCODER_PORT, HOST_BOARD_ENCODER_B_PIN, (0 != (state & 0x1)) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+   }
+}
+
+void HostBoard_SetHomeSwitch(bool active)
+{
+   HostSim_SetPin(HOST_BOARD_HOME_PORT, HOST_BOARD_HOME_PIN, (FALSE != active) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+void HostBoard_SetPressure(double pressure)
+{
+   double raw;
+
+   raw = (pressure * 10.0 - HOST_BOARD_PRESSURE_MIN) * HOST_BOARD_ADC_FULL_SCALE /
+         (HOST_BOARD_PRESSURE_MAX - HOST_BOARD_PRESSURE_MIN);
+   if (raw < 0.0)
+      raw = 0.0;
+   if (raw > HOST_BOARD_ADC_FULL_SCALE)
+      raw = HOST_BOARD_ADC_FULL_SCALE;
+
+   HostSim_SetAnalogLevel(HOST_BOARD_PRESSURE_CHANNEL, raw);
+}
+
+void HostBoard_SetFlow(double flow)
+{
+   double code;
+
+   // SFM3x00 output: 16384 * (0.1 + 0.8 * flow / full scale)
+   code = 16384.0 * (0.1 + 0.8 * flow / HOST_BOARD_SFM_FULL_SCALE);
+   if (code < 0.0)
+      code = 0.0;
+   if (code > UINT16_MAX)
+      code = UINT16_MAX;
+
+   hostBoardSfm.flow = (uint16_t)(code + 0.5);
+}
+
+static bool host_board_sfm_read(HostSimI2CDeviceType *pDev, uint8_t *pData, uint16_t size)
+{
+   HostBoardSfmType *pSfm = (HostBoardSfmType *)pDev->pUserData;
+   uint16_t word;
+
+   // the first two reads return the serial number, the measurement follows
+   if (pSfm->words < 2)
+   {
+      word = (uint16_t)(HOST_BOARD_SFM_SERIAL >> (16 * (1 - pSfm->words)));
+      pSfm->words++;
+   }
+   else
+   {
+      word = pSfm->flow;
+   }
+
+   // every word is followed by its CRC
+   for (uint16_t i = 0; i < size; i++)
+   {
+      if (0 == i)
+         pData[i] = (uint8_t)(word >> 8);
+      else if (1 == i)
+         pData[i] = (uint8_t)word;
+      else if (2 == i)
+         pData[i] = host_board_sfm_crc8(word);
+      else
+         pData[i] = 0;
+   }
+
+   return TRUE;
+}
+
+static uint8_t host_board_sfm_crc8(uint16_t word)
+{
+   uint8_t crc = (uint8_t)(word >> 8);
+
+   for (int byte = 0; byte < 2; byte++)
+   {
+      for (int bit = 0; bit < 8; bit++)
+         crc = (0 != (crc & 0x80)) ? (uint8_t)((crc << 1) ^ HOST_BOARD_SFM_CRC_POLYNOMIAL) : (uint8_t)(crc << 1);
+      if (0 == byte)
+         crc ^= (uint8_t)word;
+   }
+
+   return crc;
+}
+
+static double host_board_pwm_duty(uint32_t channel)
+{
+   TIM_TypeDef *tim = HOST_BOARD_MOTOR_TIMER;
+   uint32_t period = (tim->ARR & 0xFFFF) + 1;
+   uint32_t ccr = (0 == channel) ? tim->CCR1 : tim->CCR2;
+   uint32_t ocm = (tim->CCMR1 >> (4 + 8 * channel)) & 0x7;
+   double duty;
+
+   if ((0 == (tim->CR1 & TIM_CR1_CEN)) || (0 == (tim->CCER & (TIM_CCER_CC1E << (4 * channel)))))
+      return 0.0;
+
+   duty = (ccr >= period) ? 1.0 : ((double)ccr / period);
+   if (HOST_BOARD_OCM_PWM2 == ocm)
+      duty = 1.0 - duty;
+   else if (HOST_BOARD_OCM_PWM1 != ocm)
+      return 0.0;
+   if (0 != (tim->CCER & (TIM_CCER_CC1P << (4 * channel))))
+      duty = 1.0 - duty;
+
+   return duty;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
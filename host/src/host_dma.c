@@ -0,0 +1,275 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_dma.c
+//!
+//!   \brief      Host simulation DMA1 model. Transfers are executed one
+//!               item at a time when a peripheral model raises a request
+//!               on the channel, so the transfer counter and the half and
+//!               full transfer flags evolve as in the real controller.
+//!               Memory to memory channels run to completion as soon as
+//!               they are enabled.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_DMA_CHANNELS              (7)
+#define HOST_DMA_CHANNEL_REGS(ch)      ((DMA_Channel_TypeDef *)(DMA1_Channel1_BASE + ((ch) - 1) * 0x14UL))
+#define HOST_DMA_FLAGS_SHIFT(ch)       (((ch) - 1) * 4)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_dma_channel_tag
+{
+   bool enabled;
+   uint32_t reload;        // transfer count latched when the channel was enabled
+   uint32_t count;         // transfer count last published in CNDTR
+   uint32_t memory;        // memory address latched when the channel was enabled
+   uint32_t index;         // number of items transferred in the current block
+} HostDmaChannelType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static uint32_t host_dma_read(uint32_t address, uint32_t size);
+static void host_dma_write(uint32_t address, uint32_t size, uint32_t value);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostDmaChannelType hostDma[HOST_DMA_CHANNELS + 1];
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostDma_Init(void)
+{
+   for (uint32_t ch = 1; ch <= HOST_DMA_CHANNELS; ch++)
+   {
+      hostDma[ch].enabled = FALSE;
+      hostDma[ch].reload = 0;
+      hostDma[ch].count = 0;
+      hostDma[ch].memory = 0;
+      hostDma[ch].index = 0;
+   }
+}
+
+void HostDma_Sync(uint64_t now)
+{
+   // interrupt flag clear register
+   if (0 != DMA1->IFCR)
+   {
+      DMA1->ISR &= ~HOST_DMA_IFCR_TO_ISR(DMA1->IFCR);
+      DMA1->IFCR = 0;
+   }
+
+   for (uint32_t ch = 1; ch <= HOST_DMA_CHANNELS; ch++)
+   {
+      DMA_Channel_TypeDef *regs = HOST_DMA_CHANNEL_REGS(ch);
+      HostDmaChannelType *pCh = &hostDma[ch];
+      bool enabled = (0 != (regs->CCR & DMA_CCR_EN));
+
+      // A channel reprogrammed between two synchronizations is detected
+      // through its transfer counter or memory address
+      if ((FALSE != enabled) &&
+          ((FALSE == pCh->enabled) || ((regs->CNDTR & 0xFFFF) != pCh->count) || (regs->CMAR != pCh->memory)))
+      {
+         pCh->reload = regs->CNDTR & 0xFFFF;
+         pCh->count = pCh->reload;
+         pCh->memory = regs->CMAR;
+         pCh->index = 0;
+      }
+      pCh->enabled = enabled;
+
+      if ((FALSE != enabled) && (0 != (regs->CCR & DMA_CCR_MEM2MEM)))
+      {
+         while (FALSE != HostDma_Request(ch))
+         {
+            if (0 == pCh->count)
+               break;
+         }
+      }
+   }
+}
+
+uint64_t HostDma_NextEvent(uint64_t now)
+{
+   return HOST_SIM_NO_EVENT;
+}
+
+void HostDma_Process(uint64_t now)
+{
+}
+
+void HostDma_Commit(uint64_t now)
+{
+}
+
+bool HostDma_Ready(uint8_t channel)
+{
+   return (FALSE != hostDma[channel].enabled) && (0 != hostDma[channel].count);
+}
+
+bool HostDma_Request(uint8_t channel)
+{
+   DMA_Channel_TypeDef *regs;
+   HostDmaChannelType *pCh;
+   uint32_t ccr, psize, msize, periph, memory;
+   uint32_t shift;
+
+   if ((channel < 1) || (channel > HOST_DMA_CHANNELS) || (FALSE == HostDma_Ready(channel)))
+      return FALSE;
+
+   regs = HOST_DMA_CHANNEL_REGS(channel);
+   pCh = &hostDma[channel];
+   ccr = regs->CCR;
+
+   psize = 1UL << ((ccr & DMA_CCR_PSIZE) >> DMA_CCR_PSIZE_Pos);
+   msize = 1UL << ((ccr & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos);
+   periph = regs->CPAR + ((0 != (ccr & DMA_CCR_PINC)) ? pCh->index * psize : 0);
+   memory = pCh->memory + ((0 != (ccr & DMA_CCR_MINC)) ? pCh->index * msize : 0);
+
+   if (0 != (ccr & DMA_CCR_DIR))
+      host_dma_write(periph, psize, host_dma_read(memory, msize));
+   else
+      host_dma_write(memory, msize, host_dma_read(periph, psize));
+
+   pCh->index++;
+   pCh->count--;
+
+   shift = HOST_DMA_FLAGS_SHIFT(channel);
+   if (pCh->count == (pCh->reload - (pCh->reload / 2)))
+      DMA1->ISR |= (DMA_ISR_HTIF1 | DMA_ISR_GIF1) << shift;
+   if (0 == pCh->count)
+   {
+      DMA1->ISR |= (DMA_ISR_TCIF1 | DMA_ISR_GIF1) << shift;
+      if (0 != (ccr & DMA_CCR_CIRC))
+      {
+         pCh->count = pCh->reload;
+         pCh->index = 0;
+      }
+   }
+   regs->CNDTR = pCh->count;
+
+   return TRUE;
+}
+
+bool HostDma_IrqLevel(IRQn_Type irq)
+{
+   uint32_t ch = (uint32_t)(irq - DMA1_Channel1_IRQn) + 1;
+   uint32_t flags;
+
+   if ((ch < 1) || (ch > HOST_DMA_CHANNELS))
+      return FALSE;
+
+   // TCIE, HTIE and TEIE match the TCIF, HTIF and TEIF positions
+   flags = (DMA1->ISR >> HOST_DMA_FLAGS_SHIFT(ch)) & (DMA_ISR_TCIF1 | DMA_ISR_HTIF1 | DMA_ISR_TEIF1);
+
+   return (0 != (flags & HOST_DMA_CHANNEL_REGS(ch)->CCR));
+}
+
+static uint32_t host_dma_read(uint32_t address, uint32_t size)
+{
+   volatile void *p = (volatile void *)(uintptr_t)address;
+
+   if (1 == size)
+      return *(volatile uint8_t *)p;
+   if (2 == size)
+      return *(volatile uint16_t *)p;
+
+   return *(volatile uint32_t *)p;
+}
+
+static void host_dma_write(uint32_t address, uint32_t size, uint32_t value)
+{
+   volatile void *p = (volatile void *)(uintptr_t)address;
+
+   if ((address >= HOST_SIM_GPIO_PAGES_BASE) && (address < (HOST_SIM_GPIO_PAGES_BASE + HOST_SIM_GPIO_PAGES_SIZE)))
+   {
+      // same path as a trapped write from the core
+      uint32_t oldValue = *(volatile uint32_t *)p;
+
+      *(volatile uint32_t *)HostSim_PeriphAlias(p) = value;
+      HostGpio_Write(address, oldValue, value);
+      HostGpio_Update();
+      return;
+   }
+
+   if ((address >= PERIPH_BASE) && (address < (PERIPH_BASE + HOST_SIM_PERIPH_SIZE)))
+      p = HostSim_PeriphAlias(p);
+
+   if (1 == size)
+      *(volatile uint8_t *)p = (uint8_t)value;
+   else if (2 == size)
+      *(volatile uint16_t *)p = (uint16_t)value;
+   else
+      *(volatile uint32_t *)p = value;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
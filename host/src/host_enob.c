@@ -0,0 +1,195 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_enob.c
+//!
+//!   \brief      Host measurement of the effective resolution of the
+//!               filtered airway pressure reading. The pressure input is
+//!               held at levels 1/16 of an ADC count apart, over two
+//!               counts, and every reading of the last part of each
+//!               level is compared with the input. Combined with the ADC
+//!               noise set through HostSim_SetAnalogNoise() it shows the
+//!               resolution gained by the oversampling, the filter and
+//!               the bits kept by the driver.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "adc_drv_api.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_enob.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_ENOB_PERIOD_US         (1000)
+#define HOST_ENOB_START_MS          (500)       // firmware initialization
+#define HOST_ENOB_LEVEL_MS          (300)       // time every level is held
+#define HOST_ENOB_SETTLE_MS         (200)       // readings ignored after a level change
+#define HOST_ENOB_BASE_LEVEL        (1000.0)
+#define HOST_ENOB_STEPS_PER_COUNT   (16)
+#define HOST_ENOB_LEVELS            (2 * HOST_ENOB_STEPS_PER_COUNT)
+#define HOST_ENOB_CHANNEL           (AIN_PRESSURE)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_enob_tag
+{
+   uint32_t levels;        // levels completely measured
+   uint64_t readings;
+   double sumError;
+   double sumSquaredError;
+   double maxError;
+} HostEnobType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_enob_run(uint64_t now, void *pUserData);
+static void host_enob_report(void);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+#define X(a,b,c,d,e,f,g) (uint8_t)(b),
+static const uint8_t host_enob_hw_channel[] = { ADC_DRV_INPUTS_CFG };
+#undef X
+
+#define X(a,b,c,d,e,f,g) e,
+static const uint8_t host_enob_resolution[] = { ADC_DRV_INPUTS_CFG };
+#undef X
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostEnobType hostEnob;
+
+static HostSimProcessType hostEnobProcess =
+{
+   .period = HOST_SIM_US_TO_CYCLES(HOST_ENOB_PERIOD_US),
+   .next = 0,
+   .run = host_enob_run,
+   .pUserData = &hostEnob,
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostEnob_Init(void)
+{
+   HostSim_SetAnalogLevel(host_enob_hw_channel[HOST_ENOB_CHANNEL], HOST_ENOB_BASE_LEVEL);
+
+   HostSim_AddProcess(&hostEnobProcess);
+   atexit(host_enob_report);
+}
+
+static void host_enob_run(uint64_t now, void *pUserData)
+{
+   HostEnobType *pEnob = (HostEnobType *)pUserData;
+   uint64_t ms = now / HOST_SIM_MS_TO_CYCLES(1);
+   uint32_t level, elapsed;
+   double input, reading, error;
+
+   if (ms < HOST_ENOB_START_MS)
+      return;
+
+   level = (uint32_t)((ms - HOST_ENOB_START_MS) / HOST_ENOB_LEVEL_MS);
+   elapsed = (uint32_t)((ms - HOST_ENOB_START_MS) % HOST_ENOB_LEVEL_MS);
+   if (level >= HOST_ENOB_LEVELS)
+      return;
+
+   input = HOST_ENOB_BASE_LEVEL + (double)level / HOST_ENOB_STEPS_PER_COUNT;
+   if (0 == elapsed)
+      HostSim_SetAnalogLevel(host_enob_hw_channel[HOST_ENOB_CHANNEL], input);
+   if (elapsed < HOST_ENOB_SETTLE_MS)
+      return;
+
+   // filtered reading back to 12 bits counts
+   reading = ADCDrv_GetValue(HOST_ENOB_CHANNEL, TRUE, FALSE) /
+             (double)(1UL << (host_enob_resolution[HOST_ENOB_CHANNEL] - 12));
+   error = reading - input;
+
+   pEnob->readings++;
+   pEnob->sumError += error;
+   pEnob->sumSquaredError += error * error;
+   if (fabs(error) > pEnob->maxError)
+      pEnob->maxError = fabs(error);
+   if ((HOST_ENOB_LEVEL_MS - 1) == elapsed)
+      pEnob->levels++;
+}
+
+static void host_enob_report(void)
+{
+   double rms;
+
+   if (0 == hostEnob.readings)
+      return;
+
+   // an ideal N bits converter has an RMS error of 1 / sqrt(12) of its count
+   rms = sqrt(hostEnob.sumSquaredError / hostEnob.readings);
+   fprintf(stderr, "host_enob: %u levels, %u bits samples, error mean %.3f, rms %.3f, max %.3f counts, ENOB %.2f bits\n",
+           hostEnob.levels, host_enob_resolution[HOST_ENOB_CHANNEL], hostEnob.sumError / hostEnob.readings,
+           rms, hostEnob.maxError, 12.0 - log2(rms * sqrt(12.0)));
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,189 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_filter.c
+//!
+//!   \brief      Host check of the fixed point ADC filter. The q31
+//!               filter used by the firmware and the floating point
+//!               design it comes from are fed the same 12 bits samples
+//!               and their outputs are compared after the conversion
+//!               back to ADC counts, as the driver does. The time taken
+//!               on the target is not modeled: the host has a floating
+//!               point unit. The ADC DMA interrupt time is measured on
+//!               the board with the pulse on IO_DBG_LED.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <math.h>
+#include "standard.h"
+#include "lpf_butter_10hz_float.h"
+#include "lpf_butter_10hz_q31.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_filter.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_FILTER_SAMPLE_RATE     (1000.0)    // sample rate the filter was designed for
+#define HOST_FILTER_STEP_SAMPLES    (2000)
+#define HOST_FILTER_SWEEP_SAMPLES   (20000)
+#define HOST_FILTER_NOISE_SAMPLES   (20000)
+#define HOST_FILTER_SAMPLES         (4 * HOST_FILTER_STEP_SAMPLES + HOST_FILTER_SWEEP_SAMPLES + HOST_FILTER_NOISE_SAMPLES)
+#define HOST_FILTER_ADC_MAX         (4095)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_filter_build_input(void);
+static int16_t host_filter_float(lpf_butter_10hz_floatType *pFilter, int16_t in);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static int16_t hostFilterInput[HOST_FILTER_SAMPLES];
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType HostFilter_Check(FILE *pReport)
+{
+   lpf_butter_10hz_floatType floatFilter;
+   lpf_butter_10hz_q31Type q31Filter;
+   uint32_t differ = 0;
+   int32_t maxError = 0;
+   uint32_t at = 0;
+
+   host_filter_build_input();
+
+   lpf_butter_10hz_float_init(&floatFilter);
+   lpf_butter_10hz_q31_init(&q31Filter);
+   for (uint32_t i = 0; i < HOST_FILTER_SAMPLES; i++)
+   {
+      int32_t error = host_filter_float(&floatFilter, hostFilterInput[i]) -
+                      lpf_butter_10hz_q31_filterSample(&q31Filter, hostFilterInput[i]);
+
+      if (error < 0)
+         error = -error;
+      if (0 != error)
+         differ++;
+      if (error > maxError)
+      {
+         maxError = error;
+         at = i;
+      }
+   }
+
+   fprintf(pReport, "host_filter: %u samples, max error %ld counts at sample %u, %u samples differ\n",
+           HOST_FILTER_SAMPLES, (long)maxError, at, differ);
+
+   return (maxError <= HOST_FILTER_MAX_ERROR) ? E_OK : E_ERROR;
+}
+
+static void host_filter_build_input(void)
+{
+   uint32_t n = 0;
+   uint32_t seed = 1;
+
+   // full scale steps, the worst case for the overshoot
+   for (uint32_t i = 0; i < HOST_FILTER_STEP_SAMPLES; i++)
+      hostFilterInput[n++] = HOST_FILTER_ADC_MAX;
+   for (uint32_t i = 0; i < HOST_FILTER_STEP_SAMPLES; i++)
+      hostFilterInput[n++] = 0;
+   for (uint32_t i = 0; i < HOST_FILTER_STEP_SAMPLES; i++)
+      hostFilterInput[n++] = HOST_FILTER_ADC_MAX;
+   for (uint32_t i = 0; i < HOST_FILTER_STEP_SAMPLES; i++)
+      hostFilterInput[n++] = 296;
+
+   // logarithmic sweep from 0.1Hz to the Nyquist frequency
+   for (uint32_t i = 0; i < HOST_FILTER_SWEEP_SAMPLES; i++)
+   {
+      double t = i / HOST_FILTER_SAMPLE_RATE;
+      double duration = HOST_FILTER_SWEEP_SAMPLES / HOST_FILTER_SAMPLE_RATE;
+      double f0 = 0.1, f1 = HOST_FILTER_SAMPLE_RATE / 2;
+      double k = log(f1 / f0) / duration;
+      double phase = 2 * M_PI * f0 * (exp(k * t) - 1) / k;
+
+      hostFilterInput[n++] = (int16_t)lround(2048 + 2047 * sin(phase));
+   }
+
+   // uniform noise over the whole range
+   for (uint32_t i = 0; i < HOST_FILTER_NOISE_SAMPLES; i++)
+   {
+      seed = seed * 1664525 + 1013904223;
+      hostFilterInput[n++] = (int16_t)((seed >> 16) % (HOST_FILTER_ADC_MAX + 1));
+   }
+}
+
+static int16_t host_filter_float(lpf_butter_10hz_floatType *pFilter, int16_t in)
+{
+   // conversion done by the driver before the fixed point version
+   float tmpIn = (1.0f * in) / 4096;
+
+   lpf_butter_10hz_float_writeInput(pFilter, tmpIn);
+   return (int16_t)(lpf_butter_10hz_float_readOutput(pFilter) * 4096);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
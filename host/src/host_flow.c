@@ -0,0 +1,275 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_flow.c
+//!
+//!   \brief      Host check of the flow meter volume integrator. Breaths
+//!               of known flow waveforms are turned into sensor readings,
+//!               sampled at the flow meter rate with some jitter and
+//!               integrated by the firmware code. The volumes of every
+//!               breath are compared with the integrals of the waveforms
+//!               in double precision.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <math.h>
+#include "standard.h"
+#include "dflow_meter_drv_conf.h"
+#include "dflow_meter_drv_api.h"
+#include "dflow_volume.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_flow.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_FLOW_BREATHS           (10)
+#define HOST_FLOW_SAMPLE_US         (1000000 / DFLOW_METER_DRV_SAMPLE_RATE_HZ)
+#define HOST_FLOW_JITTER_US         (100)          // samples are taken every period +- this
+#define HOST_FLOW_START_TIMESTAMP   (0xFFF00000UL) // the timestamps wrap during the first breath
+#define HOST_FLOW_FULL_SCALE        (DFLOW_METER_SENSOR_FULL_SCALE_FLOW * 1000.0)  // ml/min
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_flow_wave_tag
+{
+   const char *pName;
+   uint32_t periodMillis;                 // length of a breath
+   double (*flow)(double t);              // flow in ml/min at t ms from the start of the breath
+   bool restAtEnd;                        // the flow is steady at the end of the breath
+} HostFlowWaveType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static double host_flow_square(double t);
+static double host_flow_sine(double t);
+static double host_flow_leak(double t);
+static uint16_t host_flow_code(double flow);
+static bool host_flow_check_wave(FILE *pReport, const HostFlowWaveType *pWave);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+static const HostFlowWaveType hostFlowWaves[] =
+{
+   { "square", 5000, host_flow_square, TRUE },
+   { "sine",   4000, host_flow_sine,   FALSE },
+   { "leak",   4000, host_flow_leak,   TRUE },
+};
+
+#define HOST_FLOW_WAVES       (sizeof(hostFlowWaves) / sizeof(hostFlowWaves[0]))
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static uint32_t hostFlowSeed;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType HostFlow_Check(FILE *pReport)
+{
+   double maxCodeError = 0;
+   uint32_t codeErrorAt = 0;
+   bool pass;
+
+   // every reading converts like the floating point formula
+   for (uint32_t code = 0; code <= UINT16_MAX; code++)
+   {
+      double ref = (HOST_FLOW_FULL_SCALE / 0.8) * (code / 16384.0 - 0.1);
+      double error = fabs(dflow_volume_flow_from_code((uint16_t)code) - ref);
+
+      if (error > maxCodeError)
+      {
+         maxCodeError = error;
+         codeErrorAt = code;
+      }
+   }
+   fprintf(pReport, "host_flow: reading to flow max error %.3f ml/min at %u\n", maxCodeError, codeErrorAt);
+   pass = (maxCodeError <= 0.5 + 1e-9);
+
+   hostFlowSeed = 1;
+   for (uint32_t i = 0; i < HOST_FLOW_WAVES; i++)
+   {
+      if (FALSE == host_flow_check_wave(pReport, &hostFlowWaves[i]))
+         pass = FALSE;
+   }
+
+   fprintf(pReport, "host_flow: %s\n", (FALSE != pass) ? "pass" : "fail");
+
+   return (FALSE != pass) ? E_OK : E_ERROR;
+}
+
+static bool host_flow_check_wave(FILE *pReport, const HostFlowWaveType *pWave)
+{
+   DFlowVolumeType vol;
+   DFlowMeterDrvBreathType breath;
+   uint64_t periodUs = (uint64_t)pWave->periodMillis * 1000;
+   uint64_t sampleUs = 0;
+   double refInspired = 0, refExpired = 0, refEndFlow, refMinuteVolume;
+   double maxVolError = 0, maxFlowError = 0, mvError = 0;
+   uint32_t wrongBreaths = 0;
+
+   // exact volumes of a breath, integrated every microsecond
+   for (uint64_t t = 0; t < periodUs; t++)
+   {
+      double flow = pWave->flow((t + 0.5) / 1000.0);
+
+      if (flow > 0)
+         refInspired += flow / 60e6;
+      else
+         refExpired -= flow / 60e6;
+   }
+   refEndFlow = pWave->flow(pWave->periodMillis);
+   refMinuteVolume = refExpired * 60000.0 / pWave->periodMillis;
+
+   dflow_volume_init(&vol);
+   if (E_OK == dflow_volume_end_breath(&vol, HOST_FLOW_START_TIMESTAMP, &breath))
+      wrongBreaths++;
+
+   for (uint32_t n = 0; n < HOST_FLOW_BREATHS; n++)
+   {
+      uint64_t endUs = (n + 1) * periodUs;
+
+      while (sampleUs < endUs)
+      {
+         double flow = pWave->flow((double)(sampleUs % periodUs) / 1000.0);
+
+         dflow_volume_add(&vol, dflow_volume_flow_from_code(host_flow_code(flow)),
+                          (uint32_t)(HOST_FLOW_START_TIMESTAMP + sampleUs));
+
+         hostFlowSeed = hostFlowSeed * 1103515245UL + 12345UL;
+         sampleUs += HOST_FLOW_SAMPLE_US - HOST_FLOW_JITTER_US + ((hostFlowSeed >> 16) % (2 * HOST_FLOW_JITTER_US + 1));
+      }
+
+      if ((E_OK != dflow_volume_end_breath(&vol, (uint32_t)(HOST_FLOW_START_TIMESTAMP + endUs), &breath)) ||
+          (breath.durationMillis != pWave->periodMillis))
+      {
+         wrongBreaths++;
+         continue;
+      }
+
+      maxVolError = fmax(maxVolError, fabs(breath.inspiredML - refInspired));
+      maxVolError = fmax(maxVolError, fabs(breath.expiredML - refExpired));
+      maxVolError = fmax(maxVolError, fabs(breath.leakML - (refInspired - refExpired)));
+      if (FALSE != pWave->restAtEnd)
+      {
+         maxFlowError = fmax(maxFlowError, fabs(breath.endExpFlow - refEndFlow));
+         maxFlowError = fmax(maxFlowError, fabs(breath.offsetFlow - refEndFlow));
+      }
+   }
+   mvError = 100.0 * fabs(breath.minuteVolumeML - refMinuteVolume) / refMinuteVolume;
+
+   fprintf(pReport, "host_flow: %-6s vti %u/%.1f ml, vte %u/%.1f ml, leak %d ml, end flow %d/%.0f ml/min, mv %u/%.0f ml\n",
+           pWave->pName, breath.inspiredML, refInspired, breath.expiredML, refExpired, breath.leakML,
+           breath.endExpFlow, refEndFlow, breath.minuteVolumeML, refMinuteVolume);
+   fprintf(pReport, "host_flow: %-6s %u wrong breaths, max volume error %.2f ml, max end flow error %.0f ml/min, mv error %.2f %%\n",
+           pWave->pName, wrongBreaths, maxVolError, maxFlowError, mvError);
+
+   return (0 == wrongBreaths) && (maxVolError <= HOST_FLOW_MAX_ERROR_ML) &&
+          (maxFlowError <= HOST_FLOW_MAX_ERROR_FLOW) && (mvError <= HOST_FLOW_MAX_ERROR_MV);
+}
+
+// The sensor reads down to -1/8 of its full scale, the expiration
+// flows are kept within it.
+
+// 30 l/min for 1 s, a pause, -10 l/min for 3 s and rest
+static double host_flow_square(double t)
+{
+   if (t < 1000.0)
+      return 30000.0;
+   if (t < 1200.0)
+      return 0.0;
+   if (t < 4200.0)
+      return -10000.0;
+   return 0.0;
+}
+
+// half sines of 60 l/min for 1 s and -10 l/min for 3 s, no rest
+static double host_flow_sine(double t)
+{
+   if (t < 1000.0)
+      return 60000.0 * sin(M_PI * t / 1000.0);
+   return -10000.0 * sin(M_PI * (t - 1000.0) / 3000.0);
+}
+
+// decelerating inspiration from 60 l/min, passive expiration and a
+// 1 l/min offset all along
+static double host_flow_leak(double t)
+{
+   if (t < 1000.0)
+      return 1000.0 + 60000.0 * (1.0 - t / 1000.0);
+   return 1000.0 - 12000.0 * exp(-(t - 1000.0) / 600.0);
+}
+
+// sensor reading of a flow
+static uint16_t host_flow_code(double flow)
+{
+   double code = 16384.0 * (0.1 + 0.8 * flow / HOST_FLOW_FULL_SCALE);
+
+   if (code < 0.0)
+      code = 0.0;
+   if (code > UINT16_MAX)
+      code = UINT16_MAX;
+
+   return (uint16_t)(code + 0.5);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,264 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_fmeter.c
+//!
+//!   \brief      Host check of the turbine flow meter driver. A process
+//!               drives the meter input with the pulses of a turbine at
+//!               a series of flows, toggling the pin at the exact time of
+//!               every edge, and reads the flow and the volume the driver
+//!               measures from the timer captures.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "flow_meter_drv_conf.h"
+#include "flow_meter_drv_api.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_fmeter.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_FMETER_PORT            (IOGetPortFromPinID(FLOW_METER_DRV_INPUT))
+#define HOST_FMETER_PIN             (IOGetPinNumberFromPinID(FLOW_METER_DRV_INPUT))
+#define HOST_FMETER_START_MS        (1000)
+#define HOST_FMETER_IDLE_US         (1000)   // process period with no flow
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_fmeter_step_tag
+{
+   double flow;                  // L/min
+   uint32_t ms;                  // duration
+   uint32_t measured;            // mL/min read from the driver
+   bool checked;
+} HostFMeterStepType;
+
+typedef struct host_fmeter_stall_tag
+{
+   uint32_t atMs;
+   uint32_t ms;                  // main loop held
+   bool overrun;                 // expected: more pulses than the capture ring
+   bool started;
+   uint32_t overruns;            // read from the driver when it starts
+} HostFMeterStallType;
+
+typedef struct host_fmeter_tag
+{
+   bool level;                   // of the meter output
+   uint32_t pulses;              // rising edges driven
+} HostFMeterType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_fmeter_run(uint64_t now, void *pUserData);
+static void host_fmeter_report(void);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostFMeterType hostFMeter;
+
+// the last step has no flow, and lasts past the driver measure time
+static HostFMeterStepType hostFMeterSteps[] =
+{
+   { .flow = 1.0,   .ms = HOST_FMETER_STEP_MS },
+   { .flow = 5.0,   .ms = HOST_FMETER_STEP_MS },
+   { .flow = 20.0,  .ms = HOST_FMETER_STEP_MS },
+   { .flow = 60.0,  .ms = HOST_FMETER_STEP_MS },
+   { .flow = 120.0, .ms = HOST_FMETER_STEP_MS },
+   { .flow = 0.0,   .ms = FLOW_METER_DRV_MAX_MEASURE_TIME_MS + HOST_FMETER_STEP_MS },
+};
+
+// the main loop is held at 120 L/min, less and more than the ring lasts
+static HostFMeterStallType hostFMeterStalls[] =
+{
+   { .atMs = 9300,  .ms = 60,  .overrun = FALSE },
+   { .atMs = 10000, .ms = 150, .overrun = TRUE },
+};
+
+static HostSimProcessType hostFMeterProcess =
+{
+   .period = HOST_SIM_US_TO_CYCLES(HOST_FMETER_IDLE_US),
+   .next = 0,
+   .run = host_fmeter_run,
+   .pUserData = &hostFMeter,
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostFMeter_Init(void)
+{
+   hostFMeter.level = FALSE;
+   hostFMeter.pulses = 0;
+   HostSim_SetPin(HOST_FMETER_PORT, HOST_FMETER_PIN, GPIO_PIN_RESET);
+
+   HostSim_AddProcess(&hostFMeterProcess);
+   atexit(host_fmeter_report);
+}
+
+static void host_fmeter_run(uint64_t now, void *pUserData)
+{
+   HostFMeterType *pMeter = (HostFMeterType *)pUserData;
+   uint32_t end = HOST_FMETER_START_MS;
+   double flow = 0.0;
+
+   for (uint32_t i = 0; i < Num_Elems(hostFMeterStalls); i++)
+   {
+      HostFMeterStallType *pStall = &hostFMeterStalls[i];
+
+      if ((FALSE == pStall->started) && (now >= HOST_SIM_MS_TO_CYCLES(pStall->atMs)))
+      {
+         pStall->overruns = FlowMeterDrv_GetOverruns();
+         pStall->started = TRUE;
+         HostSim_Stall(HOST_SIM_MS_TO_CYCLES(pStall->ms));
+      }
+   }
+
+   for (uint32_t i = 0; i < Num_Elems(hostFMeterSteps); i++)
+   {
+      HostFMeterStepType *pStep = &hostFMeterSteps[i];
+
+      if (now < HOST_SIM_MS_TO_CYCLES(end))
+         break;
+
+      end += pStep->ms;
+      if (now < HOST_SIM_MS_TO_CYCLES(end))
+      {
+         flow = pStep->flow;
+         if ((FALSE == pStep->checked) && (now >= HOST_SIM_MS_TO_CYCLES(end - HOST_FMETER_SETTLE_MS)))
+         {
+            pStep->measured = FlowMeterDrv_GetFlowRate();
+            pStep->checked = TRUE;
+         }
+      }
+   }
+
+   // the process runs at every edge, half a pulse period apart
+   if (flow > 0.0)
+   {
+      pMeter->level = !pMeter->level;
+      if (FALSE != pMeter->level)
+         pMeter->pulses++;
+      HostSim_SetPin(HOST_FMETER_PORT, HOST_FMETER_PIN, (FALSE != pMeter->level) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+      hostFMeterProcess.period = (uint64_t)(HOST_SIM_CORE_CLOCK_HZ * 60.0 / (2.0 * flow * FLOW_METER_DRV_PULSES_PER_LITER) + 0.5);
+   }
+   else
+   {
+      hostFMeterProcess.period = HOST_SIM_US_TO_CYCLES(HOST_FMETER_IDLE_US);
+   }
+}
+
+static void host_fmeter_report(void)
+{
+   uint32_t volume = FlowMeterDrv_GetVolume();
+   uint32_t expectedVolume = hostFMeter.pulses * 1000 / FLOW_METER_DRV_PULSES_PER_LITER;
+   uint32_t end = HOST_FMETER_START_MS;
+   bool pass = TRUE;
+
+   for (uint32_t i = 0; i < Num_Elems(hostFMeterSteps); i++)
+   {
+      HostFMeterStepType *pStep = &hostFMeterSteps[i];
+      double expected = (pStep->flow > 0.0) ? (pStep->flow * 1000.0 + FLOW_METER_DRV_FLOW_OFFSET) : 0.0;
+      double error = (double)pStep->measured - expected;
+
+      end += pStep->ms;
+      if (FALSE == pStep->checked)
+      {
+         for (i++; i < Num_Elems(hostFMeterSteps); i++)
+            end += hostFMeterSteps[i].ms;
+         fprintf(stderr, "host_fmeter: FAIL, the check needs at least -t %u\n", end);
+         return;
+      }
+
+      fprintf(stderr, "host_fmeter: %6.1f L/min: %6u mL/min, expected %8.1f\n", pStep->flow, pStep->measured, expected);
+      if ((error < 0 ? -error : error) > (expected * HOST_FMETER_TOLERANCE_PCT / 100.0))
+         pass = FALSE;
+   }
+
+   for (uint32_t i = 0; i < Num_Elems(hostFMeterStalls); i++)
+   {
+      HostFMeterStallType *pStall = &hostFMeterStalls[i];
+      uint32_t overruns = ((i + 1) < Num_Elems(hostFMeterStalls)) ? hostFMeterStalls[i + 1].overruns : FlowMeterDrv_GetOverruns();
+
+      overruns -= pStall->overruns;
+      fprintf(stderr, "host_fmeter: main loop held %u ms at %u ms: %u overruns, expected %u\n",
+              pStall->ms, pStall->atMs, overruns, (FALSE != pStall->overrun) ? 1 : 0);
+      if (overruns != ((FALSE != pStall->overrun) ? 1 : 0))
+         pass = FALSE;
+   }
+
+   fprintf(stderr, "host_fmeter: %u pulses, volume %u mL, expected %u\n", hostFMeter.pulses, volume, expectedVolume);
+   if (volume != expectedVolume)
+      pass = FALSE;
+
+   fprintf(stderr, "host_fmeter: %s\n", (FALSE != pass) ? "PASS" : "FAIL");
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
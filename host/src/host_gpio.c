@@ -0,0 +1,341 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_gpio.c
+//!
+//!   \brief      Host simulation GPIO, AFIO and EXTI model.
+//!
+//!               The registers live in write protected pages; the
+//!               simulation core traps every firmware write and calls
+//!               HostGpio_Write() so BSRR, BRR and PR behave as set,
+//!               reset and clear registers. IDR is rebuilt after every
+//!               change from the pin configuration, the output latch,
+//!               the pull resistors and the external levels driven by the
+//!               host, and the EXTI edge detectors and the timer input
+//!               captures are evaluated.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_GPIO_PORTS          (5)
+#define HOST_GPIO_PORT_SIZE      (0x400UL)
+#define HOST_GPIO_LINES          (16)
+
+#define HOST_GPIO_CNF_ANALOG     (0)
+#define HOST_GPIO_CNF_FLOATING   (1)
+#define HOST_GPIO_CNF_PULL       (2)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_gpio_tag
+{
+   uint16_t driven[HOST_GPIO_PORTS];      // pins driven by the host
+   uint16_t level[HOST_GPIO_PORTS];       // level of the driven pins
+   uint16_t lineLevel;                    // EXTI lines input level
+   uint16_t idr[HOST_GPIO_PORTS];         // input levels last published
+} HostGpioType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static int32_t host_gpio_port_index(uint32_t address);
+static uint16_t host_gpio_pin_levels(uint32_t port);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostGpioType hostGpio;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostSim_SetPin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+   int32_t index = host_gpio_port_index((uint32_t)(uintptr_t)port);
+
+   if (index < 0)
+      return;
+
+   hostGpio.driven[index] |= pin;
+   if (GPIO_PIN_RESET != state)
+      hostGpio.level[index] |= pin;
+   else
+      hostGpio.level[index] &= ~pin;
+
+   HostGpio_Update();
+}
+
+GPIO_PinState HostSim_GetPin(GPIO_TypeDef *port, uint16_t pin)
+{
+   return (0 != (port->IDR & pin)) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+void HostGpio_Init(void)
+{
+   for (uint32_t i = 0; i < HOST_GPIO_PORTS; i++)
+   {
+      GPIO_TypeDef *port = HOST_PERIPH_RW((GPIO_TypeDef *)(GPIOA_BASE + i * HOST_GPIO_PORT_SIZE));
+
+      port->CRL = 0x44444444UL;
+      port->CRH = 0x44444444UL;
+      hostGpio.driven[i] = 0;
+      hostGpio.level[i] = 0;
+      hostGpio.idr[i] = 0;
+   }
+   hostGpio.lineLevel = 0;
+
+   HostGpio_Update();
+}
+
+void HostGpio_Sync(uint64_t now)
+{
+}
+
+uint64_t HostGpio_NextEvent(uint64_t now)
+{
+   return HOST_SIM_NO_EVENT;
+}
+
+void HostGpio_Process(uint64_t now)
+{
+}
+
+void HostGpio_Commit(uint64_t now)
+{
+}
+
+bool HostGpio_IrqLevel(IRQn_Type irq)
+{
+   uint32_t lines;
+
+   switch (irq)
+   {
+   case EXTI0_IRQn:
+   case EXTI1_IRQn:
+   case EXTI2_IRQn:
+   case EXTI3_IRQn:
+   case EXTI4_IRQn:
+      lines = 1UL << (irq - EXTI0_IRQn);
+      break;
+   case EXTI9_5_IRQn:
+      lines = 0x03E0;
+      break;
+   case EXTI15_10_IRQn:
+      lines = 0xFC00;
+      break;
+   default:
+      return FALSE;
+   }
+
+   return (0 != (EXTI->PR & EXTI->IMR & lines));
+}
+
+bool HostGpio_IsActionRegister(uint32_t address)
+{
+   if (host_gpio_port_index(address) >= 0)
+   {
+      uint32_t offset = address & (HOST_GPIO_PORT_SIZE - 1);
+
+      return (offsetof(GPIO_TypeDef, BSRR) == offset) || (offsetof(GPIO_TypeDef, BRR) == offset);
+   }
+
+   return ((uint32_t)(uintptr_t)&EXTI->PR == address);
+}
+
+void HostGpio_Write(uint32_t address, uint32_t oldValue, uint32_t value)
+{
+   int32_t index = host_gpio_port_index(address);
+
+   if (index >= 0)
+   {
+      GPIO_TypeDef *port = HOST_PERIPH_RW((GPIO_TypeDef *)(GPIOA_BASE + index * HOST_GPIO_PORT_SIZE));
+      uint32_t offset = address & (HOST_GPIO_PORT_SIZE - 1);
+
+      if (offsetof(GPIO_TypeDef, BSRR) == offset)
+      {
+         // set has priority over reset
+         port->ODR = (port->ODR & ~(value >> 16)) | (value & 0xFFFF);
+         port->BSRR = 0;
+      }
+      else if (offsetof(GPIO_TypeDef, BRR) == offset)
+      {
+         port->ODR &= ~(value & 0xFFFF);
+         port->BRR = 0;
+      }
+      else if (offsetof(GPIO_TypeDef, IDR) == offset)
+      {
+         port->IDR = oldValue;
+      }
+      else if (offsetof(GPIO_TypeDef, ODR) == offset)
+      {
+         port->ODR = value & 0xFFFF;
+      }
+   }
+   else if ((uint32_t)(uintptr_t)&EXTI->PR == address)
+   {
+      EXTI_TypeDef *exti = HOST_PERIPH_RW(EXTI);
+
+      exti->PR = oldValue & ~value;
+      exti->SWIER &= ~value;
+   }
+   else if ((uint32_t)(uintptr_t)&EXTI->SWIER == address)
+   {
+      // a rising software interrupt bit sets the pending bit
+      HOST_PERIPH_RW(EXTI)->PR |= (value & ~oldValue) & EXTI->IMR;
+   }
+}
+
+void HostGpio_Update(void)
+{
+   EXTI_TypeDef *exti = HOST_PERIPH_RW(EXTI);
+   uint16_t idr[HOST_GPIO_PORTS];
+   uint16_t lineLevel = 0;
+   uint16_t rising, falling;
+
+   for (uint32_t i = 0; i < HOST_GPIO_PORTS; i++)
+   {
+      idr[i] = host_gpio_pin_levels(i);
+      HOST_PERIPH_RW((GPIO_TypeDef *)(GPIOA_BASE + i * HOST_GPIO_PORT_SIZE))->IDR = idr[i];
+
+      // timer input capture
+      if (idr[i] != hostGpio.idr[i])
+      {
+         HostTim_Capture(i, idr[i] & ~hostGpio.idr[i], ~idr[i] & hostGpio.idr[i], HostSim_GetCycles());
+         hostGpio.idr[i] = idr[i];
+      }
+   }
+
+   // EXTI edge detectors
+   for (uint32_t line = 0; line < HOST_GPIO_LINES; line++)
+   {
+      uint32_t port = (AFIO->EXTICR[line / 4] >> (4 * (line % 4))) & 0xF;
+
+      if ((port < HOST_GPIO_PORTS) && (0 != (idr[port] & (1UL << line))))
+         lineLevel |= (uint16_t)(1UL << line);
+   }
+
+   rising = lineLevel & ~hostGpio.lineLevel;
+   falling = ~lineLevel & hostGpio.lineLevel;
+   hostGpio.lineLevel = lineLevel;
+
+   exti->PR |= ((rising & EXTI->RTSR) | (falling & EXTI->FTSR)) & (EXTI->IMR | EXTI->EMR);
+}
+
+static int32_t host_gpio_port_index(uint32_t address)
+{
+   if ((address < GPIOA_BASE) || (address >= (GPIOA_BASE + HOST_GPIO_PORTS * HOST_GPIO_PORT_SIZE)))
+      return -1;
+
+   return (int32_t)((address - GPIOA_BASE) / HOST_GPIO_PORT_SIZE);
+}
+
+static uint16_t host_gpio_pin_levels(uint32_t index)
+{
+   GPIO_TypeDef *port = (GPIO_TypeDef *)(GPIOA_BASE + index * HOST_GPIO_PORT_SIZE);
+   uint64_t config = ((uint64_t)port->CRH << 32) | port->CRL;
+   uint16_t odr = (uint16_t)port->ODR;
+   uint16_t levels = 0;
+
+   for (uint32_t pin = 0; pin < 16; pin++)
+   {
+      uint32_t mode = (uint32_t)(config >> (4 * pin)) & 0x3;
+      uint32_t cnf = (uint32_t)(config >> (4 * pin + 2)) & 0x3;
+      uint16_t mask = (uint16_t)(1UL << pin);
+      bool level;
+
+      if (0 != mode)
+      {
+         // general purpose output drives the latch. Alternate function
+         // outputs are not modeled at pin level.
+         level = (0 == (cnf & 0x2)) ? (0 != (odr & mask)) : (0 != (hostGpio.level[index] & hostGpio.driven[index] & mask));
+      }
+      else if (HOST_GPIO_CNF_ANALOG == cnf)
+      {
+         level = FALSE;
+      }
+      else if (0 != (hostGpio.driven[index] & mask))
+      {
+         level = (0 != (hostGpio.level[index] & mask));
+      }
+      else
+      {
+         // pull-up or pull-down selected through ODR. A floating input reads low.
+         level = (HOST_GPIO_CNF_PULL == cnf) && (0 != (odr & mask));
+      }
+
+      if (FALSE != level)
+         levels |= mask;
+   }
+
+   return levels;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,553 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_i2c.c
+//!
+//!   \brief      Host simulation I2C model and HAL I2C replacement.
+//!
+//!               The STM32F1 I2C event sequence (SB, ADDR, BTF...) is
+//!               not worth modeling byte by byte, so the host build
+//!               replaces stm32f1xx_hal_i2c.c with this transaction
+//!               level implementation: a transfer takes the bus time of
+//!               all its bits, the attached device is accessed when it
+//!               ends and the event (BTF) or error (AF) interrupt then
+//!               completes the transfer through the regular HAL
+//!               callbacks. Only master mode is supported.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_I2C_BITS_PER_BYTE      (9)
+#define HOST_I2C_START_STOP_BITS    (2)
+
+// private definitions of stm32f1xx_hal_i2c.c
+#define I2C_NO_OPTION_FRAME         0xFFFF0000U
+#define I2C_STATE_MSK               ((uint32_t)((uint32_t)((uint32_t)HAL_I2C_STATE_BUSY_TX | (uint32_t)HAL_I2C_STATE_BUSY_RX) & (uint32_t)(~((uint32_t)HAL_I2C_STATE_READY))))
+#define I2C_STATE_NONE              ((uint32_t)(HAL_I2C_MODE_NONE))
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_i2c_bus_tag
+{
+   I2C_TypeDef *regs;
+   HostSimI2CDeviceType *pDevices;
+   I2C_HandleTypeDef *hi2c;      // handle owning the transfer in progress
+   bool busy;
+   bool memory;                  // memory transfer: address write first
+   bool read;
+   uint64_t end;                 // end of the transfer in progress
+} HostI2CBusType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static HostI2CBusType *host_i2c_get(I2C_TypeDef *regs);
+static HAL_StatusTypeDef host_i2c_start(I2C_HandleTypeDef *hi2c, HAL_I2C_StateTypeDef state,
+                                        HAL_I2C_ModeTypeDef mode, uint16_t DevAddress, uint16_t MemAddress,
+                                        uint16_t MemAddSize, uint8_t *pData, uint16_t Size, bool it);
+static void host_i2c_complete(HostI2CBusType *pBus);
+static void host_i2c_finish(I2C_HandleTypeDef *hi2c);
+static HAL_StatusTypeDef host_i2c_wait(I2C_HandleTypeDef *hi2c, uint32_t Timeout);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostI2CBusType hostI2C[] =
+{
+   { .regs = I2C1 },
+   { .regs = I2C2 },
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostSim_AttachI2CDevice(I2C_TypeDef *bus, HostSimI2CDeviceType *pDev)
+{
+   HostI2CBusType *pBus = host_i2c_get(bus);
+
+   if ((NULL == pBus) || (NULL == pDev))
+      return;
+
+   pDev->pNext = pBus->pDevices;
+   pBus->pDevices = pDev;
+}
+
+void HostI2C_Init(void)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostI2C); i++)
+   {
+      hostI2C[i].busy = FALSE;
+      hostI2C[i].hi2c = NULL;
+   }
+}
+
+void HostI2C_Sync(uint64_t now)
+{
+}
+
+uint64_t HostI2C_NextEvent(uint64_t now)
+{
+   uint64_t next = HOST_SIM_NO_EVENT;
+
+   for (uint32_t i = 0; i < Num_Elems(hostI2C); i++)
+   {
+      if ((FALSE != hostI2C[i].busy) && (hostI2C[i].end < next))
+         next = hostI2C[i].end;
+   }
+
+   return next;
+}
+
+void HostI2C_Process(uint64_t now)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostI2C); i++)
+   {
+      if ((FALSE != hostI2C[i].busy) && (hostI2C[i].end <= now))
+         host_i2c_complete(&hostI2C[i]);
+   }
+}
+
+void HostI2C_Commit(uint64_t now)
+{
+}
+
+bool HostI2C_IrqLevel(IRQn_Type irq)
+{
+   I2C_TypeDef *regs = ((I2C1_EV_IRQn == irq) || (I2C1_ER_IRQn == irq)) ? I2C1 : I2C2;
+
+   if ((I2C1_EV_IRQn == irq) || (I2C2_EV_IRQn == irq))
+      return (0 != (regs->SR1 & I2C_SR1_BTF)) && (0 != (regs->CR2 & I2C_CR2_ITEVTEN));
+
+   return (0 != (regs->SR1 & I2C_SR1_AF)) && (0 != (regs->CR2 & I2C_CR2_ITERREN));
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+   uint32_t pclk1;
+
+   if ((NULL == hi2c) || (NULL == host_i2c_get(hi2c->Instance)))
+      return HAL_ERROR;
+
+   if (HAL_I2C_STATE_RESET == hi2c->State)
+   {
+      hi2c->Lock = HAL_UNLOCKED;
+      HAL_I2C_MspInit(hi2c);
+   }
+
+   hi2c->State = HAL_I2C_STATE_BUSY;
+   __HAL_I2C_DISABLE(hi2c);
+
+   // keep the registers consistent for anybody reading them back
+   pclk1 = HAL_RCC_GetPCLK1Freq();
+   hi2c->Instance->CR2 = I2C_FREQRANGE(pclk1);
+   hi2c->Instance->TRISE = I2C_RISE_TIME(I2C_FREQRANGE(pclk1), hi2c->Init.ClockSpeed);
+   hi2c->Instance->CCR = I2C_SPEED(pclk1, hi2c->Init.ClockSpeed, hi2c->Init.DutyCycle);
+   hi2c->Instance->CR1 = hi2c->Init.GeneralCallMode | hi2c->Init.NoStretchMode;
+   hi2c->Instance->OAR1 = hi2c->Init.AddressingMode | hi2c->Init.OwnAddress1;
+   hi2c->Instance->OAR2 = hi2c->Init.DualAddressMode | hi2c->Init.OwnAddress2;
+   hi2c->Instance->SR1 = 0;
+
+   __HAL_I2C_ENABLE(hi2c);
+
+   hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+   hi2c->State = HAL_I2C_STATE_READY;
+   hi2c->PreviousState = I2C_STATE_NONE;
+   hi2c->Mode = HAL_I2C_MODE_NONE;
+
+   return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c)
+{
+   HostI2CBusType *pBus;
+
+   if (NULL == hi2c)
+      return HAL_ERROR;
+
+   pBus = host_i2c_get(hi2c->Instance);
+   if ((NULL != pBus) && (hi2c == pBus->hi2c))
+      pBus->busy = FALSE;
+
+   hi2c->State = HAL_I2C_STATE_BUSY;
+   __HAL_I2C_DISABLE(hi2c);
+   HAL_I2C_MspDeInit(hi2c);
+
+   hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+   hi2c->State = HAL_I2C_STATE_RESET;
+   hi2c->PreviousState = I2C_STATE_NONE;
+   hi2c->Mode = HAL_I2C_MODE_NONE;
+   __HAL_UNLOCK(hi2c);
+
+   return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+   HAL_StatusTypeDef status;
+
+   status = host_i2c_start(hi2c, HAL_I2C_STATE_BUSY_TX, HAL_I2C_MODE_MASTER, DevAddress, 0, 0, pData, Size, FALSE);
+   if (HAL_OK != status)
+      return status;
+
+   return host_i2c_wait(hi2c, Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+   HAL_StatusTypeDef status;
+
+   status = host_i2c_start(hi2c, HAL_I2C_STATE_BUSY_RX, HAL_I2C_MODE_MASTER, DevAddress, 0, 0, pData, Size, FALSE);
+   if (HAL_OK != status)
+      return status;
+
+   return host_i2c_wait(hi2c, Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+   HAL_StatusTypeDef status;
+
+   status = host_i2c_start(hi2c, HAL_I2C_STATE_BUSY_TX, HAL_I2C_MODE_MEM, DevAddress, MemAddress, MemAddSize, pData, Size, FALSE);
+   if (HAL_OK != status)
+      return status;
+
+   return host_i2c_wait(hi2c, Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+   HAL_StatusTypeDef status;
+
+   status = host_i2c_start(hi2c, HAL_I2C_STATE_BUSY_RX, HAL_I2C_MODE_MEM, DevAddress, MemAddress, MemAddSize, pData, Size, FALSE);
+   if (HAL_OK != status)
+      return status;
+
+   return host_i2c_wait(hi2c, Timeout);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+   return host_i2c_start(hi2c, HAL_I2C_STATE_BUSY_TX, HAL_I2C_MODE_MASTER, DevAddress, 0, 0, pData, Size, TRUE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size)
+{
+   return host_i2c_start(hi2c, HAL_I2C_STATE_BUSY_RX, HAL_I2C_MODE_MASTER, DevAddress, 0, 0, pData, Size, TRUE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+   return host_i2c_start(hi2c, HAL_I2C_STATE_BUSY_TX, HAL_I2C_MODE_MEM, DevAddress, MemAddress, MemAddSize, pData, Size, TRUE);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress, uint16_t MemAddSize, uint8_t *pData, uint16_t Size)
+{
+   return host_i2c_start(hi2c, HAL_I2C_STATE_BUSY_RX, HAL_I2C_MODE_MEM, DevAddress, MemAddress, MemAddSize, pData, Size, TRUE);
+}
+
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *hi2c)
+{
+   HAL_I2C_StateTypeDef state = hi2c->State;
+   HAL_I2C_ModeTypeDef mode = hi2c->Mode;
+
+   if (0 == (hi2c->Instance->SR1 & I2C_SR1_BTF))
+      return;
+
+   host_i2c_finish(hi2c);
+
+   if (HAL_I2C_MODE_MEM == mode)
+   {
+      if (HAL_I2C_STATE_BUSY_RX == state)
+         HAL_I2C_MemRxCpltCallback(hi2c);
+      else
+         HAL_I2C_MemTxCpltCallback(hi2c);
+   }
+   else
+   {
+      if (HAL_I2C_STATE_BUSY_RX == state)
+         HAL_I2C_MasterRxCpltCallback(hi2c);
+      else
+         HAL_I2C_MasterTxCpltCallback(hi2c);
+   }
+}
+
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *hi2c)
+{
+   if (0 == (hi2c->Instance->SR1 & I2C_SR1_AF))
+      return;
+
+   hi2c->ErrorCode |= HAL_I2C_ERROR_AF;
+   host_i2c_finish(hi2c);
+
+   HAL_I2C_ErrorCallback(hi2c);
+}
+
+HAL_I2C_StateTypeDef HAL_I2C_GetState(I2C_HandleTypeDef *hi2c)
+{
+   return hi2c->State;
+}
+
+HAL_I2C_ModeTypeDef HAL_I2C_GetMode(I2C_HandleTypeDef *hi2c)
+{
+   return hi2c->Mode;
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c)
+{
+   return hi2c->ErrorCode;
+}
+
+__weak void HAL_I2C_MspInit(I2C_HandleTypeDef *hi2c)
+{
+   UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_MspDeInit(I2C_HandleTypeDef *hi2c)
+{
+   UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+   UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+   UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+   UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+   UNUSED(hi2c);
+}
+
+__weak void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+   UNUSED(hi2c);
+}
+
+static HostI2CBusType *host_i2c_get(I2C_TypeDef *regs)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostI2C); i++)
+   {
+      if (regs == hostI2C[i].regs)
+         return &hostI2C[i];
+   }
+
+   return NULL;
+}
+
+static HAL_StatusTypeDef host_i2c_start(I2C_HandleTypeDef *hi2c, HAL_I2C_StateTypeDef state,
+                                        HAL_I2C_ModeTypeDef mode, uint16_t DevAddress, uint16_t MemAddress,
+                                        uint16_t MemAddSize, uint8_t *pData, uint16_t Size, bool it)
+{
+   HostI2CBusType *pBus = host_i2c_get(hi2c->Instance);
+   HostSimI2CDeviceType *pDev;
+   uint64_t bits;
+   uint64_t stretch = 0;
+
+   if ((NULL == pBus) || (HAL_I2C_STATE_READY != hi2c->State) || (FALSE != pBus->busy))
+      return HAL_BUSY;
+   if ((NULL == pData) || (0 == Size))
+      return HAL_ERROR;
+
+   __HAL_LOCK(hi2c);
+
+   hi2c->State = state;
+   hi2c->Mode = mode;
+   hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+   hi2c->pBuffPtr = pData;
+   hi2c->XferCount = Size;
+   hi2c->XferSize = Size;
+   hi2c->XferOptions = I2C_NO_OPTION_FRAME;
+   hi2c->Devaddress = DevAddress;
+   hi2c->Memaddress = MemAddress;
+   hi2c->MemaddSize = MemAddSize;
+   hi2c->EventCount = 0;
+
+   // address, data and acknowledge bits
+   bits = (uint64_t)(1 + Size) * HOST_I2C_BITS_PER_BYTE + HOST_I2C_START_STOP_BITS;
+   if (HAL_I2C_MODE_MEM == mode)
+   {
+      bits += (uint64_t)MemAddSize * HOST_I2C_BITS_PER_BYTE;
+      if (HAL_I2C_STATE_BUSY_RX == state)
+         bits += HOST_I2C_BITS_PER_BYTE + 1;
+   }
+
+   // the addressed device holds the clock low
+   for (pDev = pBus->pDevices; NULL != pDev; pDev = pDev->pNext)
+   {
+      if (pDev->address == ((DevAddress >> 1) & 0x7F))
+         stretch = ((uint64_t)pDev->stretchUs * HOST_SIM_CORE_CLOCK_HZ) / 1000000;
+   }
+
+   pBus->hi2c = hi2c;
+   pBus->busy = TRUE;
+   pBus->memory = (HAL_I2C_MODE_MEM == mode);
+   pBus->read = (HAL_I2C_STATE_BUSY_RX == state);
+   pBus->end = HostSim_GetCycles() + (bits * HOST_SIM_CORE_CLOCK_HZ) / hi2c->Init.ClockSpeed + stretch;
+
+   __HAL_UNLOCK(hi2c);
+
+   if (FALSE != it)
+      __HAL_I2C_ENABLE_IT(hi2c, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR);
+
+   return HAL_OK;
+}
+
+static void host_i2c_complete(HostI2CBusType *pBus)
+{
+   I2C_HandleTypeDef *hi2c = pBus->hi2c;
+   HostSimI2CDeviceType *pDev = pBus->pDevices;
+   bool ack = FALSE;
+
+   pBus->busy = FALSE;
+
+   while ((NULL != pDev) && (pDev->address != ((hi2c->Devaddress >> 1) & 0x7F)))
+      pDev = pDev->pNext;
+
+   if (NULL != pDev)
+   {
+      ack = TRUE;
+      if (FALSE != pBus->memory)
+      {
+         uint8_t address[2];
+
+         address[0] = (uint8_t)((I2C_MEMADD_SIZE_16BIT == hi2c->MemaddSize) ? (hi2c->Memaddress >> 8) : hi2c->Memaddress);
+         address[1] = (uint8_t)hi2c->Memaddress;
+         ack = (NULL != pDev->write) &&
+               (FALSE != pDev->write(pDev, address, (I2C_MEMADD_SIZE_16BIT == hi2c->MemaddSize) ? 2 : 1));
+      }
+
+      if (FALSE != ack)
+      {
+         if (FALSE != pBus->read)
+            ack = (NULL != pDev->read) && (FALSE != pDev->read(pDev, hi2c->pBuffPtr, hi2c->XferSize));
+         else
+            ack = (NULL != pDev->write) && (FALSE != pDev->write(pDev, hi2c->pBuffPtr, hi2c->XferSize));
+      }
+   }
+
+   pBus->regs->SR1 |= (FALSE != ack) ? I2C_SR1_BTF : I2C_SR1_AF;
+}
+
+static void host_i2c_finish(I2C_HandleTypeDef *hi2c)
+{
+   hi2c->Instance->SR1 &= ~(I2C_SR1_BTF | I2C_SR1_AF);
+   __HAL_I2C_DISABLE_IT(hi2c, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR);
+
+   if (HAL_I2C_ERROR_NONE == hi2c->ErrorCode)
+   {
+      hi2c->pBuffPtr += hi2c->XferSize;
+      hi2c->XferCount = 0;
+   }
+   hi2c->PreviousState = ((uint32_t)hi2c->State & I2C_STATE_MSK) | (uint32_t)hi2c->Mode;
+   hi2c->State = HAL_I2C_STATE_READY;
+   hi2c->Mode = HAL_I2C_MODE_NONE;
+}
+
+static HAL_StatusTypeDef host_i2c_wait(I2C_HandleTypeDef *hi2c, uint32_t Timeout)
+{
+   HostI2CBusType *pBus = host_i2c_get(hi2c->Instance);
+   uint32_t tickstart = HAL_GetTick();
+
+   while (FALSE != pBus->busy)
+   {
+      if ((HAL_MAX_DELAY != Timeout) && ((HAL_GetTick() - tickstart) > Timeout))
+      {
+         pBus->busy = FALSE;
+         hi2c->ErrorCode |= HAL_I2C_ERROR_TIMEOUT;
+         host_i2c_finish(hi2c);
+         return HAL_TIMEOUT;
+      }
+      // polling the flags until the end of the transaction
+      HostSim_Advance((pBus->end > HostSim_GetCycles()) ? (pBus->end - HostSim_GetCycles()) : 1);
+   }
+
+   if (0 != (hi2c->Instance->SR1 & I2C_SR1_AF))
+   {
+      hi2c->ErrorCode |= HAL_I2C_ERROR_AF;
+      host_i2c_finish(hi2c);
+      return HAL_ERROR;
+   }
+
+   host_i2c_finish(hi2c);
+
+   return HAL_OK;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,361 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+//********************************************************************
+//
+//!   \file       host_i2c_bus.c
+//!
+//!   \brief      Host check of the I2C bus manager. Simulated devices
+//!               are attached to the flow sensor bus next to the flow
+//!               sensor, and their reads are scheduled on the bus
+//!               manager with different sizes, periods and phases. Every
+//!               device answers its own address plus the register read,
+//!               so a read completed with the data of another device is
+//!               caught.
+//!
+//!               One device stretches the clock far past the bus manager
+//!               timeout once, and another one does not answer for a
+//!               while; the other devices must keep their reads going.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "i2c_drv_api.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_periph.h"
+#include "host_i2c_bus.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_I2C_BUS_INSTANCE       (I2C2)
+#define HOST_I2C_BUS_MAX_SIZE       (16)
+#define HOST_I2C_BUS_RUN_US         (1000)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_i2c_bus_dev_tag
+{
+   const char *pName;
+   bool stretch;                 // stretches the clock at HOST_I2C_BUS_STRETCH_MS
+   bool nack;                    // does not answer from HOST_I2C_BUS_NACK_FROM_MS
+   HostSimI2CDeviceType dev;
+   I2CDrvXferType xfer;
+   uint8_t data[HOST_I2C_BUS_MAX_SIZE];
+   uint8_t reg;                  // register address written by the bus
+   uint32_t nacksServed;
+   uint32_t ok;                  // results seen by the firmware
+   uint32_t nacks;
+   uint32_t timeouts;
+   uint32_t errors;
+   uint32_t misroutes;
+   uint64_t lastOk;              // in cycles
+   uint64_t maxGap;
+} HostI2CBusDevType;
+
+typedef struct host_i2c_bus_tag
+{
+   bool scheduled;
+   uint64_t start;               // of the scheduled reads, in cycles
+   uint32_t stretchState;        // 0 waiting, 1 stretching, 2 done
+} HostI2CBusType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_i2c_bus_run(uint64_t now, void *pUserData);
+static bool host_i2c_bus_answers(HostI2CBusDevType *pBusDev);
+static bool host_i2c_bus_read(HostSimI2CDeviceType *pDev, uint8_t *pData, uint16_t size);
+static bool host_i2c_bus_write(HostSimI2CDeviceType *pDev, const uint8_t *pData, uint16_t size);
+static void host_i2c_bus_done(I2CDrvXferType *pXfer, I2CDrvResultType result);
+static void host_i2c_bus_report(void);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostI2CBusType hostI2CBus;
+
+// the flow sensor reads 3 bytes at 1 kHz at phase 0 on the same bus
+static HostI2CBusDevType hostI2CBusDev[] =
+{
+   {
+      .pName = "exp flow",
+      .dev = { .address = 0x40 },
+      .xfer = { .address = 0x40, .dir = I2C_DRV_DIR_READ, .size = 3, .periodUs = 1000, .phaseUs = 500 },
+   },
+   {
+      .pName = "pressure",
+      .stretch = TRUE,
+      .dev = { .address = 0x28 },
+      .xfer = { .address = 0x28, .dir = I2C_DRV_DIR_READ, .size = 4, .periodUs = 500, .phaseUs = 250 },
+   },
+   {
+      .pName = "O2",
+      .nack = TRUE,
+      .dev = { .address = 0x48 },
+      .xfer = { .address = 0x48, .dir = I2C_DRV_DIR_READ_REG, .reg = 0x03, .size = 2, .periodUs = 100000, .phaseUs = 0 },
+   },
+   {
+      .pName = "bulk",
+      .dev = { .address = 0x50 },
+      .xfer = { .address = 0x50, .dir = I2C_DRV_DIR_READ, .size = 16, .periodUs = 2000, .phaseUs = 750 },
+   },
+};
+
+static HostSimProcessType hostI2CBusProcess =
+{
+   .period = HOST_SIM_US_TO_CYCLES(HOST_I2C_BUS_RUN_US),
+   .next = 0,
+   .run = host_i2c_bus_run,
+   .pUserData = &hostI2CBus,
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostI2CBus_Init(void)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostI2CBusDev); i++)
+   {
+      HostI2CBusDevType *pBusDev = &hostI2CBusDev[i];
+
+      pBusDev->dev.read = host_i2c_bus_read;
+      pBusDev->dev.write = host_i2c_bus_write;
+      pBusDev->dev.pUserData = pBusDev;
+      pBusDev->xfer.bus = I2C_DRV_BUS_SENSORS;
+      pBusDev->xfer.pData = pBusDev->data;
+      pBusDev->xfer.onDone = host_i2c_bus_done;
+      pBusDev->xfer.pUserData = pBusDev;
+      HostSim_AttachI2CDevice(HOST_I2C_BUS_INSTANCE, &pBusDev->dev);
+   }
+
+   HostSim_AddProcess(&hostI2CBusProcess);
+   atexit(host_i2c_bus_report);
+}
+
+static void host_i2c_bus_run(uint64_t now, void *pUserData)
+{
+   HostI2CBusType *pBus = (HostI2CBusType *)pUserData;
+
+   // the bus manager is initialized by then, and scheduling is
+   // interrupt safe
+   if ((FALSE == pBus->scheduled) && (now >= HOST_SIM_MS_TO_CYCLES(HOST_I2C_BUS_START_MS)))
+   {
+      pBus->scheduled = TRUE;
+      pBus->start = now;
+      for (uint32_t i = 0; i < Num_Elems(hostI2CBusDev); i++)
+      {
+         if (E_OK != I2CDrv_Schedule(&hostI2CBusDev[i].xfer))
+            HostSim_Fatal("host_i2c_bus: unable to schedule the reads");
+      }
+   }
+
+   // only the transfer started in this period is stretched
+   if ((0 == pBus->stretchState) && (now >= HOST_SIM_MS_TO_CYCLES(HOST_I2C_BUS_STRETCH_MS)))
+   {
+      pBus->stretchState = 1;
+      for (uint32_t i = 0; i < Num_Elems(hostI2CBusDev); i++)
+      {
+         if (FALSE != hostI2CBusDev[i].stretch)
+            hostI2CBusDev[i].dev.stretchUs = HOST_I2C_BUS_STRETCH_US;
+      }
+   }
+   else if (1 == pBus->stretchState)
+   {
+      pBus->stretchState = 2;
+      for (uint32_t i = 0; i < Num_Elems(hostI2CBusDev); i++)
+         hostI2CBusDev[i].dev.stretchUs = 0;
+   }
+}
+
+static bool host_i2c_bus_answers(HostI2CBusDevType *pBusDev)
+{
+   uint64_t now = HostSim_GetCycles();
+
+   if ((FALSE != pBusDev->nack) &&
+       (now >= HOST_SIM_MS_TO_CYCLES(HOST_I2C_BUS_NACK_FROM_MS)) &&
+       (now < HOST_SIM_MS_TO_CYCLES(HOST_I2C_BUS_NACK_TO_MS)))
+   {
+      pBusDev->nacksServed++;
+      return FALSE;
+   }
+
+   return TRUE;
+}
+
+static bool host_i2c_bus_read(HostSimI2CDeviceType *pDev, uint8_t *pData, uint16_t size)
+{
+   HostI2CBusDevType *pBusDev = (HostI2CBusDevType *)pDev->pUserData;
+
+   if (FALSE == host_i2c_bus_answers(pBusDev))
+      return FALSE;
+
+   for (uint16_t i = 0; i < size; i++)
+      pData[i] = (uint8_t)(pDev->address + pBusDev->reg);
+
+   // the register address is written again by every register read
+   pBusDev->reg = 0;
+
+   return TRUE;
+}
+
+static bool host_i2c_bus_write(HostSimI2CDeviceType *pDev, const uint8_t *pData, uint16_t size)
+{
+   HostI2CBusDevType *pBusDev = (HostI2CBusDevType *)pDev->pUserData;
+
+   if (FALSE == host_i2c_bus_answers(pBusDev))
+      return FALSE;
+
+   pBusDev->reg = pData[size - 1];
+
+   return TRUE;
+}
+
+static void host_i2c_bus_done(I2CDrvXferType *pXfer, I2CDrvResultType result)
+{
+   HostI2CBusDevType *pBusDev = (HostI2CBusDevType *)pXfer->pUserData;
+   uint64_t now = HostSim_GetCycles();
+   uint8_t expected = (uint8_t)(pXfer->address + ((I2C_DRV_DIR_READ_REG == pXfer->dir) ? pXfer->reg : 0));
+
+   switch (result)
+   {
+      case I2C_DRV_RESULT_OK:
+         pBusDev->ok++;
+         for (uint16_t i = 0; i < pXfer->size; i++)
+         {
+            if (expected != pXfer->pData[i])
+            {
+               pBusDev->misroutes++;
+               break;
+            }
+         }
+         if ((0 != pBusDev->lastOk) && ((now - pBusDev->lastOk) > pBusDev->maxGap))
+            pBusDev->maxGap = now - pBusDev->lastOk;
+         pBusDev->lastOk = now;
+         break;
+      case I2C_DRV_RESULT_NACK:
+         pBusDev->nacks++;
+         break;
+      case I2C_DRV_RESULT_TIMEOUT:
+         pBusDev->timeouts++;
+         break;
+      case I2C_DRV_RESULT_ERROR:
+      default:
+         pBusDev->errors++;
+         break;
+   }
+
+   // a stale buffer would pass the next check
+   for (uint16_t i = 0; i < pXfer->size; i++)
+      pXfer->pData[i] = 0;
+}
+
+static void host_i2c_bus_report(void)
+{
+   uint64_t now = HostSim_GetCycles();
+   I2CDrvStatsType stats;
+   uint32_t nacksServed = 0;
+   bool pass = TRUE;
+
+   if ((FALSE == hostI2CBus.scheduled) || (now < HOST_SIM_MS_TO_CYCLES(HOST_I2C_BUS_NACK_TO_MS)))
+   {
+      fprintf(stderr, "host_i2c_bus: FAIL, the check needs at least -t %u\n", HOST_I2C_BUS_NACK_TO_MS);
+      return;
+   }
+
+   for (uint32_t i = 0; i < Num_Elems(hostI2CBusDev); i++)
+   {
+      HostI2CBusDevType *pBusDev = &hostI2CBusDev[i];
+      uint64_t scheduled = HOST_SIM_CYCLES_TO_US(now - hostI2CBus.start) / pBusDev->xfer.periodUs;
+      uint32_t done = pBusDev->ok + pBusDev->nacks + pBusDev->timeouts + pBusDev->errors;
+
+      fprintf(stderr, "host_i2c_bus: 0x%02x %-8s %2u bytes every %6u us: %u of %llu reads, %u ok, %u nack (%u served), "
+                      "%u timeout, %u error, %u skipped, %u misrouted, max gap %llu us\n",
+              pBusDev->xfer.address, pBusDev->pName, pBusDev->xfer.size, pBusDev->xfer.periodUs, done,
+              (unsigned long long)scheduled, pBusDev->ok, pBusDev->nacks, pBusDev->nacksServed, pBusDev->timeouts,
+              pBusDev->errors, pBusDev->xfer.skipped, pBusDev->misroutes,
+              (unsigned long long)HOST_SIM_CYCLES_TO_US(pBusDev->maxGap));
+
+      nacksServed += pBusDev->nacksServed;
+      if ((0 != pBusDev->misroutes) || (0 != pBusDev->errors) || (pBusDev->nacks != pBusDev->nacksServed) ||
+          (pBusDev->timeouts != ((FALSE != pBusDev->stretch) ? 1 : 0)) ||
+          ((FALSE != pBusDev->nack) && (0 == pBusDev->nacks)) ||
+          ((uint64_t)done * 100 < scheduled * HOST_I2C_BUS_MIN_READS))
+      {
+         pass = FALSE;
+      }
+   }
+
+   I2CDrv_GetStats(I2C_DRV_BUS_SENSORS, &stats);
+   fprintf(stderr, "host_i2c_bus: bus %u transfers, %u nacks, %u errors, %u timeouts, %u recoveries, %u overruns, "
+                   "busy %.1f %%\n",
+           stats.transfers, stats.nacks, stats.errors, stats.timeouts, stats.recoveries, stats.overruns,
+           100.0 * (double)stats.busyUs / (double)HOST_SIM_CYCLES_TO_US(now));
+
+   if ((stats.nacks != nacksServed) || (0 != stats.errors) || (1 != stats.timeouts) || (1 != stats.recoveries))
+      pass = FALSE;
+
+   fprintf(stderr, "host_i2c_bus: %s\n", (FALSE != pass) ? "PASS" : "FAIL");
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,280 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_main.c
+//!
+//!   \brief      Host simulation entry point.
+//!
+//!               usage: ventilator_host [-t ms] [-q cycles] [-o file] [-c ms:text]...
+//!
+//!               -t  virtual time to simulate in milliseconds
+//!               -q  core cycles consumed by each HAL_GetTick() call,
+//!                   0 jumps to the next peripheral event
+//!               -o  file receiving the debug USART output
+//!               -c  text sent to the debug USART at the given time
+//!               -n  run without the patient and bellows plant
+//!               -l  lung compliance, resistance and PEEP of the plant
+//!               -P  inspiratory pressure target for the breath metrics
+//!               -V  tidal volume target for the breath metrics
+//!               -b  file receiving the metrics of every breath
+//!               -N  ADC input noise in counts RMS
+//!               -E  measure the effective resolution of the pressure
+//!                   reading instead of running the plant
+//!               -F  compare the q31 ADC filter against the float
+//!                   design and exit
+//!               -R  compare the ventilator parameter engine against
+//!                   the floating point calculation and exit
+//!               -T  compare the resampled volume table against the
+//!                   source table and exit
+//!               -I  replay known flow waveforms through the flow meter
+//!                   volume integrator and exit
+//!               -S  measure the step response of the pressure loop
+//!                   controller on the plant model and exit
+//!               -A  register and unregister ADC triggers with the DMA
+//!                   interrupt taken between every instruction and exit
+//!               -L  print the load of every periodic time slot
+//!               -B  share the flow sensor bus with simulated devices
+//!                   and check the I2C bus manager
+//!               -M  drive the flow meter input with turbine pulses and
+//!                   check the measured flow and volume
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_board.h"
+#include "host_plant.h"
+#include "host_filter.h"
+#include "host_params.h"
+#include "host_volume.h"
+#include "host_flow.h"
+#include "host_pid.h"
+#include "host_triggers.h"
+#include "host_enob.h"
+#include "host_periodic.h"
+#include "host_i2c_bus.h"
+#include "flow_meter_drv_conf.h"
+#include "host_fmeter.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_MAIN_DEFAULT_TIME_MS      (10000)
+#define HOST_MAIN_DEBUG_USART          (USART1)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_main_usage(const char *pName);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+int main(int argc, char *argv[])
+{
+   uint32_t limitMs = HOST_MAIN_DEFAULT_TIME_MS;
+   FILE *pOutput = stdout;
+   HostPlantParamsType plant;
+   bool plantEnabled = TRUE;
+   bool enobEnabled = FALSE;
+   char *pText;
+   int opt;
+
+   if (E_OK != HostSim_Init())
+   {
+      fprintf(stderr, "%s: unable to initialize the simulation\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   HostBoard_Init();
+   HostPlant_GetDefaultParams(&plant);
+
+   while ((opt = getopt(argc, argv, "t:q:o:c:nl:P:V:b:N:EFRTISALBMh")) != -1)
+   {
+      switch (opt)
+      {
+      case 't':
+         limitMs = (uint32_t)strtoul(optarg, NULL, 0);
+         break;
+      case 'q':
+         HostSim_SetTickQuantum((uint32_t)strtoul(optarg, NULL, 0));
+         break;
+      case 'o':
+         pOutput = fopen(optarg, "w");
+         if (NULL == pOutput)
+         {
+            perror(optarg);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'c':
+         pText = strchr(optarg, ':');
+         if ((NULL == pText) ||
+             (E_OK != HostSim_UsartInput(HOST_MAIN_DEBUG_USART, (uint32_t)strtoul(optarg, NULL, 0),
+                                         (const uint8_t *)(pText + 1), (uint32_t)strlen(pText + 1))))
+         {
+            host_main_usage(argv[0]);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'n':
+         plantEnabled = FALSE;
+         break;
+      case 'l':
+         plant.compliance = strtod(optarg, &pText);
+         if (',' == *pText)
+            plant.resistance = strtod(pText + 1, &pText);
+         if (',' == *pText)
+            plant.peep = strtod(pText + 1, &pText);
+         break;
+      case 'P':
+         plant.targetPressure = strtod(optarg, NULL);
+         break;
+      case 'V':
+         plant.targetVolume = strtod(optarg, NULL);
+         break;
+      case 'b':
+         plant.pBreathLog = fopen(optarg, "w");
+         if (NULL == plant.pBreathLog)
+         {
+            perror(optarg);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'N':
+         HostSim_SetAnalogNoise(strtod(optarg, NULL));
+         break;
+      case 'E':
+         enobEnabled = TRUE;
+         plantEnabled = FALSE;
+         break;
+      case 'F':
+         return (E_OK == HostFilter_Check(stdout)) ? EXIT_SUCCESS : EXIT_FAILURE;
+      case 'R':
+         return (E_OK == HostParams_Check(stdout)) ? EXIT_SUCCESS : EXIT_FAILURE;
+      case 'T':
+         return (E_OK == HostVolume_Check(stdout)) ? EXIT_SUCCESS : EXIT_FAILURE;
+      case 'I':
+         return (E_OK == HostFlow_Check(stdout)) ? EXIT_SUCCESS : EXIT_FAILURE;
+      case 'S':
+         return (E_OK == HostPid_Check(stdout)) ? EXIT_SUCCESS : EXIT_FAILURE;
+      case 'A':
+         return (E_OK == HostTriggers_Check(stdout)) ? EXIT_SUCCESS : EXIT_FAILURE;
+      case 'L':
+         HostPeriodic_Init();
+         break;
+      case 'B':
+         HostI2CBus_Init();
+         break;
+      case 'M':
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+         HostFMeter_Init();
+#else
+         fprintf(stderr, "%s: -M needs the flow meter timer capture, build with BOARD_REV=2\n", argv[0]);
+         return EXIT_FAILURE;
+#endif
+         break;
+      default:
+         host_main_usage(argv[0]);
+         return EXIT_FAILURE;
+      }
+   }
+
+   if ((FALSE != plantEnabled) && (E_OK != HostPlant_Init(&plant)))
+   {
+      fprintf(stderr, "%s: invalid plant parameters\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   if (FALSE != enobEnabled)
+      HostEnob_Init();
+
+   HostSim_SetUsartOutput(HOST_MAIN_DEBUG_USART, pOutput);
+   HostSim_Run(limitMs);
+
+   return EXIT_SUCCESS;
+}
+
+static void host_main_usage(const char *pName)
+{
+   fprintf(stderr, "usage: %s [-t ms] [-q cycles] [-o file] [-c ms:text]... [-n]\n"
+                   "       [-l compliance[,resistance[,peep]]] [-P cmH2O] [-V mL] [-b file] [-N counts] [-E] [-L] [-B] [-M]\n"
+                   "       %s -F\n"
+                   "       %s -R\n"
+                   "       %s -T\n"
+                   "       %s -I\n"
+                   "       %s -S\n"
+                   "       %s -A\n", pName, pName, pName, pName, pName, pName, pName);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
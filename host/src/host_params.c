@@ -0,0 +1,375 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_params.c
+//!
+//!   \brief      Host check of the ventilator parameter engine. Every
+//!               setting in range is run through the integer engine
+//!               used by the firmware and through a copy of the double
+//!               precision calculation it replaced, and the breath
+//!               timings and motion targets are compared. The old
+//!               calculation divided by zero when a phase took no time
+//!               and the FSM wrapped around on expiratory times below
+//!               its 50ms margin; the engine rejects those sets and
+//!               they are counted apart. Below the first point of the
+//!               volume table the old lookup wrapped around too, so
+//!               the reference extends the first segment there.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <math.h>
+#include "standard.h"
+#include "ventilator_manager_conf.h"
+#include "ventilator_params.h"
+#include "ventilator_volume.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_params.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_PARAMS_MAX_REPORTED    (10)     // differences printed
+#define HOST_PARAMS_INSP_PRESSURE   (200)    // not used by the timings
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef enum host_params_ref_result_tag
+{
+   HOST_PARAMS_REF_OK,
+   HOST_PARAMS_REF_REJECTED,
+   HOST_PARAMS_REF_DIV_ZERO,
+} HostParamsRefResultType;
+
+typedef struct host_params_ref_tag
+{
+   uint32_t respPeriodMillis;
+   uint32_t inspiratoryTimeMillis;
+   uint32_t expirationTimeMillis;
+   uint32_t ieRatio;
+   uint32_t distanceInDeg;
+   uint32_t inhaleSpeed;
+   uint32_t exhaleSpeed;
+} HostParamsRefType;
+
+typedef struct host_params_stats_tag
+{
+   uint32_t sets;
+   uint32_t equal;
+   uint32_t bothRejected;
+   uint32_t marginRejected;
+   uint32_t differ;
+} HostParamsStatsType;
+
+typedef struct vol2deg_table_tag
+{
+   uint32_t volumeML;
+   uint32_t deg;
+} VolumeToDegType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_params_compare(FILE *pReport, const VentilatorParamsSettingsType *pSettings, HostParamsStatsType *pStats);
+static HostParamsRefResultType host_params_reference(const VentilatorParamsSettingsType *pSettings, HostParamsRefType *pRef);
+static uint32_t host_params_vol2deg(uint32_t vol);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+static const VolumeToDegType volToDegTable[] = {
+#undef X
+#define X(a,b) {a, b},
+      VENTILATOR_MGR_VOL_DEG_TABLE
+};
+
+static const VentilatorMgrModeControlType hostParamsModes[] = {
+   VENTILATOR_MGR_VOLUME_CONTROL,
+   VENTILATOR_MGR_PRESSURE_CONTROL,
+};
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType HostParams_Check(FILE *pReport)
+{
+   VentilatorParamsSettingsType settings;
+   HostParamsStatsType stats = { 0 };
+
+   if (E_OK != ventilator_volume_init())
+   {
+      fprintf(pReport, "host_params: invalid volume table\n");
+      return E_ERROR;
+   }
+
+   settings.pltTimeMillis = VENTILATOR_MGR_HOLD_TIME_MILLIS;
+   settings.inspPressure = HOST_PARAMS_INSP_PRESSURE;
+   settings.flowShape = VENTILATOR_MGR_DEFAULT_FLOW_SHAPE;
+   settings.ieRatio = VENTILATOR_MGR_DEFAULT_IE_RATIO;
+   settings.inspiratoryTimeMillis = VENTILATOR_MGR_INSP_TIME_MIN_MILLIS;
+
+   for (uint32_t m = 0; m < (sizeof(hostParamsModes) / sizeof(hostParamsModes[0])); m++)
+   {
+      settings.controlMode = hostParamsModes[m];
+
+      for (settings.respRateBPM = VENTILATOR_MGR_BPM_MIN; settings.respRateBPM <= VENTILATOR_MGR_BPM_MAX; settings.respRateBPM++)
+      {
+         // every volume with the IE ratio and with the inspiratory time
+         settings.pltTimeMillis = VENTILATOR_MGR_HOLD_TIME_MILLIS;
+         for (settings.tidalVolumeML = VENTILATOR_MGR_TIDAL_VOLUME_MIN; settings.tidalVolumeML <= VENTILATOR_MGR_TIDAL_VOLUME_MAX; settings.tidalVolumeML++)
+         {
+            settings.paramMode = VENTILATOR_PARAMS_IERATIO_SET;
+            for (settings.ieRatio = VENTILATOR_MGR_IE_RATIO_MIN; settings.ieRatio <= VENTILATOR_MGR_IE_RATIO_MAX; settings.ieRatio++)
+               host_params_compare(pReport, &settings, &stats);
+
+            settings.paramMode = VENTILATOR_PARAMS_INSPTIME_SET;
+            for (settings.inspiratoryTimeMillis = VENTILATOR_MGR_INSP_TIME_MIN_MILLIS; settings.inspiratoryTimeMillis <= VENTILATOR_MGR_INSP_TIME_MAX_MILLIS; settings.inspiratoryTimeMillis++)
+               host_params_compare(pReport, &settings, &stats);
+         }
+
+         // every plateau time with the default volume
+         settings.tidalVolumeML = VENTILATOR_MGR_DEFAULT_TVOLUME;
+         for (settings.pltTimeMillis = VENTILATOR_MGR_PLT_TIME_MIN_MILLIS; settings.pltTimeMillis <= VENTILATOR_MGR_PLT_TIME_MAX_MILLIS; settings.pltTimeMillis++)
+         {
+            settings.paramMode = VENTILATOR_PARAMS_IERATIO_SET;
+            for (settings.ieRatio = VENTILATOR_MGR_IE_RATIO_MIN; settings.ieRatio <= VENTILATOR_MGR_IE_RATIO_MAX; settings.ieRatio++)
+               host_params_compare(pReport, &settings, &stats);
+
+            settings.paramMode = VENTILATOR_PARAMS_INSPTIME_SET;
+            for (settings.inspiratoryTimeMillis = VENTILATOR_MGR_INSP_TIME_MIN_MILLIS; settings.inspiratoryTimeMillis <= VENTILATOR_MGR_INSP_TIME_MAX_MILLIS; settings.inspiratoryTimeMillis++)
+               host_params_compare(pReport, &settings, &stats);
+         }
+      }
+   }
+
+   fprintf(pReport, "host_params: %u sets, %u equal, %u rejected by both, %u rejected by the phase margins, %u differ\n",
+           stats.sets, stats.equal, stats.bothRejected, stats.marginRejected, stats.differ);
+
+   return (0 == stats.differ) ? E_OK : E_ERROR;
+}
+
+static void host_params_compare(FILE *pReport, const VentilatorParamsSettingsType *pSettings, HostParamsStatsType *pStats)
+{
+   VentilatorParamsType params;
+   HostParamsRefType ref;
+   HostParamsRefResultType refResult;
+   StatusType result;
+
+   refResult = host_params_reference(pSettings, &ref);
+   result = ventilator_params_calc(pSettings, &params);
+   pStats->sets++;
+
+   if ((E_OK == result) && (HOST_PARAMS_REF_OK == refResult))
+   {
+      // the phase ends are the ones the FSM used to calculate on every breath
+      if ((params.respPeriodMillis == ref.respPeriodMillis) &&
+          (params.inspiratoryTimeMillis == ref.inspiratoryTimeMillis) &&
+          (params.expirationTimeMillis == ref.expirationTimeMillis) &&
+          (params.ieRatio == ref.ieRatio) &&
+          (params.distanceInDeg == ref.distanceInDeg) &&
+          (params.inhaleSpeed == ref.inhaleSpeed) &&
+          (params.exhaleSpeed == ref.exhaleSpeed) &&
+          (params.pauseTimeMillis == (pSettings->pltTimeMillis - VENTILATOR_MGR_PLATEAU_MEAS_TIME)) &&
+          (params.inTimeMillis == (ref.inspiratoryTimeMillis + 50)) &&
+          (params.exTimeMillis == (ref.expirationTimeMillis - 50)) &&
+          (params.maxExTimeMillis == ((ref.expirationTimeMillis * 110) / 100)))
+      {
+         pStats->equal++;
+         return;
+      }
+   }
+   else if ((E_OK != result) && (HOST_PARAMS_REF_REJECTED == refResult))
+   {
+      pStats->bothRejected++;
+      return;
+   }
+   else if ((E_OK != result) &&
+            ((HOST_PARAMS_REF_DIV_ZERO == refResult) || (ref.expirationTimeMillis <= 50)))
+   {
+      pStats->marginRejected++;
+      return;
+   }
+
+   if (pStats->differ < HOST_PARAMS_MAX_REPORTED)
+   {
+      fprintf(pReport, "host_params: mode %u bpm %u vt %u ie %u tin %u plt %u (%s): engine %s, reference %s\n",
+              pSettings->controlMode, pSettings->respRateBPM, pSettings->tidalVolumeML,
+              pSettings->ieRatio, pSettings->inspiratoryTimeMillis, pSettings->pltTimeMillis,
+              (VENTILATOR_PARAMS_IERATIO_SET == pSettings->paramMode) ? "ie" : "tin",
+              (E_OK == result) ? "ok" : "rejected",
+              (HOST_PARAMS_REF_OK == refResult) ? "ok" : "rejected");
+      if ((E_OK == result) && (HOST_PARAMS_REF_OK == refResult))
+      {
+         fprintf(pReport, "   T %u/%u ti %u/%u te %u/%u ie %u/%u d %u/%u is %u/%u es %u/%u\n",
+                 params.respPeriodMillis, ref.respPeriodMillis,
+                 params.inspiratoryTimeMillis, ref.inspiratoryTimeMillis,
+                 params.expirationTimeMillis, ref.expirationTimeMillis,
+                 params.ieRatio, ref.ieRatio,
+                 params.distanceInDeg, ref.distanceInDeg,
+                 params.inhaleSpeed, ref.inhaleSpeed,
+                 params.exhaleSpeed, ref.exhaleSpeed);
+      }
+   }
+   pStats->differ++;
+}
+
+// copy of the calculation done before the parameter engine
+static HostParamsRefResultType host_params_reference(const VentilatorParamsSettingsType *pSettings, HostParamsRefType *pRef)
+{
+   uint32_t periodMillis;
+   uint32_t tinMillis;
+   uint32_t texMillis;
+   uint32_t ieRatio;
+   uint32_t distanceInDeg;
+
+   periodMillis = (60 * 1e3) / pSettings->respRateBPM;
+
+   if (VENTILATOR_PARAMS_IERATIO_SET == pSettings->paramMode)
+   {
+      if (((periodMillis * 100) / (100 + pSettings->ieRatio)) < pSettings->pltTimeMillis)
+         return HOST_PARAMS_REF_REJECTED;
+
+      if (VENTILATOR_MGR_VOLUME_CONTROL == pSettings->controlMode)
+      {
+         tinMillis = (periodMillis * 100) / (100 + pSettings->ieRatio) - pSettings->pltTimeMillis;
+         texMillis = periodMillis - (tinMillis + pSettings->pltTimeMillis);
+      }
+      else
+      {
+         tinMillis = (periodMillis * 100) / (100 + pSettings->ieRatio);
+         texMillis = periodMillis - (tinMillis);
+      }
+      ieRatio = pSettings->ieRatio;
+   }
+   else
+   {
+      tinMillis = pSettings->inspiratoryTimeMillis;
+      if (periodMillis < (tinMillis + pSettings->pltTimeMillis))
+         return HOST_PARAMS_REF_REJECTED;
+
+      if (VENTILATOR_MGR_VOLUME_CONTROL == pSettings->controlMode)
+      {
+         texMillis = periodMillis - (tinMillis + pSettings->pltTimeMillis);
+         ieRatio = (100 * texMillis) / (tinMillis + pSettings->pltTimeMillis);
+      }
+      else
+      {
+         texMillis = periodMillis - (tinMillis);
+         ieRatio = (100 * texMillis) / (tinMillis);
+      }
+   }
+
+   distanceInDeg = host_params_vol2deg(pSettings->tidalVolumeML);
+
+   pRef->respPeriodMillis = periodMillis;
+   pRef->inspiratoryTimeMillis = tinMillis;
+   pRef->expirationTimeMillis = texMillis;
+   pRef->ieRatio = ieRatio;
+   pRef->distanceInDeg = distanceInDeg;
+
+   if ((0 == tinMillis) || (0 == texMillis))
+      return HOST_PARAMS_REF_DIV_ZERO;
+
+   pRef->inhaleSpeed = (distanceInDeg * 1e3) / tinMillis;
+   pRef->exhaleSpeed = (distanceInDeg * 1e3) / texMillis;
+
+   return HOST_PARAMS_REF_OK;
+}
+
+static uint32_t host_params_vol2deg(uint32_t vol)
+{
+   uint32_t i, tableSize;
+   float deg_f;
+   const VolumeToDegType *eLow, *eHigh;
+
+   tableSize = sizeof(volToDegTable) / sizeof(volToDegTable[0]);
+
+   if (vol < volToDegTable[0].volumeML)
+   {
+      // extend the first segment
+      eLow = &volToDegTable[0];
+      eHigh = &volToDegTable[1];
+      return (uint32_t)floor(eLow->deg - (double)(eLow->volumeML - vol) * (eHigh->deg - eLow->deg) / (eHigh->volumeML - eLow->volumeML));
+   }
+
+   for (i = 0; i < tableSize; i++)
+   {
+      eHigh = &volToDegTable[i];
+
+      if (eHigh->volumeML >= vol)
+         break;
+   }
+
+   if (i > 0)
+   {
+      eLow = &volToDegTable[i-1];
+      deg_f = (1.0f * eLow->deg) + 1.0f * (vol - eLow->volumeML)*(eHigh->deg - eLow->deg) / (1.0f * (eHigh->volumeML - eLow->volumeML));
+   }
+   else
+   {
+      deg_f = (1.0f * eHigh->deg);
+   }
+
+   return (uint32_t) deg_f;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
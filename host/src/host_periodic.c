@@ -0,0 +1,217 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_periodic.c
+//!
+//!   \brief      Host report of the load of the periodic time slots. The
+//!               longest time measured by the firmware in every slot is
+//!               printed with the number of handlers the task table
+//!               runs in it, next to the number of handlers the slot
+//!               would run if every rate group had no phase offset. The
+//!               simulation only accounts the time of the HAL_GetTick()
+//!               polling, so the times compare slots, they are not the
+//!               load of the target.
+//!
+//!               The slot counter of the firmware is also sampled every
+//!               millisecond: the time of every new slot is compared with
+//!               the time of the first one plus the slots elapsed, so any
+//!               drift of the slot deadlines shows up.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "periodic_conf.h"
+#include "periodic_api.h"
+#include "periodic_callouts.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_periodic.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_PERIODIC_SLOTS         (1U << PERIODIC_HYPERPERIOD_SHIFT)
+#define HOST_PERIODIC_BUDGET_US     (PERIODIC_MIN_TIMESLOT * 1000U)
+#define HOST_PERIODIC_SAMPLE_US     (1000)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_periodic_tag
+{
+   bool started;
+   uint32_t firstSlot;     // slot count when the first slot was seen
+   uint64_t firstTime;     // and when, in cycles
+   uint32_t lastSlot;
+   int64_t drift;          // of the last slot, in cycles
+   int64_t maxDrift;
+} HostPeriodicType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_periodic_run(uint64_t now, void *pUserData);
+static void host_periodic_report(void);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+#define X(a,b,c) b,
+static const uint32_t host_periodic_period[] = { PERIODIC_TASKS_CFG };
+#undef X
+
+#define X(a,b,c) c,
+static const uint32_t host_periodic_phase[] = { PERIODIC_TASKS_CFG };
+#undef X
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostPeriodicType hostPeriodic;
+
+static HostSimProcessType hostPeriodicProcess =
+{
+   .period = HOST_SIM_US_TO_CYCLES(HOST_PERIODIC_SAMPLE_US),
+   .next = 0,
+   .run = host_periodic_run,
+   .pUserData = &hostPeriodic,
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostPeriodic_Init(void)
+{
+   HostSim_AddProcess(&hostPeriodicProcess);
+   atexit(host_periodic_report);
+}
+
+static void host_periodic_run(uint64_t now, void *pUserData)
+{
+   HostPeriodicType *pPeriodic = (HostPeriodicType *)pUserData;
+   uint32_t slot = Periodic_GetSlotCount();
+   int64_t expected;
+
+   if (0 == slot)
+      return;
+
+   if (FALSE == pPeriodic->started)
+   {
+      pPeriodic->started = TRUE;
+      pPeriodic->firstSlot = slot;
+      pPeriodic->firstTime = now;
+      pPeriodic->lastSlot = slot;
+      return;
+   }
+   if (slot == pPeriodic->lastSlot)
+      return;
+
+   pPeriodic->lastSlot = slot;
+   expected = (int64_t)(slot - pPeriodic->firstSlot) * (int64_t)HOST_SIM_MS_TO_CYCLES(PERIODIC_MIN_TIMESLOT);
+   pPeriodic->drift = (int64_t)(now - pPeriodic->firstTime) - expected;
+   if (llabs(pPeriodic->drift) > pPeriodic->maxDrift)
+      pPeriodic->maxDrift = llabs(pPeriodic->drift);
+}
+
+static void host_periodic_report(void)
+{
+   uint32_t worst = 0, worstSlot = 0, total = 0;
+   uint32_t maxTasks = 0, maxAligned = 0;
+
+   for (uint32_t slot = 0; slot < HOST_PERIODIC_SLOTS; slot++)
+   {
+      uint32_t load = 0, tasks = 0, aligned = 0;
+
+      Periodic_GetSlotLoad(slot, &load);
+      for (uint32_t i = 0; i < Num_Elems(host_periodic_period); i++)
+      {
+         uint32_t mask = host_periodic_period[i] - 1;
+
+         if ((slot & mask) == host_periodic_phase[i])
+            tasks++;
+         // the groups without offset all run in the last slot of their period
+         if ((slot & mask) == mask)
+            aligned++;
+      }
+
+      fprintf(stderr, "host_periodic: slot %3u load %5u us, %u handlers (%u without phase offsets)\n",
+              slot, load, tasks, aligned);
+      if (load > worst)
+      {
+         worst = load;
+         worstSlot = slot;
+      }
+      total += load;
+      if (tasks > maxTasks)
+         maxTasks = tasks;
+      if (aligned > maxAligned)
+         maxAligned = aligned;
+   }
+
+   fprintf(stderr, "host_periodic: worst slot %u, %u us of %u us, mean of the slots %u us, "
+                   "%u handlers per slot at most (%u without phase offsets)\n",
+           worstSlot, worst, HOST_PERIODIC_BUDGET_US, total / HOST_PERIODIC_SLOTS, maxTasks, maxAligned);
+   fprintf(stderr, "host_periodic: %u slots, %u missed, deadline drift %lld us (max %lld us)\n",
+           Periodic_GetSlotCount(), Periodic_GetMissedSlots(),
+           (long long)(hostPeriodic.drift / (int64_t)HOST_SIM_US_TO_CYCLES(1)),
+           (long long)(hostPeriodic.maxDrift / (int64_t)HOST_SIM_US_TO_CYCLES(1)));
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
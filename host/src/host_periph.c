@@ -0,0 +1,249 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_periph.c
+//!
+//!   \brief      Host simulation peripheral models dispatcher and RCC
+//!               model. The RCC model only reports the oscillators and
+//!               the PLL as ready and the selected system clock as
+//!               active; the virtual core clock always runs at
+//!               HOST_SIM_CORE_CLOCK_HZ.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef bool (*HostIrqLevelType)(IRQn_Type irq);
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+static const HostIrqLevelType host_periph_irq_level[] =
+{
+   [EXTI0_IRQn]          = HostGpio_IrqLevel,
+   [EXTI1_IRQn]          = HostGpio_IrqLevel,
+   [EXTI2_IRQn]          = HostGpio_IrqLevel,
+   [EXTI3_IRQn]          = HostGpio_IrqLevel,
+   [EXTI4_IRQn]          = HostGpio_IrqLevel,
+   [EXTI9_5_IRQn]        = HostGpio_IrqLevel,
+   [EXTI15_10_IRQn]      = HostGpio_IrqLevel,
+   [DMA1_Channel1_IRQn]  = HostDma_IrqLevel,
+   [DMA1_Channel2_IRQn]  = HostDma_IrqLevel,
+   [DMA1_Channel3_IRQn]  = HostDma_IrqLevel,
+   [DMA1_Channel4_IRQn]  = HostDma_IrqLevel,
+   [DMA1_Channel5_IRQn]  = HostDma_IrqLevel,
+   [DMA1_Channel6_IRQn]  = HostDma_IrqLevel,
+   [DMA1_Channel7_IRQn]  = HostDma_IrqLevel,
+   [ADC1_2_IRQn]         = HostAdc_IrqLevel,
+   [TIM1_UP_IRQn]        = HostTim_IrqLevel,
+   [TIM1_CC_IRQn]        = HostTim_IrqLevel,
+   [TIM2_IRQn]           = HostTim_IrqLevel,
+   [TIM3_IRQn]           = HostTim_IrqLevel,
+   [TIM4_IRQn]           = HostTim_IrqLevel,
+   [I2C1_EV_IRQn]        = HostI2C_IrqLevel,
+   [I2C1_ER_IRQn]        = HostI2C_IrqLevel,
+   [I2C2_EV_IRQn]        = HostI2C_IrqLevel,
+   [I2C2_ER_IRQn]        = HostI2C_IrqLevel,
+   [USART1_IRQn]         = HostUsart_IrqLevel,
+   [USART2_IRQn]         = HostUsart_IrqLevel,
+   [USART3_IRQn]         = HostUsart_IrqLevel,
+   [USBWakeUp_IRQn]      = NULL,
+};
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostPeriph_Init(void)
+{
+#define X(name) name##_Init();
+   HOST_PERIPH_MODELS_CFG
+#undef X
+}
+
+void HostPeriph_Sync(uint64_t now)
+{
+#define X(name) name##_Sync(now);
+   HOST_PERIPH_MODELS_CFG
+#undef X
+}
+
+uint64_t HostPeriph_NextEvent(uint64_t now)
+{
+   uint64_t next = HOST_SIM_NO_EVENT;
+   uint64_t event;
+
+#define X(name)                      \
+   event = name##_NextEvent(now);    \
+   if (event < next)                 \
+      next = event;
+   HOST_PERIPH_MODELS_CFG
+#undef X
+
+   return next;
+}
+
+void HostPeriph_Process(uint64_t now)
+{
+#define X(name) name##_Process(now);
+   HOST_PERIPH_MODELS_CFG
+#undef X
+}
+
+void HostPeriph_Commit(uint64_t now)
+{
+#define X(name) name##_Commit(now);
+   HOST_PERIPH_MODELS_CFG
+#undef X
+}
+
+bool HostPeriph_IrqLevel(IRQn_Type irq)
+{
+   if ((irq < 0) || (irq >= (IRQn_Type)Num_Elems(host_periph_irq_level)) ||
+       (NULL == host_periph_irq_level[irq]))
+   {
+      return FALSE;
+   }
+
+   return host_periph_irq_level[irq](irq);
+}
+
+uint32_t HostRcc_GetApbDivider(uint8_t bus)
+{
+   static const uint8_t divider[8] = { 1, 1, 1, 1, 2, 4, 8, 16 };
+   uint32_t ppre;
+
+   if (1 == bus)
+      ppre = (RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos;
+   else
+      ppre = (RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos;
+
+   return divider[ppre];
+}
+
+uint32_t HostRcc_GetAdcDivider(void)
+{
+   uint32_t adcpre;
+
+   adcpre = (RCC->CFGR & RCC_CFGR_ADCPRE) >> RCC_CFGR_ADCPRE_Pos;
+
+   return HostRcc_GetApbDivider(2) * (2 * (adcpre + 1));
+}
+
+void HostRcc_Init(void)
+{
+   RCC->CR = RCC_CR_HSION | RCC_CR_HSIRDY | (0x10UL << RCC_CR_HSITRIM_Pos);
+   RCC->CSR = RCC_CSR_PINRSTF | RCC_CSR_PORRSTF;
+   FLASH->ACR = FLASH_ACR_PRFTBE | FLASH_ACR_PRFTBS;
+}
+
+void HostRcc_Sync(uint64_t now)
+{
+   uint32_t cr = RCC->CR;
+   uint32_t ready = 0;
+
+   // oscillators and PLL lock instantly
+   if (0 != (cr & RCC_CR_HSION))
+      ready |= RCC_CR_HSIRDY;
+   if (0 != (cr & RCC_CR_HSEON))
+      ready |= RCC_CR_HSERDY;
+   if (0 != (cr & RCC_CR_PLLON))
+      ready |= RCC_CR_PLLRDY;
+   if ((cr & (RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY)) != ready)
+      RCC->CR = (cr & ~(RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY)) | ready;
+
+   // system clock switch is immediate
+   if (((RCC->CFGR & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos) != (RCC->CFGR & RCC_CFGR_SWS))
+      RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SWS) | ((RCC->CFGR & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos);
+
+   if ((0 != (RCC->CSR & RCC_CSR_LSION)) && (0 == (RCC->CSR & RCC_CSR_LSIRDY)))
+      RCC->CSR |= RCC_CSR_LSIRDY;
+   if ((0 != (RCC->BDCR & RCC_BDCR_LSEON)) && (0 == (RCC->BDCR & RCC_BDCR_LSERDY)))
+      RCC->BDCR |= RCC_BDCR_LSERDY;
+}
+
+uint64_t HostRcc_NextEvent(uint64_t now)
+{
+   return HOST_SIM_NO_EVENT;
+}
+
+void HostRcc_Process(uint64_t now)
+{
+}
+
+void HostRcc_Commit(uint64_t now)
+{
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,148 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       host_periph.h
+//!
+//!   \brief      Host simulation peripheral models private header file.
+//!
+//!               Every model implements the same five hooks:
+//!               - Init:      set the registers to their reset values.
+//!               - Sync:      pick up the register writes done by the
+//!                            firmware since the last call.
+//!               - NextEvent: virtual time of the next model event.
+//!               - Process:   execute every event up to a virtual time.
+//!               - Commit:    publish free running counters (CNT, VAL)
+//!                            before the firmware reads them.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _HOST_PERIPH_H
+#define  _HOST_PERIPH_H 1
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_SIM_NO_EVENT              (UINT64_MAX)
+
+// Peripheral memory map
+#define HOST_SIM_PERIPH_SIZE           (0x00030000UL)
+#define HOST_SIM_SRAM_SIZE             (0x00040000UL)
+#define HOST_SIM_SCS_BASE              (0xE0000000UL)
+#define HOST_SIM_SCS_SIZE              (0x00100000UL)
+
+// GPIO, AFIO and EXTI share two pages that are write protected. Every
+// firmware write there is trapped so set/reset/clear registers behave
+// as in the real hardware.
+#define HOST_SIM_GPIO_PAGES_BASE       (AFIO_BASE)
+#define HOST_SIM_GPIO_PAGES_SIZE       (0x00002000UL)
+
+// Exception vectors: 16 system exceptions followed by the device IRQs
+#define HOST_SIM_VECTORS               (16 + USBWakeUp_IRQn + 1)
+
+/**
+ * Get a writable view of a peripheral register. Must be used by the
+ * models for every write to the write protected pages.
+ */
+#define HOST_PERIPH_RW(ptr)            ((__typeof__(ptr))HostSim_PeriphAlias((volatile void *)(ptr)))
+
+/**
+ * Peripheral models table.
+ * The input format is: X([model prefix])
+ */
+#define HOST_PERIPH_MODELS_CFG \
+   X(HostRcc)     \
+   X(HostSysTick) \
+   X(HostDma)     \
+   X(HostTim)     \
+   X(HostAdc)     \
+   X(HostUsart)   \
+   X(HostI2C)     \
+   X(HostGpio)    \
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+#define X(name) \
+   extern void name##_Init(void);                  \
+   extern void name##_Sync(uint64_t now);          \
+   extern uint64_t name##_NextEvent(uint64_t now); \
+   extern void name##_Process(uint64_t now);       \
+   extern void name##_Commit(uint64_t now);
+HOST_PERIPH_MODELS_CFG
+#undef X
+
+// Exception vector table indexed by IRQn + 16
+extern void (* const HostSim_Vectors[HOST_SIM_VECTORS])(void);
+
+// Simulation core services used by the models
+extern volatile void *HostSim_PeriphAlias(volatile void *reg);
+extern void HostSim_Fatal(const char *pFormat, ...) __attribute__((noreturn, format(printf, 1, 2)));
+
+// Clock tree helpers
+extern uint32_t HostRcc_GetApbDivider(uint8_t bus);
+extern uint32_t HostRcc_GetAdcDivider(void);
+
+// Interrupt request levels
+extern bool HostPeriph_IrqLevel(IRQn_Type irq);
+extern bool HostDma_IrqLevel(IRQn_Type irq);
+extern bool HostTim_IrqLevel(IRQn_Type irq);
+extern bool HostAdc_IrqLevel(IRQn_Type irq);
+extern bool HostUsart_IrqLevel(IRQn_Type irq);
+extern bool HostI2C_IrqLevel(IRQn_Type irq);
+extern bool HostGpio_IrqLevel(IRQn_Type irq);
+
+// Inter model signals
+extern bool HostDma_Request(uint8_t channel);
+extern bool HostDma_Ready(uint8_t channel);
+extern int32_t HostAdc_GetExternalTrigger(void);
+extern void HostAdc_Trigger(uint32_t extsel, uint64_t now);
+extern void HostTim_Capture(uint32_t port, uint16_t rising, uint16_t falling, uint64_t now);
+extern bool HostGpio_IsActionRegister(uint32_t address);
+extern void HostGpio_Write(uint32_t address, uint32_t oldValue, uint32_t value);
+extern void HostGpio_Update(void);
+
+// Aggregated model hooks
+extern void HostPeriph_Init(void);
+extern void HostPeriph_Sync(uint64_t now);
+extern uint64_t HostPeriph_NextEvent(uint64_t now);
+extern void HostPeriph_Process(uint64_t now);
+extern void HostPeriph_Commit(uint64_t now);
+
+#endif // _HOST_PERIPH_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,307 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_pid.c
+//!
+//!   \brief      Host check of the step response of the PID controller.
+//!               The controller of the firmware closes the pressure loop
+//!               on the plant model of the simulation, every ms as the
+//!               ADC blocks do, with the 10 Hz filter of the ADC driver
+//!               on the feedback. The simulated board is not used, so
+//!               every case starts from the same state and runs in a
+//!               fraction of a second.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "standard.h"
+#include "pid_api.h"
+#include "ventilator_manager_conf.h"
+#include "lpf_butter_10hz_q31.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_plant.h"
+#include "host_pid.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_PID_SAMPLE_US          (1000)
+#define HOST_PID_PLANT_STEPS        (HOST_PID_SAMPLE_US / HOST_PLANT_STEP_US)
+
+#define HOST_PID_SETPOINT           (200)    // mmH2O
+#define HOST_PID_STEP_MS            (1000)
+#define HOST_PID_HOLD_MS            (2000)
+#define HOST_PID_GAIN_CHANGE_MS     (500)
+#define HOST_PID_ERROR_MS           (100)    // end of the step averaged for the steady state error
+#define HOST_PID_NOISE              (3)      // mmH2O, uniform
+#define HOST_PID_NOISE_KD           (0.5f)
+#define HOST_PID_SETTLING_BAND      (0.05)
+
+// ranges of the firmware pressure loop
+#define HOST_PID_INPUT_RANGE        (2048)
+#define HOST_PID_OUTPUT_RANGE       (100)
+#define HOST_PID_DERIV_SHIFT        (3)
+
+#define HOST_PID_CASES              (sizeof(hostPidCases) / sizeof(hostPidCases[0]))
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_pid_case_tag
+{
+   const char *pName;
+   float32_t beta;
+   float32_t kd;
+   uint32_t derivShift;
+   PidAntiWindupType antiWindup;
+   uint32_t holdMs;              // bellows held before the step
+   uint32_t gainChangeMs;        // proportional gain doubled, 0 for none
+   int32_t noise;                // feedback noise amplitude in mmH2O
+} HostPidCaseType;
+
+typedef struct host_pid_result_tag
+{
+   double rise;                  // ms from 10 % to 90 % of the step
+   double overshoot;             // % of the step
+   double settling;              // ms until the pressure stays in the band
+   double error;                 // mmH2O
+   int32_t maxDrive;
+   double saturated;             // ms at the drive limit after the pressure passed the setpoint
+   int32_t bump;                 // drive level change on the gain change
+   int32_t plainBump;            // the same without the integral correction
+   double driveNoise;            // RMS drive level change between samples, 2nd half of the step
+} HostPidResultType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_pid_run(const HostPidCaseType *pCase, HostPidResultType *pResult);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+static const HostPidCaseType hostPidCases[] =
+{
+   { "step",                      VENTILATOR_MGR_PRESSURE_BETA, VENTILATOR_MGR_PRESSURE_KD, HOST_PID_DERIV_SHIFT, PID_ANTI_WINDUP_BACK_CALC,   0,                0,                       0 },
+   { "step, beta 1",              1.0f,                         VENTILATOR_MGR_PRESSURE_KD, HOST_PID_DERIV_SHIFT, PID_ANTI_WINDUP_BACK_CALC,   0,                0,                       0 },
+   { "held, no anti-windup",      VENTILATOR_MGR_PRESSURE_BETA, VENTILATOR_MGR_PRESSURE_KD, HOST_PID_DERIV_SHIFT, PID_ANTI_WINDUP_NONE,        HOST_PID_HOLD_MS, 0,                       0 },
+   { "held, conditional",         VENTILATOR_MGR_PRESSURE_BETA, VENTILATOR_MGR_PRESSURE_KD, HOST_PID_DERIV_SHIFT, PID_ANTI_WINDUP_CONDITIONAL, HOST_PID_HOLD_MS, 0,                       0 },
+   { "held, back calculation",    VENTILATOR_MGR_PRESSURE_BETA, VENTILATOR_MGR_PRESSURE_KD, HOST_PID_DERIV_SHIFT, PID_ANTI_WINDUP_BACK_CALC,   HOST_PID_HOLD_MS, 0,                       0 },
+   { "gain change",               VENTILATOR_MGR_PRESSURE_BETA, VENTILATOR_MGR_PRESSURE_KD, HOST_PID_DERIV_SHIFT, PID_ANTI_WINDUP_BACK_CALC,   0,                HOST_PID_GAIN_CHANGE_MS, 0 },
+   { "noise, derivative",         VENTILATOR_MGR_PRESSURE_BETA, HOST_PID_NOISE_KD,          0,                    PID_ANTI_WINDUP_BACK_CALC,   0,                0,                       HOST_PID_NOISE },
+   { "noise, filtered derivative",VENTILATOR_MGR_PRESSURE_BETA, HOST_PID_NOISE_KD,          HOST_PID_DERIV_SHIFT, PID_ANTI_WINDUP_BACK_CALC,   0,                0,                       HOST_PID_NOISE },
+};
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType HostPid_Check(FILE *pReport)
+{
+   HostPidResultType results[HOST_PID_CASES];
+   StatusType status = E_OK;
+
+   for (uint32_t i = 0; i < HOST_PID_CASES; i++)
+   {
+      const HostPidCaseType *pCase = &hostPidCases[i];
+      HostPidResultType *pResult = &results[i];
+
+      host_pid_run(pCase, pResult);
+      fprintf(pReport, "host_pid: %-26s rise %4.0f ms, overshoot %5.1f %%, settling %4.0f ms, error %5.1f mmH2O, max drive %2ld %%",
+              pCase->pName, pResult->rise, pResult->overshoot, pResult->settling, pResult->error, (long)pResult->maxDrive);
+      if (0 != pCase->holdMs)
+         fprintf(pReport, ", saturated %.0f ms past the setpoint", pResult->saturated);
+      if (0 != pCase->gainChangeMs)
+         fprintf(pReport, ", bump %ld %% (%ld %% without correction)", (long)pResult->bump, (long)pResult->plainBump);
+      if (0 != pCase->noise)
+         fprintf(pReport, ", drive noise %.2f %% RMS", pResult->driveNoise);
+      fprintf(pReport, "\n");
+   }
+
+   // the firmware settings. The rise time and the error are reported only:
+   // the bellows starts at rest against the static friction
+   if (results[0].overshoot > HOST_PID_MAX_OVERSHOOT)
+      status = E_ERROR;
+   // anti-windup
+   if ((results[3].saturated >= results[2].saturated) || (results[4].saturated >= results[2].saturated))
+      status = E_ERROR;
+   // bumpless gain change
+   if (abs(results[5].bump) > HOST_PID_MAX_BUMP)
+      status = E_ERROR;
+   // derivative filter
+   if (results[7].driveNoise >= results[6].driveNoise)
+      status = E_ERROR;
+
+   fprintf(pReport, "host_pid: %s\n", (E_OK == status) ? "pass" : "FAIL");
+
+   return status;
+}
+
+static void host_pid_run(const HostPidCaseType *pCase, HostPidResultType *pResult)
+{
+   PidConfigType config =
+   {
+      .kp = VENTILATOR_MGR_PRESSURE_KP,
+      .ki = VENTILATOR_MGR_PRESSURE_KI,
+      .kd = pCase->kd,
+      .beta = pCase->beta,
+      .kt = VENTILATOR_MGR_PRESSURE_KT,
+      .derivShift = pCase->derivShift,
+      .antiWindup = pCase->antiWindup,
+      .inputRange = HOST_PID_INPUT_RANGE,
+      .outputRange = HOST_PID_OUTPUT_RANGE,
+      .outMin = 0,
+      .outMax = VENTILATOR_MGR_PRESSURE_MAX_DRIVE,
+   };
+   HostPlantParamsType params;
+   HostPlantStateType state;
+   lpf_butter_10hz_q31Type filter;
+   PidType pid;
+   uint32_t seed = 1;
+   int32_t drive = 0, lastDrive = 0;
+   double start, step, peak;
+   double t10 = -1.0, t90 = -1.0, settled = 0.0;
+   double errorSum = 0.0, noiseSum = 0.0;
+   uint32_t noiseCount = 0;
+
+   HostPlant_GetDefaultParams(&params);
+   // the step starts with the finger on the bellows
+   params.startPosition = HostPlant_GetContactPosition();
+   HostPlant_InitState(&params, &state);
+   lpf_butter_10hz_q31_init(&filter);
+   Pid_Init(&pid, &config);
+   Pid_Reset(&pid, VENTILATOR_MGR_PRESSURE_START_DRIVE);
+
+   start = 10.0 * state.pressure;
+   step = HOST_PID_SETPOINT - start;
+   peak = start;
+   pResult->maxDrive = 0;
+   pResult->saturated = 0.0;
+   pResult->bump = 0;
+   pResult->plainBump = 0;
+
+   for (uint32_t ms = 0; ms < (pCase->holdMs + HOST_PID_STEP_MS); ms++)
+   {
+      int32_t measurement = (int32_t)lround(10.0 * state.pressure);
+      double t = (double)ms - pCase->holdMs;
+      double pressure;
+
+      if (0 != pCase->noise)
+      {
+         seed = seed * 1664525 + 1013904223;
+         measurement += (int32_t)((seed >> 16) % (2 * pCase->noise + 1)) - pCase->noise;
+      }
+      measurement = lpf_butter_10hz_q31_filterSample(&filter, (int16_t)measurement);
+
+      if ((0 != pCase->gainChangeMs) && (t == pCase->gainChangeMs))
+      {
+         // what the proportional term would jump by if nothing compensated it
+         pResult->plainBump = (int32_t)lround(VENTILATOR_MGR_PRESSURE_KP *
+                                              (pCase->beta * HOST_PID_SETPOINT - measurement));
+         Pid_SetGains(&pid, 2.0f * VENTILATOR_MGR_PRESSURE_KP, VENTILATOR_MGR_PRESSURE_KI, pCase->kd);
+      }
+
+      drive = Pid_Update(&pid, HOST_PID_SETPOINT, measurement, 0);
+      if ((0 != pCase->gainChangeMs) && (t == pCase->gainChangeMs))
+         pResult->bump = drive - lastDrive;
+
+      // a held bellows doesn't move whatever the drive level
+      for (uint32_t i = 0; i < HOST_PID_PLANT_STEPS; i++)
+         HostPlant_Step(&params, &state, (t < 0.0) ? 0.0 : drive / 100.0, drive / 100.0);
+
+      if (t < 0.0)
+      {
+         lastDrive = drive;
+         continue;
+      }
+
+      pressure = 10.0 * state.pressure;
+      if ((t10 < 0.0) && (pressure >= (start + 0.1 * step)))
+         t10 = t;
+      if ((t90 < 0.0) && (pressure >= (start + 0.9 * step)))
+         t90 = t;
+      if (pressure > peak)
+         peak = pressure;
+      if (fabs(pressure - HOST_PID_SETPOINT) > (HOST_PID_SETTLING_BAND * step))
+         settled = t + 1.0;
+      if (t >= (HOST_PID_STEP_MS - HOST_PID_ERROR_MS))
+         errorSum += HOST_PID_SETPOINT - pressure;
+      if (t >= (HOST_PID_STEP_MS / 2))
+      {
+         noiseSum += (double)(drive - lastDrive) * (drive - lastDrive);
+         noiseCount++;
+      }
+      if (drive > pResult->maxDrive)
+         pResult->maxDrive = drive;
+      if ((measurement > HOST_PID_SETPOINT) && (drive >= VENTILATOR_MGR_PRESSURE_MAX_DRIVE))
+         pResult->saturated += 1.0;
+      lastDrive = drive;
+   }
+
+   pResult->rise = ((t10 < 0.0) || (t90 < 0.0)) ? HOST_PID_STEP_MS : (t90 - t10);
+   pResult->overshoot = (peak > HOST_PID_SETPOINT) ? (100.0 * (peak - HOST_PID_SETPOINT) / step) : 0.0;
+   pResult->settling = settled;
+   pResult->error = errorSum / HOST_PID_ERROR_MS;
+   pResult->driveNoise = sqrt(noiseSum / noiseCount);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,531 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_plant.c
+//!
+//!   \brief      Host simulation patient and bellows plant. The motor is
+//!               a first order model driven by the H bridge, with dry
+//!               friction and the bellows pressure as load. The bellows
+//!               pushes its displaced volume into a single compartment
+//!               lung through the airway resistance while it's being
+//!               compressed, and the lung empties through the expiratory
+//!               valve once the bellows is released. The mechanism is
+//!               not back driven by the bellows pressure. The model is
+//!               integrated with a fixed step as a simulation process.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "ventilator_manager_api.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_board.h"
+#include "host_plant.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_PLANT_DT                  (HOST_PLANT_STEP_US * 1e-6)
+
+// mechanical end stops in counts from home
+#define HOST_PLANT_MIN_POSITION        (-10.0)
+#define HOST_PLANT_MAX_POSITION        (400.0)
+
+// encoder counts in a degree of the finger, 4 per pulse of 600 PPR
+#define HOST_PLANT_COUNTS_PER_DEG      (2400.0 / 360.0)
+
+// bellows displaced volume in mL: slope * (x - contact) with x in degrees
+// past the contact, a least squares line through the volume to finger
+// angle calibration of the ventilator
+#define HOST_PLANT_BELLOWS_SLOPE       (22.74)
+#define HOST_PLANT_BELLOWS_CONTACT     (12.22)
+
+// max difference between the volume the ventilator estimates from the
+// finger angle and the bellows volume, in mL: the line is up to 22 mL
+// away from the calibration points
+#define HOST_PLANT_MAX_ESTIMATE_ERROR  (25.0)
+
+// breaths moving less volume are motor adjustments
+#define HOST_PLANT_MIN_BREATH_VOLUME   (10.0)
+
+// pressure band around the setpoint used for the settling time
+#define HOST_PLANT_SETTLING_BAND       (0.05)
+
+// fraction of the setpoint that ends the rise time
+#define HOST_PLANT_RISE_LEVEL          (0.9)
+
+#define HOST_PLANT_CYCLES_TO_MS(c)     ((double)HOST_SIM_CYCLES_TO_US(c) / 1000.0)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_plant_breath_tag
+{
+   bool active;
+   uint64_t start;
+   uint64_t inspEnd;             // release of the bellows, 0 while inspiring
+   uint64_t lastOutOfBand;       // last instant the pressure was out of the settling band
+   uint64_t risen;               // instant the pressure reached the rise level, 0 before
+   double volume;
+   double bellowsVolume;         // at the end of the inspiration
+   double estimatedVolume;       // by the ventilator at the same time
+   double pip;
+   double plateau;
+   double peep;
+   double pressureTime;          // airway pressure integral in cmH2O x s
+   double duration;              // s
+} HostPlantBreathType;
+
+typedef struct host_plant_stats_tag
+{
+   uint32_t breaths;
+   double pip, pipMax;
+   double plateau;
+   double peep;
+   double volume;
+   uint32_t cycles;              // breaths followed by another one
+   double meanPressure;
+   double volumeError, volumeErrorMax;
+   double overshoot, overshootMax;
+   double rise, riseMax;
+   double settling, settlingMax;
+   double estimateError, estimateErrorMax;
+} HostPlantStatsType;
+
+typedef struct host_plant_tag
+{
+   HostPlantParamsType params;
+   HostPlantStateType state;
+   bool home;
+   HostPlantBreathType breath;
+   HostPlantStatsType stats;
+} HostPlantType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_plant_run(uint64_t now, void *pUserData);
+static double host_plant_bellows(double position, double *pSlope);
+static void host_plant_breath_update(uint64_t now, double volume, double lastPressure);
+static void host_plant_breath_end(bool complete);
+static double host_plant_estimated_volume(void);
+static void host_plant_report(void);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostPlantType hostPlant;
+
+static HostSimProcessType hostPlantProcess =
+{
+   .period = HOST_SIM_US_TO_CYCLES(HOST_PLANT_STEP_US),
+   .next = 0,
+   .run = host_plant_run,
+   .pUserData = &hostPlant,
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostPlant_GetDefaultParams(HostPlantParamsType *pParams)
+{
+   pParams->compliance = 30.0;
+   pParams->resistance = 20.0;
+   pParams->expResistance = 5.0;
+   pParams->peep = 5.0;
+
+   // matches the speed to drive level feedforward of the motor driver:
+   // drive = 0.433 * speed + 9.6 with the speed in 0.15 deg steps
+   pParams->motorSpeed = 1540.0;
+   pParams->motorTimeConstant = 0.01;
+   pParams->motorFriction = 0.096;
+   pParams->motorTorque = 360.0;
+
+   pParams->startPosition = 0.0;
+   pParams->targetPressure = 0.0;
+   pParams->targetVolume = 0.0;
+   pParams->pBreathLog = NULL;
+}
+
+StatusType HostPlant_Init(const HostPlantParamsType *pParams)
+{
+   if ((NULL == pParams) || (pParams->compliance <= 0.0) || (pParams->resistance <= 0.0) ||
+       (pParams->expResistance < 0.0) || (pParams->motorSpeed <= 0.0) || (pParams->motorTimeConstant <= 0.0) ||
+       (pParams->motorTorque <= 0.0) || (pParams->startPosition < HOST_PLANT_MIN_POSITION) ||
+       (pParams->startPosition > HOST_PLANT_MAX_POSITION))
+   {
+      return E_ERROR;
+   }
+
+   hostPlant.params = *pParams;
+   HostPlant_InitState(pParams, &hostPlant.state);
+   hostPlant.home = (hostPlant.state.position <= 0.0);
+   hostPlant.breath.active = FALSE;
+
+   HostBoard_SetEncoderPosition((int32_t)floor(hostPlant.state.position));
+   HostBoard_SetHomeSwitch(hostPlant.home);
+   HostBoard_SetPressure(hostPlant.state.pressure);
+   HostBoard_SetFlow(0.0);
+
+   if (NULL != pParams->pBreathLog)
+      fprintf(pParams->pBreathLog, "breath,start_ms,ti_ms,vt_ml,pip_cmh2o,plateau_cmh2o,peep_cmh2o,overshoot_pct,rise_ms,settling_ms\n");
+
+   HostSim_AddProcess(&hostPlantProcess);
+   atexit(host_plant_report);
+
+   return E_OK;
+}
+
+void HostPlant_InitState(const HostPlantParamsType *pParams, HostPlantStateType *pState)
+{
+   pState->position = pParams->startPosition;
+   pState->speed = 0.0;
+   pState->bellowsVolume = host_plant_bellows(pState->position, NULL);
+   pState->lungVolume = 0.0;
+   pState->pressure = pParams->peep;
+   pState->inFlow = 0.0;
+   pState->exFlow = 0.0;
+   pState->expiring = TRUE;
+}
+
+double HostPlant_GetContactPosition(void)
+{
+   return HOST_PLANT_BELLOWS_CONTACT * HOST_PLANT_COUNTS_PER_DEG;
+}
+
+void HostPlant_Step(const HostPlantParamsType *pParams, HostPlantStateType *pState, double drive, double closed)
+{
+   double gain = pParams->motorSpeed / pParams->motorTimeConstant;
+   double friction = gain * pParams->motorFriction;
+   double slope, accel, speed, volume, lungPressure;
+
+   // motor: the bellows opposes the motion only while it's compressed
+   host_plant_bellows(pState->position, &slope);
+   accel = gain * (drive - closed * pState->speed / pParams->motorSpeed);
+   if ((pState->speed > 0.0) && (pState->pressure > 0.0))
+      accel -= gain * pState->pressure * slope / pParams->motorTorque;
+
+   if (0.0 != pState->speed)
+      accel -= (pState->speed > 0.0) ? friction : -friction;
+   else if (fabs(accel) <= friction)
+      accel = 0.0;
+   else
+      accel -= (accel > 0.0) ? friction : -friction;
+
+   // dry friction stops the motor instead of reversing it
+   speed = pState->speed + accel * HOST_PLANT_DT;
+   if (((pState->speed > 0.0) && (speed < 0.0)) || ((pState->speed < 0.0) && (speed > 0.0)))
+      speed = 0.0;
+   pState->speed = speed;
+   pState->position += speed * HOST_PLANT_DT;
+
+   if ((pState->position < HOST_PLANT_MIN_POSITION) || (pState->position > HOST_PLANT_MAX_POSITION))
+   {
+      pState->position = (pState->position < HOST_PLANT_MIN_POSITION) ? HOST_PLANT_MIN_POSITION : HOST_PLANT_MAX_POSITION;
+      pState->speed = 0.0;
+   }
+
+   // The bellows pushes into the lung while it's compressed and refills
+   // from the air inlet when released. The patient valve lets the lung
+   // empty through the expiratory valve once the bellows retracts; while
+   // the bellows is held the circuit is closed.
+   pState->inFlow = 0.0;
+   pState->exFlow = 0.0;
+   volume = host_plant_bellows(pState->position, NULL);
+   if (volume > pState->bellowsVolume)
+   {
+      pState->inFlow = (volume - pState->bellowsVolume) / HOST_PLANT_DT;
+      pState->lungVolume += volume - pState->bellowsVolume;
+      pState->expiring = FALSE;
+   }
+   else if ((pState->speed < 0.0) || (volume <= 0.0))
+   {
+      pState->expiring = TRUE;
+   }
+   pState->bellowsVolume = volume;
+
+   lungPressure = pParams->peep + pState->lungVolume / pParams->compliance;
+   if ((FALSE != pState->expiring) && (pState->lungVolume > 0.0))
+   {
+      pState->exFlow = 1000.0 * (lungPressure - pParams->peep) / (pParams->resistance + pParams->expResistance);
+      pState->lungVolume -= pState->exFlow * HOST_PLANT_DT;
+   }
+   pState->pressure = lungPressure + pParams->resistance * (pState->inFlow - pState->exFlow) / 1000.0;
+}
+
+static void host_plant_run(uint64_t now, void *pUserData)
+{
+   HostPlantType *pPlant = (HostPlantType *)pUserData;
+   HostPlantStateType *pState = &pPlant->state;
+   HostBoardBridgeType bridge;
+   double lastPressure = pState->pressure;
+   bool home;
+
+   HostBoard_GetMotorBridge(&bridge);
+   HostPlant_Step(&pPlant->params, pState, bridge.drive, bridge.closed);
+
+   // sensors
+   HostBoard_SetEncoderPosition((int32_t)floor(pState->position));
+   home = (pState->position <= 0.0);
+   if (home != pPlant->home)
+   {
+      HostBoard_SetHomeSwitch(home);
+      pPlant->home = home;
+   }
+   HostBoard_SetPressure(pState->pressure);
+   HostBoard_SetFlow((pState->inFlow - pState->exFlow) * 60.0 / 1000.0);
+
+   host_plant_breath_update(now, pState->inFlow * HOST_PLANT_DT, lastPressure);
+}
+
+static double host_plant_bellows(double position, double *pSlope)
+{
+   double angle = position / HOST_PLANT_COUNTS_PER_DEG;
+
+   if (angle <= HOST_PLANT_BELLOWS_CONTACT)
+   {
+      if (NULL != pSlope)
+         *pSlope = 0.0;
+      return 0.0;
+   }
+
+   // slope in mL per count
+   if (NULL != pSlope)
+      *pSlope = HOST_PLANT_BELLOWS_SLOPE / HOST_PLANT_COUNTS_PER_DEG;
+
+   return HOST_PLANT_BELLOWS_SLOPE * (angle - HOST_PLANT_BELLOWS_CONTACT);
+}
+
+static void host_plant_breath_update(uint64_t now, double volume, double lastPressure)
+{
+   HostPlantBreathType *pBreath = &hostPlant.breath;
+   double target = hostPlant.params.targetPressure;
+
+   // a breath starts when the bellows is compressed again after a release
+   if ((volume > 0.0) && ((FALSE == pBreath->active) || (0 != pBreath->inspEnd)))
+   {
+      host_plant_breath_end(TRUE);
+
+      pBreath->active = TRUE;
+      pBreath->start = now;
+      pBreath->inspEnd = 0;
+      pBreath->lastOutOfBand = now;
+      pBreath->risen = 0;
+      pBreath->volume = 0.0;
+      pBreath->pip = hostPlant.state.pressure;
+      pBreath->peep = lastPressure;
+      pBreath->pressureTime = 0.0;
+      pBreath->duration = 0.0;
+   }
+
+   if (FALSE == pBreath->active)
+      return;
+
+   pBreath->volume += volume;
+   pBreath->pressureTime += hostPlant.state.pressure * HOST_PLANT_DT;
+   pBreath->duration += HOST_PLANT_DT;
+   if (hostPlant.state.pressure > pBreath->pip)
+      pBreath->pip = hostPlant.state.pressure;
+
+   if (0 == pBreath->inspEnd)
+   {
+      if (hostPlant.state.speed < 0.0)
+      {
+         pBreath->inspEnd = now;
+         pBreath->plateau = lastPressure;
+         pBreath->bellowsVolume = hostPlant.state.bellowsVolume;
+         pBreath->estimatedVolume = host_plant_estimated_volume();
+         if (0 == pBreath->risen)
+            pBreath->risen = now;
+      }
+      else if (target > 0.0)
+      {
+         if (fabs(hostPlant.state.pressure - target) > (HOST_PLANT_SETTLING_BAND * target))
+            pBreath->lastOutOfBand = now;
+         if ((0 == pBreath->risen) && (hostPlant.state.pressure >= (HOST_PLANT_RISE_LEVEL * target)))
+            pBreath->risen = now;
+      }
+   }
+}
+
+static void host_plant_breath_end(bool complete)
+{
+   HostPlantBreathType *pBreath = &hostPlant.breath;
+   HostPlantStatsType *pStats = &hostPlant.stats;
+   HostPlantParamsType *pParams = &hostPlant.params;
+   double overshoot = 0.0, rise = 0.0, settling = 0.0, volumeError = 0.0;
+   double estimateError;
+
+   if ((FALSE == pBreath->active) || (0 == pBreath->inspEnd))
+      return;
+
+   pBreath->active = FALSE;
+   if (pBreath->volume < HOST_PLANT_MIN_BREATH_VOLUME)
+      return;
+
+   if (pParams->targetPressure > 0.0)
+   {
+      overshoot = 100.0 * (pBreath->pip - pParams->targetPressure) / pParams->targetPressure;
+      if (overshoot < 0.0)
+         overshoot = 0.0;
+      rise = HOST_PLANT_CYCLES_TO_MS(pBreath->risen - pBreath->start);
+      settling = HOST_PLANT_CYCLES_TO_MS(pBreath->lastOutOfBand - pBreath->start);
+   }
+   if (pParams->targetVolume > 0.0)
+      volumeError = pBreath->volume - pParams->targetVolume;
+   estimateError = pBreath->estimatedVolume - pBreath->bellowsVolume;
+
+   pStats->breaths++;
+   pStats->pip += pBreath->pip;
+   pStats->plateau += pBreath->plateau;
+   pStats->peep += pBreath->peep;
+   pStats->volume += pBreath->volume;
+   pStats->volumeError += volumeError;
+   pStats->overshoot += overshoot;
+   pStats->rise += rise;
+   pStats->settling += settling;
+   pStats->estimateError += estimateError;
+   // the mean airway pressure needs the whole expiration
+   if (FALSE != complete)
+   {
+      pStats->cycles++;
+      pStats->meanPressure += pBreath->pressureTime / pBreath->duration;
+   }
+   if ((1 == pStats->breaths) || (pBreath->pip > pStats->pipMax))
+      pStats->pipMax = pBreath->pip;
+   if ((1 == pStats->breaths) || (fabs(volumeError) > fabs(pStats->volumeErrorMax)))
+      pStats->volumeErrorMax = volumeError;
+   if ((1 == pStats->breaths) || (overshoot > pStats->overshootMax))
+      pStats->overshootMax = overshoot;
+   if ((1 == pStats->breaths) || (rise > pStats->riseMax))
+      pStats->riseMax = rise;
+   if ((1 == pStats->breaths) || (settling > pStats->settlingMax))
+      pStats->settlingMax = settling;
+   if ((1 == pStats->breaths) || (fabs(estimateError) > fabs(pStats->estimateErrorMax)))
+      pStats->estimateErrorMax = estimateError;
+
+   if (NULL != pParams->pBreathLog)
+   {
+      fprintf(pParams->pBreathLog, "%lu,%.1f,%.1f,%.1f,%.2f,%.2f,%.2f,%.1f,%.1f,%.1f\n",
+              (unsigned long)pStats->breaths, HOST_PLANT_CYCLES_TO_MS(pBreath->start),
+              HOST_PLANT_CYCLES_TO_MS(pBreath->inspEnd - pBreath->start), pBreath->volume,
+              pBreath->pip, pBreath->plateau, pBreath->peep, overshoot, rise, settling);
+   }
+}
+
+static void host_plant_report(void)
+{
+   HostPlantStatsType *pStats = &hostPlant.stats;
+   HostPlantParamsType *pParams = &hostPlant.params;
+   double n;
+
+   // the breath in progress is complete once the bellows has been released
+   host_plant_breath_end(FALSE);
+   if (NULL != pParams->pBreathLog)
+      fflush(pParams->pBreathLog);
+
+   if (0 == pStats->breaths)
+   {
+      fprintf(stderr, "host_plant: no breaths\n");
+      return;
+   }
+
+   n = pStats->breaths;
+   fprintf(stderr, "host_plant: %lu breaths, Vt %.0f mL, PIP %.1f cmH2O (max %.1f), Pplat %.1f cmH2O, PEEP %.1f cmH2O\n",
+           (unsigned long)pStats->breaths, pStats->volume / n, pStats->pip / n, pStats->pipMax,
+           pStats->plateau / n, pStats->peep / n);
+   if (pStats->cycles > 0)
+      fprintf(stderr, "host_plant: mean airway pressure %.2f cmH2O\n", pStats->meanPressure / pStats->cycles);
+   if (pParams->targetVolume > 0.0)
+   {
+      fprintf(stderr, "host_plant: Vt error %.0f mL (%.1f %%), worst %.0f mL\n",
+              pStats->volumeError / n, 100.0 * pStats->volumeError / (n * pParams->targetVolume),
+              pStats->volumeErrorMax);
+   }
+   if (pParams->targetPressure > 0.0)
+   {
+      fprintf(stderr, "host_plant: overshoot %.1f %% (max %.1f), rise %.0f ms (max %.0f), settling %.0f ms (max %.0f)\n",
+              pStats->overshoot / n, pStats->overshootMax, pStats->rise / n, pStats->riseMax,
+              pStats->settling / n, pStats->settlingMax);
+   }
+
+   // the estimate is read when the bellows is released, the breath
+   // starts from home so the bellows volume is the volume delivered
+   fprintf(stderr, "host_plant: estimated volume error %.1f mL, worst %.1f mL: %s\n",
+           pStats->estimateError / n, pStats->estimateErrorMax,
+           (fabs(pStats->estimateErrorMax) <= HOST_PLANT_MAX_ESTIMATE_ERROR) ? "pass" : "fail");
+}
+
+static double host_plant_estimated_volume(void)
+{
+   uint32_t volume = 0;
+
+   VentilatorMgr_GetEstimatedVolume(&volume);
+
+   return (double)volume;
+}
+
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,877 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_sim.c
+//!
+//!   \brief      Host simulation core. Maps the STM32F1 memory regions at
+//!               their physical addresses, keeps the virtual clock,
+//!               implements the virtual NVIC and dispatches the firmware
+//!               exception handlers.
+//!
+//!               The firmware runs on a stack placed in the simulated
+//!               SRAM. Time only advances when the firmware polls the
+//!               tick, waits for an interrupt or blocks in a HAL call;
+//!               peripheral models are synchronized with the registers at
+//!               those points.
+//!
+//!               GPIO, AFIO and EXTI registers are write protected. A
+//!               write faults, the page is unlocked and the instruction is
+//!               single stepped; the trap that follows hands the written
+//!               value to the GPIO model and locks the page again. The
+//!               peripheral bit-band alias region is emulated the same
+//!               way. The single step relies on the x86-64 trap flag.
+//!               The same trap runs a step handler between every
+//!               instruction while a check single steps firmware code.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+#if !defined(__x86_64__) || !defined(__linux__)
+#error "The host simulation requires Linux on x86-64"
+#endif
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_SIM_EFLAGS_TF             (0x100)
+#define HOST_SIM_TRAP_WORDS            (4)
+#define HOST_SIM_THREAD_PRIORITY       (0x100)
+#define HOST_SIM_STORM_LIMIT           (100000)
+#define HOST_SIM_DEFAULT_QUANTUM       (HOST_SIM_US_TO_CYCLES(10))
+#define HOST_SIM_MAX_TICK_JUMP         (HOST_SIM_US_TO_CYCLES(100))
+#define HOST_SIM_AIRCR_RESET           (0xFA050000UL)
+#define HOST_SIM_ALT_STACK_SIZE        (64 * 1024)
+#define HOST_SIM_PAGE_SIZE             (0x1000UL)
+
+// every peripheral register bit has a word in the bit-band alias region
+#define HOST_SIM_BITBAND_SIZE          (HOST_SIM_PERIPH_SIZE * 32)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_sim_tag
+{
+   uint64_t now;                       // virtual time in core cycles
+   uint64_t limit;                     // end of the simulation
+   uint32_t quantum;                   // cycles consumed by HAL_GetTick()
+   uint64_t stall;                     // cycles the next unmasked thread mode HAL_GetTick() holds the main loop
+   uint8_t *pAlias;                    // writable view of the peripherals
+   HostSimProcessType *pProcesses;
+   bool processing;                    // models are being processed
+
+   // virtual NVIC, indexed by IRQn + 16
+   bool enabled[HOST_SIM_VECTORS];
+   bool latched[HOST_SIM_VECTORS];
+   bool active[HOST_SIM_VECTORS];
+   uint8_t priority[HOST_SIM_VECTORS];
+   uint32_t primask;
+   uint32_t executionPriority;         // preempt priority of the running code
+   uint32_t depth;                     // nested exception handlers
+   uint64_t dispatches;                // number of handlers executed
+   uint64_t spinTime;                  // last time instant checked by the storm guard
+   uint32_t spinCount;                 // iterations without time advancing
+
+   // DWT cycle counter
+   uint64_t cyccntOrigin;
+   uint32_t cyccntLast;
+
+   // write trap
+   uint32_t trapAddress;
+   uint32_t trapWords;
+   uint32_t trapValue[HOST_SIM_TRAP_WORDS];
+
+   // single step
+   HostSimStepHandlerType pStepHandler;
+   bool stepping;                      // the step handler is running
+
+   // firmware context
+   ucontext_t firmware;
+   ucontext_t host;
+   struct timespec wallStart;
+} HostSimType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static StatusType host_sim_map(void *address, size_t size, int fd);
+static void host_sim_segv_handler(int sig, siginfo_t *pInfo, void *pContext);
+static void host_sim_trap_handler(int sig, siginfo_t *pInfo, void *pContext);
+static void host_sim_trap_write(uint32_t address);
+static void host_sim_fault_handler(int sig, siginfo_t *pInfo, void *pContext);
+static bool host_sim_divide_by_zero(ucontext_t *pUc);
+static uint32_t host_sim_bitband_read(uint32_t alias);
+static void host_sim_bitband_write(uint32_t alias, uint32_t bit);
+static void host_sim_sync(void);
+static void host_sim_commit(void);
+static uint64_t host_sim_next_event(void);
+static void host_sim_run_until(uint64_t target);
+static void host_sim_spin_guard(void);
+static int32_t host_sim_pending(bool ignoreMask);
+static bool host_sim_is_pending(uint32_t index);
+static uint32_t host_sim_preempt_priority(uint32_t index);
+static void host_sim_dispatch(void);
+static void host_sim_firmware_entry(void);
+static void host_sim_report(void);
+
+// Firmware entry points
+extern void SystemInit(void);
+extern int HostSim_FirmwareMain(void);
+
+// HAL tick counter
+extern __IO uint32_t uwTick;
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostSimType hostSim;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType HostSim_Init(void)
+{
+   static uint8_t altStack[HOST_SIM_ALT_STACK_SIZE];
+   stack_t ss;
+   struct sigaction sa;
+   int fd;
+
+   memset(&hostSim, 0, sizeof(hostSim));
+   hostSim.quantum = HOST_SIM_DEFAULT_QUANTUM;
+   hostSim.limit = HOST_SIM_NO_EVENT;
+   hostSim.executionPriority = HOST_SIM_THREAD_PRIORITY;
+
+   // The peripheral region is shared memory so a second, writable, view of
+   // the protected pages is available to the models
+   fd = memfd_create("host_sim_periph", 0);
+   if ((fd < 0) || (0 != ftruncate(fd, HOST_SIM_PERIPH_SIZE)))
+      return E_ERROR;
+
+   if ((E_OK != host_sim_map((void *)PERIPH_BASE, HOST_SIM_PERIPH_SIZE, fd)) ||
+       (E_OK != host_sim_map((void *)SRAM_BASE, HOST_SIM_SRAM_SIZE, -1)) ||
+       (E_OK != host_sim_map((void *)HOST_SIM_SCS_BASE, HOST_SIM_SCS_SIZE, -1)) ||
+       (E_OK != host_sim_map((void *)PERIPH_BB_BASE, HOST_SIM_BITBAND_SIZE, -1)))
+   {
+      close(fd);
+      return E_ERROR;
+   }
+
+   hostSim.pAlias = mmap(NULL, HOST_SIM_PERIPH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   close(fd);
+   if (MAP_FAILED == hostSim.pAlias)
+      return E_ERROR;
+
+   // system control block reset values
+   SCB->AIRCR = HOST_SIM_AIRCR_RESET;
+   *(volatile uint32_t *)&SCB->CPUID = 0x411FC231UL;
+
+   HostPeriph_Init();
+
+   // write trap on the GPIO pages. Handlers run on their own stack so the
+   // firmware stack usage is not altered.
+   ss.ss_sp = altStack;
+   ss.ss_size = sizeof(altStack);
+   ss.ss_flags = 0;
+   memset(&sa, 0, sizeof(sa));
+   sa.sa_flags = SA_SIGINFO | SA_ONSTACK;
+   sigemptyset(&sa.sa_mask);
+   sa.sa_sigaction = host_sim_segv_handler;
+   if ((0 != sigaltstack(&ss, NULL)) || (0 != sigaction(SIGSEGV, &sa, NULL)))
+      return E_ERROR;
+   // the step handler may write the GPIO, which traps again
+   sa.sa_sigaction = host_sim_trap_handler;
+   sa.sa_flags |= SA_NODEFER;
+   if (0 != sigaction(SIGTRAP, &sa, NULL))
+      return E_ERROR;
+   sa.sa_flags &= ~SA_NODEFER;
+   sa.sa_sigaction = host_sim_fault_handler;
+   if ((0 != sigaction(SIGFPE, &sa, NULL)) || (0 != sigaction(SIGILL, &sa, NULL)) ||
+       (0 != sigaction(SIGBUS, &sa, NULL)))
+   {
+      return E_ERROR;
+   }
+
+   if ((0 != mprotect((void *)HOST_SIM_GPIO_PAGES_BASE, HOST_SIM_GPIO_PAGES_SIZE, PROT_READ)) ||
+       (0 != mprotect((void *)PERIPH_BB_BASE, HOST_SIM_BITBAND_SIZE, PROT_NONE)))
+   {
+      return E_ERROR;
+   }
+
+   return E_OK;
+}
+
+void HostSim_Run(uint32_t limitMs)
+{
+   hostSim.limit = HOST_SIM_MS_TO_CYCLES(limitMs);
+   clock_gettime(CLOCK_MONOTONIC, &hostSim.wallStart);
+   atexit(host_sim_report);
+
+   // the firmware stack grows down from the end of the SRAM
+   getcontext(&hostSim.firmware);
+   hostSim.firmware.uc_stack.ss_sp = (void *)SRAM_BASE;
+   hostSim.firmware.uc_stack.ss_size = HOST_SIM_SRAM_SIZE;
+   hostSim.firmware.uc_link = &hostSim.host;
+   makecontext(&hostSim.firmware, host_sim_firmware_entry, 0);
+   swapcontext(&hostSim.host, &hostSim.firmware);
+
+   HostSim_Fatal("firmware context exited");
+}
+
+void HostSim_SetTickQuantum(uint32_t cycles)
+{
+   hostSim.quantum = cycles;
+}
+
+void HostSim_Stall(uint64_t cycles)
+{
+   hostSim.stall += cycles;
+}
+
+uint64_t HostSim_GetCycles(void)
+{
+   return hostSim.now;
+}
+
+void HostSim_Advance(uint64_t cycles)
+{
+   host_sim_run_until(hostSim.now + cycles);
+}
+
+void HostSim_WaitForInterrupt(void)
+{
+   uint64_t dispatches = hostSim.dispatches;
+
+   // sleep until an exception is taken, or becomes pending while masked
+   do
+   {
+      host_sim_run_until(host_sim_next_event());
+   } while ((dispatches == hostSim.dispatches) && (host_sim_pending(TRUE) < 0));
+}
+
+bool HostSim_InISR(void)
+{
+   return (0 != hostSim.depth);
+}
+
+void HostSim_SetStepHandler(HostSimStepHandlerType pHandler)
+{
+   hostSim.pStepHandler = pHandler;
+
+   // the trap handler keeps the trap flag set while there is a handler.
+   // The flags are pushed below the red zone of the caller.
+   if (NULL != pHandler)
+   {
+      __asm__ volatile ("sub $128, %%rsp\n\t"
+                        "pushfq\n\t"
+                        "orq %0, (%%rsp)\n\t"
+                        "popfq\n\t"
+                        "add $128, %%rsp"
+                        : : "i" (HOST_SIM_EFLAGS_TF) : "cc", "memory");
+   }
+}
+
+void HostSim_AddProcess(HostSimProcessType *pProcess)
+{
+   pProcess->pNext = hostSim.pProcesses;
+   hostSim.pProcesses = pProcess;
+}
+
+volatile void *HostSim_PeriphAlias(volatile void *reg)
+{
+   uintptr_t address = (uintptr_t)reg;
+
+   if ((address < PERIPH_BASE) || (address >= (PERIPH_BASE + HOST_SIM_PERIPH_SIZE)))
+      return reg;
+
+   return hostSim.pAlias + (address - PERIPH_BASE);
+}
+
+void HostSim_Fatal(const char *pFormat, ...)
+{
+   va_list args;
+
+   fflush(stdout);
+   fprintf(stderr, "host_sim: fatal error at %llu us: ", (unsigned long long)HOST_SIM_CYCLES_TO_US(hostSim.now));
+   va_start(args, pFormat);
+   vfprintf(stderr, pFormat, args);
+   va_end(args);
+   fprintf(stderr, "\n");
+
+   exit(EXIT_FAILURE);
+}
+
+uint32_t HostSim_GetProfilerTicks(void)
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+
+   return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t HostSim_GetPRIMASK(void)
+{
+   return hostSim.primask;
+}
+
+void HostSim_SetPRIMASK(uint32_t priMask)
+{
+   hostSim.primask = priMask & 1;
+
+   // interrupts pended inside the critical section are taken right away
+   if ((0 == hostSim.primask) && (FALSE == hostSim.processing))
+   {
+      host_sim_sync();
+      host_sim_dispatch();
+   }
+}
+
+void HostSim_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+   if (IRQn < 0)
+      return;
+
+   hostSim.enabled[IRQn + 16] = TRUE;
+   if (FALSE == hostSim.processing)
+   {
+      host_sim_sync();
+      host_sim_dispatch();
+   }
+}
+
+uint32_t HostSim_NVIC_GetEnableIRQ(IRQn_Type IRQn)
+{
+   return (IRQn >= 0) && (FALSE != hostSim.enabled[IRQn + 16]);
+}
+
+void HostSim_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+   if (IRQn >= 0)
+      hostSim.enabled[IRQn + 16] = FALSE;
+}
+
+uint32_t HostSim_NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+   return host_sim_is_pending(IRQn + 16);
+}
+
+void HostSim_NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+   hostSim.latched[IRQn + 16] = TRUE;
+   if (FALSE == hostSim.processing)
+      host_sim_dispatch();
+}
+
+void HostSim_NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+   hostSim.latched[IRQn + 16] = FALSE;
+}
+
+uint32_t HostSim_NVIC_GetActive(IRQn_Type IRQn)
+{
+   return hostSim.active[IRQn + 16];
+}
+
+void HostSim_NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+   hostSim.priority[IRQn + 16] = (uint8_t)(priority & ((1UL << __NVIC_PRIO_BITS) - 1));
+}
+
+uint32_t HostSim_NVIC_GetPriority(IRQn_Type IRQn)
+{
+   return hostSim.priority[IRQn + 16];
+}
+
+void HostSim_NVIC_SystemReset(void)
+{
+   HostSim_Fatal("system reset requested");
+}
+
+uint32_t HAL_GetTick(void)
+{
+   uint64_t next;
+
+   // the main loop is held, the interrupts keep running
+   if ((0 != hostSim.stall) && (0 == hostSim.depth) && (0 == hostSim.primask))
+   {
+      next = hostSim.stall;
+      hostSim.stall = 0;
+      HostSim_Advance(next);
+   }
+
+   if (0 != hostSim.quantum)
+   {
+      HostSim_Advance(hostSim.quantum);
+   }
+   else
+   {
+      // the polled condition may not depend on any event
+      next = host_sim_next_event();
+      if ((next - hostSim.now) > HOST_SIM_MAX_TICK_JUMP)
+         next = hostSim.now + HOST_SIM_MAX_TICK_JUMP;
+      host_sim_run_until(next);
+   }
+
+   return uwTick;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+   uint32_t tickstart = HAL_GetTick();
+   uint32_t wait = Delay;
+
+   // Add a freq to guarantee minimum wait
+   if (wait < HAL_MAX_DELAY)
+      wait += (uint32_t)(uwTickFreq);
+
+   while ((HAL_GetTick() - tickstart) < wait)
+      HostSim_WaitForInterrupt();
+}
+
+static StatusType host_sim_map(void *address, size_t size, int fd)
+{
+   void *p;
+
+   if (fd < 0)
+      p = mmap(address, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+   else
+      p = mmap(address, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+
+   if (p != address)
+   {
+      fprintf(stderr, "host_sim: unable to map 0x%08lx\n", (unsigned long)(uintptr_t)address);
+      if (MAP_FAILED != p)
+         munmap(p, size);
+      return E_ERROR;
+   }
+
+   return E_OK;
+}
+
+static void host_sim_segv_handler(int sig, siginfo_t *pInfo, void *pContext)
+{
+   ucontext_t *pUc = (ucontext_t *)pContext;
+   uintptr_t address = (uintptr_t)pInfo->si_addr;
+   uintptr_t end = HOST_SIM_GPIO_PAGES_BASE + HOST_SIM_GPIO_PAGES_SIZE;
+
+   if ((0 == hostSim.trapAddress) && (address >= HOST_SIM_GPIO_PAGES_BASE) && (address < end))
+   {
+      hostSim.trapAddress = (uint32_t)(address & ~3UL);
+      hostSim.trapWords = 0;
+      for (uint32_t a = hostSim.trapAddress; (hostSim.trapWords < HOST_SIM_TRAP_WORDS) && (a < end); a += 4)
+      {
+         hostSim.trapValue[hostSim.trapWords++] = *(volatile uint32_t *)(uintptr_t)a;
+
+         // action registers read as zero, so a write that doesn't touch them is a no-op
+         if (FALSE != HostGpio_IsActionRegister(a))
+            *(volatile uint32_t *)HostSim_PeriphAlias((volatile void *)(uintptr_t)a) = 0;
+      }
+
+      mprotect((void *)HOST_SIM_GPIO_PAGES_BASE, HOST_SIM_GPIO_PAGES_SIZE, PROT_READ | PROT_WRITE);
+   }
+   else if ((0 == hostSim.trapAddress) && (address >= PERIPH_BB_BASE) &&
+            (address < (PERIPH_BB_BASE + HOST_SIM_BITBAND_SIZE)))
+   {
+      // the alias word is loaded with the bit value before the access
+      hostSim.trapAddress = (uint32_t)(address & ~3UL);
+      hostSim.trapWords = 1;
+      hostSim.trapValue[0] = host_sim_bitband_read(hostSim.trapAddress);
+
+      mprotect((void *)(address & ~(HOST_SIM_PAGE_SIZE - 1)), HOST_SIM_PAGE_SIZE, PROT_READ | PROT_WRITE);
+      *(volatile uint32_t *)(uintptr_t)hostSim.trapAddress = hostSim.trapValue[0];
+   }
+   else
+   {
+      // a genuine fault, let it crash
+      fprintf(stderr, "host_sim: invalid access to 0x%08lx at %llu us, pc 0x%lx\n", (unsigned long)address,
+              (unsigned long long)HOST_SIM_CYCLES_TO_US(hostSim.now), (unsigned long)pUc->uc_mcontext.gregs[REG_RIP]);
+      signal(SIGSEGV, SIG_DFL);
+      return;
+   }
+
+   pUc->uc_mcontext.gregs[REG_EFL] |= HOST_SIM_EFLAGS_TF;
+}
+
+static void host_sim_trap_handler(int sig, siginfo_t *pInfo, void *pContext)
+{
+   ucontext_t *pUc = (ucontext_t *)pContext;
+
+   pUc->uc_mcontext.gregs[REG_EFL] &= ~HOST_SIM_EFLAGS_TF;
+   if (0 != hostSim.trapAddress)
+      host_sim_trap_write(hostSim.trapAddress);
+
+   // an interrupt between every instruction of the single stepped code
+   if ((NULL != hostSim.pStepHandler) && (FALSE == hostSim.stepping))
+   {
+      hostSim.stepping = TRUE;
+      hostSim.pStepHandler();
+      hostSim.stepping = FALSE;
+
+      if (NULL != hostSim.pStepHandler)
+         pUc->uc_mcontext.gregs[REG_EFL] |= HOST_SIM_EFLAGS_TF;
+   }
+}
+
+static void host_sim_trap_write(uint32_t address)
+{
+   hostSim.trapAddress = 0;
+
+   if (address >= PERIPH_BB_BASE)
+   {
+      uint32_t value = *(volatile uint32_t *)(uintptr_t)address;
+
+      mprotect((void *)(uintptr_t)(address & ~(HOST_SIM_PAGE_SIZE - 1)), HOST_SIM_PAGE_SIZE, PROT_NONE);
+      if (value != hostSim.trapValue[0])
+         host_sim_bitband_write(address, value & 1);
+      return;
+   }
+
+   mprotect((void *)HOST_SIM_GPIO_PAGES_BASE, HOST_SIM_GPIO_PAGES_SIZE, PROT_READ);
+
+   for (uint32_t i = 0; i < hostSim.trapWords; i++, address += 4)
+   {
+      uint32_t value = *(volatile uint32_t *)(uintptr_t)address;
+
+      if ((value != hostSim.trapValue[i]) || (FALSE != HostGpio_IsActionRegister(address)))
+         HostGpio_Write(address, hostSim.trapValue[i], value);
+   }
+   HostGpio_Update();
+}
+
+static void host_sim_fault_handler(int sig, siginfo_t *pInfo, void *pContext)
+{
+   ucontext_t *pUc = (ucontext_t *)pContext;
+
+   // Cortex-M3 divisions by zero return zero
+   if ((SIGFPE == sig) && (FALSE != host_sim_divide_by_zero(pUc)))
+      return;
+
+   // the default action runs when the faulting instruction is restarted
+   fprintf(stderr, "host_sim: %s at %llu us, pc 0x%lx\n", strsignal(sig),
+           (unsigned long long)HOST_SIM_CYCLES_TO_US(hostSim.now), (unsigned long)pUc->uc_mcontext.gregs[REG_RIP]);
+   signal(sig, SIG_DFL);
+}
+
+static bool host_sim_divide_by_zero(ucontext_t *pUc)
+{
+   const uint8_t *pCode = (const uint8_t *)pUc->uc_mcontext.gregs[REG_RIP];
+   greg_t *pRegs = pUc->uc_mcontext.gregs;
+   uint32_t length = 0;
+   bool wide = FALSE;
+   uint8_t modrm, mod, rm;
+
+   // [REX] F7 /6 (div) or F7 /7 (idiv) with any operand
+   if (0x40 == (pCode[length] & 0xF0))
+      wide = (0 != (pCode[length++] & 0x08));
+   if (0xF7 != pCode[length++])
+      return FALSE;
+
+   modrm = pCode[length++];
+   mod = modrm >> 6;
+   rm = modrm & 0x07;
+   if (6 != ((modrm >> 3) & 0x07) && (7 != ((modrm >> 3) & 0x07)))
+      return FALSE;
+
+   if (3 != mod)
+   {
+      if (4 == rm)
+      {
+         if ((0 == mod) && (5 == (pCode[length] & 0x07)))
+            length += 4;
+         length++;
+      }
+      else if ((0 == mod) && (5 == rm))
+      {
+         length += 4;
+      }
+      length += (1 == mod) ? 1 : ((2 == mod) ? 4 : 0);
+   }
+
+   // quotient is zero, so the remainder is the dividend
+   pRegs[REG_RDX] = (FALSE != wide) ? pRegs[REG_RAX] : (greg_t)(uint32_t)pRegs[REG_RAX];
+   pRegs[REG_RAX] = 0;
+   pRegs[REG_RIP] += length;
+
+   return TRUE;
+}
+
+static uint32_t host_sim_bitband_read(uint32_t alias)
+{
+   uint32_t offset = alias - PERIPH_BB_BASE;
+   uint32_t word = PERIPH_BASE + ((offset / 32) & ~3UL);
+
+   return (*(volatile uint32_t *)(uintptr_t)word >> ((offset / 4) % 32)) & 1;
+}
+
+static void host_sim_bitband_write(uint32_t alias, uint32_t bit)
+{
+   uint32_t offset = alias - PERIPH_BB_BASE;
+   uint32_t word = PERIPH_BASE + ((offset / 32) & ~3UL);
+   uint32_t mask = 1UL << ((offset / 4) % 32);
+   volatile uint32_t *p = (volatile uint32_t *)HostSim_PeriphAlias((volatile void *)(uintptr_t)word);
+   uint32_t oldValue = *p;
+
+   *p = (0 != bit) ? (oldValue | mask) : (oldValue & ~mask);
+
+   if ((word >= HOST_SIM_GPIO_PAGES_BASE) && (word < (HOST_SIM_GPIO_PAGES_BASE + HOST_SIM_GPIO_PAGES_SIZE)))
+   {
+      HostGpio_Write(word, oldValue, *p);
+      HostGpio_Update();
+   }
+}
+
+static void host_sim_sync(void)
+{
+   // DWT cycle counter written by the firmware
+   if (DWT->CYCCNT != hostSim.cyccntLast)
+      hostSim.cyccntOrigin = hostSim.now - DWT->CYCCNT;
+
+   HostPeriph_Sync(hostSim.now);
+}
+
+static void host_sim_commit(void)
+{
+   if (0 != (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+   {
+      hostSim.cyccntLast = (uint32_t)(hostSim.now - hostSim.cyccntOrigin);
+      DWT->CYCCNT = hostSim.cyccntLast;
+   }
+   else
+   {
+      hostSim.cyccntOrigin = hostSim.now - DWT->CYCCNT;
+   }
+
+   HostPeriph_Commit(hostSim.now);
+}
+
+static uint64_t host_sim_next_event(void)
+{
+   uint64_t next = HostPeriph_NextEvent(hostSim.now);
+
+   for (HostSimProcessType *p = hostSim.pProcesses; NULL != p; p = p->pNext)
+   {
+      if (p->next < next)
+         next = p->next;
+   }
+
+   return (hostSim.limit < next) ? hostSim.limit : next;
+}
+
+static void host_sim_run_until(uint64_t target)
+{
+   host_sim_sync();
+   host_sim_dispatch();
+
+   for (;;)
+   {
+      uint64_t next = host_sim_next_event();
+
+      if (next > target)
+         break;
+
+      // nested calls from handlers never move the time backwards
+      if (next > hostSim.now)
+         hostSim.now = next;
+      if (hostSim.now >= hostSim.limit)
+         exit(EXIT_SUCCESS);
+      host_sim_spin_guard();
+
+      hostSim.processing = TRUE;
+      HostPeriph_Process(hostSim.now);
+      for (HostSimProcessType *p = hostSim.pProcesses; NULL != p; p = p->pNext)
+      {
+         while (p->next <= hostSim.now)
+         {
+            p->run(hostSim.now, p->pUserData);
+            p->next += (0 != p->period) ? p->period : HOST_SIM_NO_EVENT - p->next;
+         }
+      }
+      hostSim.processing = FALSE;
+
+      host_sim_dispatch();
+   }
+
+   if (target > hostSim.now)
+      hostSim.now = target;
+   host_sim_commit();
+}
+
+static void host_sim_spin_guard(void)
+{
+   if (hostSim.now != hostSim.spinTime)
+   {
+      hostSim.spinTime = hostSim.now;
+      hostSim.spinCount = 0;
+   }
+   else if (++hostSim.spinCount > HOST_SIM_STORM_LIMIT)
+   {
+      int32_t index = host_sim_pending(TRUE);
+
+      HostSim_Fatal("simulation stalled, interrupt storm on IRQn %d", (int)(index - 16));
+   }
+}
+
+static bool host_sim_is_pending(uint32_t index)
+{
+   if (FALSE != hostSim.latched[index])
+      return TRUE;
+
+   return (index >= 16) && (FALSE != HostPeriph_IrqLevel((IRQn_Type)(index - 16)));
+}
+
+static uint32_t host_sim_preempt_priority(uint32_t index)
+{
+   uint32_t prigroup = (SCB->AIRCR & SCB_AIRCR_PRIGROUP_Msk) >> SCB_AIRCR_PRIGROUP_Pos;
+
+   return ((uint32_t)hostSim.priority[index] << (8 - __NVIC_PRIO_BITS)) >> (prigroup + 1);
+}
+
+static int32_t host_sim_pending(bool ignoreMask)
+{
+   int32_t best = -1;
+
+   for (uint32_t index = 1; index < HOST_SIM_VECTORS; index++)
+   {
+      // device interrupts need to be enabled, system exceptions always are
+      if (((index >= 16) && (FALSE == hostSim.enabled[index])) || (FALSE != hostSim.active[index]) ||
+          (FALSE == host_sim_is_pending(index)))
+      {
+         continue;
+      }
+
+      // lowest priority value wins, ties are resolved by the exception number
+      if ((best < 0) || (hostSim.priority[index] < hostSim.priority[best]))
+         best = (int32_t)index;
+   }
+
+   if ((best < 0) || (FALSE != ignoreMask))
+      return best;
+
+   if ((0 != hostSim.primask) || (host_sim_preempt_priority((uint32_t)best) >= hostSim.executionPriority))
+      return -1;
+
+   return best;
+}
+
+static void host_sim_dispatch(void)
+{
+   int32_t index;
+
+   while ((index = host_sim_pending(FALSE)) >= 0)
+   {
+      uint32_t savedPriority = hostSim.executionPriority;
+
+      host_sim_spin_guard();
+      if (NULL == HostSim_Vectors[index])
+         HostSim_Fatal("no handler for exception %d", (int)index);
+
+      hostSim.latched[index] = FALSE;
+      hostSim.active[index] = TRUE;
+      hostSim.executionPriority = host_sim_preempt_priority((uint32_t)index);
+      hostSim.depth++;
+      hostSim.dispatches++;
+
+      host_sim_commit();
+      HostSim_Vectors[index]();
+      host_sim_sync();
+
+      hostSim.depth--;
+      hostSim.executionPriority = savedPriority;
+      hostSim.active[index] = FALSE;
+   }
+}
+
+static void host_sim_firmware_entry(void)
+{
+   SystemInit();
+   HostSim_FirmwareMain();
+
+   HostSim_Fatal("firmware main returned");
+}
+
+static void host_sim_report(void)
+{
+   struct timespec wallEnd;
+   double wall, virtualTime;
+
+   clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+   wall = (double)(wallEnd.tv_sec - hostSim.wallStart.tv_sec) +
+          (double)(wallEnd.tv_nsec - hostSim.wallStart.tv_nsec) / 1e9;
+   virtualTime = (double)hostSim.now / (double)HOST_SIM_CORE_CLOCK_HZ;
+
+   fflush(stdout);
+   fprintf(stderr, "host_sim: %.3f s simulated in %.3f s (x%.1f)\n", virtualTime, wall,
+           (wall > 0.0) ? virtualTime / wall : 0.0);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,661 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_tim.c
+//!
+//!   \brief      Host simulation timers model: TIM1 to TIM4 time base,
+//!               output compare and input capture in up-counting mode,
+//!               and the Cortex SysTick.
+//!
+//!               Counters are not stepped. Each running counter keeps
+//!               the virtual time and counter value of its last update
+//!               event, so the value at any instant and the time of the
+//!               next update or compare match are computed directly.
+//!               Compare matches are only scheduled for the channels
+//!               somebody listens to (interrupt, DMA or ADC trigger).
+//!               Input capture takes the edges of the default (not
+//!               remapped) pins from the GPIO model, without the input
+//!               filter and prescaler.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_TIM_CHANNELS        (4)
+#define HOST_TIM_CC_MASK(ch)     (TIM_SR_CC1IF << (ch))
+
+#define HOST_TIM_NO_DMA          (0)
+
+// ADC1 external trigger selection (EXTSEL) codes
+#define HOST_ADC_EXTSEL_TIM1_CC1    (0)
+#define HOST_ADC_EXTSEL_TIM1_CC2    (1)
+#define HOST_ADC_EXTSEL_TIM1_CC3    (2)
+#define HOST_ADC_EXTSEL_TIM2_CC2    (3)
+#define HOST_ADC_EXTSEL_TIM3_TRGO   (4)
+#define HOST_ADC_EXTSEL_TIM4_CC4    (5)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_tim_tag
+{
+   TIM_TypeDef *regs;
+   uint8_t apb;            // APB bus the timer is clocked from
+   bool running;
+   uint64_t origin;        // virtual time at which the counter was cnt0
+   uint64_t done;          // events up to this time have been processed
+   uint32_t cnt0;          // counter value at origin
+   uint32_t psc;           // active (preloaded) prescaler
+   uint32_t arr;           // active (preloaded) auto reload
+   uint32_t lastCnt;       // counter value last published
+   uint32_t lastArr;       // ARR register value last seen
+} HostTimType;
+
+typedef struct host_systick_tag
+{
+   bool running;
+   uint64_t origin;        // virtual time of the last reload
+   uint64_t period;        // core cycles between reloads
+   uint32_t lastVal;       // VAL value last published
+} HostSysTickType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static uint64_t host_tim_tick(const HostTimType *pTim);
+static uint32_t host_tim_count(const HostTimType *pTim, uint64_t now);
+static uint32_t host_tim_listened_channels(const HostTimType *pTim);
+static uint64_t host_tim_next_event(const HostTimType *pTim, uint32_t *pEvents);
+static void host_tim_rebase(HostTimType *pTim, uint64_t now);
+static void host_tim_compare_match(HostTimType *pTim, uint32_t channel, uint64_t now);
+static void host_tim_update_event(HostTimType *pTim, uint64_t now);
+static void host_tim_trgo(HostTimType *pTim, uint32_t mms, uint64_t now);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostTimType hostTim[] =
+{
+   { .regs = TIM1, .apb = 2 },
+   { .regs = TIM2, .apb = 1 },
+   { .regs = TIM3, .apb = 1 },
+   { .regs = TIM4, .apb = 1 },
+};
+
+static HostSysTickType hostSysTick;
+
+// timer channel inputs and their DMA request channel
+static const struct
+{
+   uint8_t tim;            // index in hostTim
+   uint8_t channel;
+   uint8_t port;           // 0 for GPIOA
+   uint16_t pin;
+   uint8_t dma;
+} hostTimInputs[] =
+{
+   { 0, 0, 0, GPIO_PIN_8,  2 },
+   { 0, 1, 0, GPIO_PIN_9,  3 },
+   { 0, 2, 0, GPIO_PIN_10, 6 },
+   { 0, 3, 0, GPIO_PIN_11, 4 },
+   { 1, 0, 0, GPIO_PIN_0,  5 },
+   { 1, 1, 0, GPIO_PIN_1,  7 },
+   { 1, 2, 0, GPIO_PIN_2,  1 },
+   { 1, 3, 0, GPIO_PIN_3,  7 },
+   { 2, 0, 0, GPIO_PIN_6,  6 },
+   { 2, 1, 0, GPIO_PIN_7,  HOST_TIM_NO_DMA },
+   { 2, 2, 1, GPIO_PIN_0,  2 },
+   { 2, 3, 1, GPIO_PIN_1,  3 },
+   { 3, 0, 1, GPIO_PIN_6,  1 },
+   { 3, 1, 1, GPIO_PIN_7,  4 },
+   { 3, 2, 1, GPIO_PIN_8,  5 },
+   { 3, 3, 1, GPIO_PIN_9,  HOST_TIM_NO_DMA },
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostTim_Init(void)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostTim); i++)
+   {
+      HostTimType *pTim = &hostTim[i];
+
+      pTim->running = FALSE;
+      pTim->origin = 0;
+      pTim->done = 0;
+      pTim->cnt0 = 0;
+      pTim->psc = 0;
+      pTim->arr = 0xFFFF;
+      pTim->lastCnt = 0;
+      pTim->lastArr = 0xFFFF;
+      pTim->regs->ARR = 0xFFFF;
+   }
+}
+
+void HostTim_Sync(uint64_t now)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostTim); i++)
+   {
+      HostTimType *pTim = &hostTim[i];
+      TIM_TypeDef *regs = pTim->regs;
+
+      // update generation: reinitialize the counter and load the preload registers
+      if (0 != (regs->EGR & TIM_EGR_UG))
+      {
+         regs->EGR = 0;
+         pTim->psc = regs->PSC;
+         pTim->arr = regs->ARR;
+         pTim->lastArr = regs->ARR;
+         pTim->cnt0 = 0;
+         pTim->origin = now;
+         pTim->done = now;
+         pTim->lastCnt = 0;
+         regs->CNT = 0;
+         if (0 == (regs->CR1 & TIM_CR1_URS))
+            regs->SR |= TIM_SR_UIF;
+      }
+      // other event generation bits just set the matching flags
+      if (0 != regs->EGR)
+      {
+         regs->SR |= regs->EGR & (TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF | TIM_SR_CC4IF | TIM_SR_TIF);
+         regs->EGR = 0;
+      }
+
+      // counter written by software
+      if ((regs->CNT & 0xFFFF) != pTim->lastCnt)
+      {
+         pTim->cnt0 = regs->CNT & 0xFFFF;
+         pTim->origin = now;
+         pTim->done = now;
+         pTim->lastCnt = pTim->cnt0;
+      }
+
+      // auto reload written by software without preload takes effect immediately
+      if (regs->ARR != pTim->lastArr)
+      {
+         pTim->lastArr = regs->ARR;
+         if (0 == (regs->CR1 & TIM_CR1_ARPE))
+         {
+            host_tim_rebase(pTim, now);
+            pTim->arr = regs->ARR;
+         }
+      }
+
+      if ((FALSE == pTim->running) && (0 != (regs->CR1 & TIM_CR1_CEN)))
+      {
+         pTim->running = TRUE;
+         pTim->origin = now;
+         pTim->done = now;
+         pTim->cnt0 = regs->CNT & 0xFFFF;
+      }
+      else if ((FALSE != pTim->running) && (0 == (regs->CR1 & TIM_CR1_CEN)))
+      {
+         pTim->cnt0 = host_tim_count(pTim, now);
+         pTim->running = FALSE;
+         pTim->lastCnt = pTim->cnt0;
+         regs->CNT = pTim->cnt0;
+      }
+   }
+}
+
+uint64_t HostTim_NextEvent(uint64_t now)
+{
+   uint64_t next = HOST_SIM_NO_EVENT;
+   uint64_t event;
+   uint32_t events;
+
+   for (uint32_t i = 0; i < Num_Elems(hostTim); i++)
+   {
+      event = host_tim_next_event(&hostTim[i], &events);
+      if (event < next)
+         next = event;
+   }
+
+   return next;
+}
+
+void HostTim_Process(uint64_t now)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostTim); i++)
+   {
+      HostTimType *pTim = &hostTim[i];
+      uint64_t event;
+      uint32_t events;
+
+      for (;;)
+      {
+         event = host_tim_next_event(pTim, &events);
+         if (event > now)
+            break;
+
+         pTim->done = event;
+         for (uint32_t ch = 0; ch < HOST_TIM_CHANNELS; ch++)
+         {
+            if (0 != (events & HOST_TIM_CC_MASK(ch)))
+               host_tim_compare_match(pTim, ch, event);
+         }
+         if (0 != (events & TIM_SR_UIF))
+            host_tim_update_event(pTim, event);
+      }
+      pTim->done = now;
+   }
+}
+
+void HostTim_Commit(uint64_t now)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostTim); i++)
+   {
+      HostTimType *pTim = &hostTim[i];
+
+      if (FALSE != pTim->running)
+      {
+         pTim->lastCnt = host_tim_count(pTim, now);
+         pTim->regs->CNT = pTim->lastCnt;
+      }
+   }
+}
+
+void HostTim_Capture(uint32_t port, uint16_t rising, uint16_t falling, uint64_t now)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostTimInputs); i++)
+   {
+      HostTimType *pTim = &hostTim[hostTimInputs[i].tim];
+      TIM_TypeDef *regs = pTim->regs;
+      uint32_t ch = hostTimInputs[i].channel;
+      uint32_t ccmr = ((ch < 2) ? regs->CCMR1 : regs->CCMR2) >> (8 * (ch % 2));
+      uint32_t ccer = regs->CCER >> (4 * ch);
+      uint16_t edges;
+
+      if ((port != hostTimInputs[i].port) || (1 != (ccmr & TIM_CCMR1_CC1S)) || (0 == (ccer & TIM_CCER_CC1E)))
+         continue;
+
+      edges = (0 != (ccer & TIM_CCER_CC1P)) ? falling : rising;
+      if (0 == (edges & hostTimInputs[i].pin))
+         continue;
+
+      (&regs->CCR1)[ch] = host_tim_count(pTim, now);
+      if (0 != (regs->SR & HOST_TIM_CC_MASK(ch)))
+         regs->SR |= TIM_SR_CC1OF << ch;
+      regs->SR |= HOST_TIM_CC_MASK(ch);
+
+      // the DMA reads the capture, which clears the flag
+      if ((0 != (regs->DIER & (TIM_DIER_CC1DE << ch))) && (FALSE != HostDma_Request(hostTimInputs[i].dma)))
+         regs->SR &= ~HOST_TIM_CC_MASK(ch);
+   }
+}
+
+bool HostTim_IrqLevel(IRQn_Type irq)
+{
+   TIM_TypeDef *regs;
+   uint32_t mask;
+
+   switch (irq)
+   {
+   case TIM1_UP_IRQn:
+      regs = TIM1;
+      mask = TIM_SR_UIF;
+      break;
+   case TIM1_CC_IRQn:
+      regs = TIM1;
+      mask = TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF | TIM_SR_CC4IF;
+      break;
+   case TIM2_IRQn:
+      regs = TIM2;
+      mask = TIM_SR_UIF | TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF | TIM_SR_CC4IF | TIM_SR_TIF;
+      break;
+   case TIM3_IRQn:
+      regs = TIM3;
+      mask = TIM_SR_UIF | TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF | TIM_SR_CC4IF | TIM_SR_TIF;
+      break;
+   case TIM4_IRQn:
+      regs = TIM4;
+      mask = TIM_SR_UIF | TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC3IF | TIM_SR_CC4IF | TIM_SR_TIF;
+      break;
+   default:
+      return FALSE;
+   }
+
+   // interrupt enable bits in DIER match the flag positions in SR
+   return (0 != (regs->SR & regs->DIER & mask));
+}
+
+void HostSysTick_Init(void)
+{
+   hostSysTick.running = FALSE;
+   hostSysTick.origin = 0;
+   hostSysTick.period = 0;
+   hostSysTick.lastVal = 0;
+}
+
+void HostSysTick_Sync(uint64_t now)
+{
+   if ((FALSE == hostSysTick.running) && (0 != (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)))
+   {
+      hostSysTick.running = TRUE;
+      hostSysTick.origin = now;
+      hostSysTick.period = (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1;
+      if (0 == (SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk))
+         hostSysTick.period *= 8;
+   }
+   else if ((FALSE != hostSysTick.running) && (0 == (SysTick->CTRL & SysTick_CTRL_ENABLE_Msk)))
+   {
+      hostSysTick.running = FALSE;
+   }
+   else if ((FALSE != hostSysTick.running) && (SysTick->VAL != hostSysTick.lastVal))
+   {
+      // any write to VAL clears the counter
+      hostSysTick.origin = now;
+      hostSysTick.lastVal = 0;
+      SysTick->VAL = 0;
+   }
+}
+
+uint64_t HostSysTick_NextEvent(uint64_t now)
+{
+   if (FALSE == hostSysTick.running)
+      return HOST_SIM_NO_EVENT;
+
+   return hostSysTick.origin + hostSysTick.period;
+}
+
+void HostSysTick_Process(uint64_t now)
+{
+   while ((FALSE != hostSysTick.running) && ((hostSysTick.origin + hostSysTick.period) <= now))
+   {
+      hostSysTick.origin += hostSysTick.period;
+      hostSysTick.period = (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) + 1;
+      if (0 == (SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk))
+         hostSysTick.period *= 8;
+
+      SysTick->CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+      if (0 != (SysTick->CTRL & SysTick_CTRL_TICKINT_Msk))
+         NVIC_SetPendingIRQ(SysTick_IRQn);
+   }
+}
+
+void HostSysTick_Commit(uint64_t now)
+{
+   uint64_t elapsed;
+
+   if (FALSE == hostSysTick.running)
+      return;
+
+   elapsed = now - hostSysTick.origin;
+   if (0 == (SysTick->CTRL & SysTick_CTRL_CLKSOURCE_Msk))
+      elapsed /= 8;
+
+   hostSysTick.lastVal = (SysTick->LOAD & SysTick_LOAD_RELOAD_Msk) - (uint32_t)elapsed;
+   SysTick->VAL = hostSysTick.lastVal;
+}
+
+// core cycles per counter tick
+static uint64_t host_tim_tick(const HostTimType *pTim)
+{
+   uint32_t apbDivider = HostRcc_GetApbDivider(pTim->apb);
+
+   // timer clock is twice the APB clock when the APB is divided
+   return (uint64_t)((1 == apbDivider) ? 1 : (apbDivider / 2)) * (pTim->psc + 1);
+}
+
+static uint32_t host_tim_count(const HostTimType *pTim, uint64_t now)
+{
+   uint64_t count;
+
+   if ((FALSE == pTim->running) || (now < pTim->origin))
+      return pTim->cnt0;
+
+   count = pTim->cnt0 + (now - pTim->origin) / host_tim_tick(pTim);
+
+   return (uint32_t)(count % ((uint64_t)pTim->arr + 1));
+}
+
+static uint32_t host_tim_listened_channels(const HostTimType *pTim)
+{
+   TIM_TypeDef *regs = pTim->regs;
+   uint32_t channels;
+   int32_t extsel;
+
+   // interrupt and DMA enables
+   channels = regs->DIER & (TIM_DIER_CC1IE | TIM_DIER_CC2IE | TIM_DIER_CC3IE | TIM_DIER_CC4IE);
+   channels |= (regs->DIER >> (TIM_DIER_CC1DE_Pos - TIM_DIER_CC1IE_Pos)) &
+               (TIM_DIER_CC1IE | TIM_DIER_CC2IE | TIM_DIER_CC3IE | TIM_DIER_CC4IE);
+
+   // input capture channels never match
+   for (uint32_t ch = 0; ch < HOST_TIM_CHANNELS; ch++)
+   {
+      uint32_t ccmr = ((ch < 2) ? regs->CCMR1 : regs->CCMR2) >> (8 * (ch % 2));
+
+      if (0 != (ccmr & TIM_CCMR1_CC1S))
+         channels &= ~HOST_TIM_CC_MASK(ch);
+   }
+
+   // ADC external trigger
+   extsel = HostAdc_GetExternalTrigger();
+   if (TIM1 == regs)
+   {
+      if (HOST_ADC_EXTSEL_TIM1_CC1 == extsel)
+         channels |= TIM_SR_CC1IF;
+      else if (HOST_ADC_EXTSEL_TIM1_CC2 == extsel)
+         channels |= TIM_SR_CC2IF;
+      else if (HOST_ADC_EXTSEL_TIM1_CC3 == extsel)
+         channels |= TIM_SR_CC3IF;
+   }
+   else if ((TIM2 == regs) && (HOST_ADC_EXTSEL_TIM2_CC2 == extsel))
+   {
+      channels |= TIM_SR_CC2IF;
+   }
+   else if ((TIM3 == regs) && (HOST_ADC_EXTSEL_TIM3_TRGO == extsel))
+   {
+      uint32_t mms = (regs->CR2 & TIM_CR2_MMS) >> TIM_CR2_MMS_Pos;
+
+      // compare pulse and OCxREF master modes
+      if ((3 == mms) || (4 == mms))
+         channels |= TIM_SR_CC1IF;
+      else if (mms >= 5)
+         channels |= HOST_TIM_CC_MASK(mms - 4);
+   }
+   else if ((TIM4 == regs) && (HOST_ADC_EXTSEL_TIM4_CC4 == extsel))
+   {
+      channels |= TIM_SR_CC4IF;
+   }
+
+   return channels;
+}
+
+static uint64_t host_tim_next_event(const HostTimType *pTim, uint32_t *pEvents)
+{
+   TIM_TypeDef *regs = pTim->regs;
+   uint64_t tick;
+   uint64_t next;
+   uint64_t event;
+   uint32_t channels;
+
+   *pEvents = 0;
+   if (FALSE == pTim->running)
+      return HOST_SIM_NO_EVENT;
+
+   tick = host_tim_tick(pTim);
+
+   // overflow
+   if (pTim->cnt0 <= pTim->arr)
+      next = pTim->origin + ((uint64_t)pTim->arr + 1 - pTim->cnt0) * tick;
+   else
+      next = pTim->origin + (0x10000ULL - pTim->cnt0) * tick;
+   *pEvents = TIM_SR_UIF;
+
+   // compare matches within the current period
+   channels = host_tim_listened_channels(pTim);
+   for (uint32_t ch = 0; ch < HOST_TIM_CHANNELS; ch++)
+   {
+      uint32_t ccr;
+
+      if (0 == (channels & HOST_TIM_CC_MASK(ch)))
+         continue;
+
+      ccr = (&regs->CCR1)[ch] & 0xFFFF;
+      if ((ccr < pTim->cnt0) || (ccr > pTim->arr))
+         continue;
+
+      event = pTim->origin + (uint64_t)(ccr - pTim->cnt0) * tick;
+      if (event <= pTim->done)
+         continue;
+
+      if (event < next)
+      {
+         next = event;
+         *pEvents = HOST_TIM_CC_MASK(ch);
+      }
+      else if (event == next)
+      {
+         *pEvents |= HOST_TIM_CC_MASK(ch);
+      }
+   }
+
+   return next;
+}
+
+static void host_tim_rebase(HostTimType *pTim, uint64_t now)
+{
+   uint64_t tick;
+
+   if ((FALSE == pTim->running) || (now < pTim->origin))
+      return;
+
+   tick = host_tim_tick(pTim);
+   pTim->cnt0 = host_tim_count(pTim, now);
+   pTim->origin = now - ((now - pTim->origin) % tick);
+}
+
+static void host_tim_compare_match(HostTimType *pTim, uint32_t channel, uint64_t now)
+{
+   TIM_TypeDef *regs = pTim->regs;
+   uint32_t mms = (regs->CR2 & TIM_CR2_MMS) >> TIM_CR2_MMS_Pos;
+
+   regs->SR |= HOST_TIM_CC_MASK(channel);
+
+   if (TIM1 == regs)
+   {
+      if (channel <= 2)
+         HostAdc_Trigger(HOST_ADC_EXTSEL_TIM1_CC1 + channel, now);
+   }
+   else if ((TIM2 == regs) && (1 == channel))
+   {
+      HostAdc_Trigger(HOST_ADC_EXTSEL_TIM2_CC2, now);
+   }
+   else if ((TIM4 == regs) && (3 == channel))
+   {
+      HostAdc_Trigger(HOST_ADC_EXTSEL_TIM4_CC4, now);
+   }
+
+   if ((((3 == mms) || (4 == mms)) && (0 == channel)) || ((mms >= 5) && ((mms - 4) == channel)))
+      host_tim_trgo(pTim, mms, now);
+}
+
+static void host_tim_update_event(HostTimType *pTim, uint64_t now)
+{
+   TIM_TypeDef *regs = pTim->regs;
+
+   pTim->origin = now;
+   pTim->cnt0 = 0;
+   pTim->psc = regs->PSC;
+   pTim->arr = regs->ARR;
+   pTim->lastArr = regs->ARR;
+
+   if (0 == (regs->CR1 & TIM_CR1_UDIS))
+      regs->SR |= TIM_SR_UIF;
+
+   if (2 == ((regs->CR2 & TIM_CR2_MMS) >> TIM_CR2_MMS_Pos))
+      host_tim_trgo(pTim, 2, now);
+
+   // compare values of zero match as the counter restarts
+   for (uint32_t ch = 0; ch < HOST_TIM_CHANNELS; ch++)
+   {
+      if ((0 != (host_tim_listened_channels(pTim) & HOST_TIM_CC_MASK(ch))) &&
+          (0 == ((&regs->CCR1)[ch] & 0xFFFF)))
+      {
+         host_tim_compare_match(pTim, ch, now);
+      }
+   }
+
+   // one pulse mode stops the counter at the update event
+   if (0 != (regs->CR1 & TIM_CR1_OPM))
+   {
+      regs->CR1 &= ~TIM_CR1_CEN;
+      pTim->running = FALSE;
+      pTim->lastCnt = 0;
+      regs->CNT = 0;
+   }
+}
+
+static void host_tim_trgo(HostTimType *pTim, uint32_t mms, uint64_t now)
+{
+   if (TIM3 == pTim->regs)
+      HostAdc_Trigger(HOST_ADC_EXTSEL_TIM3_TRGO, now);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
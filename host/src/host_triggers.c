@@ -0,0 +1,376 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_triggers.c
+//!
+//!   \brief      Host stress check of the ADC trigger table. The driver
+//!               runs on the simulated board with its input overridden,
+//!               and every register, unregister, reset and update call
+//!               is single stepped: the time advances a sample period
+//!               between every instruction, so the DMA block interrupt
+//!               evaluates the table at every point the main loop can be
+//!               stopped.
+//!
+//!               Every round raises two steady triggers, registers a
+//!               churned trigger into the lowest free slot, removes it and
+//!               reuses its slot with a trigger that can never be raised,
+//!               and now and then removes and registers a steady trigger
+//!               again. A raise must reach the main loop exactly once, the
+//!               reused slot must never fire and the uuids must not move.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "board_hw_config.h"
+#include "profiler_api.h"
+#include "trace_api.h"
+#include "clock_drv_api.h"
+#include "adc_drv_api.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_triggers.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_TRIGGERS_CHANNEL       (AIN_CH2)
+#define HOST_TRIGGERS_LOW           (400)    // raw conversion, under the release level
+#define HOST_TRIGGERS_HIGH          (3600)   // raw conversion, over the threshold
+#define HOST_TRIGGERS_THRESHOLD     (500)    // channel units
+#define HOST_TRIGGERS_HYSTERESIS    (100)
+#define HOST_TRIGGERS_NEVER         (1155)   // top of the channel range, never exceeded
+#define HOST_TRIGGERS_LATCH         (1300)   // hysteresis past the bottom of the range, never released
+#define HOST_TRIGGERS_DEBOUNCE      (2)
+#define HOST_TRIGGERS_SETTLE_BLOCKS (100)    // the filtered input settles well within
+#define HOST_TRIGGERS_RENEW_ROUNDS  (4)      // a steady trigger is registered again every
+#define HOST_TRIGGERS_MAX_REPORTS   (10)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef enum host_triggers_id_tag
+{
+   HOST_TRIGGERS_STEADY_0,
+   HOST_TRIGGERS_STEADY_1,
+   HOST_TRIGGERS_CHURNED,
+   HOST_TRIGGERS_NEVER_RAISED,
+   HOST_TRIGGERS_NUM,
+} HostTriggersIdType;
+
+typedef struct host_triggers_record_tag
+{
+   ADCDrvTriggerConfType conf;
+   const char *pName;
+   bool registered;
+   uint32_t uuid;                // slot it was registered into
+   uint32_t fired;               // callbacks in the current phase
+} HostTriggersRecordType;
+
+typedef struct host_triggers_tag
+{
+   HostTriggersRecordType records[HOST_TRIGGERS_NUM];
+   bool used[ADC_DRV_MAX_TRIGGERS];  // model of the driver slots
+   uint32_t blocks;              // DMA blocks taken
+   uint32_t steppedBlocks;       // DMA blocks taken between instructions
+   uint32_t raises;
+   uint32_t lost;
+   uint32_t stale;
+   uint32_t uuidErrors;
+   uint32_t reports;
+   FILE *pReport;
+} HostTriggersType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+extern void ADCDrv_DbgOverrideChannel(ADCDrvChType ch, int32_t value);
+
+static void host_triggers_init_record(HostTriggersIdType id, const char *pName, int32_t threshold, int32_t hysteresis);
+static void host_triggers_block(void);
+static void host_triggers_step(void);
+static void host_triggers_settle(void);
+static void host_triggers_register(uint32_t round, HostTriggersIdType id);
+static void host_triggers_unregister(uint32_t round, HostTriggersIdType id);
+static void host_triggers_reset(HostTriggersIdType id);
+static void host_triggers_update(void);
+static void host_triggers_expect(uint32_t round, const char *pPhase, const uint32_t *pExpected);
+static void host_triggers_event(ADCDrvTriggerConfType *trigger, int32_t value);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostTriggersType hostTriggers;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType HostTriggers_Check(FILE *pReport)
+{
+   static const uint32_t none[HOST_TRIGGERS_NUM] = { 0 };
+   static const uint32_t raise[HOST_TRIGGERS_NUM] = { 1, 1, 1, 0 };
+
+   hostTriggers.pReport = pReport;
+   host_triggers_init_record(HOST_TRIGGERS_STEADY_0, "steady 0", HOST_TRIGGERS_THRESHOLD, HOST_TRIGGERS_HYSTERESIS);
+   host_triggers_init_record(HOST_TRIGGERS_STEADY_1, "steady 1", HOST_TRIGGERS_THRESHOLD, HOST_TRIGGERS_HYSTERESIS);
+   host_triggers_init_record(HOST_TRIGGERS_CHURNED, "churned", HOST_TRIGGERS_THRESHOLD, HOST_TRIGGERS_HYSTERESIS);
+
+   // a single evaluation with the thresholds of the previous owner of
+   // the slot latches it, so the main loop sees it
+   host_triggers_init_record(HOST_TRIGGERS_NEVER_RAISED, "never raised", HOST_TRIGGERS_NEVER, HOST_TRIGGERS_LATCH);
+
+   Profiler_Init();
+   Trace_Init();
+   Board_Init();
+   ClockDrv_Init();
+   if (E_OK != ADCDrv_Init())
+   {
+      fprintf(pReport, "host_triggers: ADC driver initialization failed\n");
+      return E_ERROR;
+   }
+
+   ADCDrv_DbgOverrideChannel(HOST_TRIGGERS_CHANNEL, HOST_TRIGGERS_LOW);
+   host_triggers_settle();
+   host_triggers_register(0, HOST_TRIGGERS_STEADY_0);
+   host_triggers_register(0, HOST_TRIGGERS_STEADY_1);
+
+   for (uint32_t round = 0; round < HOST_TRIGGERS_ROUNDS; round++)
+   {
+      uint32_t renew[HOST_TRIGGERS_NUM] = { 0 };
+      HostTriggersIdType renewed = (HostTriggersIdType)((round / HOST_TRIGGERS_RENEW_ROUNDS) % 2);
+
+      // the input crosses the threshold while the table is being edited
+      ADCDrv_DbgOverrideChannel(HOST_TRIGGERS_CHANNEL, HOST_TRIGGERS_HIGH);
+      host_triggers_reset(HOST_TRIGGERS_STEADY_0);
+      host_triggers_reset(HOST_TRIGGERS_STEADY_1);
+      host_triggers_register(round, HOST_TRIGGERS_CHURNED);
+      host_triggers_settle();
+      host_triggers_expect(round, "raise", raise);
+
+      // the slot of the churned trigger is reused, the compaction moves
+      // the entries behind a steady trigger removed from the table
+      host_triggers_unregister(round, HOST_TRIGGERS_CHURNED);
+      host_triggers_register(round, HOST_TRIGGERS_NEVER_RAISED);
+      if (0 == (round % HOST_TRIGGERS_RENEW_ROUNDS))
+      {
+         host_triggers_unregister(round, renewed);
+         host_triggers_register(round, renewed);
+         renew[renewed] = 1;
+      }
+      host_triggers_settle();
+      host_triggers_expect(round, "reuse", renew);
+
+      ADCDrv_DbgOverrideChannel(HOST_TRIGGERS_CHANNEL, HOST_TRIGGERS_LOW);
+      host_triggers_settle();
+      host_triggers_expect(round, "release", none);
+      host_triggers_unregister(round, HOST_TRIGGERS_NEVER_RAISED);
+   }
+
+   fprintf(pReport, "host_triggers: %u rounds, %u blocks, %u between instructions, %u raises, "
+                    "%u lost, %u stale, %u uuid errors\n",
+           HOST_TRIGGERS_ROUNDS, hostTriggers.blocks, hostTriggers.steppedBlocks, hostTriggers.raises,
+           hostTriggers.lost, hostTriggers.stale, hostTriggers.uuidErrors);
+
+   return ((0 == hostTriggers.lost) && (0 == hostTriggers.stale) && (0 == hostTriggers.uuidErrors)) ?
+          E_OK : E_ERROR;
+}
+
+static void host_triggers_init_record(HostTriggersIdType id, const char *pName, int32_t threshold, int32_t hysteresis)
+{
+   HostTriggersRecordType *pRecord = &hostTriggers.records[id];
+
+   pRecord->pName = pName;
+   pRecord->conf.channel = HOST_TRIGGERS_CHANNEL;
+   pRecord->conf.type = ADC_DRV_TRIGGER_TYPE_HIGHER_THAN;
+   pRecord->conf.threshold = threshold;
+   pRecord->conf.hysteresis = hysteresis;
+   pRecord->conf.debounce = HOST_TRIGGERS_DEBOUNCE;
+   pRecord->conf.triggerFnt = host_triggers_event;
+   pRecord->conf.pUserData = pRecord;
+}
+
+static void host_triggers_block(void)
+{
+   // the DMA completes a block every sample period
+   hostTriggers.blocks++;
+   HostSim_Advance(HOST_SIM_CORE_CLOCK_HZ / ADC_DRV_SAMPLE_RATE_HZ);
+}
+
+static void host_triggers_step(void)
+{
+   // the interrupt is only taken when the main loop has it enabled
+   if ((0 != HostSim_GetPRIMASK()) || (FALSE != HostSim_InISR()))
+      return;
+
+   hostTriggers.steppedBlocks++;
+   host_triggers_block();
+}
+
+static void host_triggers_settle(void)
+{
+   for (uint32_t i = 0; i < HOST_TRIGGERS_SETTLE_BLOCKS; i++)
+      host_triggers_block();
+
+   host_triggers_update();
+}
+
+static void host_triggers_register(uint32_t round, HostTriggersIdType id)
+{
+   HostTriggersRecordType *pRecord = &hostTriggers.records[id];
+   StatusType status;
+   uint32_t slot;
+
+   // the driver takes the lowest free slot
+   for (slot = 0; (slot < ADC_DRV_MAX_TRIGGERS) && (FALSE != hostTriggers.used[slot]); slot++);
+
+   pRecord->conf.uuid = UINT32_MAX;
+   HostSim_SetStepHandler(host_triggers_step);
+   status = ADCDrv_RegisterTrigger(&pRecord->conf);
+   HostSim_SetStepHandler(NULL);
+
+   if ((E_OK != status) || (pRecord->conf.uuid != slot))
+   {
+      hostTriggers.uuidErrors++;
+      if (hostTriggers.reports++ < HOST_TRIGGERS_MAX_REPORTS)
+         fprintf(hostTriggers.pReport, "host_triggers: round %u, %s registered into uuid %u, expected %u\n",
+                 round, pRecord->pName, pRecord->conf.uuid, slot);
+   }
+
+   hostTriggers.used[slot] = TRUE;
+   pRecord->uuid = slot;
+   pRecord->registered = TRUE;
+}
+
+static void host_triggers_unregister(uint32_t round, HostTriggersIdType id)
+{
+   HostTriggersRecordType *pRecord = &hostTriggers.records[id];
+   StatusType status;
+
+   HostSim_SetStepHandler(host_triggers_step);
+   status = ADCDrv_UnregisterTrigger(&pRecord->conf);
+   HostSim_SetStepHandler(NULL);
+
+   if ((E_OK != status) || (pRecord->conf.uuid != pRecord->uuid))
+   {
+      hostTriggers.uuidErrors++;
+      if (hostTriggers.reports++ < HOST_TRIGGERS_MAX_REPORTS)
+         fprintf(hostTriggers.pReport, "host_triggers: round %u, %s uuid %u not unregistered\n",
+                 round, pRecord->pName, pRecord->uuid);
+   }
+
+   hostTriggers.used[pRecord->uuid] = FALSE;
+   pRecord->registered = FALSE;
+}
+
+static void host_triggers_reset(HostTriggersIdType id)
+{
+   HostSim_SetStepHandler(host_triggers_step);
+   ADCDrv_ResetTrigger(&hostTriggers.records[id].conf);
+   HostSim_SetStepHandler(NULL);
+}
+
+static void host_triggers_update(void)
+{
+   HostSim_SetStepHandler(host_triggers_step);
+   ADCDrv_Update();
+   HostSim_SetStepHandler(NULL);
+}
+
+static void host_triggers_expect(uint32_t round, const char *pPhase, const uint32_t *pExpected)
+{
+   for (uint32_t i = 0; i < HOST_TRIGGERS_NUM; i++)
+   {
+      HostTriggersRecordType *pRecord = &hostTriggers.records[i];
+
+      // a raise not seen is lost, any other callback comes from a stale slot
+      if (pRecord->fired < pExpected[i])
+         hostTriggers.lost += pExpected[i] - pRecord->fired;
+      else if (pRecord->fired > pExpected[i])
+         hostTriggers.stale += pRecord->fired - pExpected[i];
+
+      if ((pRecord->fired != pExpected[i]) && (hostTriggers.reports++ < HOST_TRIGGERS_MAX_REPORTS))
+         fprintf(hostTriggers.pReport, "host_triggers: round %u, %s: %s fired %u times, expected %u\n",
+                 round, pPhase, pRecord->pName, pRecord->fired, pExpected[i]);
+
+      hostTriggers.raises += pRecord->fired;
+      pRecord->fired = 0;
+   }
+}
+
+static void host_triggers_event(ADCDrvTriggerConfType *trigger, int32_t value)
+{
+   HostTriggersRecordType *pRecord = (HostTriggersRecordType *)trigger->pUserData;
+
+   // the callback gets the configuration the trigger was registered with
+   if ((FALSE == pRecord->registered) || (trigger->uuid != pRecord->uuid))
+   {
+      hostTriggers.uuidErrors++;
+      if (hostTriggers.reports++ < HOST_TRIGGERS_MAX_REPORTS)
+         fprintf(hostTriggers.pReport, "host_triggers: %s fired with uuid %u, registered into %u\n",
+                 pRecord->pName, trigger->uuid, pRecord->uuid);
+   }
+
+   pRecord->fired++;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,350 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_usart.c
+//!
+//!   \brief      Host simulation USART1 to USART3 model. Frames take the
+//!               time given by the programmed baudrate. The transmitter
+//!               is fed through DMA and writes every frame to an output
+//!               stream. The receiver gets its frames from an input queue
+//!               filled by the host and raises IDLE one frame after the
+//!               last received byte. Polled transmission through DR is
+//!               not modeled.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_sim.h"
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_USART_RX_QUEUE_SIZE       (4096)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct host_usart_rx_tag
+{
+   uint64_t earliest;      // the byte can't start before this instant
+   uint8_t data;
+} HostUsartRxType;
+
+typedef struct host_usart_tag
+{
+   USART_TypeDef *regs;
+   uint8_t apb;
+   uint8_t txDmaChannel;
+   uint8_t rxDmaChannel;
+   FILE *pOutput;
+   bool shifting;          // transmit shift register busy
+   uint64_t txEnd;         // end of the frame being transmitted
+   uint8_t txData;
+   uint64_t rxLineFree;    // end of the last received frame
+   bool idlePending;
+   uint64_t idleAt;
+   HostUsartRxType rxQueue[HOST_USART_RX_QUEUE_SIZE];
+   uint32_t rxHead;
+   uint32_t rxTail;
+} HostUsartType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static HostUsartType *host_usart_get(USART_TypeDef *regs);
+static uint64_t host_usart_frame_cycles(const HostUsartType *pUsart);
+static bool host_usart_tx_ready(const HostUsartType *pUsart);
+static uint64_t host_usart_rx_next(const HostUsartType *pUsart);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static HostUsartType hostUsart[] =
+{
+   { .regs = USART1, .apb = 2, .txDmaChannel = 4, .rxDmaChannel = 5 },
+   { .regs = USART2, .apb = 1, .txDmaChannel = 7, .rxDmaChannel = 6 },
+   { .regs = USART3, .apb = 1, .txDmaChannel = 2, .rxDmaChannel = 3 },
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void HostSim_SetUsartOutput(USART_TypeDef *usart, FILE *pFile)
+{
+   HostUsartType *pUsart = host_usart_get(usart);
+
+   if (NULL != pUsart)
+      pUsart->pOutput = pFile;
+}
+
+StatusType HostSim_UsartInput(USART_TypeDef *usart, uint32_t atMs, const uint8_t *pData, uint32_t size)
+{
+   HostUsartType *pUsart = host_usart_get(usart);
+
+   if (NULL == pUsart)
+      return E_ERROR;
+
+   for (uint32_t i = 0; i < size; i++)
+   {
+      uint32_t next = (pUsart->rxTail + 1) % HOST_USART_RX_QUEUE_SIZE;
+
+      if (next == pUsart->rxHead)
+         return E_ERROR;
+
+      pUsart->rxQueue[pUsart->rxTail].earliest = HOST_SIM_MS_TO_CYCLES(atMs);
+      pUsart->rxQueue[pUsart->rxTail].data = pData[i];
+      pUsart->rxTail = next;
+   }
+
+   return E_OK;
+}
+
+void HostUsart_Init(void)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostUsart); i++)
+   {
+      hostUsart[i].shifting = FALSE;
+      hostUsart[i].idlePending = FALSE;
+      hostUsart[i].rxLineFree = 0;
+      hostUsart[i].regs->SR = USART_SR_TXE | USART_SR_TC;
+   }
+}
+
+void HostUsart_Sync(uint64_t now)
+{
+}
+
+uint64_t HostUsart_NextEvent(uint64_t now)
+{
+   uint64_t next = HOST_SIM_NO_EVENT;
+
+   for (uint32_t i = 0; i < Num_Elems(hostUsart); i++)
+   {
+      HostUsartType *pUsart = &hostUsart[i];
+      uint64_t event;
+
+      if (FALSE != pUsart->shifting)
+         event = pUsart->txEnd;
+      else if (FALSE != host_usart_tx_ready(pUsart))
+         event = now;
+      else
+         event = HOST_SIM_NO_EVENT;
+      if (event < next)
+         next = event;
+
+      event = host_usart_rx_next(pUsart);
+      if (event < next)
+         next = event;
+
+      if ((FALSE != pUsart->idlePending) && (pUsart->idleAt < next))
+         next = pUsart->idleAt;
+   }
+
+   return next;
+}
+
+void HostUsart_Process(uint64_t now)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostUsart); i++)
+   {
+      HostUsartType *pUsart = &hostUsart[i];
+      USART_TypeDef *regs = pUsart->regs;
+      uint64_t event;
+
+      // transmitter
+      if ((FALSE != pUsart->shifting) && (pUsart->txEnd <= now))
+      {
+         pUsart->shifting = FALSE;
+         if (NULL != pUsart->pOutput)
+            fputc(pUsart->txData, pUsart->pOutput);
+         if (FALSE == host_usart_tx_ready(pUsart))
+            regs->SR |= USART_SR_TC;
+      }
+      if ((FALSE == pUsart->shifting) && (FALSE != host_usart_tx_ready(pUsart)))
+      {
+         uint64_t start = (pUsart->txEnd > now) ? pUsart->txEnd : now;
+
+         HostDma_Request(pUsart->txDmaChannel);
+         pUsart->txData = (uint8_t)regs->DR;
+         pUsart->shifting = TRUE;
+         pUsart->txEnd = start + host_usart_frame_cycles(pUsart);
+         regs->SR = (regs->SR & ~USART_SR_TC) | USART_SR_TXE;
+      }
+
+      // receiver
+      while ((event = host_usart_rx_next(pUsart)) <= now)
+      {
+         uint8_t data = pUsart->rxQueue[pUsart->rxHead].data;
+
+         pUsart->rxHead = (pUsart->rxHead + 1) % HOST_USART_RX_QUEUE_SIZE;
+         pUsart->rxLineFree = event;
+
+         if ((0 == (regs->CR1 & USART_CR1_UE)) || (0 == (regs->CR1 & USART_CR1_RE)))
+            continue;
+
+         if (0 != (regs->SR & USART_SR_RXNE))
+            regs->SR |= USART_SR_ORE;
+         regs->DR = data;
+         regs->SR |= USART_SR_RXNE;
+
+         // reading DR through the DMA clears the receive flag
+         if ((0 != (regs->CR3 & USART_CR3_DMAR)) && (FALSE != HostDma_Request(pUsart->rxDmaChannel)))
+            regs->SR &= ~USART_SR_RXNE;
+
+         pUsart->idlePending = TRUE;
+         pUsart->idleAt = event + host_usart_frame_cycles(pUsart);
+      }
+
+      if ((FALSE != pUsart->idlePending) && (pUsart->idleAt <= now))
+      {
+         // a new frame restarts the idle detection
+         if (host_usart_rx_next(pUsart) > pUsart->idleAt)
+            regs->SR |= USART_SR_IDLE;
+         pUsart->idlePending = FALSE;
+      }
+   }
+}
+
+void HostUsart_Commit(uint64_t now)
+{
+}
+
+bool HostUsart_IrqLevel(IRQn_Type irq)
+{
+   USART_TypeDef *regs;
+   uint32_t sr, cr1;
+
+   if (USART1_IRQn == irq)
+      regs = USART1;
+   else if (USART2_IRQn == irq)
+      regs = USART2;
+   else if (USART3_IRQn == irq)
+      regs = USART3;
+   else
+      return FALSE;
+
+   sr = regs->SR;
+   cr1 = regs->CR1;
+
+   return ((0 != (sr & USART_SR_TXE)) && (0 != (cr1 & USART_CR1_TXEIE))) ||
+          ((0 != (sr & USART_SR_TC)) && (0 != (cr1 & USART_CR1_TCIE))) ||
+          ((0 != (sr & (USART_SR_RXNE | USART_SR_ORE))) && (0 != (cr1 & USART_CR1_RXNEIE))) ||
+          ((0 != (sr & USART_SR_IDLE)) && (0 != (cr1 & USART_CR1_IDLEIE))) ||
+          ((0 != (sr & USART_SR_PE)) && (0 != (cr1 & USART_CR1_PEIE))) ||
+          ((0 != (sr & (USART_SR_FE | USART_SR_NE | USART_SR_ORE))) && (0 != (regs->CR3 & USART_CR3_EIE)) &&
+           (0 != (regs->CR3 & USART_CR3_DMAR)));
+}
+
+static HostUsartType *host_usart_get(USART_TypeDef *regs)
+{
+   for (uint32_t i = 0; i < Num_Elems(hostUsart); i++)
+   {
+      if (regs == hostUsart[i].regs)
+         return &hostUsart[i];
+   }
+
+   return NULL;
+}
+
+static uint64_t host_usart_frame_cycles(const HostUsartType *pUsart)
+{
+   USART_TypeDef *regs = pUsart->regs;
+   uint32_t bits = 10;
+   uint32_t brr = regs->BRR & 0xFFFF;
+
+   if (0 != (regs->CR1 & USART_CR1_M))
+      bits++;
+   if (0 != (regs->CR2 & USART_CR2_STOP_1))
+      bits++;
+   if (0 == brr)
+      brr = 1;
+
+   // baudrate is the peripheral clock divided by BRR
+   return (uint64_t)bits * brr * HostRcc_GetApbDivider(pUsart->apb);
+}
+
+static bool host_usart_tx_ready(const HostUsartType *pUsart)
+{
+   USART_TypeDef *regs = pUsart->regs;
+
+   return (0 != (regs->CR1 & USART_CR1_UE)) && (0 != (regs->CR1 & USART_CR1_TE)) &&
+          (0 != (regs->CR3 & USART_CR3_DMAT)) && (FALSE != HostDma_Ready(pUsart->txDmaChannel));
+}
+
+static uint64_t host_usart_rx_next(const HostUsartType *pUsart)
+{
+   uint64_t start;
+
+   if (pUsart->rxHead == pUsart->rxTail)
+      return HOST_SIM_NO_EVENT;
+
+   start = pUsart->rxQueue[pUsart->rxHead].earliest;
+   if (pUsart->rxLineFree > start)
+      start = pUsart->rxLineFree;
+
+   return start + host_usart_frame_cycles(pUsart);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,216 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_vectors.c
+//!
+//!   \brief      Host simulation exception vector table. Mirrors the
+//!               table of startup_stm32f103xb.s: every handler not
+//!               defined by the firmware is a weak alias of a default
+//!               handler that stops the simulation.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_periph.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void host_vectors_default_handler(void);
+
+extern void NMI_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void HardFault_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void MemManage_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void BusFault_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void UsageFault_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void SVC_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void DebugMon_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void PendSV_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void SysTick_Handler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void WWDG_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void PVD_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void TAMPER_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void RTC_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void FLASH_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void RCC_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void EXTI0_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void EXTI1_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void EXTI2_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void EXTI3_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void EXTI4_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void DMA1_Channel1_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void DMA1_Channel2_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void DMA1_Channel3_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void DMA1_Channel4_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void DMA1_Channel5_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void DMA1_Channel6_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void DMA1_Channel7_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void ADC1_2_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void USB_HP_CAN1_TX_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void USB_LP_CAN1_RX0_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void CAN1_RX1_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void CAN1_SCE_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void EXTI9_5_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void TIM1_BRK_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void TIM1_UP_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void TIM1_TRG_COM_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void TIM1_CC_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void TIM2_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void TIM3_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void TIM4_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void I2C1_EV_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void I2C1_ER_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void I2C2_EV_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void I2C2_ER_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void SPI1_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void SPI2_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void USART1_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void USART2_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void USART3_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void EXTI15_10_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void RTC_Alarm_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+extern void USBWakeUp_IRQHandler(void) __attribute__((weak, alias("host_vectors_default_handler")));
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+void (* const HostSim_Vectors[HOST_SIM_VECTORS])(void) =
+{
+   NULL,                               // initial stack pointer
+   NULL,                               // Reset_Handler, the simulation starts at main
+   NMI_Handler,
+   HardFault_Handler,
+   MemManage_Handler,
+   BusFault_Handler,
+   UsageFault_Handler,
+   NULL,
+   NULL,
+   NULL,
+   NULL,
+   SVC_Handler,
+   DebugMon_Handler,
+   NULL,
+   PendSV_Handler,
+   SysTick_Handler,
+   WWDG_IRQHandler,
+   PVD_IRQHandler,
+   TAMPER_IRQHandler,
+   RTC_IRQHandler,
+   FLASH_IRQHandler,
+   RCC_IRQHandler,
+   EXTI0_IRQHandler,
+   EXTI1_IRQHandler,
+   EXTI2_IRQHandler,
+   EXTI3_IRQHandler,
+   EXTI4_IRQHandler,
+   DMA1_Channel1_IRQHandler,
+   DMA1_Channel2_IRQHandler,
+   DMA1_Channel3_IRQHandler,
+   DMA1_Channel4_IRQHandler,
+   DMA1_Channel5_IRQHandler,
+   DMA1_Channel6_IRQHandler,
+   DMA1_Channel7_IRQHandler,
+   ADC1_2_IRQHandler,
+   USB_HP_CAN1_TX_IRQHandler,
+   USB_LP_CAN1_RX0_IRQHandler,
+   CAN1_RX1_IRQHandler,
+   CAN1_SCE_IRQHandler,
+   EXTI9_5_IRQHandler,
+   TIM1_BRK_IRQHandler,
+   TIM1_UP_IRQHandler,
+   TIM1_TRG_COM_IRQHandler,
+   TIM1_CC_IRQHandler,
+   TIM2_IRQHandler,
+   TIM3_IRQHandler,
+   TIM4_IRQHandler,
+   I2C1_EV_IRQHandler,
+   I2C1_ER_IRQHandler,
+   I2C2_EV_IRQHandler,
+   I2C2_ER_IRQHandler,
+   SPI1_IRQHandler,
+   SPI2_IRQHandler,
+   USART1_IRQHandler,
+   USART2_IRQHandler,
+   USART3_IRQHandler,
+   EXTI15_10_IRQHandler,
+   RTC_Alarm_IRQHandler,
+   USBWakeUp_IRQHandler,
+};
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+static void host_vectors_default_handler(void)
+{
+   HostSim_Fatal("unexpected exception");
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
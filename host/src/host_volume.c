@@ -0,0 +1,223 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       host_volume.c
+//!
+//!   \brief      Host check of the resampled tidal volume to finger
+//!               angle table. Both conversions are compared with the
+//!               linear interpolation of VENTILATOR_MGR_VOL_DEG_TABLE
+//!               in double precision, over every angle step and every
+//!               milliliter from below the first point to past the
+//!               last one.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <math.h>
+#include "standard.h"
+#include "ventilator_manager_conf.h"
+#include "ventilator_manager_api.h"
+#include "ventilator_volume.h"
+
+//********************************************************************
+//! @addtogroup host_sim_imp
+//!   @{
+//********************************************************************
+#include "host_volume.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define HOST_VOLUME_ANGLE_ONE       (1L << VENTILATOR_MGR_ANGLE_SHIFT)
+#define HOST_VOLUME_MIN_ANGLE       (-2 * HOST_VOLUME_ANGLE_ONE)
+#define HOST_VOLUME_MAX_ANGLE       ((VENTILATOR_MGR_VOL_TABLE_POINTS + 4) * HOST_VOLUME_ANGLE_ONE)
+#define HOST_VOLUME_MAX_VOLUME      (1200)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct vol2deg_table_tag
+{
+   uint32_t volumeML;
+   uint32_t deg;
+} VolumeToDegType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static double host_volume_from_deg(double deg);
+static double host_volume_to_deg(double volume);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+static const VolumeToDegType volToDegTable[] = {
+#undef X
+#define X(a,b) {a, b},
+      VENTILATOR_MGR_VOL_DEG_TABLE
+};
+
+#define HOST_VOLUME_TABLE_SIZE      (sizeof(volToDegTable) / sizeof(volToDegTable[0]))
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType HostVolume_Check(FILE *pReport)
+{
+   uint32_t pointErrors = 0;
+   uint32_t notIncreasing = 0;
+   double maxVolError = 0, maxDegError = 0;
+   int32_t volErrorAt = 0;
+   uint32_t degErrorAt = 0;
+   uint32_t last;
+
+   if (E_OK != ventilator_volume_init())
+   {
+      fprintf(pReport, "host_volume: invalid volume table\n");
+      return E_ERROR;
+   }
+
+   // the source points are converted exactly
+   for (uint32_t i = 0; i < HOST_VOLUME_TABLE_SIZE; i++)
+   {
+      if ((ventilator_volume_from_deg(volToDegTable[i].deg * HOST_VOLUME_ANGLE_ONE) != volToDegTable[i].volumeML) ||
+          (ventilator_volume_to_deg(volToDegTable[i].volumeML) != volToDegTable[i].deg * HOST_VOLUME_ANGLE_ONE))
+      {
+         fprintf(pReport, "host_volume: point %lu ml %lu deg converts to %u ml %.3f deg\n",
+                 (unsigned long)volToDegTable[i].volumeML, (unsigned long)volToDegTable[i].deg,
+                 ventilator_volume_from_deg(volToDegTable[i].deg * HOST_VOLUME_ANGLE_ONE),
+                 (double)ventilator_volume_to_deg(volToDegTable[i].volumeML) / HOST_VOLUME_ANGLE_ONE);
+         pointErrors++;
+      }
+   }
+
+   // angle to volume, rounded to the nearest milliliter
+   last = 0;
+   for (int32_t angle = HOST_VOLUME_MIN_ANGLE; angle <= HOST_VOLUME_MAX_ANGLE; angle++)
+   {
+      uint32_t volume = ventilator_volume_from_deg(angle);
+      double ref = host_volume_from_deg((double)angle / HOST_VOLUME_ANGLE_ONE);
+      double error = fabs((double)volume - ((ref > 0) ? ref : 0));
+
+      if (volume < last)
+         notIncreasing++;
+      last = volume;
+      if (error > maxVolError)
+      {
+         maxVolError = error;
+         volErrorAt = angle;
+      }
+   }
+
+   // volume to angle, rounded down
+   last = 0;
+   for (uint32_t volume = 0; volume <= HOST_VOLUME_MAX_VOLUME; volume++)
+   {
+      uint32_t angle = ventilator_volume_to_deg(volume);
+      double ref = host_volume_to_deg(volume) * HOST_VOLUME_ANGLE_ONE;
+      double error = fabs((double)angle - ((ref > 0) ? floor(ref) : 0));
+
+      if (angle < last)
+         notIncreasing++;
+      last = angle;
+      if (error > maxDegError)
+      {
+         maxDegError = error;
+         degErrorAt = volume;
+      }
+   }
+
+   fprintf(pReport, "host_volume: %u points, %u wrong, %u decreasing steps\n",
+           (unsigned)HOST_VOLUME_TABLE_SIZE, pointErrors, notIncreasing);
+   fprintf(pReport, "host_volume: angle to volume max error %.3f ml at %.3f deg, volume to angle max error %.0f/%ld deg at %u ml\n",
+           maxVolError, (double)volErrorAt / HOST_VOLUME_ANGLE_ONE, maxDegError, HOST_VOLUME_ANGLE_ONE, degErrorAt);
+
+   return ((0 == pointErrors) && (0 == notIncreasing) &&
+           (maxVolError <= HOST_VOLUME_MAX_ERROR_ML) && (maxDegError <= HOST_VOLUME_MAX_ERROR_DEG)) ? E_OK : E_ERROR;
+}
+
+static double host_volume_from_deg(double deg)
+{
+   uint32_t i;
+
+   for (i = 1; i < (HOST_VOLUME_TABLE_SIZE - 1); i++)
+   {
+      if (volToDegTable[i].deg >= deg)
+         break;
+   }
+
+   return volToDegTable[i-1].volumeML + (deg - volToDegTable[i-1].deg) *
+          ((double)volToDegTable[i].volumeML - volToDegTable[i-1].volumeML) /
+          ((double)volToDegTable[i].deg - volToDegTable[i-1].deg);
+}
+
+static double host_volume_to_deg(double volume)
+{
+   uint32_t i;
+
+   for (i = 1; i < (HOST_VOLUME_TABLE_SIZE - 1); i++)
+   {
+      if (volToDegTable[i].volumeML >= volume)
+         break;
+   }
+
+   return volToDegTable[i-1].deg + (volume - volToDegTable[i-1].volumeML) *
+          ((double)volToDegTable[i].deg - volToDegTable[i-1].deg) /
+          ((double)volToDegTable[i].volumeML - volToDegTable[i-1].volumeML);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
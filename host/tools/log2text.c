@@ -0,0 +1,463 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       log2text.c
+//!
+//!   \brief      Converts the binary records of a debug log to text
+//!               lines, as the logger writes them with LOG_CONF_TEXT.
+//!
+//!               usage: log2text -e elf [-o file] [log]
+//!
+//!               -e  firmware ELF file the log comes from, holding the
+//!                   strings of every log line
+//!               -o  file receiving the text, default the standard
+//!                   output
+//!
+//!               The records carry the address of their strings in the
+//!               logger format section, and %s arguments the address of
+//!               a constant string; both are read from the ELF file. The
+//!               bytes that are not a valid record are skipped. The log
+//!               is read from the standard input when no file is given.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <ctype.h>
+#include <elf.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "logger_api.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define LOG2TEXT_MAX_SECTIONS       (256)
+#define LOG2TEXT_SPEC_SIZE          (32)
+#define LOG2TEXT_WORD_SIZE          (sizeof(uint32_t))
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct log2text_section_tag
+{
+   uint64_t address;
+   uint64_t size;
+   const uint8_t *pData;
+} Log2TextSectionType;
+
+typedef struct log2text_tag
+{
+   FILE *pOutput;
+   uint8_t *pElf;
+   Log2TextSectionType fmt;
+   Log2TextSectionType sections[LOG2TEXT_MAX_SECTIONS];
+   uint32_t numSections;
+   uint32_t records;
+   uint32_t skipped;                      // bytes
+} Log2TextType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void log2text_usage(const char *pName);
+static uint8_t *log2text_read_file(FILE *pFile, size_t *pSize);
+static int log2text_load_elf(const char *pFile);
+static void log2text_add_section(const char *pName, uint32_t type, uint64_t flags, uint64_t address,
+                                 uint64_t offset, uint64_t size, size_t elfSize);
+static const char *log2text_string(const Log2TextSectionType *pSection, uint64_t address);
+static size_t log2text_record(const uint8_t *pData, size_t size);
+static void log2text_format(const char *pMsg, const uint32_t *pArgs, uint32_t count, const char *pText);
+static uint32_t log2text_word(const uint8_t *pData);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static Log2TextType log2text;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+int main(int argc, char *argv[])
+{
+   FILE *pInput = stdin;
+   const char *pElf = NULL;
+   uint8_t *pLog;
+   size_t size, pos, used;
+   int opt;
+
+   log2text.pOutput = stdout;
+
+   while (-1 != (opt = getopt(argc, argv, "e:o:h")))
+   {
+      switch (opt)
+      {
+      case 'e':
+         pElf = optarg;
+         break;
+      case 'o':
+         log2text.pOutput = fopen(optarg, "w");
+         if (NULL == log2text.pOutput)
+         {
+            fprintf(stderr, "%s: unable to open %s\n", argv[0], optarg);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'h':
+      default:
+         log2text_usage(argv[0]);
+         return ('h' == opt) ? EXIT_SUCCESS : EXIT_FAILURE;
+      }
+   }
+
+   if (NULL == pElf)
+   {
+      log2text_usage(argv[0]);
+      return EXIT_FAILURE;
+   }
+   if (0 != log2text_load_elf(pElf))
+   {
+      fprintf(stderr, "%s: no log strings found in %s\n", argv[0], pElf);
+      return EXIT_FAILURE;
+   }
+
+   if (optind < argc)
+   {
+      pInput = fopen(argv[optind], "rb");
+      if (NULL == pInput)
+      {
+         fprintf(stderr, "%s: unable to open %s\n", argv[0], argv[optind]);
+         return EXIT_FAILURE;
+      }
+   }
+
+   pLog = log2text_read_file(pInput, &size);
+   if (NULL == pLog)
+   {
+      fprintf(stderr, "%s: unable to read the log\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   for (pos = 0; pos < size; pos += (0 != used) ? used : 1)
+   {
+      used = log2text_record(&pLog[pos], size - pos);
+      if (0 == used)
+         log2text.skipped++;
+   }
+
+   if (0 != log2text.skipped)
+      fprintf(stderr, "%s: %u records, %u bytes skipped\n", argv[0], log2text.records, log2text.skipped);
+
+   return EXIT_SUCCESS;
+}
+
+static void log2text_usage(const char *pName)
+{
+   fprintf(stderr, "usage: %s -e elf [-o file] [log]\n", pName);
+}
+
+static uint8_t *log2text_read_file(FILE *pFile, size_t *pSize)
+{
+   uint8_t *pData = NULL;
+   size_t capacity = 0;
+   size_t size = 0;
+   size_t read;
+
+   do
+   {
+      if (size == capacity)
+      {
+         capacity = (0 != capacity) ? (capacity * 2) : 65536;
+         pData = realloc(pData, capacity);
+         if (NULL == pData)
+            return NULL;
+      }
+      read = fread(&pData[size], 1, capacity - size, pFile);
+      size += read;
+   } while (0 != read);
+
+   *pSize = size;
+   return pData;
+}
+
+static int log2text_load_elf(const char *pFile)
+{
+   FILE *pElfFile = fopen(pFile, "rb");
+   size_t size;
+   uint8_t *pElf;
+
+   if (NULL == pElfFile)
+      return -1;
+   pElf = log2text_read_file(pElfFile, &size);
+   fclose(pElfFile);
+   if ((NULL == pElf) || (size < EI_NIDENT) || (0 != memcmp(pElf, ELFMAG, SELFMAG)))
+      return -1;
+   log2text.pElf = pElf;
+
+   // the target firmware is a 32 bits ELF, the host simulation a 64 bits one
+   if ((ELFCLASS32 == pElf[EI_CLASS]) && (size >= sizeof(Elf32_Ehdr)))
+   {
+      const Elf32_Ehdr *pHdr = (const Elf32_Ehdr *)pElf;
+      const Elf32_Shdr *pShdr = (const Elf32_Shdr *)(pElf + pHdr->e_shoff);
+      const char *pNames;
+
+      if ((pHdr->e_shoff + (uint64_t)pHdr->e_shnum * sizeof(Elf32_Shdr)) > size)
+         return -1;
+      pNames = (const char *)(pElf + pShdr[pHdr->e_shstrndx].sh_offset);
+      for (uint32_t i = 0; i < pHdr->e_shnum; i++)
+      {
+         log2text_add_section(pNames + pShdr[i].sh_name, pShdr[i].sh_type, pShdr[i].sh_flags, pShdr[i].sh_addr,
+                              pShdr[i].sh_offset, pShdr[i].sh_size, size);
+      }
+   }
+   else if ((ELFCLASS64 == pElf[EI_CLASS]) && (size >= sizeof(Elf64_Ehdr)))
+   {
+      const Elf64_Ehdr *pHdr = (const Elf64_Ehdr *)pElf;
+      const Elf64_Shdr *pShdr = (const Elf64_Shdr *)(pElf + pHdr->e_shoff);
+      const char *pNames;
+
+      if ((pHdr->e_shoff + (uint64_t)pHdr->e_shnum * sizeof(Elf64_Shdr)) > size)
+         return -1;
+      pNames = (const char *)(pElf + pShdr[pHdr->e_shstrndx].sh_offset);
+      for (uint32_t i = 0; i < pHdr->e_shnum; i++)
+      {
+         log2text_add_section(pNames + pShdr[i].sh_name, pShdr[i].sh_type, pShdr[i].sh_flags, pShdr[i].sh_addr,
+                              pShdr[i].sh_offset, pShdr[i].sh_size, size);
+      }
+   }
+
+   return (NULL != log2text.fmt.pData) ? 0 : -1;
+}
+
+static void log2text_add_section(const char *pName, uint32_t type, uint64_t flags, uint64_t address,
+                                 uint64_t offset, uint64_t size, size_t elfSize)
+{
+   Log2TextSectionType *pSection;
+
+   if ((SHT_PROGBITS != type) || ((offset + size) > elfSize))
+      return;
+
+   // the format section is not loaded on the target
+   if (0 == strcmp(pName, LOGGER_FMT_SECTION))
+   {
+      pSection = &log2text.fmt;
+   }
+   else if ((0 != (flags & SHF_ALLOC)) && (log2text.numSections < LOG2TEXT_MAX_SECTIONS))
+   {
+      pSection = &log2text.sections[log2text.numSections++];
+   }
+   else
+   {
+      return;
+   }
+
+   pSection->address = address;
+   pSection->size = size;
+   pSection->pData = log2text.pElf + offset;
+}
+
+// a string fully inside the section
+static const char *log2text_string(const Log2TextSectionType *pSection, uint64_t address)
+{
+   const char *pString;
+
+   if ((address < pSection->address) || (address >= (pSection->address + pSection->size)))
+      return NULL;
+
+   pString = (const char *)(pSection->pData + (address - pSection->address));
+   if (NULL == memchr(pString, '\0', pSection->address + pSection->size - address))
+      return NULL;
+
+   return pString;
+}
+
+// the bytes of a valid record at pData, 0 if there is none
+static size_t log2text_record(const uint8_t *pData, size_t size)
+{
+   uint32_t header, timestamp, type, length;
+   uint32_t args[LOGGER_MAX_ARGS];
+   char text[LOGGER_MAX_TEXT + 1];
+   const char *pTag, *pMsg;
+   size_t recordSize;
+
+   if ((size < (LOGGER_RECORD_HEADER * LOG2TEXT_WORD_SIZE)) || (LOGGER_RECORD_SYNC != pData[0]))
+      return 0;
+
+   header = log2text_word(pData);
+   type = (header >> 8) & 0xFF;
+   length = header >> 16;
+   timestamp = log2text_word(pData + LOG2TEXT_WORD_SIZE);
+
+   if ((LOGGER_RECORD_FORMAT == type) && (length <= LOGGER_MAX_ARGS))
+      recordSize = (LOGGER_RECORD_HEADER + length) * LOG2TEXT_WORD_SIZE;
+   else if ((LOGGER_RECORD_TEXT == type) && (length <= LOGGER_MAX_TEXT))
+      recordSize = (LOGGER_RECORD_HEADER * LOG2TEXT_WORD_SIZE) + ((length + 3) & ~3UL);
+   else
+      return 0;
+   if (recordSize > size)
+      return 0;
+
+   // the tag and the message follow each other
+   pTag = log2text_string(&log2text.fmt, log2text_word(pData + 2 * LOG2TEXT_WORD_SIZE));
+   if (NULL == pTag)
+      return 0;
+   pMsg = log2text_string(&log2text.fmt, log2text_word(pData + 2 * LOG2TEXT_WORD_SIZE) + strlen(pTag) + 1);
+   if (NULL == pMsg)
+      return 0;
+
+   fprintf(log2text.pOutput, "[%010u]%s: ", timestamp, pTag);
+   if (LOGGER_RECORD_FORMAT == type)
+   {
+      for (uint32_t i = 0; i < length; i++)
+         args[i] = log2text_word(pData + (LOGGER_RECORD_HEADER + i) * LOG2TEXT_WORD_SIZE);
+      log2text_format(pMsg, args, length, NULL);
+   }
+   else
+   {
+      memcpy(text, pData + LOGGER_RECORD_HEADER * LOG2TEXT_WORD_SIZE, length);
+      text[length] = '\0';
+      log2text_format(pMsg, NULL, 0, text);
+   }
+   fputc('\n', log2text.pOutput);
+   log2text.records++;
+
+   return recordSize;
+}
+
+// printf with the arguments as 32 bits words, as the target passes them
+static void log2text_format(const char *pMsg, const uint32_t *pArgs, uint32_t count, const char *pText)
+{
+   char spec[LOG2TEXT_SPEC_SIZE];
+   uint32_t next = 0;
+   uint32_t word;
+   size_t n;
+   char conv;
+
+   while ('\0' != *pMsg)
+   {
+      if (('%' != *pMsg) || ('%' == pMsg[1]))
+      {
+         fputc(*pMsg, log2text.pOutput);
+         pMsg += ('%' == *pMsg) ? 2 : 1;
+         continue;
+      }
+
+      // flags, width and precision are kept, the length modifiers dropped
+      n = 0;
+      spec[n++] = *pMsg++;
+      while (('\0' != *pMsg) && (NULL != strchr("-+ #0", *pMsg)) && (n < (LOG2TEXT_SPEC_SIZE - 2)))
+         spec[n++] = *pMsg++;
+      while ((isdigit((unsigned char)*pMsg) || ('.' == *pMsg)) && (n < (LOG2TEXT_SPEC_SIZE - 2)))
+         spec[n++] = *pMsg++;
+      while (('\0' != *pMsg) && (NULL != strchr("hlLqjzt", *pMsg)))
+         pMsg++;
+      conv = *pMsg;
+      if ('\0' == conv)
+         break;
+      pMsg++;
+      spec[n++] = conv;
+      spec[n] = '\0';
+
+      if (NULL != pText)
+      {
+         fprintf(log2text.pOutput, ('s' == conv) ? spec : "%s", pText);
+         pText = "";
+         continue;
+      }
+      if (next >= count)
+      {
+         fputs("<?>", log2text.pOutput);
+         continue;
+      }
+      word = pArgs[next++];
+
+      switch (conv)
+      {
+      case 'd':
+      case 'i':
+         fprintf(log2text.pOutput, spec, (int32_t)word);
+         break;
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+      case 'c':
+         fprintf(log2text.pOutput, spec, word);
+         break;
+      case 's':
+      {
+         const char *pString = NULL;
+
+         for (uint32_t i = 0; (i < log2text.numSections) && (NULL == pString); i++)
+            pString = log2text_string(&log2text.sections[i], word);
+         if (NULL != pString)
+            fprintf(log2text.pOutput, spec, pString);
+         else
+            fprintf(log2text.pOutput, "<0x%08x>", word);
+         break;
+      }
+      case 'p':
+         fprintf(log2text.pOutput, "0x%08x", word);
+         break;
+      default:
+         fputs(spec, log2text.pOutput);
+         break;
+      }
+   }
+}
+
+static uint32_t log2text_word(const uint8_t *pData)
+{
+   return (uint32_t)pData[0] | ((uint32_t)pData[1] << 8) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 24);
+}
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
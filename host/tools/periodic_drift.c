@@ -0,0 +1,336 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       periodic_drift.c
+//!
+//!   \brief      Long run check of the periodic scheduler deadlines.
+//!
+//!               usage: periodic_drift [-H hours] [-s seed]
+//!
+//!               -H  time to run, in hours (default 24)
+//!               -s  seed of the injected overruns
+//!
+//!               The periodic module runs alone on a virtual millisecond
+//!               tick that starts an hour before it wraps. Waiting for an
+//!               interrupt jumps to the next tick, so the idle time costs
+//!               nothing and a day runs in seconds. The slot handlers
+//!               overrun now and then by up to 8 slots.
+//!
+//!               Every slot is checked against a model of the absolute
+//!               deadlines: a slot starts exactly at its deadline unless
+//!               the previous one overran it, and then as soon as the
+//!               previous one ends, less than a slot late. The slots
+//!               skipped are counted from the time the overrun ended and
+//!               compared with the ones reported by the module. Exits
+//!               with failure on any drift of the deadlines or any
+//!               miscount of the missed slots.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "periodic_conf.h"
+#include "periodic_api.h"
+#include "periodic_callouts.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define PERIODIC_DRIFT_DEFAULT_HOURS   (24)
+#define PERIODIC_DRIFT_MS_PER_HOUR     (3600000ULL)
+#define PERIODIC_DRIFT_START_TICK      (UINT32_MAX - (uint32_t)PERIODIC_DRIFT_MS_PER_HOUR)
+#define PERIODIC_DRIFT_OVERRUN_RATE    (500)    // one slot in
+#define PERIODIC_DRIFT_MAX_OVERRUN_MS  (8 * PERIODIC_MIN_TIMESLOT)
+#define PERIODIC_DRIFT_MAX_REPORTS     (10)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct periodic_drift_tag
+{
+   uint32_t tick;                         // HAL tick
+   uint64_t now;                          // ms since the start, never wraps
+   uint64_t end;
+   uint32_t primask;
+   uint32_t seed;
+
+   // model of the scheduler
+   uint64_t deadline;                     // of the next slot
+   uint64_t slotEnd;                      // time the last slot finished
+   uint32_t slots;
+   uint32_t missed;
+
+   uint32_t reported;                     // by the last Periodic_OnSlotsMissed()
+   uint32_t overruns;                     // injected
+   uint32_t lateStarts;
+   uint32_t maxLate;                      // ms
+   uint32_t driftErrors;
+   uint32_t missedErrors;
+} PeriodicDriftType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void periodic_drift_usage(const char *pName);
+static void periodic_drift_advance(uint32_t ms);
+static uint32_t periodic_drift_random(void);
+static void periodic_drift_error(uint32_t *pCount, const char *pFormat, uint64_t value, uint64_t expected);
+static void periodic_drift_report(void);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static PeriodicDriftType periodicDrift;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+int main(int argc, char *argv[])
+{
+   uint32_t hours = PERIODIC_DRIFT_DEFAULT_HOURS;
+   int opt;
+
+   periodicDrift.seed = 1;
+
+   while (-1 != (opt = getopt(argc, argv, "H:s:h")))
+   {
+      switch (opt)
+      {
+      case 'H':
+         hours = strtoul(optarg, NULL, 0);
+         break;
+      case 's':
+         periodicDrift.seed = strtoul(optarg, NULL, 0);
+         break;
+      case 'h':
+      default:
+         periodic_drift_usage(argv[0]);
+         return ('h' == opt) ? EXIT_SUCCESS : EXIT_FAILURE;
+      }
+   }
+
+   periodicDrift.tick = PERIODIC_DRIFT_START_TICK;
+   periodicDrift.end = hours * PERIODIC_DRIFT_MS_PER_HOUR;
+   periodicDrift.deadline = PERIODIC_MIN_TIMESLOT;
+
+   // never returns, the first slot past the end reports and exits
+   Periodic_Init();
+   Periodic_Start();
+
+   return EXIT_FAILURE;
+}
+
+uint32_t HAL_GetTick(void)
+{
+   return periodicDrift.tick;
+}
+
+void HostSim_WaitForInterrupt(void)
+{
+   // the next tick interrupt
+   periodic_drift_advance(1);
+}
+
+uint32_t HostSim_GetPRIMASK(void)
+{
+   return periodicDrift.primask;
+}
+
+void HostSim_SetPRIMASK(uint32_t priMask)
+{
+   periodicDrift.primask = priMask & 1;
+}
+
+uint32_t Periodic_GetHighResTimestamp(void)
+{
+   return (uint32_t)(periodicDrift.now * 1000);
+}
+
+void Periodic_OnSlotsMissed(uint32_t missed)
+{
+   periodicDrift.reported = missed;
+}
+
+void Periodic_OnProcessingStart(void)
+{
+   uint64_t late = 0;
+
+   // the slots whose deadline passed while the previous one was running
+   // are skipped, the first one still ahead runs
+   if (periodicDrift.slotEnd > periodicDrift.deadline)
+   {
+      late = (periodicDrift.slotEnd - periodicDrift.deadline) / PERIODIC_MIN_TIMESLOT;
+      periodicDrift.deadline += late * PERIODIC_MIN_TIMESLOT;
+      periodicDrift.lateStarts++;
+      if ((periodicDrift.now - periodicDrift.deadline) > periodicDrift.maxLate)
+         periodicDrift.maxLate = (uint32_t)(periodicDrift.now - periodicDrift.deadline);
+
+      if (periodicDrift.now != periodicDrift.slotEnd)
+         periodic_drift_error(&periodicDrift.driftErrors, "late slot started at %llu ms, expected %llu ms",
+                              periodicDrift.now, periodicDrift.slotEnd);
+   }
+   else if (periodicDrift.now != periodicDrift.deadline)
+   {
+      periodic_drift_error(&periodicDrift.driftErrors, "slot started at %llu ms, deadline %llu ms",
+                           periodicDrift.now, periodicDrift.deadline);
+   }
+   periodicDrift.slots += (uint32_t)late + 1;
+   periodicDrift.missed += (uint32_t)late;
+
+   if ((uint64_t)Periodic_GetSlotCount() * PERIODIC_MIN_TIMESLOT != periodicDrift.deadline)
+      periodic_drift_error(&periodicDrift.driftErrors, "slot deadline %llu ms, expected %llu ms",
+                           (uint64_t)Periodic_GetSlotCount() * PERIODIC_MIN_TIMESLOT, periodicDrift.deadline);
+   if (periodicDrift.reported != late)
+      periodic_drift_error(&periodicDrift.missedErrors, "%llu slots reported missed, expected %llu",
+                           periodicDrift.reported, late);
+   if (Periodic_GetMissedSlots() != periodicDrift.missed)
+      periodic_drift_error(&periodicDrift.missedErrors, "%llu slots missed in total, expected %llu",
+                           Periodic_GetMissedSlots(), periodicDrift.missed);
+
+   periodicDrift.reported = 0;
+   periodicDrift.deadline += PERIODIC_MIN_TIMESLOT;
+
+   if (periodicDrift.now >= periodicDrift.end)
+   {
+      periodic_drift_report();
+      exit(((0 == periodicDrift.driftErrors) && (0 == periodicDrift.missedErrors)) ? EXIT_SUCCESS : EXIT_FAILURE);
+   }
+}
+
+void Periodic_OnProcessingStop(void)
+{
+   periodicDrift.slotEnd = periodicDrift.now;
+}
+
+void Periodic_handler_1x(void)
+{
+   if (0 == (periodic_drift_random() % PERIODIC_DRIFT_OVERRUN_RATE))
+   {
+      periodicDrift.overruns++;
+      periodic_drift_advance(1 + periodic_drift_random() % PERIODIC_DRIFT_MAX_OVERRUN_MS);
+   }
+}
+
+void Periodic_handler_2x(void)
+{
+}
+
+void Periodic_handler_4x(void)
+{
+}
+
+void Periodic_handler_8x(void)
+{
+}
+
+void Periodic_handler_16x(void)
+{
+}
+
+void Periodic_handler_32x(void)
+{
+}
+
+void Periodic_handler_64x(void)
+{
+}
+
+void Periodic_handler_128x(void)
+{
+}
+
+static void periodic_drift_usage(const char *pName)
+{
+   fprintf(stderr, "usage: %s [-H hours] [-s seed]\n", pName);
+}
+
+static void periodic_drift_advance(uint32_t ms)
+{
+   periodicDrift.tick += ms;
+   periodicDrift.now += ms;
+}
+
+static uint32_t periodic_drift_random(void)
+{
+   periodicDrift.seed = periodicDrift.seed * 1103515245UL + 12345UL;
+
+   return periodicDrift.seed >> 16;
+}
+
+static void periodic_drift_error(uint32_t *pCount, const char *pFormat, uint64_t value, uint64_t expected)
+{
+   if ((periodicDrift.driftErrors + periodicDrift.missedErrors) < PERIODIC_DRIFT_MAX_REPORTS)
+   {
+      fprintf(stderr, "periodic_drift: slot %lu at tick 0x%08lx: ", (unsigned long)periodicDrift.slots,
+              (unsigned long)periodicDrift.tick);
+      fprintf(stderr, pFormat, (unsigned long long)value, (unsigned long long)expected);
+      fprintf(stderr, "\n");
+   }
+
+   (*pCount)++;
+}
+
+static void periodic_drift_report(void)
+{
+   printf("periodic_drift: %llu h, tick 0x%08lx to 0x%08lx, %lu slots, %lu overruns injected\n",
+          (unsigned long long)(periodicDrift.now / PERIODIC_DRIFT_MS_PER_HOUR),
+          (unsigned long)PERIODIC_DRIFT_START_TICK, (unsigned long)periodicDrift.tick,
+          (unsigned long)Periodic_GetSlotCount(), (unsigned long)periodicDrift.overruns);
+   printf("periodic_drift: %lu slots missed, expected %lu, %lu late starts up to %lu ms\n",
+          (unsigned long)Periodic_GetMissedSlots(), (unsigned long)periodicDrift.missed,
+          (unsigned long)periodicDrift.lateStarts, (unsigned long)periodicDrift.maxLate);
+   printf("periodic_drift: %lu drift errors, %lu missed count errors\n",
+          (unsigned long)periodicDrift.driftErrors, (unsigned long)periodicDrift.missedErrors);
+}
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
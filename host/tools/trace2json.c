@@ -0,0 +1,508 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       trace2json.c
+//!
+//!   \brief      Converts the trace dumps of a debug log to a Chrome
+//!               trace, shown by Perfetto or chrome://tracing.
+//!
+//!               usage: trace2json [-s symbols] [-o file] [log]
+//!
+//!               -s  symbol table of the firmware, the output of nm,
+//!                   used to name the state machine states
+//!               -o  file receiving the trace, default the standard
+//!                   output
+//!
+//!               Every dump found in the log becomes a process of the
+//!               trace. The log is read from the standard input when no
+//!               file is given.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "stm32f1xx.h"
+#include "trace_api.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define TRACE2JSON_TAG              "trc: "
+#define TRACE2JSON_EVENT_DIGITS     (16)
+#define TRACE2JSON_LINE_SIZE        (256)
+#define TRACE2JSON_MAX_DEPTH        (16)
+
+// trace threads
+#define TRACE2JSON_TID_IRQ          (1)
+#define TRACE2JSON_TID_SLOTS        (2)
+#define TRACE2JSON_TID_EVENTS       (3)
+#define TRACE2JSON_TID_FSM          (10)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct trace2json_symbol_tag
+{
+   uint64_t address;
+   char *pName;
+} Trace2JsonSymbolType;
+
+typedef struct trace2json_tag
+{
+   FILE *pOutput;
+   Trace2JsonSymbolType *pSymbols;
+   uint32_t symbols;
+   uint32_t outputEvents;
+   uint32_t dumps;
+   uint32_t ticksPerUs;
+   uint32_t lastTimestamp;
+   uint64_t ticks;                        // unwrapped timestamp
+   bool firstEvent;
+   double lastTs;
+   uint32_t irqDepth;
+   uint8_t irqStack[TRACE2JSON_MAX_DEPTH];
+   uint32_t slotDepth;
+   uint8_t slot;
+   const char *pFsmState[TRACE_FSM_NUM];
+} Trace2JsonType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void trace2json_usage(const char *pName);
+static int trace2json_load_symbols(const char *pFile);
+static const char *trace2json_state_name(uint16_t data);
+static const char *trace2json_irq_name(uint8_t exception);
+static void trace2json_begin_dump(uint32_t ticksPerUs);
+static void trace2json_end_dump(void);
+static void trace2json_event(uint32_t timestamp, uint8_t id, uint8_t arg, uint16_t data);
+static void trace2json_write(const char *pName, char phase, double ts, uint32_t tid, const char *pExtra);
+static void trace2json_thread_name(uint32_t tid, const char *pName);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+static const struct
+{
+   IRQn_Type irqn;
+   const char *pName;
+} trace2jsonIrqNames[] =
+{
+   { NonMaskableInt_IRQn,     "NMI" },
+   { HardFault_IRQn,          "HardFault" },
+   { MemoryManagement_IRQn,   "MemManage" },
+   { BusFault_IRQn,           "BusFault" },
+   { UsageFault_IRQn,         "UsageFault" },
+   { SVCall_IRQn,             "SVC" },
+   { DebugMonitor_IRQn,       "DebugMon" },
+   { PendSV_IRQn,             "PendSV" },
+   { SysTick_IRQn,            "SysTick" },
+   { DMA1_Channel1_IRQn,      "DMA1_Channel1 (ADC)" },
+   { DMA1_Channel4_IRQn,      "DMA1_Channel4 (USART TX)" },
+   { DMA1_Channel5_IRQn,      "DMA1_Channel5 (USART RX)" },
+   { TIM1_UP_IRQn,            "TIM1_UP" },
+   { TIM1_CC_IRQn,            "TIM1_CC" },
+   { TIM2_IRQn,               "TIM2 (motor)" },
+   { USART1_IRQn,             "USART1" },
+   { EXTI9_5_IRQn,            "EXTI9_5" },
+   { EXTI15_10_IRQn,          "EXTI15_10 (encoder)" },
+   { I2C2_EV_IRQn,            "I2C2_EV" },
+   { I2C2_ER_IRQn,            "I2C2_ER" },
+};
+
+static const char * const trace2jsonFsmNames[TRACE_FSM_NUM] =
+{
+#undef X
+#define X(a,b) b,
+   TRACE_FSMS_CFG
+#undef X
+};
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static Trace2JsonType trace2json;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+int main(int argc, char *argv[])
+{
+   char line[TRACE2JSON_LINE_SIZE];
+   FILE *pInput = stdin;
+   bool inDump = false;
+   int opt;
+
+   trace2json.pOutput = stdout;
+
+   while (-1 != (opt = getopt(argc, argv, "s:o:h")))
+   {
+      switch (opt)
+      {
+      case 's':
+         if (0 != trace2json_load_symbols(optarg))
+         {
+            fprintf(stderr, "%s: unable to read %s\n", argv[0], optarg);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'o':
+         trace2json.pOutput = fopen(optarg, "w");
+         if (NULL == trace2json.pOutput)
+         {
+            fprintf(stderr, "%s: unable to open %s\n", argv[0], optarg);
+            return EXIT_FAILURE;
+         }
+         break;
+      case 'h':
+      default:
+         trace2json_usage(argv[0]);
+         return ('h' == opt) ? EXIT_SUCCESS : EXIT_FAILURE;
+      }
+   }
+
+   if (optind < argc)
+   {
+      pInput = fopen(argv[optind], "r");
+      if (NULL == pInput)
+      {
+         fprintf(stderr, "%s: unable to open %s\n", argv[0], argv[optind]);
+         return EXIT_FAILURE;
+      }
+   }
+
+   fprintf(trace2json.pOutput, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+   while (NULL != fgets(line, sizeof(line), pInput))
+   {
+      char *pText = strstr(line, TRACE2JSON_TAG);
+      unsigned long events, ticksPerUs;
+
+      if (NULL == pText)
+         continue;
+      pText += strlen(TRACE2JSON_TAG);
+
+      if (2 == sscanf(pText, "b;n=%lu;f=%lu;", &events, &ticksPerUs))
+      {
+         if (inDump)
+            trace2json_end_dump();
+         trace2json_begin_dump((0 != ticksPerUs) ? (uint32_t)ticksPerUs : 1);
+         inDump = true;
+      }
+      else if (inDump && (0 == strncmp(pText, "d=", 2)))
+      {
+         pText += 2;
+         while ((strspn(pText, "0123456789abcdefABCDEF") >= TRACE2JSON_EVENT_DIGITS))
+         {
+            char field[9];
+            uint32_t timestamp;
+            uint8_t id, arg;
+            uint16_t data;
+
+            memcpy(field, pText, 8);
+            field[8] = '\0';
+            timestamp = (uint32_t)strtoul(field, NULL, 16);
+            memcpy(field, pText + 8, 2);
+            field[2] = '\0';
+            id = (uint8_t)strtoul(field, NULL, 16);
+            memcpy(field, pText + 10, 2);
+            arg = (uint8_t)strtoul(field, NULL, 16);
+            memcpy(field, pText + 12, 4);
+            field[4] = '\0';
+            data = (uint16_t)strtoul(field, NULL, 16);
+
+            trace2json_event(timestamp, id, arg, data);
+            pText += TRACE2JSON_EVENT_DIGITS;
+         }
+      }
+      else if (inDump && (0 == strncmp(pText, "e;", 2)))
+      {
+         trace2json_end_dump();
+         inDump = false;
+      }
+   }
+
+   if (inDump)
+      trace2json_end_dump();
+
+   fprintf(trace2json.pOutput, "\n]}\n");
+
+   if (stdout != trace2json.pOutput)
+      fclose(trace2json.pOutput);
+
+   fprintf(stderr, "trace2json: %u dumps, %u trace events\n", trace2json.dumps, trace2json.outputEvents);
+
+   return (0 != trace2json.dumps) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void trace2json_usage(const char *pName)
+{
+   fprintf(stderr, "usage: %s [-s symbols] [-o file] [log]\n", pName);
+   fprintf(stderr, "  -s  symbol table of the firmware (nm output)\n");
+   fprintf(stderr, "  -o  file receiving the Chrome trace\n");
+}
+
+static int trace2json_load_symbols(const char *pFile)
+{
+   char line[TRACE2JSON_LINE_SIZE];
+   char name[TRACE2JSON_LINE_SIZE];
+   unsigned long long address;
+   char type;
+   FILE *pInput = fopen(pFile, "r");
+
+   if (NULL == pInput)
+      return -1;
+
+   while (NULL != fgets(line, sizeof(line), pInput))
+   {
+      if ((3 != sscanf(line, "%llx %c %255s", &address, &type, name)) || (('t' != type) && ('T' != type)))
+         continue;
+
+      trace2json.pSymbols = realloc(trace2json.pSymbols, (trace2json.symbols + 1) * sizeof(Trace2JsonSymbolType));
+      if (NULL == trace2json.pSymbols)
+         return -1;
+
+      trace2json.pSymbols[trace2json.symbols].address = address;
+      trace2json.pSymbols[trace2json.symbols].pName = strdup(name);
+      trace2json.symbols++;
+   }
+
+   fclose(pInput);
+
+   return 0;
+}
+
+static const char *trace2json_state_name(uint16_t data)
+{
+   static char unknown[8];
+   const char *pName = NULL;
+   uint32_t i;
+
+   // the event carries the low half of the address. A state machine
+   // state is preferred when several functions match.
+   for (i = 0; i < trace2json.symbols; i++)
+   {
+      if ((uint16_t)trace2json.pSymbols[i].address != data)
+         continue;
+
+      if (NULL != strstr(trace2json.pSymbols[i].pName, "fsm"))
+         return trace2json.pSymbols[i].pName;
+      if (NULL == pName)
+         pName = trace2json.pSymbols[i].pName;
+   }
+
+   if (NULL != pName)
+      return pName;
+
+   snprintf(unknown, sizeof(unknown), "0x%04x", data);
+   return unknown;
+}
+
+static const char *trace2json_irq_name(uint8_t exception)
+{
+   static char unknown[16];
+   uint32_t i;
+
+   for (i = 0; i < sizeof(trace2jsonIrqNames) / sizeof(trace2jsonIrqNames[0]); i++)
+   {
+      if ((int32_t)trace2jsonIrqNames[i].irqn + 16 == exception)
+         return trace2jsonIrqNames[i].pName;
+   }
+
+   snprintf(unknown, sizeof(unknown), "IRQ %d", (int)exception - 16);
+   return unknown;
+}
+
+static void trace2json_begin_dump(uint32_t ticksPerUs)
+{
+   char name[32];
+   uint32_t i;
+
+   trace2json.dumps++;
+   trace2json.ticksPerUs = ticksPerUs;
+   trace2json.ticks = 0;
+   trace2json.lastTs = 0;
+   trace2json.firstEvent = true;
+   trace2json.irqDepth = 0;
+   trace2json.slotDepth = 0;
+   for (i = 0; i < TRACE_FSM_NUM; i++)
+      trace2json.pFsmState[i] = NULL;
+
+   snprintf(name, sizeof(name), "dump %u", trace2json.dumps);
+   fprintf(trace2json.pOutput, "%s{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"%s\"}}",
+         (1 == trace2json.dumps) ? "" : ",\n", trace2json.dumps, name);
+
+   trace2json_thread_name(TRACE2JSON_TID_IRQ, "interrupts");
+   trace2json_thread_name(TRACE2JSON_TID_SLOTS, "periodic slots");
+   trace2json_thread_name(TRACE2JSON_TID_EVENTS, "events");
+   for (i = 0; i < TRACE_FSM_NUM; i++)
+      trace2json_thread_name(TRACE2JSON_TID_FSM + i, trace2jsonFsmNames[i]);
+}
+
+static void trace2json_end_dump(void)
+{
+   uint32_t i;
+
+   // close what is still open at the end of the dump
+   while (trace2json.irqDepth > 0)
+   {
+      trace2json.irqDepth--;
+      trace2json_write(trace2json_irq_name(trace2json.irqStack[trace2json.irqDepth]), 'E', trace2json.lastTs,
+            TRACE2JSON_TID_IRQ, NULL);
+   }
+   if (trace2json.slotDepth > 0)
+   {
+      char name[16];
+
+      snprintf(name, sizeof(name), "slot %u", trace2json.slot);
+      trace2json_write(name, 'E', trace2json.lastTs, TRACE2JSON_TID_SLOTS, NULL);
+      trace2json.slotDepth = 0;
+   }
+   for (i = 0; i < TRACE_FSM_NUM; i++)
+   {
+      if (NULL != trace2json.pFsmState[i])
+         trace2json_write(trace2json.pFsmState[i], 'E', trace2json.lastTs, TRACE2JSON_TID_FSM + i, NULL);
+      trace2json.pFsmState[i] = NULL;
+   }
+}
+
+static void trace2json_event(uint32_t timestamp, uint8_t id, uint8_t arg, uint16_t data)
+{
+   char name[64];
+   char extra[64];
+   double ts;
+
+   // the 32 bits timestamps wrap, the first event of a dump is time 0
+   if (!trace2json.firstEvent)
+      trace2json.ticks += (uint32_t)(timestamp - trace2json.lastTimestamp);
+   trace2json.firstEvent = false;
+   trace2json.lastTimestamp = timestamp;
+   ts = (double)trace2json.ticks / trace2json.ticksPerUs;
+   trace2json.lastTs = ts;
+
+   switch (id)
+   {
+   case TRACE_EV_IRQ_ENTER:
+      if (trace2json.irqDepth < TRACE2JSON_MAX_DEPTH)
+      {
+         trace2json.irqStack[trace2json.irqDepth++] = arg;
+         trace2json_write(trace2json_irq_name(arg), 'B', ts, TRACE2JSON_TID_IRQ, NULL);
+      }
+      break;
+
+   case TRACE_EV_IRQ_EXIT:
+      // the handlers running when the trace starts have no entry
+      if ((trace2json.irqDepth > 0) && (trace2json.irqStack[trace2json.irqDepth - 1] == arg))
+      {
+         trace2json.irqDepth--;
+         trace2json_write(trace2json_irq_name(arg), 'E', ts, TRACE2JSON_TID_IRQ, NULL);
+      }
+      break;
+
+   case TRACE_EV_SLOT_START:
+      snprintf(name, sizeof(name), "slot %u", arg);
+      snprintf(extra, sizeof(extra), "\"args\":{\"count\":%u}", data);
+      trace2json_write(name, 'B', ts, TRACE2JSON_TID_SLOTS, extra);
+      trace2json.slot = arg;
+      trace2json.slotDepth = 1;
+      break;
+
+   case TRACE_EV_SLOT_STOP:
+      // a slot running when the trace starts begins with the trace
+      snprintf(name, sizeof(name), "slot %u", arg);
+      if (0 == trace2json.slotDepth)
+         trace2json_write(name, 'B', 0, TRACE2JSON_TID_SLOTS, NULL);
+      trace2json_write(name, 'E', ts, TRACE2JSON_TID_SLOTS, NULL);
+      trace2json.slotDepth = 0;
+      break;
+
+   case TRACE_EV_FSM_TRAN:
+      if (arg < TRACE_FSM_NUM)
+      {
+         if (NULL != trace2json.pFsmState[arg])
+            trace2json_write(trace2json.pFsmState[arg], 'E', ts, TRACE2JSON_TID_FSM + arg, NULL);
+         trace2json.pFsmState[arg] = trace2json_state_name(data);
+         trace2json_write(trace2json.pFsmState[arg], 'B', ts, TRACE2JSON_TID_FSM + arg, NULL);
+      }
+      break;
+
+   case TRACE_EV_ADC_TRIGGER:
+      snprintf(name, sizeof(name), "trigger %u", arg);
+      snprintf(extra, sizeof(extra), "\"s\":\"t\",\"args\":{\"channel\":%u}", data);
+      trace2json_write(name, 'i', ts, TRACE2JSON_TID_EVENTS, extra);
+      break;
+
+   case TRACE_EV_SLOTS_MISSED:
+      snprintf(name, sizeof(name), "%u slots missed", data);
+      trace2json_write(name, 'i', ts, TRACE2JSON_TID_EVENTS, "\"s\":\"g\"");
+      break;
+
+   default:
+      snprintf(name, sizeof(name), "event %u", id);
+      snprintf(extra, sizeof(extra), "\"s\":\"t\",\"args\":{\"arg\":%u,\"data\":%u}", arg, data);
+      trace2json_write(name, 'i', ts, TRACE2JSON_TID_EVENTS, extra);
+      break;
+   }
+}
+
+static void trace2json_write(const char *pName, char phase, double ts, uint32_t tid, const char *pExtra)
+{
+   fprintf(trace2json.pOutput, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%u,\"tid\":%u%s%s}",
+         pName, phase, ts, trace2json.dumps, tid, (NULL != pExtra) ? "," : "", (NULL != pExtra) ? pExtra : "");
+   trace2json.outputEvents++;
+}
+
+static void trace2json_thread_name(uint32_t tid, const char *pName)
+{
+   fprintf(trace2json.pOutput, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+         trace2json.dumps, tid, pName);
+}
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
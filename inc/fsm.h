@@ -21,12 +21,18 @@
 #define TICK_SIG     (2)
 #define USER_SIG     (3)
 
+/* transition hook, a module can define it before including this file */
+#ifndef FsmOnTran
+#define FsmOnTran(me_, targ_) ((void)0)
+#endif
+
 /* "inlined" methods of Fsm class */
 #define FsmCtor(me_, init_) ((me_)->state__ = (State)(init_))
 #define FsmInit(me_, e_)     (*(me_)->state__)((Fsm *)(me_), (const Event *)(e_))
 #define FsmDispatch(me_, e_) (*(me_)->state__)((Fsm *)(me_), (const Event *)(e_))
 #define FsmTran(me_, targ_) do { FsmDispatch(me_,&exitEvt); \
                                   ((me_)->state__ = (State)(targ_)); \
+                                  FsmOnTran(me_, targ_); \
                                   FsmDispatch(me_,&entryEvt); \
                                 } while(0)
 
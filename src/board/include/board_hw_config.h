@@ -39,6 +39,12 @@
 //********************************************************************
 // Constant and Macro Definitions using #define
 //********************************************************************
+// board revision, set by the Makefile. Revision 2 swaps the buzzer and the
+// flow meter pins so the meter is on TIM1_CH1 (PA8)
+#ifndef BOARD_CONF_REV
+#define BOARD_CONF_REV     (1)
+#endif
+
 #define BOARD_PERIPHERALS_CLK_TABLE \
    X(DMA1)  \
    X(GPIOA) \
@@ -50,6 +56,8 @@
    X(PWR)   \
    X(TIM1)  \
    X(TIM2)  \
+   X(TIM3)  \
+   X(TIM4)  \
    X(USART1)\
    X(I2C2)
 
@@ -65,6 +65,16 @@
 //#define motorEncA_EXTI_IRQn EXTI15_10_IRQn
 //#define motorEncB_EXTI_IRQn EXTI15_10_IRQn
 
+// Revision 2 takes the flow meter to TIM1_CH1, the timer captures its
+// pulses. See BOARD_CONF_REV
+#if (BOARD_CONF_REV >= 2)
+#define IO_BUZZ_L_PIN      (GPIO_PIN_12)
+#define IO_FLOW_METER_PIN  (GPIO_PIN_8)
+#else
+#define IO_BUZZ_L_PIN      (GPIO_PIN_8)
+#define IO_FLOW_METER_PIN  (GPIO_PIN_12)
+#endif
+
 #undef X
 #define IO_CFG_TABLE \
    X(IO_MOTOR_DIRA   ,IO_OFF, GPIOC, GPIO_PIN_14, GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
@@ -90,12 +100,12 @@
    X(IO_KEY_R0       ,IO_OFF, GPIOC, GPIO_PIN_10 ,GPIO_SPEED_FREQ_LOW , GPIO_MODE_INPUT            , GPIO_NOPULL) \
    X(IO_KEY_R1       ,IO_OFF, GPIOC, GPIO_PIN_12, GPIO_SPEED_FREQ_LOW , GPIO_MODE_INPUT            , GPIO_NOPULL) \
    X(IO_KEY_R2       ,IO_OFF, GPIOC, GPIO_PIN_11, GPIO_SPEED_FREQ_LOW , GPIO_MODE_INPUT            , GPIO_NOPULL) \
-   X(IO_BUZZ_L       ,IO_OFF, GPIOA, GPIO_PIN_8 , GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
+   X(IO_BUZZ_L       ,IO_OFF, GPIOA, IO_BUZZ_L_PIN, GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
    X(IO_LED_ALARM_EN ,IO_OFF, GPIOC, GPIO_PIN_9 , GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
    X(IO_LED_BUB_EN   ,IO_OFF, GPIOC, GPIO_PIN_8 , GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
    X(IO_LED_RUN_EN   ,IO_OFF, GPIOB, GPIO_PIN_2 , GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
    X(IO_DBG_LED      ,IO_ON,  GPIOA, GPIO_PIN_11, GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
-   X(IO_FLOW_METER   ,IO_OFF, GPIOA, GPIO_PIN_12, GPIO_SPEED_FREQ_LOW , GPIO_MODE_INPUT            , GPIO_PULLUP) \
+   X(IO_FLOW_METER   ,IO_OFF, GPIOA, IO_FLOW_METER_PIN, GPIO_SPEED_FREQ_LOW , GPIO_MODE_INPUT            , GPIO_PULLUP) \
    X(IO_RELAY1       ,IO_OFF, GPIOD, GPIO_PIN_2,  GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
    X(IO_RELAY2       ,IO_OFF, GPIOB, GPIO_PIN_5,  GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
    X(IO_RELAY3       ,IO_OFF, GPIOB, GPIO_PIN_12, GPIO_SPEED_FREQ_LOW , GPIO_MODE_OUTPUT_PP        , GPIO_NOPULL) \
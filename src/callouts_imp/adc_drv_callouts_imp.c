@@ -41,7 +41,7 @@
 #include "standard.h"
 #include "stm32f1xx_hal.h"
 #include "clock_drv_api.h"
-#include "lpf_butter_10hz_float.h"
+#include "ventilator_manager_api.h"
 
 
 //********************************************************************
@@ -76,16 +76,13 @@
 //********************************************************************
 // Static Variables and Const Variables With File Level Scope
 //********************************************************************
-static lpf_butter_10hz_floatType *filter_lpf;
+
 //********************************************************************
 // Function Definitions
 //********************************************************************
 
 inline StatusType ADCDrv_DriverInit(void)
 {
-   filter_lpf = lpf_butter_10hz_float_create();
-   lpf_butter_10hz_float_init(filter_lpf);
-
    return E_OK;
 }
 
@@ -94,21 +91,10 @@ inline uint32_t ADCDrv_GetHighResTimestamp()
    return ClockDrv_GetHighResTimestamp();
 }
 
-inline void ADCDrv_FilterSignal(ADCDrvChType ch, int16_t in, int16_t *out)
+void ADCDrv_OnNewBlock(void)
 {
-   float tmpIn, tmpOut;
-
-   if (AIN_PRESSURE == ch)
-   {
-      tmpIn = (1.0f * in) / 4096;
-      lpf_butter_10hz_float_writeInput(filter_lpf, tmpIn);
-      tmpOut = lpf_butter_10hz_float_readOutput(filter_lpf);
-      *out = (int16_t)(tmpOut * 4096);
-   }
-   else
-   {
-      *out = in;
-   }
+   // the pressure control loop runs on every filtered pressure sample
+   VentilatorMgr_OnPressureSample(ADCDrv_GetValue(AIN_PRESSURE, TRUE, TRUE));
 }
 
 //********************************************************************
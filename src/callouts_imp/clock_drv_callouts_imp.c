@@ -42,7 +42,6 @@
 #include "stm32f1xx_hal.h"
 #include "display_drv_api.h"
 #include "logger_api.h"
-#include "adc_drv_api.h"
 
 //********************************************************************
 //! \addtogroup
@@ -83,15 +82,8 @@
 //********************************************************************
 void ClockDrv_OnTimerEvent(void)
 {
-   static uint32_t prescaler = 0;
-
    //IOTogglePinID(IO_DBG_LED);
    //IOWritePinID(IO_DBG_LED, IO_ON);
-   if (prescaler++ == 9)
-   {
-      ADCDrv_StartConversion();
-      prescaler = 0;
-   }
    DisplayDrv_UpdateData();
    //IOWritePinID(IO_DBG_LED, IO_OFF);
 }
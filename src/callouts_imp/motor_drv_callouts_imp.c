@@ -42,6 +42,7 @@
 #include "stm32f1xx_hal.h"
 #include "motor_drv_api.h"
 #include "rotary_enc_drv_api.h"
+#include "clock_drv_api.h"
 #include "ventilator_manager_api.h"
 #include "alarm_manager_api.h"
 
@@ -87,6 +88,16 @@ inline int32_t MotorDrv_GetPosition(void)
    return RotaryEncDrv_GetPosition();
 }
 
+inline int32_t MotorDrv_GetStepPosition(uint32_t *pTimestamp)
+{
+   return RotaryEncDrv_GetStep(pTimestamp);
+}
+
+inline uint32_t MotorDrv_GetHighResTimestamp(void)
+{
+   return ClockDrv_GetHighResTimestamp();
+}
+
 inline void MotorDrv_ResetPosition(void)
 {
    RotaryEncDrv_SetPosition(0);
@@ -48,12 +48,15 @@
 #include "motor_manager_api.h"
 #include "adc_drv_api.h"
 #include "dflow_meter_drv_api.h"
+#include "flow_meter_drv_conf.h"
+#include "flow_meter_drv_api.h"
 #include "ventilator_manager_api.h"
 #include "clock_drv_api.h"
 #include "keyboard_drv_api.h"
 #include "alarm_manager_api.h"
 #include "power_manager_api.h"
 #include "system_monitor_api.h"
+#include "trace_api.h"
 
 //********************************************************************
 //! \addtogroup
@@ -72,6 +75,15 @@
 //********************************************************************
 // Constant and Macro Definitions using #define
 //********************************************************************
+#define LOG_TAG   "slot"
+
+// measures the execution time of a module call
+#define PERIODIC_PROBE(p, call)  do                                  \
+                                 {                                   \
+                                    SystemMonitor_StartProbe(p);     \
+                                    call;                            \
+                                    SystemMonitor_StopProbe(p);      \
+                                 } while(0)
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
@@ -96,68 +108,120 @@
 
 inline void Periodic_OnProcessingStart(void)
 {
+   uint32_t slot = Periodic_GetSlotCount();
+
    SystemMonitor_StartUserTime();
+   TRACE_EVENT(TRACE_EV_SLOT_START, slot & ((1UL << PERIODIC_HYPERPERIOD_SHIFT) - 1), slot);
 }
 
 inline void Periodic_OnProcessingStop(void)
 {
+   uint32_t slot = Periodic_GetSlotCount();
+
+   TRACE_EVENT(TRACE_EV_SLOT_STOP, slot & ((1UL << PERIODIC_HYPERPERIOD_SHIFT) - 1), slot);
    SystemMonitor_StopUserTime();
 }
 
+inline uint32_t Periodic_GetHighResTimestamp(void)
+{
+   return ClockDrv_GetHighResTimestamp();
+}
+
+void Periodic_OnSlotsMissed(uint32_t missed)
+{
+   LOG_PRINT_INFO(DEBUG_CPU, LOG_TAG, "m=%lu;t=%lu", missed, Periodic_GetMissedSlots());
+
+   // keep the events that led to the overrun
+   TRACE_EVENT(TRACE_EV_SLOTS_MISSED, 0, missed);
+   Trace_Freeze();
+}
+
 void Periodic_handler_1x(void)
 {
+   SystemMonitor_StartProbe(SMON_PROBE_1X);
+
    //toogle debug led
    //IOTogglePinID(IO_DBG_LED);
 
-   //ADCDrv_StartConversion();
-   ADCDrv_Update();
+   PERIODIC_PROBE(SMON_PROBE_ADC_DRV, ADCDrv_Update());
 
-   MotorDrv_Update();
+   PERIODIC_PROBE(SMON_PROBE_MOTOR_DRV, MotorDrv_Update());
    //IOWritePinID(IO_DBG_LED, IO_ON);
-   USARTDrv_Update();
+   PERIODIC_PROBE(SMON_PROBE_USART_DRV, USARTDrv_Update());
    //IOWritePinID(IO_DBG_LED, IO_OFF);
+
+   SystemMonitor_StopProbe(SMON_PROBE_1X);
 }
 
 void Periodic_handler_2x(void)
 {
-   VentilatorMgr_Update();
-   AlarmMgr_Update();
+   SystemMonitor_StartProbe(SMON_PROBE_2X);
+
+   PERIODIC_PROBE(SMON_PROBE_VENT_MGR, VentilatorMgr_Update());
+   PERIODIC_PROBE(SMON_PROBE_ALARM_MGR, AlarmMgr_Update());
+
+   PERIODIC_PROBE(SMON_PROBE_ADC_DBG, ADCDrv_Dbg());
 
-   ADCDrv_Dbg();
+   SystemMonitor_StopProbe(SMON_PROBE_2X);
 }
 
 void Periodic_handler_4x(void)
 {
-   RotaryEncDrv_Update();
-   DFlowMeterDrv_Update();
+   SystemMonitor_StartProbe(SMON_PROBE_4X);
+
+   PERIODIC_PROBE(SMON_PROBE_ROTARY_ENC, RotaryEncDrv_Update());
+   PERIODIC_PROBE(SMON_PROBE_DFLOW_METER, DFlowMeterDrv_Update());
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+   PERIODIC_PROBE(SMON_PROBE_FLOW_METER, FlowMeterDrv_Update());
+#else
    //FlowMeterDrv_Update();
+#endif
+
+   SystemMonitor_StopProbe(SMON_PROBE_4X);
 }
 
 void Periodic_handler_8x(void)
 {
-   PowerMgr_Update();
-   SystemMonitor_Update();
+   SystemMonitor_StartProbe(SMON_PROBE_8X);
+
+   PERIODIC_PROBE(SMON_PROBE_POWER_MGR, PowerMgr_Update());
+   PERIODIC_PROBE(SMON_PROBE_SYS_MONITOR, SystemMonitor_Update());
+   PERIODIC_PROBE(SMON_PROBE_TRACE, Trace_Update());
+
+   SystemMonitor_StopProbe(SMON_PROBE_8X);
 }
 
 void Periodic_handler_16x(void)
 {
-   KeyboardDrv_Update();
+   SystemMonitor_StartProbe(SMON_PROBE_16X);
+
+   PERIODIC_PROBE(SMON_PROBE_KEYBOARD, KeyboardDrv_Update());
    //RotaryEncDrv_Update();
+
+   SystemMonitor_StopProbe(SMON_PROBE_16X);
 }
 
 void Periodic_handler_32x(void)
 {
+   SystemMonitor_StartProbe(SMON_PROBE_32X);
 
+   SystemMonitor_StopProbe(SMON_PROBE_32X);
 }
 
 void Periodic_handler_64x(void)
 {
+   SystemMonitor_StartProbe(SMON_PROBE_64X);
 
+   SystemMonitor_StopProbe(SMON_PROBE_64X);
 }
 
 void Periodic_handler_128x(void)
 {
+   SystemMonitor_StartProbe(SMON_PROBE_128X);
+
    //DFlowMeterDrv_Update();
+
+   SystemMonitor_StopProbe(SMON_PROBE_128X);
 }
 
 //********************************************************************
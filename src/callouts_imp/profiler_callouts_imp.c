@@ -0,0 +1,114 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       profiler_callouts_imp.c
+//!
+//!   \brief      This is the profiler callouts implementation.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "logger_api.h"
+
+//********************************************************************
+//! \addtogroup
+//! @{
+//!   \addtogroup
+//!   @{
+//********************************************************************
+#include "profiler_api.h"
+#include "profiler_conf.h"
+#include "profiler_callouts.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define LOG_TAG   "prof"
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static uint32_t profiler_ticks_to_ns(uint64_t ticks);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+
+void Profiler_OnProbeReport(const char *name, const ProfilerStatsType *pStats)
+{
+   uint64_t avg = (0 != pStats->count) ? (pStats->sum / pStats->count) : 0;
+
+   // times in ns
+   LOG_PRINT_INFO(DEBUG_CPU, LOG_TAG, "p=%s;n=%lu;min=%lu;max=%lu;avg=%lu;", name, pStats->count,
+         profiler_ticks_to_ns(pStats->min), profiler_ticks_to_ns(pStats->max), profiler_ticks_to_ns(avg));
+}
+
+static uint32_t profiler_ticks_to_ns(uint64_t ticks)
+{
+   return (uint32_t)((ticks * 1000U) / PROFILER_TICKS_PER_US);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//!   @}
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -43,6 +43,7 @@
 #include "clock_drv_api.h"
 #include "motor_manager_api.h"
 #include "motor_drv_api.h"
+#include "ventilator_manager_api.h"
 
 //********************************************************************
 //! \addtogroup
@@ -89,6 +90,9 @@ inline uint32_t RotaryEncDrv_GetHighResTimestamp()
 inline void RotaryEncDrv_OnNewStep(int32_t pos, int32_t deltaPos, uint32_t speed)
 {
    MotorDrv_UpdatePosAndSpeed(pos, deltaPos, speed);
+   // the finger compresses moving CCW, towards negative positions.
+   // There are 4 steps per encoder pulse
+   VentilatorMgr_onFingerPosition((-pos * (360L << VENTILATOR_MGR_ANGLE_SHIFT)) / (4 * ROTARY_ENC_DRV_PPR));
    //MotorManager_UpdatePosAndSpeed(pos, deltaPos, speed);
 }
 
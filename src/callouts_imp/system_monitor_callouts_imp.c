@@ -62,6 +62,10 @@
 //********************************************************************
 #define LOG_TAG   "cpu"
 
+#if (SYSTEM_MONITOR_PROBE_HIST_BINS != 12)
+#error "SystemMonitor_OnProbeReport logs 12 histogram bins"
+#endif
+
 //********************************************************************
 // Enumerations and Structures and Typedefs
 //********************************************************************
@@ -97,6 +101,17 @@ void SystemMonitor_OnCPUUsageReport(uint32_t wallClock, uint32_t CPUUserTime)
    LOG_PRINT_INFO(DEBUG_CPU, LOG_TAG, "t=%lu;u=%lu;", wallClock, CPUUserTime);
 }
 
+void SystemMonitor_OnProbeReport(const char *name, const SystemMonitorProbeStatsType *pStats)
+{
+   const uint16_t *h = pStats->hist;
+
+   LOG_PRINT_INFO(DEBUG_CPU, LOG_TAG, "p=%s;n=%lu;min=%lu;max=%lu;avg=%lu;dm=%lu;", name,
+         pStats->count, pStats->min, pStats->max, pStats->mean, pStats->deadlineMisses);
+
+   LOG_PRINT_INFO(DEBUG_CPU, LOG_TAG, "p=%s;h=%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u;", name,
+         h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], h[8], h[9], h[10], h[11]);
+}
+
 //********************************************************************
 //
 // Close the Doxygen group.
@@ -50,6 +50,9 @@
 #include "adc_drv_api.h"
 #include "alarm_manager_api.h"
 #include "hmi_api.h"
+#include "system_monitor_api.h"
+#include "profiler_api.h"
+#include "trace_api.h"
 
 //********************************************************************
 //! \addtogroup
@@ -225,6 +228,7 @@ void USARTDrv_OnReceiveComplete(UART_HandleTypeDef *huart, uint32_t size)
        * VM,7,kp,ki,kd; -> VentilatorMgr_SetPIDParameters
        * VM,8,minTV; -> VentilatorMgr_SetMinTidalVolume
        * VM,9,maxTv; -> VentilatorMgr_SetMaxTidalVolume
+       * VM,0,shape; -> VentilatorMgr_SetFlowShape
        */
       uint32_t bpm, vol, ieratio, inspTime, mode, minTv, maxTv;
       token = strtok(NULL, ",;");
@@ -283,6 +287,11 @@ void USARTDrv_OnReceiveComplete(UART_HandleTypeDef *huart, uint32_t size)
             maxTv = atoi(token);
             VentilatorMgr_SetMaxTidalVolume(maxTv);
             break;
+         case '0':
+            token = strtok(NULL, ",;");
+            mode = atoi(token);
+            VentilatorMgr_SetFlowShape(mode);
+            break;
          default:
             break;
       }
@@ -311,6 +320,68 @@ void USARTDrv_OnReceiveComplete(UART_HandleTypeDef *huart, uint32_t size)
          default:
             break;
       }
+   } else if (0 == strncmp(token, "SM", 2))
+   {
+      /* System Monitor Commands
+       * SM,1; -> SystemMonitor ReportProbes
+       * SM,2; -> SystemMonitor ResetProbes
+       */
+      token = strtok(NULL, ",;");
+      switch (*token)
+      {
+         case '1':
+            SystemMonitor_ReportProbes();
+            break;
+         case '2':
+            SystemMonitor_ResetProbes();
+            break;
+         default:
+            break;
+      }
+   } else if (0 == strncmp(token, "PR", 2))
+   {
+      /* Profiler Commands
+       * PR,1; -> Profiler Report
+       * PR,2; -> Profiler Reset
+       */
+      token = strtok(NULL, ",;");
+      switch (*token)
+      {
+         case '1':
+            Profiler_Report();
+            break;
+         case '2':
+            Profiler_Reset();
+            break;
+         default:
+            break;
+      }
+   } else if (0 == strncmp(token, "TR", 2))
+   {
+      /* Trace Commands
+       * TR,1; -> Trace Freeze and dump
+       * TR,2; -> Trace Arm
+       * TR,3,mask; -> Trace SetFilter, mask in hex
+       */
+      token = strtok(NULL, ",;");
+      switch (*token)
+      {
+         case '1':
+            Trace_Freeze();
+            break;
+         case '2':
+            Trace_Arm();
+            break;
+         case '3':
+            token = strtok(NULL, ",;");
+            if (NULL != token)
+            {
+               Trace_SetFilter(strtoul(token, NULL, 16));
+            }
+            break;
+         default:
+            break;
+      }
    } else if (0 == strncmp(token, "HMI", 3))
    {
       /* HMI Commands
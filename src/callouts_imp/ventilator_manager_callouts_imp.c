@@ -65,7 +65,8 @@
 //********************************************************************
 // Constant and Macro Definitions using #define
 //********************************************************************
-#define MAX_PRESSURE_DEBOUNCE_COUNTER  (40)
+#define PRESSURE_TRIGGER_DEBOUNCE      (200)   // filtered samples, 1 ms each
+#define PRESSURE_TRIGGER_HYSTERESIS    (10)    // mmH2O
 
 #define SET_ERROR_FLAG(e) do { \
                            errorFlags |= (1UL << (e)); \
@@ -121,9 +122,11 @@ static void CheckForClearedAlarms(void);
 //********************************************************************
 static uint32_t usedTriggers;
 static ADCDrvTriggerConfType pressureTriggers[VENTILATOR_MGR_PRESSURE_MAX_TRIGGERS];
-static uint32_t pressureTriggersDebounce[VENTILATOR_MGR_PRESSURE_MAX_TRIGGERS];
 static uint32_t errorFlags;
 static uint32_t alarmFlags;
+static Bool breathPressureValid;
+static int32_t breathPressureIntegral;
+static uint32_t breathPressureDuration;
 
 
 static const int32_t error2alarm_map[] =
@@ -138,17 +141,10 @@ static const int32_t error2alarm_map[] =
 //********************************************************************
 StatusType VentilatorMgr_ModuleInit(void)
 {
-   uint32_t i;
-
    usedTriggers = 0;
    errorFlags = 0;
    alarmFlags = 0;
 
-   for(i=0; i < sizeof(pressureTriggersDebounce)/sizeof(pressureTriggersDebounce[0]); i++)
-   {
-      pressureTriggersDebounce[i] = 0;
-   }
-
    return E_OK;
 }
 
@@ -185,20 +181,59 @@ StatusType VentilatorMgr_SetMotorState(VentilatorMotorStateType state, int32_t d
    return err;
 }
 
+StatusType VentilatorMgr_CompressInTime(int32_t distance, uint32_t timeMillis, VentilatorMgrFlowShapeType shape)
+{
+   MotorShapeType motorShape;
+
+   switch (shape)
+   {
+      case VENTILATOR_MGR_FLOW_SQUARE:
+         motorShape = MOTOR_SHAPE_SQUARE;
+         break;
+      case VENTILATOR_MGR_FLOW_DECELERATING:
+         motorShape = MOTOR_SHAPE_DECELERATING;
+         break;
+      case VENTILATOR_MGR_FLOW_SINE:
+         motorShape = MOTOR_SHAPE_SINE;
+         break;
+      default:
+         return E_ERROR;
+   }
+
+   return MotorDrv_MoveDistanceInTime(MOTOR_DIR_CCW, distance, timeMillis, motorShape);
+}
+
+StatusType VentilatorMgr_WriteDriveLevel(int32_t driveLevel)
+{
+   return MotorDrv_WriteDriveLevel(driveLevel);
+}
+
 void VentilatorMgr_OnStateChange(VentilatorStateType state)
 {
 
    switch(state)
    {
       case VENTILATOR_MGR_STATE_IDLE:
+         breathPressureValid = FALSE;
          Hmi_UpdateVentilatorState(HMI_VENTILATOR_STATE_IDLE);
+         DFlowMeterDrv_StopBreath();
          RESET_ERROR_FLAGS();
          CheckForClearedAlarms();
          break;
       case VENTILATOR_MGR_STATE_INHALE:
+         // every phase of the last breath has been added, report its mean
+         // airway pressure and pressure-time integral
+         if ((breathPressureValid) && (breathPressureDuration > 0))
+         {
+            LOG_PRINT_INFO(DEBUG_VENT_P, "VentP", "map=%ld;pti=%ld;tbreath=%lu",
+                  breathPressureIntegral / (int32_t)breathPressureDuration, breathPressureIntegral, breathPressureDuration);
+         }
+         breathPressureValid = TRUE;
+         breathPressureIntegral = 0;
+         breathPressureDuration = 0;
          Hmi_UpdateVentilatorState(HMI_VENTILATOR_STATE_CYCLING);
          Hmi_UpdateTidalVolume(DFlowMeterDrv_GetVolume());
-         DFlowMeterDrv_ResetVolume();
+         DFlowMeterDrv_StartBreath();
          CheckForClearedAlarms();
          RESET_ERROR_FLAGS();
          break;
@@ -222,11 +257,9 @@ static void onADCTriggerEventFnt(ADCDrvTriggerConfType *trigger, int32_t value)
    if ((NULL != trigger) && (NULL != trigger->pUserData))
    {
       VentilatorMgrPressureTrigType *t = (VentilatorMgrPressureTrigType *)trigger->pUserData;
-      if (pressureTriggersDebounce[t->id]++ > MAX_PRESSURE_DEBOUNCE_COUNTER)
-      {
-         (*t->callback)(t, value);
-         pressureTriggersDebounce[t->id] = 0;
-      }
+
+      // the driver already debounced the trigger
+      (*t->callback)(t, value);
       ADCDrv_ResetTrigger(trigger);
    }
 }
@@ -239,6 +272,8 @@ StatusType VentilatorMgr_SetPressureTrigger(VentilatorMgrPressureTrigType *trigg
    t->type = (trigger->type == VENTILATOR_MGR_PRESSURE_TRIGGER_LOWER_THAN)?
                ADC_DRV_TRIGGER_TYPE_LOWER_THAN : ADC_DRV_TRIGGER_TYPE_HIGHER_THAN;
    t->threshold = trigger->threshold;
+   t->hysteresis = PRESSURE_TRIGGER_HYSTERESIS;
+   t->debounce = PRESSURE_TRIGGER_DEBOUNCE;
    t->triggerFnt = onADCTriggerEventFnt;
    t->pUserData = (void*) trigger;
 
@@ -252,6 +287,15 @@ StatusType VentilatorMgr_InitPressureMeasurement(void)
 
 inline StatusType VentilatorMgr_StartPressureMeasurement(void)
 {
+   ADCDrvChStatType pressureStats;
+
+   // the phase that ends is part of the breath
+   if ((breathPressureValid) && (E_OK == ADCDrv_GetStats(AIN_PRESSURE, &pressureStats, TRUE)))
+   {
+      breathPressureIntegral += pressureStats.integral;
+      breathPressureDuration += pressureStats.duration;
+   }
+
    return ADCDrv_ResetStats(AIN_PRESSURE);
 }
 
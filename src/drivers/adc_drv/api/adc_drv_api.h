@@ -48,6 +48,14 @@
 //********************************************************************
 // Constant and Macro Definitions using #define
 //********************************************************************
+/**
+ * Filter stages that can be chained on a channel in #ADC_DRV_INPUTS_CFG.
+ * The enabled stages are applied in the order they are listed here.
+ */
+#define ADC_DRV_FILTER_NONE         (0x00)   /**< The raw conversion is used */
+#define ADC_DRV_FILTER_MEDIAN3      (0x01)   /**< Median of the last 3 samples, rejects single sample spikes */
+#define ADC_DRV_FILTER_LPF_10HZ     (0x02)   /**< 4th order 10Hz Butterworth low pass filter in q31 */
+#define ADC_DRV_FILTER_MAVG         (0x04)   /**< Moving average of #ADC_DRV_FILTER_MAVG_SIZE samples */
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
@@ -60,14 +68,30 @@ typedef struct adc_drv_ch_stat_tag
    int32_t min;         /**< min conversion */
    int32_t max;         /**< max conversion */
    int32_t avg;         /**< avg conversion */
+   int32_t rms;         /**< root mean square of the conversions */
+   int32_t integral;    /**< integral of the conversions over time, in value x ms */
+   uint32_t duration;   /**< time covered by the statistics in ms */
    int32_t value;       /**< last filtered conversion */
    int32_t rawValue;    /**< last raw conversion */
-   uint32_t tmin;       /**< min time between conversions */
-   uint32_t tmax;       /**< max time between conversions */
+   uint32_t tmin;       /**< timestamp of the min conversion */
+   uint32_t tmax;       /**< timestamp of the max conversion */
 } ADCDrvChStatType;
 
+/**
+ * Statistics of the last filtered conversions of a channel
+ */
+typedef struct adc_drv_ch_window_stat_tag
+{
+   int32_t min;         /**< min conversion */
+   int32_t max;         /**< max conversion */
+   int32_t avg;         /**< avg conversion */
+   int32_t rms;         /**< root mean square of the conversions */
+   int32_t integral;    /**< integral of the conversions over time, in value x ms */
+   uint32_t duration;   /**< time covered by the window in ms */
+} ADCDrvChWindowStatType;
+
 /* \cond DO_NOT_DOCUMENT */
-#define X(a,b,c,d) a,
+#define X(a,b,c,d,e,f,g) a,
 /* \endcond */
 /** @brief Analog channels enumeration 
  * 
@@ -107,15 +131,11 @@ struct adc_drv_trigger_conf_tag
    ADCDrvChType channel;         /**< Channel to applied the trigger to */
    ADCDrvTriggerType type;       /**< Trigger type */
    int32_t threshold;            /**< Trigger threshold */
+   int32_t hysteresis;           /**< Distance back from the threshold the value must go to release the trigger */
+   uint16_t debounce;            /**< Consecutive filtered samples needed to raise or release the trigger */
    onTriggerEventFnt triggerFnt; /**< Function to execute when the trigger is met */
    void *pUserData;              /**< To be used by the higher layers */
    uint32_t uuid;                /**< id of the trigger */
-
-   //used internally
-   //uint32_t id;
-   //volatile Bool raised;
-   //uint32_t rawThreshold;
-   //volatile uint32_t value;
 };
 
 //********************************************************************
@@ -138,17 +158,9 @@ struct adc_drv_trigger_conf_tag
 extern StatusType ADCDrv_Init(void);
 
 /**
- * Starts a conversion of the ADC
- *
- * @param
- *
- * @return none
- * 
- */
-extern void ADCDrv_StartConversion(void);
-
-/**
- * Checks if there is a trigger active and calls the respective callback
+ * Checks if there is a trigger active and calls the respective callback.
+ * The callback is called again while the trigger stays raised, once
+ * #ADCDrv_ResetTrigger is called.
  * This function must be called periodically
  *
  * @param
@@ -179,10 +191,12 @@ extern int32_t ADCDrv_GetValue(ADCDrvChType channel, Bool applyFilter, Bool scal
  *   max_value
  *   min_value
  *   average_value
+ *   root mean square value
+ *   integral over time and time covered
  *   last filtered value
  *   last raw value
- *   max time between conversions
- *   min time between conversions 
+ *   timestamp of the max value
+ *   timestamp of the min value
  *
  * @param channel the channel to obtain the statistics from
  *        stats the structure to be filled
@@ -190,13 +204,31 @@ extern int32_t ADCDrv_GetValue(ADCDrvChType channel, Bool applyFilter, Bool scal
  *               false: do not apply any scale to the statistics
  *
  * @return #E_OK if the operation was successful\n
- *         #E_ERROR if an error occurred
+ *         #E_ERROR if an error occurred or there are no conversions
+ *         since the last reset
  * 
  */
 extern StatusType ADCDrv_GetStats(ADCDrvChType channel, ADCDrvChStatType *stats, Bool scaled);
 
 /**
- * Reset the stats counters of a certain channel
+ * Get the statistics of the last 2^#ADC_DRV_STATS_WINDOW_SHIFT filtered
+ * conversions of a channel, or less if the channel has not produced them
+ * yet. The window is not affected by #ADCDrv_ResetStats.
+ *
+ * @param channel the channel to obtain the statistics from
+ *        stats the structure to be filled
+ *        scaled true: return the scaled statistics
+ *               false: do not apply any scale to the statistics
+ *
+ * @return #E_OK if the operation was successful\n
+ *         #E_ERROR if an error occurred or there are no conversions yet
+ *
+ */
+extern StatusType ADCDrv_GetWindowStats(ADCDrvChType channel, ADCDrvChWindowStatType *stats, Bool scaled);
+
+/**
+ * Reset the stats counters of a certain channel. The statistics start
+ * again with the next block of conversions.
  *
  * @param channel the channel to reset the statistics
  *
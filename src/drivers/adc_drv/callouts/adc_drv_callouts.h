@@ -69,17 +69,6 @@
  */
 extern uint32_t ADCDrv_GetHighResTimestamp(void);
 
-/**
- * Callout to applied a filtering algorithm
- *
- * @param in the input data
- *        out the data after the filtering is applied
- *
- * @return none
- * 
- */
-extern void ADCDrv_FilterSignal(ADCDrvChType ch, int16_t in, int16_t *out);
-
 /**
  * Driver low level initialization callout.
  * This function is called during the driver initialization and shall
@@ -93,6 +82,15 @@ extern void ADCDrv_FilterSignal(ADCDrvChType ch, int16_t in, int16_t *out);
  */
 extern StatusType ADCDrv_DriverInit(void);
 
+/**
+ * Callout for every block of samples processed.
+ * This function is called from the DMA interrupt after the block has been
+ * filtered, the statistics updated and the triggers evaluated, so the
+ * filtered values read with #ADCDrv_GetValue are the newest ones.
+ * It runs in interrupt context and shall return quickly.
+ */
+extern void ADCDrv_OnNewBlock(void);
+
 //********************************************************************
 //
 // Close the Doxygen group.
@@ -50,18 +50,33 @@
 #define ADC_DRV_DMA_IRQ_NAME           (DMA1_Channel1_IRQn)          /**< DMA channel interrupt number */
 #define ADC_DRV_DMA_IRQ_PRIORITY       (2)                           /**< DMA channel interrupt priority */
 #define ADC_DRV_MAX_OUTPUT             (4095)                        /**< Max count number of conversion with 12 bits */
+#define ADC_DRV_RESOLUTION             (12)                          /**< Bits of every conversion */
 #define ADC_VOLTAGE_REFERENCE          (3.3)                         /**< Voltage reference */
-#define ADC_DRV_STATS_AVG_MAX_WINDOW   (2048)                        /**< Average window max size in samples */
+#define ADC_DRV_STATS_WINDOW_SHIFT     (7)                           /**< Sliding statistics window of 2^shift filtered samples, 8 max */
 #define ADC_DRV_MAX_TRIGGERS           (10)                          /**< Max number of triggers of the system */
-#define ADC_DRV_WAIT_FOR_LOCK_TIMEOUT  (2U)                          /**< Timeout to wait to lock the value */
+#define ADC_DRV_FILTER_MAVG_SIZE       (4)                           /**< Moving average window in samples, power of 2 */
+#define ADC_DRV_BLOCK_SAMPLES          (1)                           /**< Samples of every channel processed on each DMA interrupt */
+#define ADC_DRV_SAMPLE_RATE_HZ         (1000)                        /**< Sample rate of all the channels, the filters are designed for it */
+#define ADC_DRV_OVERSAMPLING_SHIFT     (4)                           /**< 2^shift conversions are added into every sample */
+#define ADC_DRV_TRIGGER_TIMER          (TIM3)                        /**< Timer whose update event (TRGO) starts every scan */
+#define ADC_DRV_TRIGGER_TIMER_CLOCK_HZ (72000000)                    /**< Trigger timer input clock */
+#define ADC_DRV_TRIGGER_TIMER_PRESCALER (9-1)                        /**< Trigger timer prescaler, 8MHz count */
+#define ADC_DRV_TRIGGER_CONV           (ADC_EXTERNALTRIGCONV_T3_TRGO) /**< ADC external trigger matching the trigger timer */
 
 /**
- * The configured ADC channels in the system
+ * The configured ADC channels in the system: name, hardware channel,
+ * scaled limits, sample resolution, filter stages and decimation.
+ * Every sample is the sum of the oversampled conversions, kept with the
+ * given resolution: from #ADC_DRV_RESOLUTION bits, an average, up to
+ * #ADC_DRV_RESOLUTION + #ADC_DRV_OVERSAMPLING_SHIFT bits and at most 15,
+ * as the filtered samples are 16 bit signed. The effective
+ * resolution gained with noise is half a bit per oversampling shift. The
+ * filtered value is updated once every decimation samples.
  */
 #define ADC_DRV_INPUTS_CFG \
-   X(AIN_PRESSURE        , ADC_CHANNEL_4  , -90, 1155  )  \
-   X(AIN_M1_CURRENT      , ADC_CHANNEL_10 ,   0, 33000 )  \
-   X(AIN_CH2             , ADC_CHANNEL_6  , -90, 1155 )  \
+   X(AIN_PRESSURE        , ADC_CHANNEL_4  , -90, 1155  , 14, ADC_DRV_FILTER_LPF_10HZ                       , 1 )  \
+   X(AIN_M1_CURRENT      , ADC_CHANNEL_10 ,   0, 33000 , 12, ADC_DRV_FILTER_MEDIAN3 | ADC_DRV_FILTER_MAVG  , 1 )  \
+   X(AIN_CH2             , ADC_CHANNEL_6  , -90, 1155  , 14, ADC_DRV_FILTER_LPF_10HZ                       , 1 )  \
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
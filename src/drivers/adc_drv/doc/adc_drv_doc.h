@@ -32,7 +32,39 @@
  * such as filtering and scaling. It also lets the upper layers set 
  * triggers by comparing the converted value to some threshold and 
  * calling a function callout.
- * 
+ *
+ * Every channel has its own filter chain selected in #ADC_DRV_INPUTS_CFG:
+ * spike rejection with a median of 3, a 10Hz low pass filter and a
+ * moving average, followed by an optional decimation. The chains are
+ * statically allocated and run in the ADC DMA interrupt, so channels
+ * without filters add no processing time.
+ *
+ * The scans are started by a timer at #ADC_DRV_SAMPLE_RATE_HZ times
+ * 2^#ADC_DRV_OVERSAMPLING_SHIFT, and the conversions of every channel are
+ * added into samples at #ADC_DRV_SAMPLE_RATE_HZ. With some noise at the
+ * input this gives samples with more resolution than the ADC; each
+ * channel chooses how many bits it keeps.
+ *
+ * The DMA buffer holds the scans of 2 * #ADC_DRV_BLOCK_SAMPLES samples.
+ * The half transfer and transfer complete interrupts each process the
+ * half the DMA just filled as a block: filters, statistics and triggers
+ * see every sample, but the interrupt overhead is paid once per block.
+ * The #ADCDrv_OnNewBlock callout runs at the end of every block, so a
+ * control loop closed on the filtered values runs at the block rate.
+ *
+ * Two sets of statistics are kept for every channel: since the last
+ * #ADCDrv_ResetStats, used to measure every breath phase, and over a
+ * sliding window of the last 2^#ADC_DRV_STATS_WINDOW_SHIFT filtered
+ * samples. Both give min, max, mean, RMS and the integral over time.
+ * The interrupt only adds sums and updates the min and max queues; the
+ * divisions are done when the statistics are read.
+ *
+ * A trigger is raised when the filtered value stays past its threshold
+ * for the debounce samples, and released when it stays back past the
+ * hysteresis for as long. The interrupt reads the triggers from one of
+ * two tables and never waits: registering or removing a trigger edits
+ * the other table and publishes it with a single write.
+ *
  * @startuml
  *
  * @enduml
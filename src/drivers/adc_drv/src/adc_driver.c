@@ -42,6 +42,8 @@
 #include "standard.h"
 #include "stm32f1xx_hal.h"
 #include "logger_api.h"
+#include "profiler_api.h"
+#include "trace_api.h"
 
 //********************************************************************
 //! @addtogroup adc_drv_imp
@@ -51,6 +53,7 @@
 #include "adc_drv_api.h"
 #include "adc_drv_conf.h"
 #include "adc_drv_callouts.h"
+#include "lpf_butter_10hz_q31.h"
 
 
 //********************************************************************
@@ -61,8 +64,12 @@
 // Constant and Macro Definitions using #define
 //********************************************************************
 #define LOG_TAG "ADCDrv"
-#define ADC_INVALID_VALUE (0xFFFF)
 #define ADC_VALUE_NO_OVERRIDE (-1)
+#define ADC_DRV_OVERSAMPLING (1 << ADC_DRV_OVERSAMPLING_SHIFT)
+#define ADC_DRV_BLOCK_SCANS (ADC_DRV_BLOCK_SAMPLES * ADC_DRV_OVERSAMPLING)
+#define ADC_DRV_DMA_SCANS (2 * ADC_DRV_BLOCK_SCANS)
+#define ADC_DRV_STATS_WINDOW (1 << ADC_DRV_STATS_WINDOW_SHIFT)
+#define ADC_DRV_STATS_WINDOW_MASK (ADC_DRV_STATS_WINDOW - 1)
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
@@ -73,62 +80,150 @@ typedef struct adc_dvr_ch_cfg_tag
    uint8_t     hw_channel;
    int32_t    limit_l;
    int32_t    limit_h;
+   uint8_t     resolution;
+   uint8_t     filters;
+   uint8_t     decimation;
+   uint8_t     sumShift;      // shift from the sum of the conversions to the resolution
+   int32_t    maxOutput;     // full scale of the samples
 } ADCDrvChCfgType;
 
+// Filter chain state of a channel
+typedef struct adc_drv_filter_tag
+{
+   int16_t median[2];
+   lpf_butter_10hz_q31Type lpf;
+   int16_t mavg[ADC_DRV_FILTER_MAVG_SIZE];
+   int32_t mavgSum;
+   uint8_t mavgIdx;
+   uint8_t decimationCnt;
+} ADCDrvFilterType;
+
+// Statistics of a channel since its last reset
+typedef struct adc_drv_stats_tag
+{
+   int16_t min;
+   int16_t max;
+   uint32_t tmin;
+   uint32_t tmax;
+   uint32_t samples;
+   int64_t sum;
+   uint64_t sumSq;
+} ADCDrvStatsType;
+
+// Window positions ordered by age whose values are also ordered, so the
+// front one holds the min (or max) of the window
+typedef struct adc_drv_deque_tag
+{
+   uint8_t pos[ADC_DRV_STATS_WINDOW];
+   uint16_t head;
+   uint16_t tail;
+} ADCDrvDequeType;
+
+// Sliding window statistics of a channel
+typedef struct adc_drv_window_tag
+{
+   int16_t value[ADC_DRV_STATS_WINDOW];
+   uint16_t pos;        // where the next value goes
+   uint16_t fill;
+   int32_t sum;
+   uint64_t sumSq;
+   ADCDrvDequeType minQ;
+   ADCDrvDequeType maxQ;
+} ADCDrvWindowType;
+
+// Trigger slot. The configuration and pendingAttention belong to the
+// main loop, the state to the interrupt.
 typedef struct adc_drv_trigger_cdt_tag
 {
    ADCDrvTriggerConfType config;
-
-   //used internally
-   uint32_t id;
-   volatile Bool raised;
-   uint32_t rawThreshold;
-   volatile uint32_t value;
+   Bool used;
    volatile Bool pendingAttention;
+
+   volatile Bool raised;         // the condition held for the debounce samples
+   volatile int32_t value;       // last value past the threshold
+   uint16_t count;               // consecutive samples changing the state
 } ADCDrvTriggerCDType;
 
+// Trigger evaluated by the interrupt, with raw thresholds
+typedef struct adc_drv_trigger_entry_tag
+{
+   uint8_t slot;
+   uint8_t channel;
+   uint8_t type;
+   uint16_t debounce;
+   int32_t rawThreshold;
+   int32_t rawRelease;           // threshold moved back by the hysteresis
+} ADCDrvTriggerEntryType;
+
+// The main loop edits the table the interrupt is not reading and
+// publishes it with a single write
+typedef struct adc_drv_trigger_table_tag
+{
+   uint32_t qtty;
+   ADCDrvTriggerEntryType entries[ADC_DRV_MAX_TRIGGERS];
+} ADCDrvTriggerTableType;
+
 
 typedef struct adc_drv_tag
 {
+   volatile uint16_t an_buffer_dma[ADC_DRV_DMA_SCANS][AN_NUM_CHANNELS];
    volatile uint16_t an_buffer_raw[AN_NUM_CHANNELS];
    volatile int16_t an_buffer_f[AN_NUM_CHANNELS];
-   volatile uint16_t an_buffer_min[AN_NUM_CHANNELS];
-   volatile uint16_t an_buffer_max[AN_NUM_CHANNELS];
-   volatile uint16_t an_buffer_avg[AN_NUM_CHANNELS];
-   volatile uint32_t an_buffer_min_time[AN_NUM_CHANNELS];
-   volatile uint32_t an_buffer_max_time[AN_NUM_CHANNELS];
-   volatile uint32_t an_buffer_avg_samples[AN_NUM_CHANNELS];
+   ADCDrvStatsType stats[AN_NUM_CHANNELS];
+   volatile Bool statsReset[AN_NUM_CHANNELS];
+   ADCDrvWindowType windows[AN_NUM_CHANNELS];
+   volatile uint32_t statsSeq;      // incremented after every statistics update
    volatile int32_t an_buffer_override[AN_NUM_CHANNELS];
+   int16_t an_block_f[AN_NUM_CHANNELS][ADC_DRV_BLOCK_SAMPLES];
+   uint8_t an_block_size[AN_NUM_CHANNELS];
 
-   //lpf_butter_10hz_floatType *filter_lpf;
+   ADCDrvFilterType filters[AN_NUM_CHANNELS];
 
-   Bool lockTriggers;
    ADCDrvTriggerCDType triggers[ADC_DRV_MAX_TRIGGERS];
-   uint32_t triggersQtty;
+   ADCDrvTriggerTableType triggerTables[2];
+   volatile uint8_t activeTriggerTable;
    ADC_HandleTypeDef hadc;
    DMA_HandleTypeDef hdma_adc;
+   TIM_HandleTypeDef htim;
 } ADCDrvType;
 
 //********************************************************************
 // Function Prototypes for Private Functions with File Level Scope
 //********************************************************************
 static int32_t Scale(int32_t value, int32_t min_from, int32_t max_from, int32_t min_to, int32_t max_to);
-static void adc_drv_update_stats(void);
+static void adc_drv_process_block(uint32_t firstScan);
+static void adc_drv_update_stats(uint32_t timestamp);
+static void adc_drv_window_push(ADCDrvWindowType *window, int16_t value);
+static void adc_drv_summarize(ADCDrvChType channel, Bool scaled, uint32_t samples, int64_t sum, uint64_t sumSq,
+                              int32_t *pAvg, int32_t *pRms, int32_t *pIntegral, uint32_t *pDuration);
+static uint32_t adc_drv_isqrt(uint64_t value);
 static void adc_drv_process_triggers(void);
-static void adc_drv_process_overrides(void);
-static void adc_drv_process_filters(void);
-StatusType adc_drv_wait_for_lock(volatile Bool *pLock);
+static void adc_drv_process_overrides(uint32_t firstScan);
+static void adc_drv_process_filters(uint32_t firstScan);
+static void adc_drv_reset_filter(ADCDrvChType channel);
+static int32_t adc_drv_median3(int32_t a, int32_t b, int32_t c);
+static ADCDrvTriggerTableType *adc_drv_edit_trigger_table(void);
+static ADCDrvTriggerCDType *adc_drv_get_trigger(ADCDrvTriggerConfType *trigger);
+static StatusType adc_drv_trigger_timer_init(void);
 
 //********************************************************************
 // ROM Const Variables With File Level Scope
 //********************************************************************
-#define X(a,b,c,d) { b, c, d },
+#define X(a,b,c,d,e,f,g) { b, c, d, e, f, g, \
+   ADC_DRV_RESOLUTION + ADC_DRV_OVERSAMPLING_SHIFT - (e), ADC_DRV_MAX_OUTPUT << ((e) - ADC_DRV_RESOLUTION) },
 static ADCDrvChCfgType const adc_drv_ch_cfg[] =
 {
       ADC_DRV_INPUTS_CFG
 };
 #undef X
 
+// the resolution must be between the conversion one and the oversampled
+// one, and the samples must fit in the 16 bit signed filter paths
+#define X(a,b,c,d,e,f,g) && ((e) >= ADC_DRV_RESOLUTION) \
+   && ((e) <= ADC_DRV_RESOLUTION + ADC_DRV_OVERSAMPLING_SHIFT) && ((e) <= 15)
+typedef char adc_drv_ch_cfg_check[(1 ADC_DRV_INPUTS_CFG)? 1 : -1];
+#undef X
+
 //********************************************************************
 // Static Variables and Const Variables With File Level Scope
 //********************************************************************
@@ -143,19 +238,20 @@ StatusType ADCDrv_Init(void)
    uint32_t i;
    ADC_ChannelConfTypeDef sConfig = {0};
 
-   //adc_drv_data.filter_lpf = lpf_butter_10hz_float_create();
-   //lpf_butter_10hz_float_init(adc_drv_data.filter_lpf);
-
-   adc_drv_data.triggersQtty = 0;
-   adc_drv_data.lockTriggers = FALSE;
+   adc_drv_data.triggerTables[0].qtty = 0;
+   adc_drv_data.activeTriggerTable = 0;
+   for(i = 0; i < ADC_DRV_MAX_TRIGGERS; i++)
+   {
+      adc_drv_data.triggers[i].used = FALSE;
+   }
 
    adc_drv_data.hadc.Instance = ADC1;
    adc_drv_data.hadc.Init.ScanConvMode = ADC_SCAN_ENABLE;
    adc_drv_data.hadc.Init.ContinuousConvMode = DISABLE; //ENABLE;
    adc_drv_data.hadc.Init.DiscontinuousConvMode = DISABLE;
-   adc_drv_data.hadc.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+   adc_drv_data.hadc.Init.ExternalTrigConv = ADC_DRV_TRIGGER_CONV;
    adc_drv_data.hadc.Init.DataAlign = ADC_DATAALIGN_RIGHT;
-   adc_drv_data.hadc.Init.NbrOfConversion = 3;
+   adc_drv_data.hadc.Init.NbrOfConversion = AN_NUM_CHANNELS;
    if (HAL_ADC_Init(&adc_drv_data.hadc) != HAL_OK)
    {
       return E_ERROR;
@@ -169,6 +265,9 @@ StatusType ADCDrv_Init(void)
       // reset override
       adc_drv_data.an_buffer_override[i] = ADC_VALUE_NO_OVERRIDE;
 
+      // reset the filter chain
+      adc_drv_reset_filter(i);
+
       // Configure Channel
       sConfig.Channel = adc_drv_ch_cfg[i].hw_channel;
       sConfig.Rank = ADC_REGULAR_RANK_1 + i;
@@ -205,39 +304,38 @@ StatusType ADCDrv_Init(void)
 
    ADCDrv_DriverInit();
 
-   HAL_ADC_Start_DMA(&adc_drv_data.hadc, (uint32_t*)adc_drv_data.an_buffer_raw, AN_NUM_CHANNELS);
+   // every trigger converts one scan, the circular DMA keeps the buffer
+   // armed so the CPU doesn't take part in the sampling. Each half of
+   // the buffer is processed while the DMA fills the other one.
+   if (HAL_OK != HAL_ADC_Start_DMA(&adc_drv_data.hadc, (uint32_t*)adc_drv_data.an_buffer_dma, ADC_DRV_DMA_SCANS * AN_NUM_CHANNELS))
+   {
+      return E_ERROR;
+   }
 
-   return E_OK;
+   return adc_drv_trigger_timer_init();
 }
 
 void ADCDrv_Update(void)
 {
    uint32_t i;
 
-   for(i=0; i < adc_drv_data.triggersQtty; i++)
+   for(i=0; i < ADC_DRV_MAX_TRIGGERS; i++)
    {
       ADCDrvTriggerCDType *trigger = &adc_drv_data.triggers[i];
-      if ((!trigger->pendingAttention) && (trigger->raised))
+      if ((trigger->used) && (!trigger->pendingAttention) && (trigger->raised))
       {
          ADCDrvChType ch = trigger->config.channel;
          int32_t value = Scale(trigger->value,
-               0, ADC_DRV_MAX_OUTPUT,
+               0, adc_drv_ch_cfg[ch].maxOutput,
                adc_drv_ch_cfg[ch].limit_l, adc_drv_ch_cfg[ch].limit_h);
          //Logger_WriteLine("ADCT", "ch=%ul;v=%ld", ch, value);
          trigger->pendingAttention = TRUE;
          (*trigger->config.triggerFnt)(&trigger->config, value);
-
-         trigger->raised = FALSE;
       }
    }
 
 }
 
-void ADCDrv_StartConversion(void)
-{
-   HAL_ADC_Start_DMA(&adc_drv_data.hadc, (uint32_t*)adc_drv_data.an_buffer_raw, AN_NUM_CHANNELS);
-}
-
 int32_t ADCDrv_GetValue(ADCDrvChType channel, Bool applyFilter, Bool scaled)
 {
    int32_t value = 0;
@@ -246,11 +344,12 @@ int32_t ADCDrv_GetValue(ADCDrvChType channel, Bool applyFilter, Bool scaled)
    if ((0 <= channel) && (AN_NUM_CHANNELS > channel))
    {
       int16_t adcValue = (applyFilter == TRUE)? adc_drv_data.an_buffer_f[channel] : adc_drv_data.an_buffer_raw[channel];
+      int32_t maxOutput = (applyFilter == TRUE)? adc_drv_ch_cfg[channel].maxOutput : ADC_DRV_MAX_OUTPUT;
       // Check scale setting
       if (TRUE == scaled)
       {
          value = Scale (adcValue, 0,
-               ADC_DRV_MAX_OUTPUT,
+               maxOutput,
                adc_drv_ch_cfg[channel].limit_l,
                adc_drv_ch_cfg[channel].limit_h);
       }
@@ -268,12 +367,9 @@ StatusType ADCDrv_ResetStats(ADCDrvChType channel)
    // Check bounds
    if ((0 <= channel) && (AN_NUM_CHANNELS > channel))
    {
-      adc_drv_data.an_buffer_min[channel] = ADC_INVALID_VALUE;
-      adc_drv_data.an_buffer_max[channel] = ADC_INVALID_VALUE;
-      adc_drv_data.an_buffer_avg[channel] = ADC_INVALID_VALUE;
-      adc_drv_data.an_buffer_avg_samples[channel] = 0;
-      adc_drv_data.an_buffer_max_time[channel] = 0;
-      adc_drv_data.an_buffer_min_time[channel] = 0;
+      // the interrupt clears the statistics before the next block, so
+      // they are never written from both sides
+      adc_drv_data.statsReset[channel] = TRUE;
       return E_OK;
    }
    else
@@ -284,6 +380,9 @@ StatusType ADCDrv_ResetStats(ADCDrvChType channel)
 
 StatusType ADCDrv_GetStats(ADCDrvChType channel, ADCDrvChStatType *stats, Bool scaled)
 {
+   ADCDrvStatsType copy;
+   uint32_t seq;
+
    if (NULL == stats)
    {
       return E_ERROR;
@@ -292,30 +391,39 @@ StatusType ADCDrv_GetStats(ADCDrvChType channel, ADCDrvChStatType *stats, Bool s
    // Check bounds
    if ((0 <= channel) && (AN_NUM_CHANNELS > channel))
    {
-      if (adc_drv_data.an_buffer_avg_samples == 0)
+      // copy again if a block was processed in the middle
+      do
+      {
+         seq = adc_drv_data.statsSeq;
+         __DMB();
+         copy = adc_drv_data.stats[channel];
+         __DMB();
+      }
+      while (seq != adc_drv_data.statsSeq);
+
+      if ((0 == copy.samples) || (FALSE != adc_drv_data.statsReset[channel]))
       {
          return E_ERROR;
       }
+
+      adc_drv_summarize(channel, scaled, copy.samples, copy.sum, copy.sumSq,
+            &stats->avg, &stats->rms, &stats->integral, &stats->duration);
+
       // Check scale setting
       if (TRUE == scaled)
       {
-         stats->min = Scale (adc_drv_data.an_buffer_min[channel], 0,
-               ADC_DRV_MAX_OUTPUT,
+         stats->min = Scale (copy.min, 0,
+               adc_drv_ch_cfg[channel].maxOutput,
                adc_drv_ch_cfg[channel].limit_l,
                adc_drv_ch_cfg[channel].limit_h);
 
-         stats->max = Scale (adc_drv_data.an_buffer_max[channel], 0,
-               ADC_DRV_MAX_OUTPUT,
-               adc_drv_ch_cfg[channel].limit_l,
-               adc_drv_ch_cfg[channel].limit_h);
-
-         stats->avg = Scale (adc_drv_data.an_buffer_avg[channel], 0,
-               ADC_DRV_MAX_OUTPUT,
+         stats->max = Scale (copy.max, 0,
+               adc_drv_ch_cfg[channel].maxOutput,
                adc_drv_ch_cfg[channel].limit_l,
                adc_drv_ch_cfg[channel].limit_h);
 
          stats->value = Scale (adc_drv_data.an_buffer_f[channel], 0,
-                        ADC_DRV_MAX_OUTPUT,
+                        adc_drv_ch_cfg[channel].maxOutput,
                         adc_drv_ch_cfg[channel].limit_l,
                         adc_drv_ch_cfg[channel].limit_h);
 
@@ -323,20 +431,16 @@ StatusType ADCDrv_GetStats(ADCDrvChType channel, ADCDrvChStatType *stats, Bool s
                                  ADC_DRV_MAX_OUTPUT,
                                  adc_drv_ch_cfg[channel].limit_l,
                                  adc_drv_ch_cfg[channel].limit_h);
-
-         stats->tmin = adc_drv_data.an_buffer_min_time[channel];
-         stats->tmax = adc_drv_data.an_buffer_max_time[channel];
       }
       else
       {
-         stats->min = (int32_t)adc_drv_data.an_buffer_min[channel];
-         stats->max = (int32_t)adc_drv_data.an_buffer_max[channel];
-         stats->avg = (int32_t)adc_drv_data.an_buffer_avg[channel];
+         stats->min = (int32_t)copy.min;
+         stats->max = (int32_t)copy.max;
          stats->value = (int32_t)adc_drv_data.an_buffer_f[channel];
          stats->rawValue = (int32_t)adc_drv_data.an_buffer_raw[channel];
-         stats->tmin = adc_drv_data.an_buffer_min_time[channel];
-         stats->tmax = adc_drv_data.an_buffer_max_time[channel];
       }
+      stats->tmin = copy.tmin;
+      stats->tmax = copy.tmax;
       return E_OK;
    }
    else
@@ -345,128 +449,163 @@ StatusType ADCDrv_GetStats(ADCDrvChType channel, ADCDrvChStatType *stats, Bool s
    }
 }
 
+StatusType ADCDrv_GetWindowStats(ADCDrvChType channel, ADCDrvChWindowStatType *stats, Bool scaled)
+{
+   ADCDrvWindowType *window;
+   uint32_t seq, fill;
+   int32_t sum, min, max;
+   uint64_t sumSq;
+
+   if ((NULL == stats) || (0 > channel) || (AN_NUM_CHANNELS <= channel))
+   {
+      return E_ERROR;
+   }
+
+   window = &adc_drv_data.windows[channel];
+   do
+   {
+      seq = adc_drv_data.statsSeq;
+      __DMB();
+      fill = window->fill;
+      sum = window->sum;
+      sumSq = window->sumSq;
+      min = window->value[window->minQ.pos[window->minQ.head & ADC_DRV_STATS_WINDOW_MASK]];
+      max = window->value[window->maxQ.pos[window->maxQ.head & ADC_DRV_STATS_WINDOW_MASK]];
+      __DMB();
+   }
+   while (seq != adc_drv_data.statsSeq);
+
+   if (0 == fill)
+   {
+      return E_ERROR;
+   }
+
+   adc_drv_summarize(channel, scaled, fill, sum, sumSq,
+         &stats->avg, &stats->rms, &stats->integral, &stats->duration);
+
+   if (TRUE == scaled)
+   {
+      min = Scale (min, 0, adc_drv_ch_cfg[channel].maxOutput,
+            adc_drv_ch_cfg[channel].limit_l, adc_drv_ch_cfg[channel].limit_h);
+      max = Scale (max, 0, adc_drv_ch_cfg[channel].maxOutput,
+            adc_drv_ch_cfg[channel].limit_l, adc_drv_ch_cfg[channel].limit_h);
+   }
+   stats->min = min;
+   stats->max = max;
+
+   return E_OK;
+}
+
 
 StatusType ADCDrv_RegisterTrigger(ADCDrvTriggerConfType *trigger)
 {
    ADCDrvChType ch;
    ADCDrvTriggerCDType *t;
-   if (adc_drv_data.triggersQtty >= ADC_DRV_MAX_TRIGGERS)
-   {
-      return E_ERROR;
-   }
+   ADCDrvTriggerTableType *table;
+   ADCDrvTriggerEntryType *entry;
+   int32_t release;
+   uint32_t slot;
 
    if (NULL == trigger)
       return E_ERROR;
 
-   if ((trigger->channel >= AN_NUM_CHANNELS) || (NULL == trigger->triggerFnt))
+   if ((trigger->channel >= AN_NUM_CHANNELS) || (NULL == trigger->triggerFnt) || (trigger->hysteresis < 0))
       return E_ERROR;
 
-   if (E_OK != adc_drv_wait_for_lock(&adc_drv_data.lockTriggers))
+   for(slot = 0; (slot < ADC_DRV_MAX_TRIGGERS) && (adc_drv_data.triggers[slot].used); slot++);
+   if (slot >= ADC_DRV_MAX_TRIGGERS)
+   {
       return E_ERROR;
+   }
 
-   adc_drv_data.lockTriggers = TRUE;
-
+   // the slot is not in the published table, the interrupt doesn't use it
    ch = trigger->channel;
-   t = &adc_drv_data.triggers[adc_drv_data.triggersQtty];
-
-   t->id = adc_drv_data.triggersQtty;
-   t->rawThreshold = Scale (trigger->threshold,
-         adc_drv_ch_cfg[ch].limit_l,adc_drv_ch_cfg[ch].limit_h,
-         0, ADC_DRV_MAX_OUTPUT);
-   t->raised = FALSE;
-
-   adc_drv_data.triggersQtty++;
-
-   trigger->uuid = t->id;
+   t = &adc_drv_data.triggers[slot];
+   trigger->uuid = slot;
    t->config = *trigger;
+   t->used = TRUE;
+   t->pendingAttention = FALSE;
+   t->raised = FALSE;
+   t->count = 0;
+
+   release = (ADC_DRV_TRIGGER_TYPE_HIGHER_THAN == trigger->type)?
+         trigger->threshold - trigger->hysteresis : trigger->threshold + trigger->hysteresis;
+
+   table = adc_drv_edit_trigger_table();
+   entry = &table->entries[table->qtty];
+   entry->slot = slot;
+   entry->channel = ch;
+   entry->type = trigger->type;
+   entry->debounce = (0 == trigger->debounce)? 1 : trigger->debounce;
+   entry->rawThreshold = Scale (trigger->threshold,
+         adc_drv_ch_cfg[ch].limit_l,adc_drv_ch_cfg[ch].limit_h,
+         0, adc_drv_ch_cfg[ch].maxOutput);
+   entry->rawRelease = Scale (release,
+         adc_drv_ch_cfg[ch].limit_l,adc_drv_ch_cfg[ch].limit_h,
+         0, adc_drv_ch_cfg[ch].maxOutput);
+   table->qtty++;
 
-   adc_drv_data.lockTriggers = FALSE;
+   // the table is complete in memory before the interrupt can read it
+   __DMB();
+   adc_drv_data.activeTriggerTable ^= 1;
 
    return E_OK;
 }
 
 StatusType ADCDrv_UnregisterTrigger(ADCDrvTriggerConfType *trigger)
 {
-   int32_t i, triggerIdx;
+   ADCDrvTriggerCDType *t = adc_drv_get_trigger(trigger);
+   ADCDrvTriggerTableType *table;
+   uint32_t i, n;
 
-   if ((adc_drv_data.triggersQtty == 0) || (NULL == trigger))
+   if (NULL == t)
    {
       return E_ERROR;
    }
-   if (E_OK != adc_drv_wait_for_lock(&adc_drv_data.lockTriggers))
-      return E_ERROR;
-
-   adc_drv_data.lockTriggers = TRUE;
 
-   triggerIdx = -1;
-   for(i=0; i < adc_drv_data.triggersQtty; i++)
+   table = adc_drv_edit_trigger_table();
+   for(i = 0, n = 0; i < table->qtty; i++)
    {
-      if (adc_drv_data.triggers[i].id == trigger->uuid)
+      if (table->entries[i].slot != trigger->uuid)
       {
-         triggerIdx = i;
-         break;
+         table->entries[n++] = table->entries[i];
       }
    }
+   table->qtty = n;
 
-   if (triggerIdx < 0)
-   {
-      adc_drv_data.lockTriggers = FALSE;
-      return E_ERROR;
-   }
-
-   for(i=triggerIdx; i < (adc_drv_data.triggersQtty - 1); i++)
-   {
-      adc_drv_data.triggers[i] = adc_drv_data.triggers[i+1];
-   }
-
-   adc_drv_data.triggersQtty--;
+   // the table is complete in memory before the interrupt can read it
+   __DMB();
+   adc_drv_data.activeTriggerTable ^= 1;
+   __DMB();
 
-   adc_drv_data.lockTriggers = FALSE;
+   // the interrupt reads the new table from now on, the slot is free
+   t->used = FALSE;
 
    return E_OK;
 }
 
 StatusType ADCDrv_ResetTrigger(ADCDrvTriggerConfType *trigger)
 {
-   int32_t i, triggerIdx;
+   ADCDrvTriggerCDType *t = adc_drv_get_trigger(trigger);
 
-   if ((adc_drv_data.triggersQtty == 0) || (NULL == trigger))
+   if (NULL == t)
    {
       return E_ERROR;
    }
 
-   triggerIdx = -1;
-   for(i=0; i < adc_drv_data.triggersQtty; i++)
-   {
-      if (adc_drv_data.triggers[i].id == trigger->uuid)
-      {
-         triggerIdx = i;
-         break;
-      }
-   }
-
-   if (triggerIdx < 0)
-      return E_ERROR;
-
-   adc_drv_data.triggers[triggerIdx].pendingAttention = FALSE;
+   t->pendingAttention = FALSE;
 
    return E_OK;
 }
 
 void ADCDrv_Dbg(void)
 {
-   char tmp[64];
-   uint32_t i, pos;
+   uint32_t i;
 
-   pos = 0;
    for(i=0; i< AN_NUM_CHANNELS; i++)
    {
-      pos += snprintf(tmp + pos, 64-pos, "%lu=%u;", i, adc_drv_data.an_buffer_f[i]);
+      LOG_PRINT_INFO(DEBUG_ADC_DRV, LOG_TAG, "ch=%lu;v=%d", i, adc_drv_data.an_buffer_f[i]);
    }
-
-   tmp[pos] = '\0';
-
-   LOG_PRINT_INFO(DEBUG_ADC_DRV, LOG_TAG, "%s", tmp);
 }
 
 void ADCDrv_DMAIRQHandler(void)
@@ -474,7 +613,7 @@ void ADCDrv_DMAIRQHandler(void)
    DMA_HandleTypeDef *hdma = &(adc_drv_data.hdma_adc);
    uint32_t flag_it = hdma->DmaBaseAddress->ISR;
    uint32_t source_it = hdma->Instance->CCR;
-
+   PROF_BEGIN(PROF_ADC_DMA_IRQ);
 
    /* Half Transfer Complete Interrupt management ******************************/
    if (((flag_it & (DMA_FLAG_HT1 << hdma->ChannelIndex)) != RESET) && ((source_it & DMA_IT_HT) != RESET))
@@ -488,7 +627,8 @@ void ADCDrv_DMAIRQHandler(void)
       /* Clear the half transfer complete flag */
       __HAL_DMA_CLEAR_FLAG(hdma, __HAL_DMA_GET_HT_FLAG_INDEX(hdma));
 
-      // if you want here you can notify someone about the half transfer event
+      // the first half of the buffer is ready
+      adc_drv_process_block(0);
    }
 
    /* Transfer Complete Interrupt management ***********************************/
@@ -511,22 +651,8 @@ void ADCDrv_DMAIRQHandler(void)
       /* Process Unlocked */
       __HAL_UNLOCK(hdma);
 
-      // if you want here you can notify someone about the transfer complete event
-      IOWritePinID(IO_DBG_LED, IO_ON);
-      adc_drv_process_overrides();
-      adc_drv_process_filters();
-
-      //adc_drv_data.an_buffer_f[1] = adc_drv_data.an_buffer_raw[1];
-      //adc_drv_data.an_buffer_f[2] = adc_drv_data.an_buffer_raw[0];
-      //tmpIn = (1.0f * adc_drv_data.an_buffer_raw[0]) / 4096;
-      //lpf_butter_10hz_float_writeInput(adc_drv_data.filter_lpf, tmpIn);
-      //tmpOut = lpf_butter_10hz_float_readOutput(adc_drv_data.filter_lpf);
-      //adc_drv_data.an_buffer_f[0] = (int16_t)(tmpOut * 4096);
-
-      adc_drv_update_stats();
-      adc_drv_process_triggers();
-      IOWritePinID(IO_DBG_LED, IO_OFF);
-      //HAL_ADC_Start_DMA(&adc_drv_data.hadc, (uint32_t*)adc_drv_data.an_buffer, AN_NUM_CHANNELS);
+      // the second half of the buffer is ready
+      adc_drv_process_block(ADC_DRV_BLOCK_SCANS);
    }
 
    /* Transfer Error Interrupt management **************************************/
@@ -551,116 +677,402 @@ void ADCDrv_DMAIRQHandler(void)
 
       // if you want here you can notify someone about the error event
    }
+
+   PROF_END(PROF_ADC_DMA_IRQ);
    return;
 }
 
-StatusType adc_drv_wait_for_lock(volatile Bool *pLock)
+static ADCDrvTriggerTableType *adc_drv_edit_trigger_table(void)
 {
-   uint32_t count;
-   count = ADC_DRV_WAIT_FOR_LOCK_TIMEOUT * (SystemCoreClock / 25U / 1000U);
-   do
+   ADCDrvTriggerTableType *active = &adc_drv_data.triggerTables[adc_drv_data.activeTriggerTable];
+   ADCDrvTriggerTableType *table = &adc_drv_data.triggerTables[adc_drv_data.activeTriggerTable ^ 1];
+
+   // the interrupt runs to completion before the main loop continues, so
+   // the table not published is never in use
+   *table = *active;
+
+   return table;
+}
+
+static ADCDrvTriggerCDType *adc_drv_get_trigger(ADCDrvTriggerConfType *trigger)
+{
+   if ((NULL == trigger) || (trigger->uuid >= ADC_DRV_MAX_TRIGGERS) ||
+       (!adc_drv_data.triggers[trigger->uuid].used))
    {
-      count--;
-      if (count == 0U)
-      {
-         return E_ERROR;
-      }
+      return NULL;
    }
-   while (*pLock != FALSE);
 
-   return E_OK;
+   return &adc_drv_data.triggers[trigger->uuid];
 }
 
-static void adc_drv_process_filters(void)
+static StatusType adc_drv_trigger_timer_init(void)
 {
-   uint32_t i;
-   for(i=0; i< AN_NUM_CHANNELS; i++)
+   TIM_MasterConfigTypeDef sMasterConfig = {0};
+
+   adc_drv_data.htim.Instance = ADC_DRV_TRIGGER_TIMER;
+   adc_drv_data.htim.Init.Prescaler = ADC_DRV_TRIGGER_TIMER_PRESCALER;
+   adc_drv_data.htim.Init.CounterMode = TIM_COUNTERMODE_UP;
+   adc_drv_data.htim.Init.Period = (ADC_DRV_TRIGGER_TIMER_CLOCK_HZ / (ADC_DRV_TRIGGER_TIMER_PRESCALER + 1))
+                                   / (ADC_DRV_SAMPLE_RATE_HZ * ADC_DRV_OVERSAMPLING) - 1;
+   adc_drv_data.htim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+   adc_drv_data.htim.Init.RepetitionCounter = 0;
+   adc_drv_data.htim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+   if (HAL_OK != HAL_TIM_Base_Init(&adc_drv_data.htim))
+   {
+      return E_ERROR;
+   }
+
+   // the update event starts a scan
+   sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+   sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+   if (HAL_OK != HAL_TIMEx_MasterConfigSynchronization(&adc_drv_data.htim, &sMasterConfig))
+   {
+      return E_ERROR;
+   }
+
+   if (HAL_OK != HAL_TIM_Base_Start(&adc_drv_data.htim))
    {
-      ADCDrv_FilterSignal(i, adc_drv_data.an_buffer_raw[i], &adc_drv_data.an_buffer_f[i]);
+      return E_ERROR;
    }
+
+   return E_OK;
 }
 
-static void adc_drv_update_stats(void)
+static void adc_drv_process_block(uint32_t firstScan)
 {
-   uint32_t i;
+   // all the samples of the block share the time it was completed
+   uint32_t timestamp = ADCDrv_GetHighResTimestamp();
+
+   IOWritePinID(IO_DBG_LED, IO_ON);
+   adc_drv_process_overrides(firstScan);
+   adc_drv_process_filters(firstScan);
+   adc_drv_update_stats(timestamp);
+   adc_drv_process_triggers();
+   ADCDrv_OnNewBlock();
+   IOWritePinID(IO_DBG_LED, IO_OFF);
+}
+
+static void adc_drv_process_filters(uint32_t firstScan)
+{
+   q31_t block[ADC_DRV_BLOCK_SAMPLES];
+   uint32_t i, k, j, n;
 
    for(i=0; i< AN_NUM_CHANNELS; i++)
    {
-      // calculate the minimum value
-      if ((ADC_INVALID_VALUE == adc_drv_data.an_buffer_min[i]) || (adc_drv_data.an_buffer_f[i] < adc_drv_data.an_buffer_min[i]))
+      const ADCDrvChCfgType *cfg = &adc_drv_ch_cfg[i];
+      ADCDrvFilterType *filter = &adc_drv_data.filters[i];
+      volatile uint16_t (*scan)[AN_NUM_CHANNELS] = &adc_drv_data.an_buffer_dma[firstScan];
+
+      // every sample is the sum of the oversampled conversions, rounded
+      // to the channel resolution
+      for(k = 0; k < ADC_DRV_BLOCK_SAMPLES; k++)
       {
-         adc_drv_data.an_buffer_min[i] = adc_drv_data.an_buffer_f[i];
-         adc_drv_data.an_buffer_min_time[i] = ADCDrv_GetHighResTimestamp();
+         q31_t sum = (1 << cfg->sumShift) >> 1;
+
+         for(j = 0; j < ADC_DRV_OVERSAMPLING; j++, scan++)
+         {
+            sum += (*scan)[i];
+         }
+         block[k] = sum >> cfg->sumShift;
       }
+      adc_drv_data.an_buffer_raw[i] = adc_drv_data.an_buffer_dma[firstScan + ADC_DRV_BLOCK_SCANS - 1][i];
 
-      // calculate the average value
-      if (ADC_INVALID_VALUE == adc_drv_data.an_buffer_min[i])
+      if (cfg->filters & ADC_DRV_FILTER_MEDIAN3)
       {
-         adc_drv_data.an_buffer_avg[i] = adc_drv_data.an_buffer_f[i];
-         adc_drv_data.an_buffer_avg_samples[i] = 1;
+         for(k = 0; k < ADC_DRV_BLOCK_SAMPLES; k++)
+         {
+            q31_t in = block[k];
+
+            block[k] = adc_drv_median3(filter->median[0], filter->median[1], in);
+            filter->median[0] = filter->median[1];
+            filter->median[1] = in;
+         }
       }
-      else
+
+      if (cfg->filters & ADC_DRV_FILTER_LPF_10HZ)
       {
-         adc_drv_data.an_buffer_avg[i] = (adc_drv_data.an_buffer_avg[i] * adc_drv_data.an_buffer_avg_samples[i] + adc_drv_data.an_buffer_f[i])
-                                 / (adc_drv_data.an_buffer_avg_samples[i] + 1);
+         uint32_t shift = LPF_BUTTER_10HZ_Q31_INPUT_SHIFT(cfg->resolution);
+
+         for(k = 0; k < ADC_DRV_BLOCK_SAMPLES; k++)
+         {
+            block[k] <<= shift;
+         }
+         lpf_butter_10hz_q31_filterBlock(&filter->lpf, block, block, ADC_DRV_BLOCK_SAMPLES);
+         for(k = 0; k < ADC_DRV_BLOCK_SAMPLES; k++)
+         {
+            block[k] = (block[k] + (1 << (shift - 1))) >> shift;
+         }
+      }
 
-         if (adc_drv_data.an_buffer_avg_samples[i] < ADC_DRV_STATS_AVG_MAX_WINDOW )
+      if (cfg->filters & ADC_DRV_FILTER_MAVG)
+      {
+         for(k = 0; k < ADC_DRV_BLOCK_SAMPLES; k++)
          {
-            adc_drv_data.an_buffer_avg_samples[i]++;
+            filter->mavgSum += block[k] - filter->mavg[filter->mavgIdx];
+            filter->mavg[filter->mavgIdx] = block[k];
+            filter->mavgIdx = (filter->mavgIdx + 1) & (ADC_DRV_FILTER_MAVG_SIZE - 1);
+            block[k] = filter->mavgSum / ADC_DRV_FILTER_MAVG_SIZE;
          }
       }
 
-      // calculate the max value
-      if ((ADC_INVALID_VALUE == adc_drv_data.an_buffer_max[i]) || (adc_drv_data.an_buffer_f[i] > adc_drv_data.an_buffer_max[i]))
+      // the filters run on every sample, the output is decimated
+      n = 0;
+      for(k = 0; k < ADC_DRV_BLOCK_SAMPLES; k++)
+      {
+         if (++filter->decimationCnt >= cfg->decimation)
+         {
+            filter->decimationCnt = 0;
+            adc_drv_data.an_block_f[i][n++] = (int16_t)block[k];
+         }
+      }
+      adc_drv_data.an_block_size[i] = n;
+      if (n > 0)
       {
-         adc_drv_data.an_buffer_max[i] = adc_drv_data.an_buffer_f[i];
-         adc_drv_data.an_buffer_max_time[i] = ADCDrv_GetHighResTimestamp();
+         adc_drv_data.an_buffer_f[i] = adc_drv_data.an_block_f[i][n - 1];
       }
    }
 }
 
-static void adc_drv_process_triggers(void)
+static void adc_drv_reset_filter(ADCDrvChType channel)
 {
+   ADCDrvFilterType *filter = &adc_drv_data.filters[channel];
    uint32_t i;
 
-   if (TRUE == adc_drv_data.lockTriggers)
+   filter->median[0] = 0;
+   filter->median[1] = 0;
+   lpf_butter_10hz_q31_init(&filter->lpf);
+   for(i = 0; i < ADC_DRV_FILTER_MAVG_SIZE; i++)
    {
-      //triggers are locked. we skip processing them
-      return;
+      filter->mavg[i] = 0;
    }
+   filter->mavgSum = 0;
+   filter->mavgIdx = 0;
+   filter->decimationCnt = 0;
+   adc_drv_data.an_block_size[channel] = 0;
+}
 
-   adc_drv_data.lockTriggers = TRUE;
+static int32_t adc_drv_median3(int32_t a, int32_t b, int32_t c)
+{
+   if (a > b)
+   {
+      int32_t tmp = a;
+      a = b;
+      b = tmp;
+   }
+
+   // a <= b, the median is b clipped to the range [a, c]
+   if (c < a)
+      return a;
+   if (c < b)
+      return c;
+   return b;
+}
 
-   for(i=0; i< adc_drv_data.triggersQtty; i++)
+static void adc_drv_update_stats(uint32_t timestamp)
+{
+   uint32_t i, k;
+
+   for(i=0; i< AN_NUM_CHANNELS; i++)
    {
-      ADCDrvTriggerCDType *trigger = &adc_drv_data.triggers[i];
-      ADCDrvChType ch = trigger->config.channel;
-      int32_t threshold = trigger->rawThreshold;
-      int32_t adcValue = adc_drv_data.an_buffer_f[ch];
+      ADCDrvStatsType *stats = &adc_drv_data.stats[i];
+
+      if (FALSE != adc_drv_data.statsReset[i])
+      {
+         stats->samples = 0;
+         stats->sum = 0;
+         stats->sumSq = 0;
+         adc_drv_data.statsReset[i] = FALSE;
+      }
+
+      // only additions and compares per sample, the divisions are left
+      // to the readers
+      for(k=0; k < adc_drv_data.an_block_size[i]; k++)
+      {
+         int16_t value = adc_drv_data.an_block_f[i][k];
+
+         if ((0 == stats->samples) || (value < stats->min))
+         {
+            stats->min = value;
+            stats->tmin = timestamp;
+         }
+         if ((0 == stats->samples) || (value > stats->max))
+         {
+            stats->max = value;
+            stats->tmax = timestamp;
+         }
+         stats->samples++;
+         stats->sum += value;
+         stats->sumSq += (uint32_t)(value * value);
+
+         adc_drv_window_push(&adc_drv_data.windows[i], value);
+      }
+   }
+
+   adc_drv_data.statsSeq++;
+}
+
+static void adc_drv_window_push(ADCDrvWindowType *window, int16_t value)
+{
+   uint8_t pos = (uint8_t)window->pos;
+   ADCDrvDequeType *q;
+
+   // the oldest value leaves the window
+   if (ADC_DRV_STATS_WINDOW == window->fill)
+   {
+      int16_t old = window->value[pos];
+
+      window->sum -= old;
+      window->sumSq -= (uint32_t)(old * old);
+      if (window->minQ.pos[window->minQ.head & ADC_DRV_STATS_WINDOW_MASK] == pos)
+      {
+         window->minQ.head++;
+      }
+      if (window->maxQ.pos[window->maxQ.head & ADC_DRV_STATS_WINDOW_MASK] == pos)
+      {
+         window->maxQ.head++;
+      }
+   }
+   else
+   {
+      window->fill++;
+   }
+
+   window->value[pos] = value;
+   window->sum += value;
+   window->sumSq += (uint32_t)(value * value);
+
+   // values that can't be the min or the max while the new one is in the
+   // window are dropped
+   q = &window->minQ;
+   while ((q->tail != q->head) && (window->value[q->pos[(q->tail - 1) & ADC_DRV_STATS_WINDOW_MASK]] >= value))
+   {
+      q->tail--;
+   }
+   q->pos[q->tail++ & ADC_DRV_STATS_WINDOW_MASK] = pos;
+
+   q = &window->maxQ;
+   while ((q->tail != q->head) && (window->value[q->pos[(q->tail - 1) & ADC_DRV_STATS_WINDOW_MASK]] <= value))
+   {
+      q->tail--;
+   }
+   q->pos[q->tail++ & ADC_DRV_STATS_WINDOW_MASK] = pos;
+
+   window->pos = (pos + 1) & ADC_DRV_STATS_WINDOW_MASK;
+}
+
+static void adc_drv_summarize(ADCDrvChType channel, Bool scaled, uint32_t samples, int64_t sum, uint64_t sumSq,
+                              int32_t *pAvg, int32_t *pRms, int32_t *pIntegral, uint32_t *pDuration)
+{
+   const ADCDrvChCfgType *cfg = &adc_drv_ch_cfg[channel];
+   int64_t periodUs = (1000000LL * cfg->decimation) / ADC_DRV_SAMPLE_RATE_HZ;
+   int64_t mean = sum / (int64_t)samples;
+   int64_t meanSq = (int64_t)(sumSq / samples);
+   int64_t integral;
+
+   if (TRUE == scaled)
+   {
+      int64_t range = cfg->limit_h - cfg->limit_l;
+      int64_t max = cfg->maxOutput;
+
+      // y = limit_l + range * x / max, so
+      // mean(y^2) = limit_l^2 + 2 * limit_l * range * mean(x) / max + range^2 * mean(x^2) / max^2
+      *pAvg = Scale((int32_t)mean, 0, cfg->maxOutput, cfg->limit_l, cfg->limit_h);
+      meanSq = (int64_t)cfg->limit_l * cfg->limit_l + (2 * cfg->limit_l * range * mean) / max
+               + (range * range * meanSq) / (max * max);
+      integral = (int64_t)cfg->limit_l * samples + (range * sum) / max;
+   }
+   else
+   {
+      *pAvg = (int32_t)mean;
+      integral = sum;
+   }
 
-      switch (trigger->config.type)
+   *pRms = (int32_t)adc_drv_isqrt((meanSq > 0) ? (uint64_t)meanSq : 0);
+   integral = (integral * periodUs) / 1000;
+   if (integral > INT32_MAX)
+   {
+      integral = INT32_MAX;
+   }
+   else if (integral < INT32_MIN)
+   {
+      integral = INT32_MIN;
+   }
+   *pIntegral = (int32_t)integral;
+   *pDuration = (uint32_t)((samples * periodUs) / 1000);
+}
+
+static uint32_t adc_drv_isqrt(uint64_t value)
+{
+   uint64_t result = 0;
+   uint64_t bit = 1ULL << 62;
+
+   while (bit > value)
+   {
+      bit >>= 2;
+   }
+
+   while (0 != bit)
+   {
+      if (value >= result + bit)
+      {
+         value -= result + bit;
+         result = (result >> 1) + bit;
+      }
+      else
+      {
+         result >>= 1;
+      }
+      bit >>= 2;
+   }
+
+   return (uint32_t)result;
+}
+
+static void adc_drv_process_triggers(void)
+{
+   const ADCDrvTriggerTableType *table = &adc_drv_data.triggerTables[adc_drv_data.activeTriggerTable];
+   uint32_t i, k;
+
+   for(i=0; i< table->qtty; i++)
+   {
+      const ADCDrvTriggerEntryType *entry = &table->entries[i];
+      ADCDrvTriggerCDType *trigger = &adc_drv_data.triggers[entry->slot];
+      Bool higher = (ADC_DRV_TRIGGER_TYPE_HIGHER_THAN == entry->type);
+
+      // the trigger is raised when every sample is past the threshold
+      // for the debounce samples, and released the same way once they
+      // are back past the hysteresis
+      for(k=0; k < adc_drv_data.an_block_size[entry->channel]; k++)
       {
-         case ADC_DRV_TRIGGER_TYPE_LOWER_THAN:
-            if (adcValue < threshold)
+         int32_t adcValue = adc_drv_data.an_block_f[entry->channel][k];
+         Bool past;
+
+         if (!trigger->raised)
+         {
+            past = (higher)? (adcValue > entry->rawThreshold) : (adcValue < entry->rawThreshold);
+         }
+         else
+         {
+            past = (higher)? (adcValue < entry->rawRelease) : (adcValue > entry->rawRelease);
+            if (!past)
             {
-               trigger->raised = TRUE;
                trigger->value = adcValue;
             }
-            break;
-         case ADC_DRV_TRIGGER_TYPE_HIGHER_THAN:
-            if (adcValue > threshold)
+         }
+
+         trigger->count = (past)? trigger->count + 1 : 0;
+         if (trigger->count >= entry->debounce)
+         {
+            trigger->count = 0;
+            trigger->value = adcValue;
+            trigger->raised = !trigger->raised;
+            if (trigger->raised)
             {
-               trigger->raised = TRUE;
-               trigger->value = adcValue;
+               TRACE_EVENT(TRACE_EV_ADC_TRIGGER, entry->slot, entry->channel);
             }
-            break;
-         default:
-            break;
+         }
       }
    }
-
-   adc_drv_data.lockTriggers = FALSE;
-
 }
 
 
@@ -692,15 +1104,18 @@ static int32_t Scale(int32_t value, int32_t min_from, int32_t max_from, int32_t
 // functions for debugging purposses
 //***********************************
 
-static void adc_drv_process_overrides(void)
+static void adc_drv_process_overrides(uint32_t firstScan)
 {
-   uint32_t i;
+   uint32_t i, k;
 
    for(i=0; i< AN_NUM_CHANNELS; i++)
    {
       if (ADC_VALUE_NO_OVERRIDE != adc_drv_data.an_buffer_override[i])
       {
-         adc_drv_data.an_buffer_raw[i] = adc_drv_data.an_buffer_override[i];
+         for(k=0; k < ADC_DRV_BLOCK_SCANS; k++)
+         {
+            adc_drv_data.an_buffer_dma[firstScan + k][i] = adc_drv_data.an_buffer_override[i];
+         }
       }
    }
 }
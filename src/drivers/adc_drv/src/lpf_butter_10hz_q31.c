@@ -0,0 +1,103 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       lpf_butter_10hz_q31.c
+//!
+//!   \brief      Fixed point 10Hz Butterworth low pass filter. The q31
+//!               coefficients are computed by the compiler from the
+//!               floating point design, so both versions of the filter
+//!               can't drift apart.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#include "standard.h"
+#include "profiler_api.h"
+#include "lpf_butter_10hz_q31.h"
+
+#include <string.h> // For memset
+
+// Converts a floating point coefficient to q31 scaled by 2^-postShift,
+// rounding to the nearest value
+#define LPF_BUTTER_10HZ_Q31_COEF( coef )  \
+   ((q31_t)(((coef) * 1073741824.0) + (((coef) < 0) ? -0.5 : 0.5)))
+
+const q31_t lpf_butter_10hz_q31_coefficients[10] =
+{
+// Floating point design from lpf_butter_10hz_float.c
+
+    LPF_BUTTER_10HZ_Q31_COEF(0.0009200498139105926), LPF_BUTTER_10HZ_Q31_COEF(0.0018400996278211852), LPF_BUTTER_10HZ_Q31_COEF(0.0009200498139105926), LPF_BUTTER_10HZ_Q31_COEF(1.8866095826215064), LPF_BUTTER_10HZ_Q31_COEF(-0.8903397362840242),// b0, b1, b2, a1, a2
+    LPF_BUTTER_10HZ_Q31_COEF(0.0009765625), LPF_BUTTER_10HZ_Q31_COEF(0.001953125), LPF_BUTTER_10HZ_Q31_COEF(0.0009765625), LPF_BUTTER_10HZ_Q31_COEF(1.9492159580258417), LPF_BUTTER_10HZ_Q31_COEF(-0.9530698953278909)// b0, b1, b2, a1, a2
+
+};
+
+
+void lpf_butter_10hz_q31_init( lpf_butter_10hz_q31Type * pThis )
+{
+   // the CMSIS instance doesn't take const coefficients, they are only read
+   arm_biquad_cascade_df1_init_q31( &pThis->instance, lpf_butter_10hz_q31_numStages, (q31_t *)lpf_butter_10hz_q31_coefficients, pThis->state, lpf_butter_10hz_q31_postShift );
+   lpf_butter_10hz_q31_reset( pThis );
+
+}
+
+void lpf_butter_10hz_q31_reset( lpf_butter_10hz_q31Type * pThis )
+{
+   memset( &pThis->state, 0, sizeof( pThis->state ) ); // Reset state to 0
+   pThis->output = 0;                           // Reset output
+
+}
+
+int16_t lpf_butter_10hz_q31_filterSample( lpf_butter_10hz_q31Type * pThis, int16_t input )
+{
+   q31_t tmpIn = (q31_t)input << LPF_BUTTER_10HZ_Q31_SAMPLE_SHIFT;
+
+   lpf_butter_10hz_q31_writeInput( pThis, tmpIn );
+   return (int16_t)(lpf_butter_10hz_q31_readOutput( pThis ) >> LPF_BUTTER_10HZ_Q31_SAMPLE_SHIFT);
+
+}
+
+int lpf_butter_10hz_q31_filterBlock( lpf_butter_10hz_q31Type * pThis, q31_t * pInput, q31_t * pOutput, unsigned int count )
+{
+   PROF_BEGIN(PROF_BIQUAD);
+   arm_biquad_cascade_df1_fast_q31( &pThis->instance, pInput, pOutput, count );
+   PROF_END(PROF_BIQUAD);
+   return count;
+
+}
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,94 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       lpf_butter_10hz_q31.h
+//!
+//!   \brief      Fixed point version of the 10Hz Butterworth low pass
+//!               filter found in lpf_butter_10hz_float.h. Two biquad
+//!               stages in q31 run by arm_biquad_cascade_df1_fast_q31(),
+//!               so the filter doesn't need floating point emulation on
+//!               the Cortex-M3.
+//!
+//!   \author     agent
+//!
+//!   \date       16 Oct 2026
+//!
+//********************************************************************
+
+#ifndef LPF_BUTTER_10HZ_Q31_H_ // Include guards
+#define LPF_BUTTER_10HZ_Q31_H_
+
+#define ARM_MATH_CM3  // Use ARM Cortex M3
+#include <arm_math.h>    // Include CMSIS header
+
+// Coefficients are stored divided by 2^postShift, as a1 is above 1.0
+extern const q31_t lpf_butter_10hz_q31_coefficients[10];
+static const int lpf_butter_10hz_q31_numStages = 2;
+static const int lpf_butter_10hz_q31_postShift = 1;
+
+// Samples of the given bits are moved to q31 leaving one bit of headroom
+// for the overshoot of the filter: full scale is 0.5
+#define LPF_BUTTER_10HZ_Q31_INPUT_SHIFT( bits )  (30 - (bits))
+
+// 12 bits ADC samples
+#define LPF_BUTTER_10HZ_Q31_SAMPLE_SHIFT  LPF_BUTTER_10HZ_Q31_INPUT_SHIFT(12)
+
+typedef struct
+{
+   arm_biquad_casd_df1_inst_q31 instance;
+   q31_t state[8];
+   q31_t output;
+} lpf_butter_10hz_q31Type;
+
+
+void lpf_butter_10hz_q31_init( lpf_butter_10hz_q31Type * pThis );
+void lpf_butter_10hz_q31_reset( lpf_butter_10hz_q31Type * pThis );
+#define lpf_butter_10hz_q31_writeInput( pThis, input )  \
+   arm_biquad_cascade_df1_fast_q31( &pThis->instance, &input, &pThis->output, 1 );
+
+#define lpf_butter_10hz_q31_readOutput( pThis )  \
+   pThis->output
+
+int16_t lpf_butter_10hz_q31_filterSample( lpf_butter_10hz_q31Type * pThis, int16_t input );
+int lpf_butter_10hz_q31_filterBlock( lpf_butter_10hz_q31Type * pThis, q31_t * pInput, q31_t * pOutput, unsigned int count );
+#define lpf_butter_10hz_q31_outputToFloat( output )  \
+   ((1.0f / 2147483648.0f) * (output))
+
+#define lpf_butter_10hz_q31_inputFromFloat( input )  \
+   ((q31_t)(2147483648.0f * (input)))
+
+#endif // LPF_BUTTER_10HZ_Q31_H_
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -51,6 +51,11 @@
 #define CLOCK_DRV_HIGH_RES_TIMER_CLK_DIV        (TIM_CLOCKDIVISION_DIV1)    /**< High resolution timer clock divisor */
 
 #define CLOCK_DRV_TIMER_PERIOD                  (100)                       /**< High resolution timer period (us) */
+#if (BOARD_CONF_REV >= 2)
+#define CLOCK_DRV_TIMER_OC_CHANNEL              (4)                         /**< Output compare channel of the timer period, 1 or 4. Channel 1 captures the flow meter */
+#else
+#define CLOCK_DRV_TIMER_OC_CHANNEL              (1)                         /**< Output compare channel of the timer period, 1 or 4 */
+#endif
 
 #define CLOCK_DRV_HIGH_RES_TIMER_IRQ_NAME          (TIM1_UP_IRQn)           /**< High resolution timer irq */
 #define CLOCK_DRV_HIGH_RES_TIMER_IRQ_PRIORITY      (0)                      /**< High resolution timer priority */
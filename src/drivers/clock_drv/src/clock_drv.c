@@ -40,6 +40,7 @@
 //********************************************************************
 #include "standard.h"
 #include "stm32f1xx_hal.h"
+#include "profiler_api.h"
 
 //********************************************************************
 //! @addtogroup clock_drv_imp
@@ -56,6 +57,23 @@
 //********************************************************************
 // Constant and Macro Definitions using #define
 //********************************************************************
+#if (CLOCK_DRV_TIMER_OC_CHANNEL == 4)
+#define CLOCK_DRV_OC_CHANNEL              (TIM_CHANNEL_4)
+#define CLOCK_DRV_OC_FLAG                 (TIM_FLAG_CC4)
+#define CLOCK_DRV_OC_IT                   (TIM_IT_CC4)
+#define CLOCK_DRV_OC_ACTIVE_CHANNEL       (HAL_TIM_ACTIVE_CHANNEL_4)
+#define CLOCK_DRV_OC_IS_OUTPUT(tim)       (((tim)->CCMR2 & TIM_CCMR2_CC4S) == 0x00U)
+#define CLOCK_DRV_OC_CCR(tim)             ((tim)->CCR4)
+#elif (CLOCK_DRV_TIMER_OC_CHANNEL == 1)
+#define CLOCK_DRV_OC_CHANNEL              (TIM_CHANNEL_1)
+#define CLOCK_DRV_OC_FLAG                 (TIM_FLAG_CC1)
+#define CLOCK_DRV_OC_IT                   (TIM_IT_CC1)
+#define CLOCK_DRV_OC_ACTIVE_CHANNEL       (HAL_TIM_ACTIVE_CHANNEL_1)
+#define CLOCK_DRV_OC_IS_OUTPUT(tim)       (((tim)->CCMR1 & TIM_CCMR1_CC1S) == 0x00U)
+#define CLOCK_DRV_OC_CCR(tim)             ((tim)->CCR1)
+#else
+#error "CLOCK_DRV_TIMER_OC_CHANNEL must be 1 or 4"
+#endif
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
@@ -95,7 +113,7 @@ StatusType ClockDrv_Init(void)
       return ret;
    }
 
-   if (HAL_OK != HAL_TIM_OC_Start_IT(&data.htim, TIM_CHANNEL_1))
+   if (HAL_OK != HAL_TIM_OC_Start_IT(&data.htim, CLOCK_DRV_OC_CHANNEL))
    {
       return ret;
    }
@@ -162,21 +180,22 @@ void ClockDrv_IRQHandler(void)
 void ClockDrv_CCIRQHandler(void)
 {
    TIM_HandleTypeDef *htim = &data.htim;
+   PROF_BEGIN(PROF_CLOCK_CC_IRQ);
 
-   /* Capture compare 1 event */
-   if (__HAL_TIM_GET_FLAG(htim, TIM_FLAG_CC1) != RESET)
+   /* Capture compare event */
+   if (__HAL_TIM_GET_FLAG(htim, CLOCK_DRV_OC_FLAG) != RESET)
    {
-      if (__HAL_TIM_GET_IT_SOURCE(htim, TIM_IT_CC1) != RESET)
+      if (__HAL_TIM_GET_IT_SOURCE(htim, CLOCK_DRV_OC_IT) != RESET)
       {
          {
-            __HAL_TIM_CLEAR_IT(htim, TIM_IT_CC1);
-            htim->Channel = HAL_TIM_ACTIVE_CHANNEL_1;
+            __HAL_TIM_CLEAR_IT(htim, CLOCK_DRV_OC_IT);
+            htim->Channel = CLOCK_DRV_OC_ACTIVE_CHANNEL;
 
-            if ((htim->Instance->CCMR1 & TIM_CCMR1_CC1S) == 0x00U)
+            if (CLOCK_DRV_OC_IS_OUTPUT(htim->Instance))
             {
                /* Output compare event */
                data.timerOC += (CLOCK_DRV_TIMER_PERIOD-1);
-               htim->Instance->CCR1 = data.timerOC;
+               CLOCK_DRV_OC_CCR(htim->Instance) = data.timerOC;
                ClockDrv_OnTimerEvent();
 
             }
@@ -184,6 +203,8 @@ void ClockDrv_CCIRQHandler(void)
          }
       }
    }
+
+   PROF_END(PROF_CLOCK_CC_IRQ);
 }
 
 StatusType clock_drv_timer_init(void)
@@ -226,7 +247,7 @@ StatusType clock_drv_timer_init(void)
    sConfigOC.Pulse = data.timerOC;
    sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
    sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
-   if (HAL_TIM_OC_ConfigChannel(&data.htim, &sConfigOC, TIM_CHANNEL_1) != HAL_OK)
+   if (HAL_TIM_OC_ConfigChannel(&data.htim, &sConfigOC, CLOCK_DRV_OC_CHANNEL) != HAL_OK)
    {
       return E_ERROR;
    }
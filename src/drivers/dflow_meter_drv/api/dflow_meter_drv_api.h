@@ -46,6 +46,22 @@
 // Enumerations and Structures and Typedefs
 //********************************************************************
 
+/**
+ * @brief Volumes measured along a breath, from the start of one inhale
+ *        to the start of the next one
+ *
+ */
+typedef struct dflow_meter_drv_breath_tag
+{
+   uint32_t inspiredML;       /**< inspired tidal volume (Vti) */
+   uint32_t expiredML;        /**< expired tidal volume (Vte) */
+   int32_t leakML;            /**< Vti - Vte, lost through leaks or sensor offset */
+   uint32_t durationMillis;   /**< length of the breath */
+   int32_t endExpFlow;        /**< flow at the end of the expiration in ml/min, 0 with the expiration complete and without leaks nor offset */
+   int32_t offsetFlow;        /**< end expiration flow averaged over the last breaths, in ml/min */
+   uint32_t minuteVolumeML;   /**< expired volume per minute over the last breaths */
+} DFlowMeterDrvBreathType;
+
 //********************************************************************
 // Global Variable extern Declarations
 //********************************************************************
@@ -55,10 +71,10 @@
 //********************************************************************
 // Remember to use extern modifier
 extern StatusType DFlowMeterDrv_Init(void);
-extern void DFlowMeterDrv_IRQEvHandler(void);
-extern void DFlowMeterDrv_IRQErHandler(void);
 extern uint32_t DFlowMeterDrv_GetVolume(void);
-extern StatusType DFlowMeterDrv_ResetVolume();
+extern StatusType DFlowMeterDrv_StartBreath(void);
+extern StatusType DFlowMeterDrv_StopBreath(void);
+extern StatusType DFlowMeterDrv_GetBreath(DFlowMeterDrvBreathType *pBreath);
 extern uint32_t DFlowMeterDrv_GetFlowRate(void);
 extern void DFlowMeterDrv_Update(void);
 
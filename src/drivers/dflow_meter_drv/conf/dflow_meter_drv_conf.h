@@ -41,12 +41,19 @@
 //********************************************************************
 // Constant and Macro Definitions using #define
 //********************************************************************
-#define DFLOW_METER_DRV_I2C_CH             2
-#define DFLOW_METER_DRV_I2C_IRQ_PRIORITY  (3)
+#define DFLOW_METER_DRV_I2C_BUS            (I2C_DRV_BUS_SENSORS) // clock and pins in i2c_drv_conf.h
+
+#define DFLOW_METER_DRV_SAMPLE_RATE_HZ     (1000)  // from 500 to 2000, the period a multiple of I2C_DRV_TICK_US
+#define DFLOW_METER_DRV_RING_SIZE          (64)    // samples, a power of 2. Holds more than a DFlowMeterDrv_Update period
 
 #define DFLOW_METER_DRV_I2C_ADDRESS        (0x49)
 #define DFLOW_METER_SENSOR_FULL_SCALE_FLOW (100) //SLPM
 
+#define DFLOW_METER_DRV_MAX_GAP_US         (10000) // longer gaps between samples are not integrated
+#define DFLOW_METER_DRV_END_EXP_SHIFT      (5)     // end expiration flow filter, 2^n samples
+#define DFLOW_METER_DRV_OFFSET_SHIFT       (3)     // flow offset filter, 2^n breaths
+#define DFLOW_METER_DRV_MV_BREATHS         (8)     // breaths in the minute volume
+
 //********************************************************************
 // Enumerations and Structures and Typedefs
 //********************************************************************
@@ -28,6 +28,11 @@
 //!   \file       dflow_meter_drv.c
 //!
 //!   \brief      This is the digital flow meter driver implementation.
+//!               The I2C bus manager reads the flow and its CRC at
+//!               DFLOW_METER_DRV_SAMPLE_RATE_HZ. The read completion checks
+//!               the CRC and stores the raw sample in a ring, and
+//!               DFlowMeterDrv_Update converts and integrates the samples
+//!               into the volumes of the breath.
 //!
 //!   \author     Esteban G. Pupillo
 //!
@@ -41,6 +46,7 @@
 #include "standard.h"
 #include "stm32f1xx_hal.h"
 #include "logger_api.h"
+#include "i2c_drv_api.h"
 
 //********************************************************************
 //! \addtogroup 
@@ -51,6 +57,7 @@
 #include "dflow_meter_drv_conf.h"
 #include "dflow_meter_drv_api.h"
 #include "dflow_meter_drv_callouts.h"
+#include "dflow_volume.h"
 
 
 //********************************************************************
@@ -62,16 +69,21 @@
 //********************************************************************
 #define LOG_TAG   "DFmeter"
 
-#define I2C_INSTANCE_(num)  I2C##num
-#define I2C_INSTANCE(num)   I2C_INSTANCE_(num)
+// every 16 bits word is followed by its CRC
+#define DFLOW_READ_SIZE       (3)
+#define DFLOW_CRC_POLYNOMIAL  (0x31)   // x^8 + x^5 + x^4 + 1
 
-#define I2C_EV_IRQ_(num)  I2C##num##_EV_IRQn
-#define I2C_EV_IRQ(num)   I2C_EV_IRQ_(num)
+#if ((DFLOW_METER_DRV_SAMPLE_RATE_HZ < 500) || (DFLOW_METER_DRV_SAMPLE_RATE_HZ > 2000))
+#error "DFLOW_METER_DRV_SAMPLE_RATE_HZ must be from 500 to 2000"
+#endif
 
-#define I2C_ER_IRQ_(num)  I2C##num##_ER_IRQn
-#define I2C_ER_IRQ(num)   I2C_ER_IRQ_(num)
+#if (((1000000 / DFLOW_METER_DRV_SAMPLE_RATE_HZ) % I2C_DRV_TICK_US) != 0)
+#error "DFLOW_METER_DRV_SAMPLE_RATE_HZ must give a period multiple of I2C_DRV_TICK_US"
+#endif
 
-#define PULSE_INTERVAL_TO_MILLILITERPERMIN(x)    ((((5e8 / (x)) + 44) / 825) * 100)
+#if ((DFLOW_METER_DRV_RING_SIZE & (DFLOW_METER_DRV_RING_SIZE - 1)) != 0)
+#error "DFLOW_METER_DRV_RING_SIZE must be a power of 2"
+#endif
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
@@ -82,26 +94,38 @@ typedef enum sensor_state_tag {
    DFLOW_SENSOR_STATE_READING_FLOW,
 } DFlowSensorStateType;
 
+typedef struct dflow_sample_tag
+{
+   uint16_t code;                // raw flow reading
+   uint32_t timestamp;           // high resolution timestamp of the reading
+} DFlowSampleType;
+
 typedef struct dflow_meter_data_tag
 {
-   uint32_t volume;
-   uint32_t flowAcc;
-   volatile uint32_t lastTimestamp;
-   volatile int32_t flow;
-   volatile int32_t lastFlow;
+   DFlowVolumeType vol;
+   DFlowMeterDrvBreathType breath; // last breath completed
+   Bool breathValid;
+   int32_t flow;
    Bool isInitialized;
-   I2C_HandleTypeDef  hi2c;
+   I2CDrvXferType xfer;          // periodic read scheduled on the bus
    uint8_t readBuf[4];
    uint32_t serialNumber;
    DFlowSensorStateType sensorState;
    volatile Bool commError;
-   volatile Bool readEnqueued;
+
+   DFlowSampleType ring[DFLOW_METER_DRV_RING_SIZE];
+   volatile uint32_t head;       // samples written by the I2C interrupt
+   uint32_t tail;                // samples processed by DFlowMeterDrv_Update
+   volatile uint32_t lost;       // samples dropped with the ring full
+   volatile uint32_t crcErrors;  // readings with a wrong CRC
 }DFlowMeterDataType;
 
 //********************************************************************
 // Function Prototypes for Private Functions with File Level Scope
 //********************************************************************
-static StatusType dflow_meter_drv_i2c_init(void);
+static void dflow_meter_drv_on_read(I2CDrvXferType *pXfer, I2CDrvResultType result);
+static uint8_t dflow_meter_drv_crc8(const uint8_t *pData, uint32_t size);
+static uint32_t dflow_meter_drv_process_samples(void);
 
 //********************************************************************
 // ROM Const Variables With File Level Scope
@@ -118,34 +142,84 @@ static DFlowMeterDataType flowMeterData;
 StatusType DFlowMeterDrv_Init(void)
 {
    flowMeterData.flow = 0;
-   flowMeterData.flow = 0;
-   flowMeterData.flowAcc = 0;
-   flowMeterData.lastTimestamp = 0;
-   flowMeterData.volume = 0;
+   flowMeterData.breathValid = FALSE;
+   dflow_volume_init(&flowMeterData.vol);
    flowMeterData.isInitialized = FALSE;
    flowMeterData.serialNumber = 0;
    flowMeterData.sensorState = DFLOW_SENSOR_STATE_READING_SN1;
    flowMeterData.commError = FALSE;
-   flowMeterData.readEnqueued = FALSE;
-
-   dflow_meter_drv_i2c_init();
+   flowMeterData.head = 0;
+   flowMeterData.tail = 0;
+   flowMeterData.lost = 0;
+   flowMeterData.crcErrors = 0;
+
+   // the bus manager starts every read
+   flowMeterData.xfer.bus = DFLOW_METER_DRV_I2C_BUS;
+   flowMeterData.xfer.address = DFLOW_METER_DRV_I2C_ADDRESS;
+   flowMeterData.xfer.dir = I2C_DRV_DIR_READ;
+   flowMeterData.xfer.reg = 0;
+   flowMeterData.xfer.pData = flowMeterData.readBuf;
+   flowMeterData.xfer.size = DFLOW_READ_SIZE;
+   flowMeterData.xfer.periodUs = 1000000 / DFLOW_METER_DRV_SAMPLE_RATE_HZ;
+   flowMeterData.xfer.phaseUs = 0;
+   flowMeterData.xfer.onDone = dflow_meter_drv_on_read;
+   flowMeterData.xfer.pUserData = NULL;
+
+   if (E_OK != I2CDrv_Schedule(&flowMeterData.xfer))
+   {
+      return E_ERROR;
+   }
 
    flowMeterData.isInitialized = TRUE;
 
    return E_OK;
 }
 
-StatusType DFlowMeterDrv_ResetVolume()
+StatusType DFlowMeterDrv_StartBreath(void)
+{
+   // the samples read so far belong to the breath being closed
+   dflow_meter_drv_process_samples();
+
+   if (E_OK == dflow_volume_end_breath(&flowMeterData.vol, DFlowMeterDrv_GetHighResTimestamp(), &flowMeterData.breath))
+   {
+      flowMeterData.breathValid = TRUE;
+      LOG_PRINT_INFO(DEBUG_FMETER, LOG_TAG, "vti=%lu;vte=%lu;lk=%d;fe=%d;fo=%d;mv=%lu;tb=%lu", flowMeterData.breath.inspiredML,
+                     flowMeterData.breath.expiredML, flowMeterData.breath.leakML, flowMeterData.breath.endExpFlow,
+                     flowMeterData.breath.offsetFlow, flowMeterData.breath.minuteVolumeML, flowMeterData.breath.durationMillis);
+   }
+
+   return E_OK;
+}
+
+StatusType DFlowMeterDrv_StopBreath(void)
+{
+   dflow_meter_drv_process_samples();
+
+   // the next breath starts a new history
+   dflow_volume_init(&flowMeterData.vol);
+   flowMeterData.breathValid = FALSE;
+
+   return E_OK;
+}
+
+StatusType DFlowMeterDrv_GetBreath(DFlowMeterDrvBreathType *pBreath)
 {
-   flowMeterData.flowAcc = 0;
-   flowMeterData.volume = 0;
+   if ((NULL == pBreath) || (FALSE == flowMeterData.breathValid))
+      return E_ERROR;
+
+   *pBreath = flowMeterData.breath;
 
    return E_OK;
 }
 
 void DFlowMeterDrv_Update(void)
 {
-   LOG_PRINT_INFO(DEBUG_FMETER, LOG_TAG, "f=%ld;v=%lu", flowMeterData.flow, flowMeterData.volume);
+   uint32_t samples;
+
+   samples = dflow_meter_drv_process_samples();
+
+   LOG_PRINT_INFO(DEBUG_FMETER, LOG_TAG, "f=%d;v=%lu;n=%lu;s=%lu;l=%lu;c=%lu", flowMeterData.flow, dflow_volume_inspired(&flowMeterData.vol),
+                  samples, flowMeterData.xfer.skipped, flowMeterData.lost, flowMeterData.crcErrors);
 
    // check if there is a communication error
    if (FALSE != flowMeterData.commError)
@@ -156,36 +230,13 @@ void DFlowMeterDrv_Update(void)
       //Reset errror flag
       flowMeterData.commError = FALSE;
    }
-
-   // initiate a new read.
-   // the function is non-blocking. Once the read is finished the correspoding
-   // interrupt callback will be called
-   if ((FALSE == flowMeterData.readEnqueued) &&
-       (HAL_OK == HAL_I2C_Master_Receive_IT(&flowMeterData.hi2c, DFLOW_METER_DRV_I2C_ADDRESS << 1, flowMeterData.readBuf, 2)))
-   {
-      flowMeterData.readEnqueued = TRUE;
-   }
-   else
-   {
-      //we couldn't start a new read. notify error!
-      DFlowMeterDrv_onError();
-   }
-
-}
-
-void DFlowMeterDrv_IRQEvHandler(void)
-{
-   HAL_I2C_EV_IRQHandler(&flowMeterData.hi2c);
-}
-
-void DFlowMeterDrv_IRQErHandler(void)
-{
-   HAL_I2C_ER_IRQHandler(&flowMeterData.hi2c);
 }
 
 uint32_t DFlowMeterDrv_GetVolume(void)
 {
-   return flowMeterData.volume;
+   dflow_meter_drv_process_samples();
+
+   return dflow_volume_inspired(&flowMeterData.vol);
 }
 
 uint32_t DFlowMeterDrv_GetFlowRate(void)
@@ -193,42 +244,48 @@ uint32_t DFlowMeterDrv_GetFlowRate(void)
    return flowMeterData.flow;
 }
 
-static StatusType dflow_meter_drv_i2c_init(void)
+static uint8_t dflow_meter_drv_crc8(const uint8_t *pData, uint32_t size)
 {
-   flowMeterData.hi2c.Instance = I2C_INSTANCE(DFLOW_METER_DRV_I2C_CH);
-   flowMeterData.hi2c.Mode = HAL_I2C_MODE_MASTER;
-   flowMeterData.hi2c.Init.ClockSpeed = 100000;
-   flowMeterData.hi2c.Init.DutyCycle = I2C_DUTYCYCLE_2;
-   flowMeterData.hi2c.Init.OwnAddress1 = 0;
-   flowMeterData.hi2c.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
-   flowMeterData.hi2c.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
-   flowMeterData.hi2c.Init.OwnAddress2 = 0;
-   flowMeterData.hi2c.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
-   flowMeterData.hi2c.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
-
-   if (HAL_I2C_Init(&flowMeterData.hi2c) != HAL_OK)
+   uint8_t crc = 0;
+   uint32_t i, bit;
+
+   for (i = 0; i < size; i++)
    {
-      return E_ERROR;
+      crc ^= pData[i];
+      for (bit = 0; bit < 8; bit++)
+      {
+         crc = (0 != (crc & 0x80)) ? (uint8_t)((crc << 1) ^ DFLOW_CRC_POLYNOMIAL) : (uint8_t)(crc << 1);
+      }
    }
 
-   // I2C interrupt Init
-   HAL_NVIC_SetPriority(I2C_EV_IRQ(DFLOW_METER_DRV_I2C_CH), DFLOW_METER_DRV_I2C_IRQ_PRIORITY, 0);
-   HAL_NVIC_EnableIRQ(I2C_EV_IRQ(DFLOW_METER_DRV_I2C_CH));
-   HAL_NVIC_SetPriority(I2C_ER_IRQ(DFLOW_METER_DRV_I2C_CH), DFLOW_METER_DRV_I2C_IRQ_PRIORITY, 0);
-   HAL_NVIC_EnableIRQ(I2C_ER_IRQ(DFLOW_METER_DRV_I2C_CH));
-
-   return E_OK;
+   return crc;
 }
 
-
-void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+static uint32_t dflow_meter_drv_process_samples(void)
 {
-   // use it only for debug purposes. The logger is not fully thread-safe
-   // therefore it can generate problems when called from ISR context
-   //Logger_WriteLine(LOG_TAG, "tx cmp;");
+   uint32_t head, count = 0;
+   DFlowSampleType *pSample;
+
+   // the samples up to head are complete once head is read
+   head = flowMeterData.head;
+   __DMB();
+
+   while (flowMeterData.tail != head)
+   {
+      pSample = &flowMeterData.ring[flowMeterData.tail & (DFLOW_METER_DRV_RING_SIZE - 1)];
+
+      flowMeterData.flow = dflow_volume_flow_from_code(pSample->code);
+      dflow_volume_add(&flowMeterData.vol, flowMeterData.flow, pSample->timestamp);
+
+      flowMeterData.tail++;
+      count++;
+   }
+
+   return count;
 }
 
-void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+
+static void dflow_meter_drv_on_read(I2CDrvXferType *pXfer, I2CDrvResultType result)
 {
    uint32_t now;
 
@@ -238,7 +295,18 @@ void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
    // therefore it can generate problems when called from ISR context
    //Logger_WriteLine(LOG_TAG, "r=%lu;%lu;", flowMeterData.readBuf[0], flowMeterData.readBuf[1]);
 
-   if (DFLOW_SENSOR_STATE_READING_SN1 == flowMeterData.sensorState)
+   if (I2C_DRV_RESULT_OK != result)
+   {
+      // not answered, or the bus was recovered. The next period reads again
+      flowMeterData.commError = TRUE;
+   }
+   else if (dflow_meter_drv_crc8(flowMeterData.readBuf, 2) != flowMeterData.readBuf[2])
+   {
+      // the reading is dropped
+      flowMeterData.crcErrors++;
+      flowMeterData.commError = TRUE;
+   }
+   else if (DFLOW_SENSOR_STATE_READING_SN1 == flowMeterData.sensorState)
    {
       // read first 2 bytes of serial number
       flowMeterData.serialNumber = (flowMeterData.readBuf[0] << 24) + (flowMeterData.readBuf[1] << 16);
@@ -249,38 +317,29 @@ void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
       // read first 2 bytes of serial number
       flowMeterData.serialNumber = (flowMeterData.readBuf[0] << 8) + (flowMeterData.readBuf[1] << 0);
       flowMeterData.sensorState = DFLOW_SENSOR_STATE_READING_FLOW;
-      flowMeterData.lastTimestamp = 0;
    }
    else if (DFLOW_SENSOR_STATE_READING_FLOW == flowMeterData.sensorState)
    {
-      // we are reading flow information
-      uint16_t tmp;
-      tmp = (flowMeterData.readBuf[0] << 8) + (flowMeterData.readBuf[1] << 0);
-      float flow = ((1.0 * DFLOW_METER_SENSOR_FULL_SCALE_FLOW) / 0.8) * (1.0 * tmp / 16384.0 - 0.1 );
+      // we are reading flow information. It is converted out of the interrupt
+      uint32_t head = flowMeterData.head;
 
-      flowMeterData.flow = (int32_t) (flow * 1000.0);
-      if ((0 != flowMeterData.lastTimestamp) && (0 < flowMeterData.flow))
+      if ((head - flowMeterData.tail) >= DFLOW_METER_DRV_RING_SIZE)
       {
-         uint32_t dt;
-         dt = now - flowMeterData.lastTimestamp;
-         flowMeterData.flowAcc += ((flowMeterData.flow * dt) / (60 * 1e4));
-         flowMeterData.volume = flowMeterData.flowAcc / 100;
+         flowMeterData.lost++;
       }
-      flowMeterData.lastFlow = flowMeterData.flow;
-      flowMeterData.lastTimestamp = now;
-   }
-   flowMeterData.readEnqueued = FALSE;
-}
+      else
+      {
+         DFlowSampleType *pSample = &flowMeterData.ring[head & (DFLOW_METER_DRV_RING_SIZE - 1)];
 
-void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
-{
-   // use it only for debug purposes. The logger is not fully thread-safe
-   // therefore it can generate problems when called from ISR context
-   //Logger_WriteLine(LOG_TAG, "e=%lu;", hi2c->ErrorCode);
-   flowMeterData.commError = TRUE;
-   flowMeterData.readEnqueued = FALSE;
-}
+         pSample->code = (flowMeterData.readBuf[0] << 8) + (flowMeterData.readBuf[1] << 0);
+         pSample->timestamp = now;
 
+         // publish the sample once it is complete
+         __DMB();
+         flowMeterData.head = head + 1;
+      }
+   }
+}
 
 //********************************************************************
 //
@@ -0,0 +1,242 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       dflow_volume.c
+//!
+//!   \brief      Digital flow meter volume integrator. Converts the
+//!               sensor readings to flow and integrates them with the
+//!               trapezoidal rule into the inspired and expired volumes
+//!               of every breath. At the end of each breath it gives
+//!               the leak, the flow left at the end of the expiration
+//!               and the minute volume. Only integer math is used.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+
+//********************************************************************
+//! @addtogroup dflow_meter_drv_imp
+//!   @{
+//********************************************************************
+
+#include "dflow_meter_drv_conf.h"
+#include "dflow_meter_drv_api.h"
+#include "dflow_volume.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+// the sensor reads 16384 * (0.1 + 0.8 * flow / full scale)
+#define DFLOW_VOLUME_CODE_ZERO      (16384)     // 10 times the reading at no flow
+#define DFLOW_VOLUME_CODE_SHIFT     (17)        // 10 times the readings per full scale is 8 * 16384
+#define DFLOW_VOLUME_FULL_SCALE     ((int64_t)DFLOW_METER_SENSOR_FULL_SCALE_FLOW * 1000)  // ml/min
+
+// twice the area in ml/min times us of one ml
+#define DFLOW_VOLUME_AREA_PER_ML    (2ULL * 60 * 1000000)
+
+#define DFLOW_VOLUME_FLOW_SHIFT     (8)         // fractional bits of the filtered flows
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static uint32_t dflow_volume_to_ml(uint64_t area);
+static int32_t dflow_volume_filtered_flow(int32_t flow);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+int32_t dflow_volume_flow_from_code(uint16_t code)
+{
+   int64_t num = ((int32_t)code * 10 - DFLOW_VOLUME_CODE_ZERO) * DFLOW_VOLUME_FULL_SCALE;
+
+   return (int32_t)((num + (1L << (DFLOW_VOLUME_CODE_SHIFT - 1))) >> DFLOW_VOLUME_CODE_SHIFT);
+}
+
+void dflow_volume_init(DFlowVolumeType *pVol)
+{
+   uint32_t i;
+
+   pVol->started = FALSE;
+   pVol->lastFlow = 0;
+   pVol->lastTimestamp = 0;
+   pVol->inBreath = FALSE;
+   pVol->breathStart = 0;
+   pVol->inspired = 0;
+   pVol->expired = 0;
+   pVol->endExpFlow = 0;
+   pVol->offsetFlow = 0;
+   pVol->offsetValid = FALSE;
+   for (i = 0; i < DFLOW_METER_DRV_MV_BREATHS; i++)
+   {
+      pVol->mvVolume[i] = 0;
+      pVol->mvTime[i] = 0;
+   }
+   pVol->mvIdx = 0;
+}
+
+void dflow_volume_add(DFlowVolumeType *pVol, int32_t flow, uint32_t timestamp)
+{
+   uint32_t dt = timestamp - pVol->lastTimestamp;
+   int32_t last = pVol->lastFlow;
+
+   if (FALSE == pVol->started)
+   {
+      pVol->endExpFlow = flow * (1L << DFLOW_VOLUME_FLOW_SHIFT);
+   }
+   else if (dt <= DFLOW_METER_DRV_MAX_GAP_US)
+   {
+      if ((last >= 0) && (flow >= 0))
+      {
+         pVol->inspired += (uint64_t)(last + flow) * dt;
+      }
+      else if ((last <= 0) && (flow <= 0))
+      {
+         pVol->expired += (uint64_t)(-(last + flow)) * dt;
+      }
+      else
+      {
+         // the flow crosses zero. Each side is a triangle ending where the
+         // line between the samples crosses, at dt * |side| / (|last| + |flow|)
+         uint64_t pos = (last > 0) ? last : flow;
+         uint64_t neg = (last < 0) ? -last : -flow;
+
+         pVol->inspired += (pos * pos * dt) / (pos + neg);
+         pVol->expired += (neg * neg * dt) / (pos + neg);
+      }
+   }
+
+   // the flow at the end of the expiration is the filtered flow when the
+   // next breath starts
+   pVol->endExpFlow += (flow * (1L << DFLOW_VOLUME_FLOW_SHIFT) - pVol->endExpFlow) >> DFLOW_METER_DRV_END_EXP_SHIFT;
+
+   pVol->started = TRUE;
+   pVol->lastFlow = flow;
+   pVol->lastTimestamp = timestamp;
+}
+
+StatusType dflow_volume_end_breath(DFlowVolumeType *pVol, uint32_t timestamp, DFlowMeterDrvBreathType *pBreath)
+{
+   StatusType ret = E_ERROR;
+   uint64_t mvVolume = 0, mvTime = 0;
+   uint32_t i;
+
+   if (FALSE != pVol->inBreath)
+   {
+      pBreath->inspiredML = dflow_volume_to_ml(pVol->inspired);
+      pBreath->expiredML = dflow_volume_to_ml(pVol->expired);
+      pBreath->leakML = (int32_t)pBreath->inspiredML - (int32_t)pBreath->expiredML;
+      pBreath->durationMillis = (timestamp - pVol->breathStart) / 1000;
+
+      // a flow left with the patient at rest is a leak or a sensor offset
+      if (FALSE == pVol->offsetValid)
+      {
+         pVol->offsetFlow = pVol->endExpFlow;
+         pVol->offsetValid = TRUE;
+      }
+      else
+      {
+         pVol->offsetFlow += (pVol->endExpFlow - pVol->offsetFlow) >> DFLOW_METER_DRV_OFFSET_SHIFT;
+      }
+      pBreath->endExpFlow = dflow_volume_filtered_flow(pVol->endExpFlow);
+      pBreath->offsetFlow = dflow_volume_filtered_flow(pVol->offsetFlow);
+
+      // expired volume over the length of the last breaths
+      pVol->mvVolume[pVol->mvIdx] = pBreath->expiredML;
+      pVol->mvTime[pVol->mvIdx] = pBreath->durationMillis;
+      pVol->mvIdx = (pVol->mvIdx + 1) % DFLOW_METER_DRV_MV_BREATHS;
+      for (i = 0; i < DFLOW_METER_DRV_MV_BREATHS; i++)
+      {
+         mvVolume += pVol->mvVolume[i];
+         mvTime += pVol->mvTime[i];
+      }
+      pBreath->minuteVolumeML = (0 != mvTime) ? (uint32_t)((mvVolume * 60000) / mvTime) : 0;
+
+      ret = E_OK;
+   }
+
+   pVol->inBreath = TRUE;
+   pVol->breathStart = timestamp;
+   pVol->inspired = 0;
+   pVol->expired = 0;
+
+   return ret;
+}
+
+uint32_t dflow_volume_inspired(const DFlowVolumeType *pVol)
+{
+   return dflow_volume_to_ml(pVol->inspired);
+}
+
+static uint32_t dflow_volume_to_ml(uint64_t area)
+{
+   return (uint32_t)((area + DFLOW_VOLUME_AREA_PER_ML / 2) / DFLOW_VOLUME_AREA_PER_ML);
+}
+
+static int32_t dflow_volume_filtered_flow(int32_t flow)
+{
+   return (flow + (1L << (DFLOW_VOLUME_FLOW_SHIFT - 1))) >> DFLOW_VOLUME_FLOW_SHIFT;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
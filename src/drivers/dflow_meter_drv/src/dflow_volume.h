@@ -0,0 +1,155 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       dflow_volume.h
+//!
+//!   \brief      Digital flow meter volume integrator header file
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _DFLOW_VOLUME_H
+#define  _DFLOW_VOLUME_H 1
+
+//********************************************************************
+//! @addtogroup dflow_meter_drv_imp
+//!   @{
+//********************************************************************
+
+#include "dflow_meter_drv_conf.h"
+#include "dflow_meter_drv_api.h"
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+/**
+ * @brief Volume integrator state. The volumes are kept as twice the
+ *        area under the flow, in ml/min times microseconds.
+ *
+ */
+typedef struct dflow_volume_tag
+{
+   Bool started;                                /**< a sample has been added */
+   int32_t lastFlow;                            /**< last flow added in ml/min */
+   uint32_t lastTimestamp;                      /**< timestamp of the last flow added in us */
+
+   Bool inBreath;                               /**< a breath has been started */
+   uint32_t breathStart;                        /**< timestamp of the start of the breath in us */
+   uint64_t inspired;                           /**< inspired volume of the breath */
+   uint64_t expired;                            /**< expired volume of the breath */
+   int32_t endExpFlow;                          /**< filtered flow, 2^8 times ml/min */
+   int32_t offsetFlow;                          /**< end expiration flow filtered along the breaths, 2^8 times ml/min */
+   Bool offsetValid;                            /**< offsetFlow holds the first breath at least */
+
+   uint32_t mvVolume[DFLOW_METER_DRV_MV_BREATHS]; /**< expired volume of the last breaths in ml */
+   uint32_t mvTime[DFLOW_METER_DRV_MV_BREATHS];   /**< length of the last breaths in ms */
+   uint32_t mvIdx;                              /**< next entry of the minute volume tables */
+} DFlowVolumeType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+/**
+ * @brief Convert a sensor reading to flow
+ *
+ * @param code raw sensor reading
+ *
+ * @return flow in ml/min, rounded to the nearest
+ */
+int32_t dflow_volume_flow_from_code(uint16_t code);
+
+/**
+ * @brief Clear the integrator and the breath history
+ *
+ * @param pVol integrator
+ */
+void dflow_volume_init(DFlowVolumeType *pVol);
+
+/**
+ * @brief Add a flow sample to the breath. The area from the previous
+ *        sample is added with the trapezoidal rule, to the inspired
+ *        volume where the flow is positive and to the expired volume
+ *        where it is negative. Samples more than
+ *        #DFLOW_METER_DRV_MAX_GAP_US apart are not joined.
+ *
+ * @param pVol integrator
+ * @param flow flow in ml/min
+ * @param timestamp time of the sample in us
+ */
+void dflow_volume_add(DFlowVolumeType *pVol, int32_t flow, uint32_t timestamp);
+
+/**
+ * @brief Close the breath in progress and start a new one
+ *
+ * @param pVol integrator
+ * @param timestamp time of the start of the new breath in us
+ * @param pBreath receives the volumes of the breath closed
+ *
+ * @return #E_OK if a breath was closed\n
+ *         #E_ERROR if this is the first breath, pBreath is not written
+ */
+StatusType dflow_volume_end_breath(DFlowVolumeType *pVol, uint32_t timestamp, DFlowMeterDrvBreathType *pBreath);
+
+/**
+ * @brief Volume inspired since the start of the breath
+ *
+ * @param pVol integrator
+ *
+ * @return volume in ml
+ */
+uint32_t dflow_volume_inspired(const DFlowVolumeType *pVol);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _DFLOW_VOLUME_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -55,11 +55,12 @@
 //********************************************************************
 // Remember to use extern modifier
 extern StatusType FlowMeterDrv_Init(void);
-extern void FlowMeterDrv_IRQHandler(void);
 extern uint32_t FlowMeterDrv_GetVolume(void);
 extern StatusType FlowMeterDrv_ResetVolume();
 extern uint32_t FlowMeterDrv_GetFlowRate(void);
 extern void FlowMeterDrv_Update(void);
+extern uint32_t FlowMeterDrv_GetOverruns(void);
+extern void FlowMeterDrv_DMAIRQHandler(void);
 
 #endif // _FLOW_METER_DRV_API_H
 //********************************************************************
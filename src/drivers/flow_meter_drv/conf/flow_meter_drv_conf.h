@@ -44,11 +44,23 @@
 
 // pin & port definition
 #define FLOW_METER_DRV_INPUT               (IO_FLOW_METER)
-#define FLOW_METER_DRV_IRQ                 (EXTI15_10_IRQn)
-#define FLOW_METER_DRV_IRQ_PRIORITY        (0)
-#define FLOW_METER_DRV_MAX_MEASURE_TIME_MS (100)
+#if (BOARD_CONF_REV >= 2)
+// the input is TIM1_CH1: the timer captures the pulses by DMA
+#define FLOW_METER_DRV_TIMER_CAPTURE
+#define FLOW_METER_DRV_TIMER               (TIM1)              // the clock driver 1MHz time base, only channel 1 is used here
+#define FLOW_METER_DRV_INPUT_FILTER        (0x0F)              // input capture filter, 8 samples at fDTS/32
+#define FLOW_METER_DRV_DMA_CHANNEL         (DMA1_Channel2)     // TIM1_CH1 request
+#define FLOW_METER_DRV_DMA_IRQ             (DMA1_Channel2_IRQn)
+#define FLOW_METER_DRV_DMA_IRQ_PRIORITY    (2)
+#endif
+#define FLOW_METER_DRV_CAPTURE_SIZE        (128)               // captures, a power of 2. More than the pulses between updates
+#define FLOW_METER_DRV_MAX_UPDATE_MS       (60)                // longest time between updates, under the 65 ms capture timer period
+#define FLOW_METER_DRV_MAX_MEASURE_TIME_MS (2000)              // slower pulses read as no flow
 
 // meter parameters
+#define FLOW_METER_DRV_PULSES_PER_LITER    (495)
+#define FLOW_METER_DRV_MAX_FLOW            (150)               // L/min
+#define FLOW_METER_DRV_FLOW_OFFSET         (5)                 // ml/min added to any flow measured
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
@@ -28,6 +28,17 @@
 //!   \file       flow_meter_drv.c
 //!
 //!   \brief      This is the flow meter driver implementation.
+//!               Every rising edge of the meter is captured by the
+//!               timer into a circular DMA buffer, so the pulses are
+//!               timed without an interrupt per pulse. The DMA counter
+//!               and the half and full buffer interrupts count the
+//!               pulses, and the captures give the time of the last
+//!               one; FlowMeterDrv_Update converts them into the flow
+//!               and the volume. An update late enough for the ring to
+//!               wrap over captures not read is counted as an overrun.
+//!               Only board revision 2 has the meter on a capture
+//!               input: before, FlowMeterDrv_Init fails and the meter
+//!               is not used.
 //!
 //!   \author     Esteban G. Pupillo
 //!
@@ -61,28 +72,49 @@
 // Constant and Macro Definitions using #define
 //********************************************************************
 #define LOG_TAG   "Fmeter"
-#define PULSE_INTERVAL_TO_MILLILITERPERMIN(x)    ((((5e8 / (x)) + 44) / 825) * 100)
+
+#if ((FLOW_METER_DRV_CAPTURE_SIZE & (FLOW_METER_DRV_CAPTURE_SIZE - 1)) != 0)
+#error "FLOW_METER_DRV_CAPTURE_SIZE must be a power of 2"
+#endif
+
+#if ((FLOW_METER_DRV_MAX_FLOW * FLOW_METER_DRV_PULSES_PER_LITER * FLOW_METER_DRV_MAX_UPDATE_MS) > \
+     (FLOW_METER_DRV_CAPTURE_SIZE * 60000))
+#error "FLOW_METER_DRV_CAPTURE_SIZE is less than the pulses at the max flow in the max update time"
+#endif
+
+#define FLOW_METER_CAPTURE_MASK    (FLOW_METER_DRV_CAPTURE_SIZE - 1)
+#define FLOW_METER_CAPTURE_HALF    (FLOW_METER_DRV_CAPTURE_SIZE / 2)
+
+// ml/min times us of a pulse period
+#define FLOW_METER_FLOW_PERIOD     ((uint32_t)(60000000000ULL / FLOW_METER_DRV_PULSES_PER_LITER))
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
 //********************************************************************
-typedef struct encoder_data_tag
+typedef struct flow_meter_data_tag
 {
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+   DMA_HandleTypeDef hdma;
+   volatile uint32_t halves;     // ring halves written, counted by the DMA interrupt
+#endif
+   uint16_t capture[FLOW_METER_DRV_CAPTURE_SIZE]; // timer value of every pulse
+   uint32_t captures;            // captures read
+   uint32_t overruns;            // updates that found the ring wrapped over captures not read
+   uint32_t pulses;              // since the initialization
+   uint32_t volumePulses;        // pulses at the last volume reset
+   uint32_t lastTimestamp;       // of the last pulse
+   uint32_t lastPeriod;          // of the last pulses read, in us
+   Bool pulseSeen;               // lastTimestamp is valid
    uint32_t volume;
-   uint32_t flowAcc;
-   volatile uint32_t lastTimestamp;
-   volatile uint32_t timePeriod;
-   volatile uint32_t intCounter;
-   volatile uint32_t flow;
-   uint32_t lastUpdate;
-   uint32_t lastIntCount;
+   uint32_t flow;
    Bool isInitialized;
 }flowMeterDataType;
 
 //********************************************************************
 // Function Prototypes for Private Functions with File Level Scope
 //********************************************************************
-static void flow_meter_drv_gpio_init(void);
+static StatusType flow_meter_drv_capture_init(void);
+static uint32_t flow_meter_drv_get_captures(void);
 
 //********************************************************************
 // ROM Const Variables With File Level Scope
@@ -98,16 +130,24 @@ static flowMeterDataType flowMeterData;
 //********************************************************************
 StatusType FlowMeterDrv_Init(void)
 {
-   flowMeterData.flow = 0;
-   flowMeterData.flowAcc = 0;
-   flowMeterData.intCounter = 0;
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+   flowMeterData.halves = 0;
+#endif
+   flowMeterData.captures = 0;
+   flowMeterData.overruns = 0;
+   flowMeterData.pulses = 0;
+   flowMeterData.volumePulses = 0;
    flowMeterData.lastTimestamp = 0;
-   flowMeterData.timePeriod = 0;
+   flowMeterData.lastPeriod = 0;
+   flowMeterData.pulseSeen = FALSE;
    flowMeterData.volume = 0;
-   flowMeterData.lastUpdate = 0;
+   flowMeterData.flow = 0;
    flowMeterData.isInitialized = FALSE;
 
-   flow_meter_drv_gpio_init();
+   if (E_OK != flow_meter_drv_capture_init())
+   {
+      return E_ERROR;
+   }
 
    flowMeterData.isInitialized = TRUE;
 
@@ -116,7 +156,7 @@ StatusType FlowMeterDrv_Init(void)
 
 StatusType FlowMeterDrv_ResetVolume()
 {
-   flowMeterData.flowAcc = 0;
+   flowMeterData.volumePulses = flowMeterData.pulses;
    flowMeterData.volume = 0;
 
    return E_OK;
@@ -124,100 +164,188 @@ StatusType FlowMeterDrv_ResetVolume()
 
 void FlowMeterDrv_Update(void)
 {
-   uint32_t curFlowRate;
-   uint32_t now, dt;
-   uint32_t intCount;
+   uint32_t now, elapsed;
+   uint32_t captures, count, last, timed;
+   uint32_t timestamp;
 
+   if (FALSE == flowMeterData.isInitialized)
+   {
+      return;
+   }
+
+   // the captures first, so every capture read is older than now
+   captures = flow_meter_drv_get_captures();
    now = FlowMeterDrv_GetHighResTimestamp();
-   intCount = flowMeterData.intCounter;
+   count = captures - flowMeterData.captures;
+   last = (captures - 1) & FLOW_METER_CAPTURE_MASK;
+
+   // the oldest captures were overwritten, but every pulse is counted
+   timed = count;
+   if (count > FLOW_METER_DRV_CAPTURE_SIZE)
+   {
+      timed = FLOW_METER_DRV_CAPTURE_SIZE;
+      flowMeterData.overruns++;
+      LOG_PRINT_ERR(DEBUG_FMETER, LOG_TAG, "overrun: %lu pulses since the last update", count);
+   }
 
-   if (flowMeterData.lastIntCount == intCount)
+   if (0 != count)
    {
-      if ( (now - flowMeterData.lastTimestamp) >= (FLOW_METER_DRV_MAX_MEASURE_TIME_MS * 1000))
+      // the low half of the timestamp is the timer counter, and the last
+      // capture is less than a counter period old
+      timestamp = now - (uint16_t)((uint16_t)now - flowMeterData.capture[last]);
+
+      if (FALSE != flowMeterData.pulseSeen)
       {
-         flowMeterData.flow = 0;
+         // mean of all the periods since the last pulse read before
+         elapsed = timestamp - flowMeterData.lastTimestamp;
+         flowMeterData.lastPeriod = elapsed / count;
+         flowMeterData.flow = (uint32_t)(((uint64_t)FLOW_METER_FLOW_PERIOD * count + elapsed / 2) / elapsed)
+                              + FLOW_METER_DRV_FLOW_OFFSET;
+      }
+      else if (timed > 1)
+      {
+         elapsed = (uint16_t)(flowMeterData.capture[last] -
+                              flowMeterData.capture[(captures - timed) & FLOW_METER_CAPTURE_MASK]);
+         flowMeterData.lastPeriod = elapsed / (timed - 1);
+         flowMeterData.flow = (uint32_t)(((uint64_t)FLOW_METER_FLOW_PERIOD * (timed - 1) + elapsed / 2) / elapsed)
+                              + FLOW_METER_DRV_FLOW_OFFSET;
       }
+
+      flowMeterData.pulses += count;
+      flowMeterData.captures = captures;
+      flowMeterData.lastTimestamp = timestamp;
+      flowMeterData.pulseSeen = TRUE;
    }
-   flowMeterData.lastIntCount = intCount;
+   else if (FALSE != flowMeterData.pulseSeen)
+   {
+      elapsed = now - flowMeterData.lastTimestamp;
 
-   curFlowRate = flowMeterData.flow;
-   dt = now - flowMeterData.lastUpdate;
+      if (elapsed >= (FLOW_METER_DRV_MAX_MEASURE_TIME_MS * 1000))
+      {
+         flowMeterData.flow = 0;
+         flowMeterData.pulseSeen = FALSE;
+      }
+      else if (elapsed > flowMeterData.lastPeriod)
+      {
+         // the next pulse is late, so the flow is at most this
+         flowMeterData.flow = (FLOW_METER_FLOW_PERIOD + elapsed / 2) / elapsed + FLOW_METER_DRV_FLOW_OFFSET;
+      }
+   }
 
-   flowMeterData.flowAcc += ((curFlowRate * dt) / (60 * 1e4));
-   flowMeterData.volume = flowMeterData.flowAcc / 100;
+   flowMeterData.volume = ((flowMeterData.pulses - flowMeterData.volumePulses) * 1000) / FLOW_METER_DRV_PULSES_PER_LITER;
 
-   flowMeterData.lastUpdate = now;
+   LOG_PRINT_INFO(DEBUG_FMETER, LOG_TAG, "f=%lu;v=%lu;p=%lu", flowMeterData.flow, flowMeterData.volume, flowMeterData.pulses);
+}
 
-   LOG_PRINT_INFO(DEBUG_FMETER, LOG_TAG, "f=%lu;v=%lu", flowMeterData.flow, flowMeterData.volume);
+uint32_t FlowMeterDrv_GetVolume(void)
+{
+   return flowMeterData.volume;
+}
 
-   //for debug purposes
-   //flowMeterData.intCounter++;
-   //flowMeterData.timePeriod = 200000;
-   //flowMeterData.flow = PULSE_INTERVAL_TO_MILLILITERPERMIN(flowMeterData.timePeriod);
-   //flowMeterData.lastTimestamp = now;
+uint32_t FlowMeterDrv_GetFlowRate(void)
+{
+   return flowMeterData.flow;
 }
 
-void FlowMeterDrv_IRQHandler(void)
+uint32_t FlowMeterDrv_GetOverruns(void)
 {
-   uint32_t counter, pinEXTI;
+   return flowMeterData.overruns;
+}
 
-   // EXTI line interrupt detected
+void FlowMeterDrv_DMAIRQHandler(void)
+{
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+   DMA_HandleTypeDef *hdma = &flowMeterData.hdma;
+   uint32_t flag_it = hdma->DmaBaseAddress->ISR;
 
-   // check the interrupt flags to see if they are associated with our pins
-   pinEXTI = __HAL_GPIO_EXTI_GET_IT(IOGetPinNumberFromPinID(FLOW_METER_DRV_INPUT));
-   if (pinEXTI == 0x00u)
+   // a half of the ring was written
+   if ((flag_it & (DMA_FLAG_HT1 << hdma->ChannelIndex)) != RESET)
    {
-      //it's not our interrupt. we do nothing
-      return;
+      __HAL_DMA_CLEAR_FLAG(hdma, __HAL_DMA_GET_HT_FLAG_INDEX(hdma));
+      flowMeterData.halves++;
    }
-   // it's our interrupt!!
-   // we clear the interrupt flag
-   __HAL_GPIO_EXTI_CLEAR_IT(IOGetPinNumberFromPinID(FLOW_METER_DRV_INPUT));
 
-   if(!flowMeterData.isInitialized)
+   if ((flag_it & (DMA_FLAG_TC1 << hdma->ChannelIndex)) != RESET)
    {
-      return;
+      __HAL_DMA_CLEAR_FLAG(hdma, __HAL_DMA_GET_TC_FLAG_INDEX(hdma));
+      flowMeterData.halves++;
    }
+#endif
+}
 
-   //sample the timer value as soon as possible
-   counter = FlowMeterDrv_GetHighResTimestamp();
-
-   //calculate the time period
-   flowMeterData.timePeriod = counter - flowMeterData.lastTimestamp;
-   flowMeterData.lastTimestamp = counter;
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+static uint32_t flow_meter_drv_get_captures(void)
+{
+   uint32_t halves, written;
 
-   flowMeterData.flow = PULSE_INTERVAL_TO_MILLILITERPERMIN(flowMeterData.timePeriod);
+   // the interrupt may count a half while the counter is read
+   do
+   {
+      halves = flowMeterData.halves;
+      written = FLOW_METER_DRV_CAPTURE_SIZE - __HAL_DMA_GET_COUNTER(&flowMeterData.hdma);
+   } while (halves != flowMeterData.halves);
 
-   flowMeterData.intCounter++;
-}
+   // a half written whose interrupt is still pending
+   if ((written / FLOW_METER_CAPTURE_HALF) != (halves & 1))
+   {
+      halves++;
+   }
 
-uint32_t FlowMeterDrv_GetVolume(void)
-{
-   return flowMeterData.volume;
+   return halves * FLOW_METER_CAPTURE_HALF + (written % FLOW_METER_CAPTURE_HALF);
 }
-
-uint32_t FlowMeterDrv_GetFlowRate(void)
+#else
+static uint32_t flow_meter_drv_get_captures(void)
 {
-   return flowMeterData.flow;
+   return 0;
 }
+#endif
 
-static void flow_meter_drv_gpio_init(void)
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+static StatusType flow_meter_drv_capture_init(void)
 {
-   GPIO_InitTypeDef GPIO_InitStruct = {0};
+   // every capture is copied to the ring, which wraps forever
+   flowMeterData.hdma.Instance = FLOW_METER_DRV_DMA_CHANNEL;
+   flowMeterData.hdma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+   flowMeterData.hdma.Init.PeriphInc = DMA_PINC_DISABLE;
+   flowMeterData.hdma.Init.MemInc = DMA_MINC_ENABLE;
+   flowMeterData.hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+   flowMeterData.hdma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+   flowMeterData.hdma.Init.Mode = DMA_CIRCULAR;
+   flowMeterData.hdma.Init.Priority = DMA_PRIORITY_LOW;
+   if (HAL_OK != HAL_DMA_Init(&flowMeterData.hdma))
+   {
+      return E_ERROR;
+   }
 
-   /*Configure GPIO pins*/
-   GPIO_InitStruct.Pin = IOGetPinNumberFromPinID(FLOW_METER_DRV_INPUT);
-   GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
-   GPIO_InitStruct.Pull = GPIO_PULLUP;
-   HAL_GPIO_Init(IOGetPortFromPinID(FLOW_METER_DRV_INPUT), &GPIO_InitStruct);
+   if (HAL_OK != HAL_DMA_Start(&flowMeterData.hdma, (uint32_t)&FLOW_METER_DRV_TIMER->CCR1,
+                               (uint32_t)flowMeterData.capture, FLOW_METER_DRV_CAPTURE_SIZE))
+   {
+      return E_ERROR;
+   }
 
-   __HAL_GPIO_EXTI_CLEAR_IT(IOGetPinNumberFromPinID(FLOW_METER_DRV_INPUT));
+   // the half and full buffer interrupts count the captures
+   __HAL_DMA_ENABLE_IT(&flowMeterData.hdma, DMA_IT_HT | DMA_IT_TC);
+   HAL_NVIC_SetPriority(FLOW_METER_DRV_DMA_IRQ, FLOW_METER_DRV_DMA_IRQ_PRIORITY, 0);
+   HAL_NVIC_EnableIRQ(FLOW_METER_DRV_DMA_IRQ);
 
-   /* EXTI interrupt init*/
-   HAL_NVIC_SetPriority(FLOW_METER_DRV_IRQ, FLOW_METER_DRV_IRQ_PRIORITY, 0);
-   HAL_NVIC_EnableIRQ(FLOW_METER_DRV_IRQ);
+   // The timer is the clock driver time base and keeps running: only
+   // channel 1 is set up, to capture the rising edges of TI1
+   FLOW_METER_DRV_TIMER->CCER &= ~TIM_CCER_CC1E;
+   FLOW_METER_DRV_TIMER->CCMR1 = (FLOW_METER_DRV_TIMER->CCMR1 & ~(TIM_CCMR1_CC1S | TIM_CCMR1_IC1PSC | TIM_CCMR1_IC1F)) |
+                                 TIM_CCMR1_CC1S_0 | (FLOW_METER_DRV_INPUT_FILTER << TIM_CCMR1_IC1F_Pos);
+   FLOW_METER_DRV_TIMER->CCER &= ~TIM_CCER_CC1P;
+   FLOW_METER_DRV_TIMER->DIER |= TIM_DIER_CC1DE;
+   FLOW_METER_DRV_TIMER->CCER |= TIM_CCER_CC1E;
 
+   return E_OK;
+}
+#else
+static StatusType flow_meter_drv_capture_init(void)
+{
+   // the meter input has no timer capture on this board
+   return E_ERROR;
 }
+#endif
 
 //********************************************************************
 //
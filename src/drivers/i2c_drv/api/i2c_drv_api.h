@@ -0,0 +1,234 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       i2c_drv_api.h
+//!
+//!   \brief      I2C bus manager APIs header file
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _I2C_DRV_API_H
+#define  _I2C_DRV_API_H 1
+
+//********************************************************************
+//! @addtogroup i2c_drv_api
+//!   @{
+//********************************************************************
+
+#include "i2c_drv_conf.h"
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+/* \cond DO_NOT_DOCUMENT */
+#define X(a,b,c,d,e,f,g) a,
+/* \endcond */
+/** @brief I2C buses enumeration
+ *
+ */
+typedef enum i2c_drv_bus_tag
+{
+   I2C_DRV_BUSES_CFG
+   //do not remove this one
+   I2C_DRV_NUM_BUSES,
+} I2CDrvBusType;
+#undef X
+
+/**
+ * Transfer directions
+ */
+typedef enum i2c_drv_dir_tag
+{
+   I2C_DRV_DIR_READ,                /**< Read the data from the device */
+   I2C_DRV_DIR_WRITE,               /**< Write the data to the device */
+   I2C_DRV_DIR_READ_REG,            /**< Write the register address, then read the data with a repeated start */
+} I2CDrvDirType;
+
+/**
+ * Result of a transfer
+ */
+typedef enum i2c_drv_result_tag
+{
+   I2C_DRV_RESULT_OK,               /**< The data was transferred */
+   I2C_DRV_RESULT_NACK,             /**< The device did not acknowledge */
+   I2C_DRV_RESULT_ERROR,            /**< Bus error, arbitration lost or the transfer could not start */
+   I2C_DRV_RESULT_TIMEOUT,          /**< The transfer took longer than #I2C_DRV_TIMEOUT_US */
+} I2CDrvResultType;
+
+/**
+ * Transfer structure
+ */
+typedef struct i2c_drv_xfer_tag I2CDrvXferType;
+
+/**
+ * Pointer to function to execute when a transfer ends. It runs in
+ * interrupt context and shall return quickly. The transfer can be
+ * submitted again from it.
+ */
+typedef void (*I2CDrvOnDoneFnt)(I2CDrvXferType *pXfer, I2CDrvResultType result);
+
+/**
+ * Transfer to a device. It is owned by the caller and shall stay
+ * allocated while it is scheduled or submitted.
+ */
+struct i2c_drv_xfer_tag
+{
+   I2CDrvBusType bus;               /**< Bus of the device */
+   uint8_t address;                 /**< 7 bits address of the device */
+   I2CDrvDirType dir;               /**< Transfer direction */
+   uint8_t reg;                     /**< Register address of #I2C_DRV_DIR_READ_REG transfers */
+   uint8_t *pData;                  /**< Data buffer */
+   uint16_t size;                   /**< Bytes to transfer */
+   uint32_t periodUs;               /**< Period of a scheduled transfer, multiple of #I2C_DRV_TICK_US */
+   uint32_t phaseUs;                /**< Delay of the first scheduled transfer, spreads the devices along the period */
+   I2CDrvOnDoneFnt onDone;          /**< Function to execute when the transfer ends, can be NULL */
+   void *pUserData;                 /**< To be used by the higher layers */
+
+   // driver use
+   uint32_t periodTicks;            /**< period in ticks */
+   uint32_t nextTick;               /**< tick the next scheduled transfer is due */
+   volatile Bool pending;           /**< waiting in the queue or in progress */
+   volatile uint32_t skipped;       /**< scheduled transfers skipped, the previous one was still pending */
+   I2CDrvXferType *pNext;           /**< next scheduled transfer */
+};
+
+/**
+ * Statistics of a bus
+ */
+typedef struct i2c_drv_stats_tag
+{
+   uint32_t transfers;              /**< transfers completed */
+   uint32_t nacks;                  /**< transfers not acknowledged */
+   uint32_t errors;                 /**< bus errors and transfers that could not start */
+   uint32_t timeouts;               /**< transfers aborted after #I2C_DRV_TIMEOUT_US */
+   uint32_t recoveries;             /**< bus recoveries */
+   uint32_t overruns;               /**< transfers skipped or rejected because they were pending or the queue was full */
+   uint32_t busyUs;                 /**< time with a transfer in progress */
+} I2CDrvStatsType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+
+/**
+ * Initializes the buses and starts the tick timer
+ *
+ * @return #E_OK if no error occurred\n
+ *         #E_ERROR if a bus or the timer could not be initialized
+ */
+extern StatusType I2CDrv_Init(void);
+
+/**
+ * Adds a transfer to the schedule. It is queued every periodUs, from
+ * phaseUs after the next tick, and skipped while the previous one is
+ * still pending. The transfers due on the same tick are queued with
+ * the shortest period first.
+ *
+ * @param pXfer transfer to schedule
+ *
+ * @return #E_OK if the transfer was scheduled\n
+ *         #E_ERROR if it is invalid or already scheduled
+ */
+extern StatusType I2CDrv_Schedule(I2CDrvXferType *pXfer);
+
+/**
+ * Queues a single transfer. It starts as soon as the transfers queued
+ * before it end.
+ *
+ * @param pXfer transfer to queue
+ *
+ * @return #E_OK if the transfer was queued\n
+ *         #E_ERROR if it is invalid, still pending or the queue is full
+ */
+extern StatusType I2CDrv_Submit(I2CDrvXferType *pXfer);
+
+/**
+ * Returns the statistics of a bus
+ *
+ * @param bus bus
+ * @param pStats receives the statistics
+ *
+ * @return #E_OK if the statistics were copied\n
+ *         #E_ERROR if the bus is invalid
+ */
+extern StatusType I2CDrv_GetStats(I2CDrvBusType bus, I2CDrvStatsType *pStats);
+
+/**
+ * Tick timer interrupt handler. Queues the scheduled transfers due,
+ * aborts the transfers that timed out and starts the next ones.
+ * It shall be called from the #I2C_DRV_TIMER interrupt.
+ *
+ */
+extern void I2CDrv_TimerIRQHandler(void);
+
+/**
+ * Bus event interrupt handler
+ *
+ * @param bus bus whose event interrupt was raised
+ *
+ */
+extern void I2CDrv_EvIRQHandler(I2CDrvBusType bus);
+
+/**
+ * Bus error interrupt handler
+ *
+ * @param bus bus whose error interrupt was raised
+ *
+ */
+extern void I2CDrv_ErIRQHandler(I2CDrvBusType bus);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _I2C_DRV_API_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
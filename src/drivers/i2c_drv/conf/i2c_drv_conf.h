@@ -0,0 +1,97 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//!
+//!   \file       i2c_drv_conf.h
+//!
+//!   \brief      I2C bus manager configuration header file
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//!
+//********************************************************************
+
+#ifndef  _I2C_DRV_CONF_H
+#define  _I2C_DRV_CONF_H 1
+
+//********************************************************************
+//! @addtogroup i2c_drv_conf
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define I2C_DRV_IRQ_PRIORITY           (3)                  /**< Priority of the bus and tick timer interrupts, the same so they don't preempt each other */
+#define I2C_DRV_TIMER                  (TIM4)               /**< Timer whose update interrupt runs the schedules */
+#define I2C_DRV_TIMER_IRQ              (TIM4_IRQn)          /**< Tick timer interrupt number */
+#define I2C_DRV_TIMER_CLOCK_HZ         (72000000)           /**< Tick timer input clock */
+#define I2C_DRV_TIMER_PRESCALER        (72-1)               /**< Tick timer prescaler, 1MHz count */
+#define I2C_DRV_TICK_US                (250)                /**< Schedule resolution, the periods are multiples of it */
+#define I2C_DRV_QUEUE_SIZE             (8)                  /**< Transfers waiting for every bus, power of 2 */
+#define I2C_DRV_TIMEOUT_US             (2000)               /**< A transfer taking longer is aborted and the bus recovered */
+#define I2C_DRV_RECOVERY_PULSES        (9)                  /**< Max SCL pulses to release a slave holding SDA low */
+#define I2C_DRV_RECOVERY_DELAY_LOOPS   (40)                 /**< Busy loop iterations of half a recovery SCL period, about 5us */
+
+/**
+ * The I2C buses managed: name, peripheral, event and error interrupts,
+ * clock speed and the SCL and SDA pins, driven as GPIOs to recover the
+ * bus. The transfers use interrupts, not DMA: the only DMA channels of
+ * I2C2 (4 and 5) belong to USART1.
+ */
+#define I2C_DRV_BUSES_CFG \
+   X(I2C_DRV_BUS_SENSORS, I2C2, I2C2_EV_IRQn, I2C2_ER_IRQn, 400000, IO_FLOW_SENS_SCL, IO_FLOW_SENS_SDA) \
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _I2C_DRV_CONF_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,61 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @defgroup i2c_drv I2C bus manager
+ * @brief I2C bus manager module documentation.
+ *
+ * The I2C bus manager owns the I2C peripherals and shares them between
+ * the drivers of the devices on the bus. A driver describes each
+ * transfer with an #I2CDrvXferType: device address, direction, buffer
+ * and the function called when it ends, from interrupt context.
+ *
+ * Scheduled transfers are queued by the tick timer every period, with a
+ * phase that spreads the devices along it. Single transfers are queued
+ * with #I2CDrv_Submit. Every bus has a static queue; when a transfer
+ * ends the next one starts from the interrupt, so the bus stays busy
+ * while there are transfers waiting. A scheduled transfer still pending
+ * when it is due again is skipped and counted.
+ *
+ * A transfer taking longer than #I2C_DRV_TIMEOUT_US, or ending with a
+ * bus error, aborts and recovers the bus: the pins are driven as GPIOs
+ * to clock out a slave holding SDA low and to send a STOP, and the
+ * peripheral is reset. A device not acknowledging does not need it.
+ *
+ * @{
+ *
+ * @defgroup i2c_drv_conf Module Configuration
+ * @brief i2c_drv module configuration parameters
+ *
+ * @defgroup i2c_drv_api Module API Interface
+ * @brief i2c_drv module API functions
+ *
+ * @defgroup i2c_drv_callouts Module Callouts
+ * @brief i2c_drv callout functions
+ *
+ * @defgroup i2c_drv_imp Module Implementation
+ * @brief i2c_drv implementation
+ * @}
+ */
@@ -0,0 +1,588 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       i2c_drv.c
+//!
+//!   \brief      I2C bus manager implementation. Queues the scheduled
+//!               and single transfers of the devices on every bus,
+//!               runs them back to back from the interrupts and routes
+//!               their completion to the function of each transfer.
+//!               Transfers that time out or end with a bus error
+//!               recover the bus.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "board_hw_io.h"
+
+//********************************************************************
+//! @addtogroup i2c_drv_imp
+//!   @{
+//********************************************************************
+
+#include "i2c_drv_conf.h"
+#include "i2c_drv_api.h"
+#include "i2c_drv_callouts.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#if ((I2C_DRV_QUEUE_SIZE & (I2C_DRV_QUEUE_SIZE - 1)) != 0)
+#error "I2C_DRV_QUEUE_SIZE must be a power of 2"
+#endif
+
+#define I2C_DRV_QUEUE_MASK    (I2C_DRV_QUEUE_SIZE - 1)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct i2c_drv_bus_conf_tag
+{
+   I2C_TypeDef *instance;
+   IRQn_Type evIrq;
+   IRQn_Type erIrq;
+   uint32_t clockSpeed;
+   IO_GPIO_t scl;
+   IO_GPIO_t sda;
+} I2CDrvBusConfType;
+
+typedef struct i2c_drv_bus_data_tag
+{
+   I2C_HandleTypeDef hi2c;
+   I2CDrvXferType *queue[I2C_DRV_QUEUE_SIZE];
+   uint32_t head;                // transfers queued
+   uint32_t tail;                // transfers started
+   I2CDrvXferType *pCurrent;     // transfer in progress
+   uint32_t startTimestamp;      // of the transfer in progress
+   I2CDrvStatsType stats;
+} I2CDrvBusDataType;
+
+typedef struct i2c_drv_data_tag
+{
+   I2CDrvBusDataType bus[I2C_DRV_NUM_BUSES];
+   TIM_HandleTypeDef htim;
+   uint32_t tick;
+   I2CDrvXferType *pScheduled;   // list of the scheduled transfers
+   Bool isInitialized;
+} I2CDrvDataType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static StatusType i2c_drv_bus_init(I2CDrvBusType bus);
+static StatusType i2c_drv_timer_init(void);
+static StatusType i2c_drv_push(I2CDrvBusDataType *pBus, I2CDrvXferType *pXfer);
+static void i2c_drv_start_next(I2CDrvBusType bus);
+static void i2c_drv_complete(I2CDrvBusDataType *pBus, I2CDrvResultType result);
+static void i2c_drv_recover(I2CDrvBusType bus);
+static void i2c_drv_delay(void);
+static I2CDrvBusType i2c_drv_get_bus(I2C_HandleTypeDef *hi2c);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+#define X(a,b,c,d,e,f,g) {b, c, d, e, f, g},
+static const I2CDrvBusConfType i2cDrvBusConf[I2C_DRV_NUM_BUSES] =
+{
+   I2C_DRV_BUSES_CFG
+};
+#undef X
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static I2CDrvDataType i2cDrvData;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType I2CDrv_Init(void)
+{
+   uint32_t i;
+
+   i2cDrvData.isInitialized = FALSE;
+   i2cDrvData.tick = 0;
+   i2cDrvData.pScheduled = NULL;
+
+   for (i = 0; i < I2C_DRV_NUM_BUSES; i++)
+   {
+      if (E_OK != i2c_drv_bus_init((I2CDrvBusType)i))
+      {
+         return E_ERROR;
+      }
+   }
+
+   if (E_OK != i2c_drv_timer_init())
+   {
+      return E_ERROR;
+   }
+
+   i2cDrvData.isInitialized = TRUE;
+
+   return E_OK;
+}
+
+StatusType I2CDrv_Schedule(I2CDrvXferType *pXfer)
+{
+   I2CDrvXferType *p;
+   I2CDrvXferType **ppNext;
+   uint32_t primask;
+
+   if ((NULL == pXfer) || (pXfer->bus >= I2C_DRV_NUM_BUSES) || (NULL == pXfer->pData) || (0 == pXfer->size) ||
+       (pXfer->periodUs < I2C_DRV_TICK_US) || (0 != (pXfer->periodUs % I2C_DRV_TICK_US)))
+   {
+      return E_ERROR;
+   }
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+
+   for (p = i2cDrvData.pScheduled; NULL != p; p = p->pNext)
+   {
+      if (p == pXfer)
+      {
+         __set_PRIMASK(primask);
+         return E_ERROR;
+      }
+   }
+
+   pXfer->periodTicks = pXfer->periodUs / I2C_DRV_TICK_US;
+   pXfer->nextTick = i2cDrvData.tick + 1 + pXfer->phaseUs / I2C_DRV_TICK_US;
+   pXfer->pending = FALSE;
+   pXfer->skipped = 0;
+
+   // the list is kept by period, so the transfers due on the same tick
+   // are queued with the shortest period first
+   for (ppNext = &i2cDrvData.pScheduled; (NULL != *ppNext) && ((*ppNext)->periodTicks <= pXfer->periodTicks);
+        ppNext = &(*ppNext)->pNext)
+   {
+   }
+   pXfer->pNext = *ppNext;
+   *ppNext = pXfer;
+
+   __set_PRIMASK(primask);
+
+   return E_OK;
+}
+
+StatusType I2CDrv_Submit(I2CDrvXferType *pXfer)
+{
+   StatusType ret;
+   uint32_t primask;
+
+   if ((NULL == pXfer) || (pXfer->bus >= I2C_DRV_NUM_BUSES) || (NULL == pXfer->pData) || (0 == pXfer->size))
+   {
+      return E_ERROR;
+   }
+
+   // the queue is also used by the bus and tick interrupts
+   primask = __get_PRIMASK();
+   __disable_irq();
+
+   ret = i2c_drv_push(&i2cDrvData.bus[pXfer->bus], pXfer);
+   if (E_OK == ret)
+   {
+      i2c_drv_start_next(pXfer->bus);
+   }
+
+   __set_PRIMASK(primask);
+
+   return ret;
+}
+
+StatusType I2CDrv_GetStats(I2CDrvBusType bus, I2CDrvStatsType *pStats)
+{
+   uint32_t primask;
+
+   if ((bus >= I2C_DRV_NUM_BUSES) || (NULL == pStats))
+   {
+      return E_ERROR;
+   }
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+   *pStats = i2cDrvData.bus[bus].stats;
+   __set_PRIMASK(primask);
+
+   return E_OK;
+}
+
+void I2CDrv_TimerIRQHandler(void)
+{
+   I2CDrvXferType *pXfer;
+   I2CDrvBusDataType *pBus;
+   uint32_t i;
+
+   if ((RESET == __HAL_TIM_GET_FLAG(&i2cDrvData.htim, TIM_FLAG_UPDATE)) ||
+       (RESET == __HAL_TIM_GET_IT_SOURCE(&i2cDrvData.htim, TIM_IT_UPDATE)))
+   {
+      return;
+   }
+   __HAL_TIM_CLEAR_IT(&i2cDrvData.htim, TIM_IT_UPDATE);
+
+   i2cDrvData.tick++;
+
+   // queue the scheduled transfers due
+   for (pXfer = i2cDrvData.pScheduled; NULL != pXfer; pXfer = pXfer->pNext)
+   {
+      if ((int32_t)(i2cDrvData.tick - pXfer->nextTick) >= 0)
+      {
+         pXfer->nextTick += pXfer->periodTicks;
+         if (FALSE != pXfer->pending)
+         {
+            pXfer->skipped++;
+            i2cDrvData.bus[pXfer->bus].stats.overruns++;
+         }
+         else
+         {
+            i2c_drv_push(&i2cDrvData.bus[pXfer->bus], pXfer);
+         }
+      }
+   }
+
+   for (i = 0; i < I2C_DRV_NUM_BUSES; i++)
+   {
+      pBus = &i2cDrvData.bus[i];
+
+      // a slave stretching the clock forever or a stuck bus never ends
+      // the transfer
+      if ((NULL != pBus->pCurrent) &&
+          ((I2CDrv_GetHighResTimestamp() - pBus->startTimestamp) > I2C_DRV_TIMEOUT_US))
+      {
+         i2c_drv_complete(pBus, I2C_DRV_RESULT_TIMEOUT);
+         i2c_drv_recover((I2CDrvBusType)i);
+      }
+
+      i2c_drv_start_next((I2CDrvBusType)i);
+   }
+}
+
+void I2CDrv_EvIRQHandler(I2CDrvBusType bus)
+{
+   if (bus < I2C_DRV_NUM_BUSES)
+   {
+      HAL_I2C_EV_IRQHandler(&i2cDrvData.bus[bus].hi2c);
+   }
+}
+
+void I2CDrv_ErIRQHandler(I2CDrvBusType bus)
+{
+   if (bus < I2C_DRV_NUM_BUSES)
+   {
+      HAL_I2C_ER_IRQHandler(&i2cDrvData.bus[bus].hi2c);
+   }
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+   I2CDrvBusType bus = i2c_drv_get_bus(hi2c);
+
+   if (bus < I2C_DRV_NUM_BUSES)
+   {
+      i2c_drv_complete(&i2cDrvData.bus[bus], I2C_DRV_RESULT_OK);
+      i2c_drv_start_next(bus);
+   }
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+   HAL_I2C_MasterRxCpltCallback(hi2c);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+   HAL_I2C_MasterRxCpltCallback(hi2c);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+   I2CDrvBusType bus = i2c_drv_get_bus(hi2c);
+
+   if (bus < I2C_DRV_NUM_BUSES)
+   {
+      if (HAL_I2C_ERROR_AF == hi2c->ErrorCode)
+      {
+         // the device is absent or busy, the bus is fine
+         i2c_drv_complete(&i2cDrvData.bus[bus], I2C_DRV_RESULT_NACK);
+      }
+      else
+      {
+         i2c_drv_complete(&i2cDrvData.bus[bus], I2C_DRV_RESULT_ERROR);
+         i2c_drv_recover(bus);
+      }
+      i2c_drv_start_next(bus);
+   }
+}
+
+static StatusType i2c_drv_bus_init(I2CDrvBusType bus)
+{
+   I2CDrvBusDataType *pBus = &i2cDrvData.bus[bus];
+   const I2CDrvBusConfType *pConf = &i2cDrvBusConf[bus];
+
+   pBus->head = 0;
+   pBus->tail = 0;
+   pBus->pCurrent = NULL;
+   pBus->stats = (I2CDrvStatsType){ 0 };
+
+   pBus->hi2c.Instance = pConf->instance;
+   pBus->hi2c.Init.ClockSpeed = pConf->clockSpeed;
+   pBus->hi2c.Init.DutyCycle = I2C_DUTYCYCLE_2;
+   pBus->hi2c.Init.OwnAddress1 = 0;
+   pBus->hi2c.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+   pBus->hi2c.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+   pBus->hi2c.Init.OwnAddress2 = 0;
+   pBus->hi2c.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+   pBus->hi2c.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+
+   if (HAL_OK != HAL_I2C_Init(&pBus->hi2c))
+   {
+      return E_ERROR;
+   }
+
+   HAL_NVIC_SetPriority(pConf->evIrq, I2C_DRV_IRQ_PRIORITY, 0);
+   HAL_NVIC_EnableIRQ(pConf->evIrq);
+   HAL_NVIC_SetPriority(pConf->erIrq, I2C_DRV_IRQ_PRIORITY, 0);
+   HAL_NVIC_EnableIRQ(pConf->erIrq);
+
+   return E_OK;
+}
+
+static StatusType i2c_drv_timer_init(void)
+{
+   i2cDrvData.htim.Instance = I2C_DRV_TIMER;
+   i2cDrvData.htim.Init.Prescaler = I2C_DRV_TIMER_PRESCALER;
+   i2cDrvData.htim.Init.CounterMode = TIM_COUNTERMODE_UP;
+   i2cDrvData.htim.Init.Period = ((I2C_DRV_TIMER_CLOCK_HZ / (I2C_DRV_TIMER_PRESCALER + 1)) / 1000000UL) * I2C_DRV_TICK_US - 1;
+   i2cDrvData.htim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+   i2cDrvData.htim.Init.RepetitionCounter = 0;
+   i2cDrvData.htim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+   if (HAL_OK != HAL_TIM_Base_Init(&i2cDrvData.htim))
+   {
+      return E_ERROR;
+   }
+
+   HAL_NVIC_SetPriority(I2C_DRV_TIMER_IRQ, I2C_DRV_IRQ_PRIORITY, 0);
+   HAL_NVIC_EnableIRQ(I2C_DRV_TIMER_IRQ);
+
+   if (HAL_OK != HAL_TIM_Base_Start_IT(&i2cDrvData.htim))
+   {
+      return E_ERROR;
+   }
+
+   return E_OK;
+}
+
+// it shall be called with the bus interrupts masked
+static StatusType i2c_drv_push(I2CDrvBusDataType *pBus, I2CDrvXferType *pXfer)
+{
+   if ((FALSE != pXfer->pending) || ((pBus->head - pBus->tail) >= I2C_DRV_QUEUE_SIZE))
+   {
+      pBus->stats.overruns++;
+      return E_ERROR;
+   }
+
+   pXfer->pending = TRUE;
+   pBus->queue[pBus->head & I2C_DRV_QUEUE_MASK] = pXfer;
+   pBus->head++;
+
+   return E_OK;
+}
+
+// it shall be called with the bus interrupts masked
+static void i2c_drv_start_next(I2CDrvBusType bus)
+{
+   I2CDrvBusDataType *pBus = &i2cDrvData.bus[bus];
+   I2CDrvXferType *pXfer;
+   HAL_StatusTypeDef status;
+
+   while ((NULL == pBus->pCurrent) && (pBus->head != pBus->tail))
+   {
+      pXfer = pBus->queue[pBus->tail & I2C_DRV_QUEUE_MASK];
+      pBus->tail++;
+
+      pBus->pCurrent = pXfer;
+      pBus->startTimestamp = I2CDrv_GetHighResTimestamp();
+
+      switch (pXfer->dir)
+      {
+         case I2C_DRV_DIR_WRITE:
+            status = HAL_I2C_Master_Transmit_IT(&pBus->hi2c, pXfer->address << 1, pXfer->pData, pXfer->size);
+            break;
+         case I2C_DRV_DIR_READ_REG:
+            status = HAL_I2C_Mem_Read_IT(&pBus->hi2c, pXfer->address << 1, pXfer->reg, I2C_MEMADD_SIZE_8BIT,
+                                         pXfer->pData, pXfer->size);
+            break;
+         case I2C_DRV_DIR_READ:
+         default:
+            status = HAL_I2C_Master_Receive_IT(&pBus->hi2c, pXfer->address << 1, pXfer->pData, pXfer->size);
+            break;
+      }
+
+      if (HAL_OK != status)
+      {
+         // the peripheral still sees the bus busy
+         i2c_drv_complete(pBus, I2C_DRV_RESULT_ERROR);
+         i2c_drv_recover(bus);
+      }
+   }
+}
+
+static void i2c_drv_complete(I2CDrvBusDataType *pBus, I2CDrvResultType result)
+{
+   I2CDrvXferType *pXfer = pBus->pCurrent;
+
+   if (NULL == pXfer)
+   {
+      return;
+   }
+
+   pBus->pCurrent = NULL;
+   pBus->stats.busyUs += I2CDrv_GetHighResTimestamp() - pBus->startTimestamp;
+
+   switch (result)
+   {
+      case I2C_DRV_RESULT_OK:
+         pBus->stats.transfers++;
+         break;
+      case I2C_DRV_RESULT_NACK:
+         pBus->stats.nacks++;
+         break;
+      case I2C_DRV_RESULT_TIMEOUT:
+         pBus->stats.timeouts++;
+         break;
+      case I2C_DRV_RESULT_ERROR:
+      default:
+         pBus->stats.errors++;
+         break;
+   }
+
+   // released before the callback, so it can submit the transfer again
+   pXfer->pending = FALSE;
+   if (NULL != pXfer->onDone)
+   {
+      pXfer->onDone(pXfer, result);
+   }
+}
+
+static void i2c_drv_recover(I2CDrvBusType bus)
+{
+   I2CDrvBusDataType *pBus = &i2cDrvData.bus[bus];
+   const I2CDrvBusConfType *pConf = &i2cDrvBusConf[bus];
+   uint32_t i;
+
+   pBus->stats.recoveries++;
+
+   HAL_I2C_DeInit(&pBus->hi2c);
+
+   // drive the pins, released high
+   IOWritePinID(pConf->scl, IO_ON);
+   IOWritePinID(pConf->sda, IO_ON);
+   IO_Config(IOGetPortFromPinID(pConf->scl), IOGetPinNumberFromPinID(pConf->scl), GPIO_MODE_OUTPUT_OD, GPIO_PULLUP, GPIO_SPEED_FREQ_LOW);
+   IO_Config(IOGetPortFromPinID(pConf->sda), IOGetPinNumberFromPinID(pConf->sda), GPIO_MODE_OUTPUT_OD, GPIO_PULLUP, GPIO_SPEED_FREQ_LOW);
+   i2c_drv_delay();
+
+   // clock out the rest of the byte a slave may be sending
+   for (i = 0; (i < I2C_DRV_RECOVERY_PULSES) && (!IOReadPinID(pConf->sda)); i++)
+   {
+      IOWritePinID(pConf->scl, IO_OFF);
+      i2c_drv_delay();
+      IOWritePinID(pConf->scl, IO_ON);
+      i2c_drv_delay();
+   }
+
+   // STOP: SDA rises with SCL high
+   IOWritePinID(pConf->scl, IO_OFF);
+   i2c_drv_delay();
+   IOWritePinID(pConf->sda, IO_OFF);
+   i2c_drv_delay();
+   IOWritePinID(pConf->scl, IO_ON);
+   i2c_drv_delay();
+   IOWritePinID(pConf->sda, IO_ON);
+   i2c_drv_delay();
+
+   IO_Config(IOGetPortFromPinID(pConf->scl), IOGetPinNumberFromPinID(pConf->scl), GPIO_MODE_AF_OD, GPIO_PULLUP, GPIO_SPEED_FREQ_LOW);
+   IO_Config(IOGetPortFromPinID(pConf->sda), IOGetPinNumberFromPinID(pConf->sda), GPIO_MODE_AF_OD, GPIO_PULLUP, GPIO_SPEED_FREQ_LOW);
+
+   // the peripheral may still flag the bus busy
+   pConf->instance->CR1 |= I2C_CR1_SWRST;
+   pConf->instance->CR1 &= ~I2C_CR1_SWRST;
+
+   HAL_I2C_Init(&pBus->hi2c);
+}
+
+static void i2c_drv_delay(void)
+{
+   volatile uint32_t i;
+
+   for (i = 0; i < I2C_DRV_RECOVERY_DELAY_LOOPS; i++)
+   {
+   }
+}
+
+static I2CDrvBusType i2c_drv_get_bus(I2C_HandleTypeDef *hi2c)
+{
+   uint32_t i;
+
+   for (i = 0; i < I2C_DRV_NUM_BUSES; i++)
+   {
+      if (hi2c == &i2cDrvData.bus[i].hi2c)
+      {
+         return (I2CDrvBusType)i;
+      }
+   }
+
+   return I2C_DRV_NUM_BUSES;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
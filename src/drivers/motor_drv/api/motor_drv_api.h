@@ -75,6 +75,17 @@ typedef enum motor_dir_tag
    MOTOR_STOP_BRAKE,    /**< Normal stop of the motors (both PWM to 100%) (faster stop than normal) */
 } MotorStopType;
 
+/**
+ * @brief Shapes of the speed along a move in a time
+ *
+ */
+typedef enum motor_shape_tag
+{
+   MOTOR_SHAPE_SQUARE,        /**< Constant speed, with the ramps at the start and the end */
+   MOTOR_SHAPE_DECELERATING,  /**< Speed ramping down from the peak at the start to 0 at the end */
+   MOTOR_SHAPE_SINE,          /**< Speed following half a sine wave */
+} MotorShapeType;
+
 //********************************************************************
 // Global Variable extern Declarations
 //********************************************************************
@@ -137,6 +148,21 @@ extern StatusType MotorDrv_Stop(MotorStopType stopType);
  */
 extern StatusType MotorDrv_MoveDistanceAtSpeed(MotorDirType, int32_t distance, int32_t speed);
 
+/**
+ * @brief Signal the motor FSM to move certain distance in a certain time, with the
+ *        speed following a shape. The speed starts and ends at 0 and the acceleration
+ *        is changed with a limited jerk.
+ *
+ * @param dir direction to start the motor
+ * @param distance distance to move in degrees
+ * @param timeMillis duration of the move in ms
+ * @param shape shape of the speed along the move
+ *
+ * @return #E_OK if the operation was successful
+ *         #E_ERROR if an error occurred
+ */
+extern StatusType MotorDrv_MoveDistanceInTime(MotorDirType dir, int32_t distance, uint32_t timeMillis, MotorShapeType shape);
+
 /**
  * @brief Signal the motor FSM to move certain distance at a certain driveLevel. The drive
  *        levels equal the PWM value, setting the drive level is like setting the PWM of
@@ -165,6 +191,20 @@ extern StatusType MotorDrv_MoveDistanceAtDrive(MotorDirType dir, int32_t distanc
  */
 extern StatusType MotorDrv_ChangeDriveLevel(int32_t driveLevel);
 
+/**
+ * @brief Write a new drive level straight to the PWM of the current
+ *        direction, without going through the motor FSM. It can be
+ *        called from interrupts. It only has effect while the motor
+ *        runs at a drive level, so a stop or a speed controlled move
+ *        commanded by the FSM is never overwritten.
+ *
+ * @param driveLevel driveLevel equals PWM level, from 0 to 100
+ *
+ * @return #E_OK if the operation was successful
+ *         #E_ERROR if the motor is not running at a drive level
+ */
+extern StatusType MotorDrv_WriteDriveLevel(int32_t driveLevel);
+
 /**
  * @brief Signal the motor FSM to move to the HOME position
  *  
@@ -79,6 +79,26 @@ typedef enum motor_drv_error_tag
  */
 extern int32_t MotorDrv_GetPosition(void);
 
+/**
+ * @brief Callout to get the current position of the motor and the time of
+ *        the step that reached it, read together. Called from the control
+ *        loop interrupt.
+ *
+ * @param pTimestamp returns the high resolution timestamp of the last step, in us
+ *
+ * @return the current position
+ */
+extern int32_t MotorDrv_GetStepPosition(uint32_t *pTimestamp);
+
+/**
+ * @brief Callout to get a high resolution timestamp, in us
+ *
+ * @param none
+ *
+ * @return the current timestamp
+ */
+extern uint32_t MotorDrv_GetHighResTimestamp(void);
+
 /**
  * @brief Callout to tell the current position is the 0
  *        (For example to an encoder)
@@ -68,6 +68,25 @@
 
 #define MOTOR_DRV_MAX_DISTANCE            (45)                      /**< Motor max distance in degrees */
 
+#define MOTOR_DRV_STEPS_PER_REV           (2400)                    /**< Encoder steps in a revolution of the motor shaft */
+
+#define MOTOR_DRV_CTRL_FREQ_HZ            (1000)                    /**< Position and speed loop rate, a divisor of the PWM frequency */
+#define MOTOR_DRV_MAX_FOLLOWING_ERROR     (40)                      /**< The motion profile waits while the motor is this many steps behind it */
+
+#define MOTOR_DRV_PROFILE_JERK_MS         (50)                      /**< Time the motion profiles take to bring the acceleration from 0 to its max */
+#define MOTOR_DRV_PROFILE_END_SPEED       (100)                     /**< Speed in steps/s the reference keeps past the end of a profile until the distance is covered */
+
+#define MOTOR_DRV_POS_KP                  (20.0f)                   /**< Position loop proportional gain in steps/s per step */
+#define MOTOR_DRV_POS_RANGE               (1024)                    /**< Position loop full scale in steps */
+
+#define MOTOR_DRV_SPEED_KP                (0.1f)                    /**< Speed loop proportional gain in PWM % per step/s */
+#define MOTOR_DRV_SPEED_KI                (0.003f)                  /**< Speed loop integral gain in PWM % per step/s and control period */
+#define MOTOR_DRV_SPEED_KD                (0.0f)                    /**< Speed loop derivative gain in PWM % per step/s change in a control period */
+#define MOTOR_DRV_SPEED_RANGE             (2048)                    /**< Speed loop full scale in steps/s */
+
+#define MOTOR_DRV_SPEED_FF_OFFSET         (9600)                    /**< Feed-forward drive overcoming the friction, in 1/1000 PWM % */
+#define MOTOR_DRV_SPEED_FF_SLOPE          (65)                      /**< Feed-forward drive in 1/1000 PWM % per step/s */
+
 //********************************************************************
 // Enumerations and Structures and Typedefs
 //********************************************************************
@@ -30,12 +30,27 @@
  * The Motor module has two different blocks:
  * 
  * 1. The proper motor driver which controls the hardware by the PWM
- * and manages the PID.
+ * and closes the position and speed loops.
  * 2. The motor Finite State Machine (FSM) which keep tracks on what the 
  * motor driver actions should be depending on the desired state.
  * 
  * As a whole the motor module presents to the upper layers an interface to
  * simplify the control of the motor with easy commands.
+ *
+ * The speed controlled moves are closed by a cascaded position and speed
+ * loop at #MOTOR_DRV_CTRL_FREQ_HZ, run from the motor timer update
+ * interrupt. The references come from a motion profile planned when the
+ * move starts: a table of segments of constant jerk, so the acceleration
+ * changes in ramps of #MOTOR_DRV_PROFILE_JERK_MS. A move at a speed ramps
+ * up to it and keeps it; a move in a time starts and ends at rest with the
+ * speed following a square, decelerating or sine shape. The profile waits
+ * while the bellows is #MOTOR_DRV_MAX_FOLLOWING_ERROR steps behind it.
+ * The position loop turns the error into a speed on top of the profile
+ * speed, and the speed loop adds a PID correction to the feed forward
+ * drive level. The speed is
+ * measured from the timestamps of the encoder steps, so it stays accurate
+ * at low speed. The interrupt brakes the motor as soon as the distance is
+ * covered; the FSM only supervises the move and reports it complete.
  * 
  * @startuml
  *
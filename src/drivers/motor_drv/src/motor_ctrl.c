@@ -0,0 +1,341 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       motor_ctrl.c
+//!
+//!   \brief      Motor position and speed control loop. It runs in the
+//!               motor timer interrupt every few PWM periods: a position
+//!               loop follows the motion profile of the move and sets
+//!               the speed, and the speed loop sets the drive level. The
+//!               state machine only starts and stops it.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+#include "profiler_api.h"
+
+//********************************************************************
+//! @addtogroup motor_drv_imp
+//!   @{
+//********************************************************************
+
+#include "motor_drv_conf.h"
+#include "motor_drv_api.h"
+#include "motor_drv_callouts.h"
+#include "motor_drv.h"
+#include "motor_fsm.h"
+#include "motor_ctrl.h"
+#include "motor_profile.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+#if ((MOTOR_DRV_PWM_FREQ_HZ % MOTOR_DRV_CTRL_FREQ_HZ) != 0)
+#error "MOTOR_DRV_CTRL_FREQ_HZ must divide MOTOR_DRV_PWM_FREQ_HZ"
+#endif
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define MOTOR_CTRL_PRESCALER     (MOTOR_DRV_PWM_FREQ_HZ / MOTOR_DRV_CTRL_FREQ_HZ)
+
+// fractional bits of the position loop input
+#define MOTOR_CTRL_POS_SHIFT     (8)
+
+#define MOTOR_CTRL_US_PER_SEC    (1000000L)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void motor_ctrl_measure_speed(MotorCtrlType *pCtrl, int32_t pos, uint32_t stepTime, uint32_t now);
+static void motor_ctrl_write_drive(MotorDrvType *pDrvData, int32_t driveLevel);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+// The position loop gives the speed on top of the speed of the profile.
+// Its input is in 1/256 steps so the reference moves smoothly.
+static const PidConfigType motor_ctrl_pos_pid_config =
+{
+   .kp = MOTOR_DRV_POS_KP / (1 << MOTOR_CTRL_POS_SHIFT),
+   .ki = 0.0f,
+   .kd = 0.0f,
+   .beta = 1.0f,
+   .kt = 0.0f,
+   .derivShift = 0,
+   .antiWindup = PID_ANTI_WINDUP_NONE,
+   .inputRange = MOTOR_DRV_POS_RANGE << MOTOR_CTRL_POS_SHIFT,
+   .outputRange = MOTOR_DRV_SPEED_RANGE,
+   .outMin = 0,
+   .outMax = MOTOR_DRV_SPEED_RANGE,
+};
+
+// The speed loop corrects the drive level the speed needs without load
+static const PidConfigType motor_ctrl_speed_pid_config =
+{
+   .kp = MOTOR_DRV_SPEED_KP,
+   .ki = MOTOR_DRV_SPEED_KI,
+   .kd = MOTOR_DRV_SPEED_KD,
+   .beta = 1.0f,
+   .kt = 0.0f,
+   .derivShift = 0,
+   .antiWindup = PID_ANTI_WINDUP_CONDITIONAL,
+   .inputRange = MOTOR_DRV_SPEED_RANGE,
+   .outputRange = 100,
+   .outMin = 0,
+   .outMax = 100,
+};
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType motor_ctrl_init(MotorDrvType *pDrvData)
+{
+   MotorCtrlType *pCtrl = &pDrvData->ctrl;
+
+   pCtrl->mode = MOTOR_CTRL_OFF;
+   pCtrl->done = FALSE;
+   pCtrl->prescaler = MOTOR_CTRL_PRESCALER;
+
+   if ((E_OK != Pid_Init(&pCtrl->posPid, &motor_ctrl_pos_pid_config)) ||
+       (E_OK != Pid_Init(&pCtrl->speedPid, &motor_ctrl_speed_pid_config)))
+   {
+      return E_ERROR;
+   }
+
+   return E_OK;
+}
+
+StatusType motor_ctrl_start(MotorDrvType *pDrvData, MotorCtrlModeType mode)
+{
+   MotorCtrlType *pCtrl = &pDrvData->ctrl;
+   uint32_t stepTime;
+   StatusType err = E_OK;
+
+   // the interrupt ignores the loop while it's being set up
+   pCtrl->mode = MOTOR_CTRL_OFF;
+   pCtrl->done = FALSE;
+
+   pCtrl->sign = (MOTOR_DIR_CW == pDrvData->newDir) ? 1 : -1;
+   pCtrl->startPos = MotorDrv_GetStepPosition(&stepTime);
+   pCtrl->distance = pDrvData->newDistance;
+   pCtrl->refPos = 0;
+   pCtrl->refSpeed = 0;
+
+   if (MOTOR_CTRL_SPEED == mode)
+   {
+      // the move is planned here, the interrupt only walks the profile
+      if (pDrvData->newTime > 0)
+      {
+         err = motor_profile_plan(&pCtrl->profile, pDrvData->newShape, pCtrl->distance,
+                                  (pDrvData->newTime * MOTOR_DRV_CTRL_FREQ_HZ) / 1000);
+      }
+      else
+      {
+         err = motor_profile_plan_speed(&pCtrl->profile, pCtrl->distance,
+                                        MOTOR_DRV_DEG_TO_STEPS(pDrvData->newSpeed));
+      }
+
+      if (E_OK != err)
+      {
+         return err;
+      }
+   }
+
+   // the motor is at rest, the first step gives the mean speed from now
+   pCtrl->startTime = MotorDrv_GetHighResTimestamp();
+   pCtrl->lastPos = pCtrl->startPos;
+   pCtrl->lastStepTime = pCtrl->startTime;
+   pCtrl->estSpeed = 0;
+   pCtrl->speedRef = 0;
+   pCtrl->moveTime = 0;
+   pCtrl->maxError = 0;
+
+   Pid_Reset(&pCtrl->posPid, 0);
+   Pid_Reset(&pCtrl->speedPid, 0);
+
+   __DMB();
+   pCtrl->mode = mode;
+
+   return E_OK;
+}
+
+void motor_ctrl_stop(MotorDrvType *pDrvData)
+{
+   pDrvData->ctrl.mode = MOTOR_CTRL_OFF;
+}
+
+void motor_ctrl_update(MotorDrvType *pDrvData)
+{
+   MotorCtrlType *pCtrl = &pDrvData->ctrl;
+   MotorCtrlModeType mode = pCtrl->mode;
+   MotorProfileType *pProfile = &pCtrl->profile;
+   int32_t pos, travel, error, driveLevel;
+   uint32_t stepTime, now;
+
+   if (MOTOR_CTRL_OFF == mode)
+   {
+      return;
+   }
+
+   PROF_BEGIN(PROF_MOTOR_CTRL);
+
+   pos = MotorDrv_GetStepPosition(&stepTime);
+   now = MotorDrv_GetHighResTimestamp();
+   travel = (pos - pCtrl->startPos) * pCtrl->sign;
+   motor_ctrl_measure_speed(pCtrl, pos, stepTime, now);
+
+   if ((pCtrl->distance > 0) && (travel > pCtrl->distance))
+   {
+      // the move is done. The loop stops the motor only if it drives it
+      if (MOTOR_CTRL_SPEED == mode)
+      {
+         motor_stop((MotorFsmType *)pDrvData->pFsm, MOTOR_STOP_BRAKE);
+         pDrvData->curDriveLvl = 0;
+      }
+      pCtrl->moveTime = now - pCtrl->startTime;
+      pCtrl->mode = MOTOR_CTRL_OFF;
+      pCtrl->done = TRUE;
+   }
+   else if (MOTOR_CTRL_SPEED == mode)
+   {
+      // the profile waits for a motor falling behind, so it doesn't run
+      // away from a stalled motor and the shape of the move is kept
+      if ((int32_t)(pProfile->pos >> MOTOR_PROFILE_SHIFT) - travel < MOTOR_DRV_MAX_FOLLOWING_ERROR)
+      {
+         motor_profile_advance(pProfile);
+      }
+      pCtrl->refPos = (int32_t)(pProfile->pos >> (MOTOR_PROFILE_SHIFT - MOTOR_CTRL_POS_SHIFT));
+      pCtrl->refSpeed = (int32_t)((pProfile->vel * MOTOR_DRV_CTRL_FREQ_HZ) >> MOTOR_PROFILE_SHIFT);
+
+      error = (pCtrl->refPos >> MOTOR_CTRL_POS_SHIFT) - travel;
+      if (error > pCtrl->maxError)
+      {
+         pCtrl->maxError = error;
+      }
+
+      // the speed of the profile is fed forward
+      pCtrl->speedRef = Pid_Update(&pCtrl->posPid, pCtrl->refPos, travel << MOTOR_CTRL_POS_SHIFT,
+                                   pCtrl->refSpeed);
+      driveLevel = Pid_Update(&pCtrl->speedPid, pCtrl->speedRef, pCtrl->estSpeed,
+                              motor_ctrl_speed_to_drive(pCtrl->speedRef));
+      motor_ctrl_write_drive(pDrvData, driveLevel);
+   }
+
+   PROF_END(PROF_MOTOR_CTRL);
+}
+
+int32_t motor_ctrl_speed_to_drive(int32_t speed)
+{
+   if (speed <= 0)
+      return 0;
+
+   return (MOTOR_DRV_SPEED_FF_SLOPE * speed + MOTOR_DRV_SPEED_FF_OFFSET) / 1000;
+}
+
+static void motor_ctrl_measure_speed(MotorCtrlType *pCtrl, int32_t pos, uint32_t stepTime, uint32_t now)
+{
+   int32_t interval, bound;
+
+   if (pos != pCtrl->lastPos)
+   {
+      // the steps since the last step seen over the time between both,
+      // so slow speeds keep the resolution of the timestamps
+      interval = (int32_t)(stepTime - pCtrl->lastStepTime);
+      if (interval > 0)
+      {
+         pCtrl->estSpeed = ((pos - pCtrl->lastPos) * pCtrl->sign * MOTOR_CTRL_US_PER_SEC) / interval;
+      }
+      pCtrl->lastPos = pos;
+      pCtrl->lastStepTime = stepTime;
+   }
+   else
+   {
+      // without a new step the motor is slower than a step since the last one
+      interval = (int32_t)(now - pCtrl->lastStepTime);
+      if (interval > 0)
+      {
+         bound = MOTOR_CTRL_US_PER_SEC / interval;
+         if (pCtrl->estSpeed > bound)
+            pCtrl->estSpeed = bound;
+         else if (pCtrl->estSpeed < -bound)
+            pCtrl->estSpeed = -bound;
+      }
+   }
+}
+
+static void motor_ctrl_write_drive(MotorDrvType *pDrvData, int32_t driveLevel)
+{
+   if (driveLevel == pDrvData->curDriveLvl)
+   {
+      return;
+   }
+
+   // the other channel holds its terminal, as set at the start of the move
+   if (MOTOR_DIR_CW == pDrvData->curDir)
+   {
+      MOTOR_DRV_SET_PWM(pDrvData, MOTOR_DRV_CHANNEL_A, driveLevel);
+   }
+   else
+   {
+      MOTOR_DRV_SET_PWM(pDrvData, MOTOR_DRV_CHANNEL_B, driveLevel);
+   }
+   pDrvData->curDriveLvl = driveLevel;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
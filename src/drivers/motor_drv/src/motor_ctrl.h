@@ -0,0 +1,134 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       motor_ctrl.h
+//!
+//!   \brief      Motor position and speed control loop header file
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _MOTOR_CTRL_H
+#define  _MOTOR_CTRL_H 1
+
+//********************************************************************
+//! @addtogroup motor_drv_imp
+//!   @{
+//********************************************************************
+
+#include "motor_drv.h"
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+/**
+ * @brief Initialize the control loop controllers
+ *
+ * @param pDrvData pointer to the motor driver information
+ *
+ * @return #E_OK if the operation was successful\n
+ *         #E_ERROR if an error occurred
+ */
+StatusType motor_ctrl_init(MotorDrvType *pDrvData);
+
+/**
+ * @brief Start controlling a move with the direction, distance, speed or
+ *        duration and shape in the driver data. The motion profile of the
+ *        move is planned here. The outputs must already be driving the
+ *        motor in the move direction.
+ *
+ * @param pDrvData pointer to the motor driver information
+ * @param mode #MOTOR_CTRL_SPEED to control the speed, #MOTOR_CTRL_DRIVE to
+ *        only watch the distance
+ *
+ * @return #E_OK if the operation was successful\n
+ *         #E_ERROR if the move can not be planned, the loop is left off
+ */
+StatusType motor_ctrl_start(MotorDrvType *pDrvData, MotorCtrlModeType mode);
+
+/**
+ * @brief Stop controlling the motor. The interrupt doesn't touch the
+ *        outputs after this returns.
+ *
+ * @param pDrvData pointer to the motor driver information
+ *
+ * @return none
+ */
+void motor_ctrl_stop(MotorDrvType *pDrvData);
+
+/**
+ * @brief Run a control period. Called from the motor timer interrupt at
+ *        #MOTOR_DRV_CTRL_FREQ_HZ.
+ *
+ * @param pDrvData pointer to the motor driver information
+ *
+ * @return none
+ */
+void motor_ctrl_update(MotorDrvType *pDrvData);
+
+/**
+ * @brief Convert a speed to the drive level that keeps it without load
+ *
+ * @param speed speed in steps/s
+ *
+ * @return the drive level in PWM %
+ */
+int32_t motor_ctrl_speed_to_drive(int32_t speed);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _MOTOR_CTRL_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
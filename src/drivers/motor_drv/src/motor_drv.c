@@ -52,6 +52,7 @@
 #include "motor_drv_callouts.h"
 #include "motor_drv.h"
 #include "motor_fsm.h"
+#include "motor_ctrl.h"
 
 //********************************************************************
 // File level pragmas
@@ -95,16 +96,13 @@ StatusType MotorDrv_Init(void)
    motor_drv_data.isInitialized = FALSE;
 
    motor_drv_data.homeEvent = -1;
+   motor_drv_data.directDrive = FALSE;
 
-   //init pid controller
-   float32_t coef;
-   coef = 0.25f;
-   arm_float_to_q15(&coef, &motor_drv_data.pid.Kp, 1);
-   coef = 0.03f;
-   arm_float_to_q15(&coef, &motor_drv_data.pid.Ki, 1);
-   coef = 0.00f;
-   arm_float_to_q15(&coef, &motor_drv_data.pid.Kd, 1);
-   arm_pid_init_q15(&motor_drv_data.pid, 1);
+   //init the position and speed controllers
+   if (E_OK != motor_ctrl_init(&motor_drv_data))
+   {
+      return E_ERROR;
+   }
 
    //motor_drv_data.lpf = lpf_create();
    //lpf_init( motor_drv_data.lpf );
@@ -139,18 +137,9 @@ StatusType MotorDrv_Init(void)
 
 StatusType MotorDrv_SetPIDParameters(float32_t kp, float32_t ki, float32_t kd)
 {
-//   MotorFsmStateType currentState = motor_fsm_get_state(&motor_drv_data);
-   //if ((STATE_HOME == currentState) || (STATE_STOP == currentState))
-   {
-      arm_float_to_q15(&kp, &motor_drv_data.pid.Kp, 1);
-      arm_float_to_q15(&ki, &motor_drv_data.pid.Ki, 1);
-      arm_float_to_q15(&kd, &motor_drv_data.pid.Kd, 1);
-      arm_pid_init_q15(&motor_drv_data.pid, 1);
-      return E_OK;
-   }
-
-   return E_ERROR;
+   return Pid_SetGains(&motor_drv_data.ctrl.speedPid, kp, ki, kd);
 }
+
 StatusType MotorDrv_GetPIDParameters(float32_t *kp, float32_t *ki, float32_t *kd)
 {
    if ((NULL == kp) || (NULL == ki) || (NULL == kd))
@@ -158,9 +147,7 @@ StatusType MotorDrv_GetPIDParameters(float32_t *kp, float32_t *ki, float32_t *kd
       return E_ERROR;
    }
 
-   arm_q15_to_float(&motor_drv_data.pid.Kp, kp, 1);
-   arm_q15_to_float(&motor_drv_data.pid.Ki, ki, 1);
-   arm_q15_to_float(&motor_drv_data.pid.Kd, kd, 1);
+   Pid_GetGains(&motor_drv_data.ctrl.speedPid, kp, ki, kd);
 
    return E_OK;
 }
@@ -169,7 +156,7 @@ StatusType MotorDrv_Start(MotorDirType dir, uint32_t driveLevel)
 {
    motor_drv_data.newDir = dir;
    motor_drv_data.newDriveLvl = driveLevel;
-   motor_drv_data.newDistance = (MOTOR_DRV_MAX_DISTANCE * 2400) / 360;
+   motor_drv_data.newDistance = MOTOR_DRV_DEG_TO_STEPS(MOTOR_DRV_MAX_DISTANCE);
    motor_drv_data.newSpeed = -1;
    motor_fsm_dispatch(&motor_drv_data, &startEvt);
    return E_OK;
@@ -188,10 +175,31 @@ StatusType MotorDrv_Stop(MotorStopType stopType)
 
 StatusType MotorDrv_MoveDistanceAtSpeed(MotorDirType dir, int32_t distance, int32_t speed)
 {
+   if (speed <= 0)
+      return E_ERROR;
+
    motor_drv_data.newDir = dir;
    motor_drv_data.newDriveLvl = -1;
-   motor_drv_data.newDistance = (distance * 2400) / 360;
+   motor_drv_data.newDistance = MOTOR_DRV_DEG_TO_STEPS(distance);
    motor_drv_data.newSpeed = speed;
+   motor_drv_data.newTime = -1;
+   motor_fsm_dispatch(&motor_drv_data, &startEvt);
+
+   return E_OK;
+}
+
+StatusType MotorDrv_MoveDistanceInTime(MotorDirType dir, int32_t distance, uint32_t timeMillis, MotorShapeType shape)
+{
+   if ((distance <= 0) || (0 == timeMillis) || (shape > MOTOR_SHAPE_SINE))
+      return E_ERROR;
+
+   motor_drv_data.newDir = dir;
+   motor_drv_data.newDriveLvl = -1;
+   motor_drv_data.newDistance = MOTOR_DRV_DEG_TO_STEPS(distance);
+   // the mean speed of the move, rounded up so it is never 0
+   motor_drv_data.newSpeed = (distance * 1000 + timeMillis - 1) / timeMillis;
+   motor_drv_data.newTime = timeMillis;
+   motor_drv_data.newShape = shape;
    motor_fsm_dispatch(&motor_drv_data, &startEvt);
 
    return E_OK;
@@ -201,7 +209,7 @@ StatusType MotorDrv_MoveDistanceAtDrive(MotorDirType dir, int32_t distance, uint
 {
    motor_drv_data.newDir = dir;
    motor_drv_data.newDriveLvl = driveLevel;
-   motor_drv_data.newDistance = (distance * 2400) / 360;
+   motor_drv_data.newDistance = MOTOR_DRV_DEG_TO_STEPS(distance);
    motor_drv_data.newSpeed = -1;
    motor_fsm_dispatch(&motor_drv_data, &startEvt);
 
@@ -236,6 +244,33 @@ StatusType MotorDrv_ChangeDriveLevel(int32_t driveLevel)
    return E_OK;
 }
 
+StatusType MotorDrv_WriteDriveLevel(int32_t driveLevel)
+{
+   MotorDrvType *pDrvData = &motor_drv_data;
+
+   // the FSM clears the flag before it changes the outputs
+   if (!pDrvData->directDrive)
+   {
+      return E_ERROR;
+   }
+
+   if (driveLevel < 0)
+      driveLevel = 0;
+   if (driveLevel > 100)
+      driveLevel = 100;
+
+   if (MOTOR_DIR_CW == pDrvData->curDir)
+   {
+      MOTOR_DRV_SET_PWM(pDrvData, MOTOR_DRV_CHANNEL_A, driveLevel);
+   }
+   else
+   {
+      MOTOR_DRV_SET_PWM(pDrvData, MOTOR_DRV_CHANNEL_B, driveLevel);
+   }
+   pDrvData->curDriveLvl = driveLevel;
+
+   return E_OK;
+}
 
 StatusType MotorDrv_GoHome(void)
 {
@@ -282,7 +317,24 @@ void MotorDrv_UpdatePosAndSpeed(int32_t pos, int32_t deltaPos, uint32_t speed)
 
 void MotorDrv_IRQHandler(void)
 {
-   HAL_TIM_IRQHandler(&motor_drv_data.htim);
+   TIM_HandleTypeDef *htim = &motor_drv_data.htim;
+
+   // the update interrupt is the only one enabled
+   if ((0 == __HAL_TIM_GET_FLAG(htim, TIM_FLAG_UPDATE)) ||
+       (RESET == __HAL_TIM_GET_IT_SOURCE(htim, TIM_IT_UPDATE)))
+   {
+      return;
+   }
+   __HAL_TIM_CLEAR_IT(htim, TIM_IT_UPDATE);
+
+   // the control loop runs every few PWM periods
+   if (0 != --motor_drv_data.ctrl.prescaler)
+   {
+      return;
+   }
+   motor_drv_data.ctrl.prescaler = MOTOR_DRV_PWM_FREQ_HZ / MOTOR_DRV_CTRL_FREQ_HZ;
+
+   motor_ctrl_update(&motor_drv_data);
 }
 
 void MotorDrv_HomeIRQHandler(void)
@@ -37,8 +37,8 @@
 
 #ifndef  _MOTOR_DRV_H
 #define  _MOTOR_DRV_H 1
-#define ARM_MATH_CM3  // Use ARM Cortex M3
-#include <arm_math.h>    // Include CMSIS header
+#include "pid_api.h"
+#include "motor_profile.h"
 
 //********************************************************************
 //! @addtogroup motor_drv_imp
@@ -50,6 +50,8 @@
 //********************************************************************
 #define MOTOR_DRV_FREQ_TO_COUNTS(x)       (MOTOR_DRV_TIMER_BASE_CLK_FREQ_HZ / (MOTOR_DRV_TIMER_PRESCALER * (x)))
 
+#define MOTOR_DRV_DEG_TO_STEPS(x)         (((x) * MOTOR_DRV_STEPS_PER_REV) / 360)
+
 #define MOTOR_DRV_SET_PWM(pdrv_data, ch, value) do { \
    *(pdrv_data->pwmReg[ch]) = ((value) * pdrv_data->timerPeriod) / 100; \
 } while(0)
@@ -73,6 +75,49 @@ typedef enum motor_ch_tag
    MOTOR_DRV_CHANNEL_NUM   /**< Max number of channels*/
 } MotorDrvChannelType;
 
+/**
+ * @brief What the control loop interrupt does with the motor
+ *
+ */
+typedef enum motor_ctrl_mode_tag
+{
+   MOTOR_CTRL_OFF,         /**< Nothing, the FSM owns the outputs */
+   MOTOR_CTRL_DRIVE,       /**< Watch the distance travelled, the drive level is set from outside */
+   MOTOR_CTRL_SPEED,       /**< Follow the motion profile of the move and brake at the distance */
+} MotorCtrlModeType;
+
+/**
+ * @brief State of the position and speed control loop. The FSM fills it
+ *        while the mode is #MOTOR_CTRL_OFF and the interrupt runs it
+ *        afterwards.
+ *
+ */
+typedef struct motor_ctrl_tag
+{
+   volatile MotorCtrlModeType mode;                      /**< loop mode, written last when a move starts */
+   volatile Bool done;                                   /**< the move travelled its distance */
+   uint32_t prescaler;                                   /**< timer updates left to the next control period */
+
+   int32_t sign;                                         /**< 1 if the position grows in the move direction, -1 otherwise */
+   int32_t startPos;                                     /**< position at the start of the move */
+   int32_t distance;                                     /**< distance of the move in steps, negative to move until stopped */
+   MotorProfileType profile;                             /**< motion profile giving the references */
+   int32_t refPos;                                       /**< position reference from the start of the move in 1/256 steps */
+   int32_t refSpeed;                                     /**< speed reference of the profile in steps/s */
+
+   int32_t lastPos;                                      /**< position at the last step seen */
+   uint32_t lastStepTime;                                /**< timestamp of the last step seen */
+   int32_t estSpeed;                                     /**< measured speed in the move direction in steps/s */
+   int32_t speedRef;                                     /**< speed loop setpoint in steps/s */
+
+   uint32_t startTime;                                   /**< timestamp of the start of the move */
+   uint32_t moveTime;                                    /**< duration of the move in us, once it's done */
+   int32_t maxError;                                     /**< largest following error of the move in steps */
+
+   PidType posPid;                                       /**< position controller, gives the speed */
+   PidType speedPid;                                     /**< speed controller, gives the drive level */
+} MotorCtrlType;
+
 /**
  * @brief Struct with all the information for the motor_drv
  * 
@@ -92,18 +137,21 @@ typedef struct motor_drv_data_tag
 
    int32_t newDriveLvl;                                  /**< new driver level to set to the motor (drive level equals the PWM) */
    int32_t curDriveLvl;                                  /**< current driver level to set to the motor (drive level equals the PWM) */
+   volatile Bool directDrive;                            /**< the drive level can be written without the FSM (running at a drive level) */
 
    int32_t newDistance;                                  /**< new distance to travel */
    int32_t curDistance;                                  /**< current set distance to travel */
 
    int32_t newSpeed;                                     /**< new speed */
+   int32_t newTime;                                      /**< new duration of the move in ms, negative to move at the new speed */
+   MotorShapeType newShape;                              /**< new shape of the speed along the move, used with the duration */
    int32_t curSpeed;                                     /**< current speed set */
 
    volatile int32_t homeEvent;                           /**< current state of the home switch, -1 unkown, otherwise the value read from the GPIO  */
 
    //lpfType *lpf;
 
-   arm_pid_instance_q15 pid;                             /**< information and variables of the PID */
+   MotorCtrlType ctrl;                                   /**< position and speed control loop */
 
 } MotorDrvType;
 
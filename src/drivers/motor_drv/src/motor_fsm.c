@@ -54,6 +54,7 @@
 #include "motor_drv_callouts.h"
 #include "motor_drv.h"
 #include "motor_fsm.h"
+#include "motor_ctrl.h"
 
 //********************************************************************
 // File level pragmas
@@ -84,9 +85,6 @@ static void motor_fsm_STATE_RUN(MotorFsmType *me, Event const *e);
 static void motor_fsm_STATE_STOP(MotorFsmType *me, Event const *e);
 static void motor_fsm_STATE_ERROR(MotorFsmType *me, Event const *e);
 
-void motor_stop(MotorFsmType *me, MotorStopType stopType);
-void motor_set_drive_level(MotorFsmType *me, MotorDirType dir, uint32_t level);
-
 //********************************************************************
 // ROM Const Variables With File Level Scope
 //********************************************************************
@@ -353,14 +351,6 @@ static void motor_fsm_start(MotorFsmType *me, Event const *e)
 }
  */
 
-static inline uint32_t getPWMFromSpeed(uint32_t speed)
-{
-   if (0 == speed)
-      return 0;
-
-   return ((433 * speed + 9600) / 1000);
-}
-
 static void motor_fsm_STATE_RUN(MotorFsmType *me, Event const *e)
 {
    uint32_t ticks = HAL_GetTick();
@@ -374,9 +364,6 @@ static void motor_fsm_STATE_RUN(MotorFsmType *me, Event const *e)
          //Logger_WriteLine("Motor", "s=%s;e=%s", "run", "entry");
          me->lastTimestamp = ticks;
 
-         //reset pid controller
-         arm_pid_reset_q15(&me->pDrvData->pid);
-
          // if we are at home position we will not move when asked to to go to home position
          uint32_t homeSwitchState = IOReadPinID(MOTOR_DRV_HOME_SWITCH_PIN);
          if ((me->pDrvData->newDistance < 0) && (homeSwitchState != 0))
@@ -396,8 +383,8 @@ static void motor_fsm_STATE_RUN(MotorFsmType *me, Event const *e)
             }
             else
             {
-               // we have to move controlling speed
-               motor_set_drive_level(me, me->pDrvData->newDir, getPWMFromSpeed(me->pDrvData->newSpeed));
+               // we have to move controlling speed. The motion profile starts at rest
+               motor_set_drive_level(me, me->pDrvData->newDir, 0);
             }
 
             //update interval variables state;
@@ -405,6 +392,18 @@ static void motor_fsm_STATE_RUN(MotorFsmType *me, Event const *e)
             me->pDrvData->curDriveLvl = me->pDrvData->newDriveLvl;
             me->pDrvData->curDistance = me->pDrvData->newDistance;
             me->lastPosition = MotorDrv_GetPosition();
+
+            // the drive level can now be written directly
+            me->pDrvData->directDrive = (me->pDrvData->newDriveLvl >= 0);
+
+            // the control loop interrupt watches the distance from now on,
+            // and drives the motor when moving at a speed
+            if (E_OK != motor_ctrl_start(me->pDrvData, (me->pDrvData->newDriveLvl >= 0) ? MOTOR_CTRL_DRIVE : MOTOR_CTRL_SPEED))
+            {
+               me->autoRestart = 0;
+               me->stopType = MOTOR_STOP_BRAKE;
+               FsmTran(me, motor_fsm_STATE_STOP);
+            }
          }
          break;
       case START_SIG:
@@ -443,58 +442,16 @@ static void motor_fsm_STATE_RUN(MotorFsmType *me, Event const *e)
          }
          break;
       }
-      case UPDATE_POS_SIG: {
-         if (0 > me->pDrvData->newDriveLvl)
-         {
-            //int16_t speed = (int16_t)evt->speed;
-            int32_t speederror = me->pDrvData->newSpeed - evt->speed; //speed;
-            speederror = (0x4000 * speederror) / me->pDrvData->newSpeed;
-            speederror = __SSAT(speederror,16);
-            //error = 0x7FFF;
-            /*
-         int16_t error_q15 = error;
-
-         lpf_writeInput(me->pDrvData->lpf, error_q15 );
-         error = (lpf_readOutput( me->pDrvData->lpf)) << 0;
-             */
-            int32_t errF = arm_pid_q15(&me->pDrvData->pid, (q15_t)speederror);
-
-            errF = (errF * 50) / 16384;
-            //         errF = ((errF << 1) * 100) / 0x7FFF;
-            LOG_PRINT_INFO(DEBUG_MOTOR_DRV, LOG_TAG, "s=%lu;e=%lu;p=%d;s=%lu;e=%d;c=%d", 1, evt->sig, evt->pos, evt->speed, speederror, errF);
-
-            int32_t newDriveLvl;
-            newDriveLvl = getPWMFromSpeed(me->pDrvData->newSpeed) + errF;
-            if (newDriveLvl < 0)
-               newDriveLvl = 0;
-            if (newDriveLvl > 100)
-               newDriveLvl = 100;
-
-            //check if we need to control the speed
-            if ((0 >= me->pDrvData->newDriveLvl) &&
-                  (newDriveLvl != me->pDrvData->curDriveLvl))
-            {
-               // we need to control the speed, so we update the drive level based on controller output
-               motor_set_drive_level(me, me->pDrvData->curDir, newDriveLvl);
-               me->pDrvData->curDriveLvl = newDriveLvl;
-            }
-         }
+      case UPDATE_POS_SIG:
+      {
+         MotorCtrlType *pCtrl = &me->pDrvData->ctrl;
 
-         //check if we need to stop by traveled distance
-         if (me->pDrvData->newDistance > 0)
+         if (MOTOR_CTRL_SPEED == pCtrl->mode)
          {
-            // do we traveled the required distance?
-            uint32_t dist = (evt->pos > me->lastPosition)? (evt->pos - me->lastPosition):(me->lastPosition-evt->pos);
-            if (dist > me->pDrvData->newDistance)
-            {
-               // we traveled the required distance. we now stop
-               me->autoRestart = 0;
-               me->stopType = MOTOR_STOP_BRAKE;
-               FsmTran(me, motor_fsm_STATE_STOP);
-               MotorDrv_OnMoveComplete();
-            }
+            LOG_PRINT_INFO(DEBUG_MOTOR_DRV, LOG_TAG, "p=%d;r=%d;s=%d;c=%d;l=%d", evt->pos,
+                           pCtrl->startPos + pCtrl->sign * (pCtrl->refPos >> 8),
+                           pCtrl->estSpeed, pCtrl->speedRef, me->pDrvData->curDriveLvl);
          }
-
          break;
       }
       case HOME_SIG:
@@ -518,9 +475,19 @@ static void motor_fsm_STATE_RUN(MotorFsmType *me, Event const *e)
          break;
       case EXIT_SIG:
          //Logger_WriteLine("Motor", "s=%s;e=%s", "run", "exit");
+         motor_ctrl_stop(me->pDrvData);
+         me->pDrvData->directDrive = FALSE;
          break;
       case TICK_SIG:
-
+         if (me->pDrvData->ctrl.done)
+         {
+            // the control loop saw the required distance travelled. we now stop
+            LOG_PRINT_INFO(DEBUG_MOTOR_DRV, LOG_TAG, "t=%lu;f=%d", me->pDrvData->ctrl.moveTime / 1000, me->pDrvData->ctrl.maxError);
+            me->autoRestart = 0;
+            me->stopType = MOTOR_STOP_BRAKE;
+            FsmTran(me, motor_fsm_STATE_STOP);
+            MotorDrv_OnMoveComplete();
+         }
          break;
       default:
          break;
@@ -43,6 +43,8 @@
 //!   @{
 //********************************************************************
 
+#include "trace_api.h"
+#define FsmOnTran(me_, targ_)    TRACE_FSM_TRAN(TRACE_FSM_MOTOR_DRV, targ_)
 #include "fsm.h"
 #include "motor_drv.h"
 
@@ -166,6 +168,29 @@ void motor_fsm_transition(MotorDrvType *drvData, State *newState);
  */
 MotorFsmStateType motor_fsm_get_state(MotorDrvType *pDrvData);
 
+/**
+ * @brief Stop the motor
+ *
+ * @param me pointer to the motor FSM
+ * @param stopType leave the motor free or brake it
+ *
+ * @return none
+ *
+ */
+void motor_stop(MotorFsmType *me, MotorStopType stopType);
+
+/**
+ * @brief Drive the motor in a direction
+ *
+ * @param me pointer to the motor FSM
+ * @param dir direction of the motor
+ * @param level drive level (PWM %)
+ *
+ * @return none
+ *
+ */
+void motor_set_drive_level(MotorFsmType *me, MotorDirType dir, uint32_t level);
+
 
 //********************************************************************
 //
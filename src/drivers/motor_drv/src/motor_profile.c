@@ -0,0 +1,272 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       motor_profile.c
+//!
+//!   \brief      Motor motion profile generator. Turns a move into a
+//!               table of segments of constant jerk, planned once when
+//!               the move starts, and walks it every control period to
+//!               give the position and speed references of the control
+//!               loop. Only integer math is used.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup motor_drv_imp
+//!   @{
+//********************************************************************
+
+#include "motor_drv_conf.h"
+#include "motor_drv_api.h"
+#include "motor_profile.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define MOTOR_PROFILE_JERK_TICKS       ((MOTOR_DRV_PROFILE_JERK_MS * MOTOR_DRV_CTRL_FREQ_HZ) / 1000)
+
+// a ramp of the acceleration lasts at least a control period
+#if (MOTOR_PROFILE_JERK_TICKS < 1)
+#error "MOTOR_DRV_PROFILE_JERK_MS is shorter than a control period"
+#endif
+
+#define MOTOR_PROFILE_SPEED_TO_VEL(x)  ((((int64_t)(x)) << MOTOR_PROFILE_SHIFT) / MOTOR_DRV_CTRL_FREQ_HZ)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static void motor_profile_add_seg(MotorProfileType *pProfile, uint32_t ticks, int64_t jerk);
+static int64_t motor_profile_distance(const MotorProfileType *pProfile);
+static void motor_profile_rewind(MotorProfileType *pProfile);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType motor_profile_plan(MotorProfileType *pProfile, MotorShapeType shape, int32_t distance, uint32_t ticks)
+{
+   uint32_t jerkTicks, rest;
+   int64_t span;
+   uint32_t i;
+
+   if (distance <= 0)
+      return E_ERROR;
+
+   // the acceleration ramps take at most a quarter of the move each
+   if (ticks < 4)
+      ticks = 4;
+   jerkTicks = MOTOR_PROFILE_JERK_TICKS;
+   if (jerkTicks > (ticks / 4))
+      jerkTicks = ticks / 4;
+   rest = ticks - 2 * jerkTicks;
+
+   // the table is filled with the jerk pattern of the shape first, in
+   // relative units. The speed and the acceleration end at 0
+   pProfile->numSegs = 0;
+   switch (shape)
+   {
+      case MOTOR_SHAPE_SQUARE:
+         // ramp up, constant speed and ramp down
+         motor_profile_add_seg(pProfile, jerkTicks, 1);
+         motor_profile_add_seg(pProfile, jerkTicks, -1);
+         motor_profile_add_seg(pProfile, rest - 2 * jerkTicks, 0);
+         motor_profile_add_seg(pProfile, jerkTicks, -1);
+         motor_profile_add_seg(pProfile, jerkTicks, 1);
+         break;
+      case MOTOR_SHAPE_DECELERATING:
+         // ramp up to the peak speed and slow down at a constant rate
+         // until the end of the move
+         motor_profile_add_seg(pProfile, jerkTicks, rest - jerkTicks);
+         motor_profile_add_seg(pProfile, jerkTicks, -(int64_t)(rest - jerkTicks));
+         motor_profile_add_seg(pProfile, jerkTicks, -(int64_t)jerkTicks);
+         motor_profile_add_seg(pProfile, rest - 2 * jerkTicks, 0);
+         motor_profile_add_seg(pProfile, jerkTicks, jerkTicks);
+         break;
+      case MOTOR_SHAPE_SINE:
+         // a parabola, close to half a sine wave. The acceleration it
+         // starts and ends with is reached with the jerk limited
+         motor_profile_add_seg(pProfile, jerkTicks, rest);
+         motor_profile_add_seg(pProfile, rest, -2 * (int64_t)jerkTicks);
+         motor_profile_add_seg(pProfile, jerkTicks, rest);
+         break;
+      default:
+         return E_ERROR;
+   }
+
+   // the distance is linear with the jerk, so scaling the pattern by the
+   // distance it gives makes the move cover the required one
+   span = motor_profile_distance(pProfile);
+   for (i = 0; i < pProfile->numSegs; i++)
+   {
+      pProfile->seg[i].jerk = (pProfile->seg[i].jerk * ((int64_t)distance << MOTOR_PROFILE_SHIFT)) / span;
+   }
+   pProfile->endVel = MOTOR_PROFILE_SPEED_TO_VEL(MOTOR_DRV_PROFILE_END_SPEED);
+
+   motor_profile_rewind(pProfile);
+
+   return E_OK;
+}
+
+StatusType motor_profile_plan_speed(MotorProfileType *pProfile, int32_t distance, int32_t speed)
+{
+   uint32_t ticks;
+   int64_t jerk;
+
+   if (speed <= 0)
+      return E_ERROR;
+
+   if (distance > 0)
+   {
+      // the ramps take the time they lose to the speed, so the speed is
+      // kept in between
+      ticks = ((int64_t)distance * MOTOR_DRV_CTRL_FREQ_HZ) / speed + 2 * MOTOR_PROFILE_JERK_TICKS;
+      return motor_profile_plan(pProfile, MOTOR_SHAPE_SQUARE, distance, ticks);
+   }
+
+   // ramp up and keep the speed. Two segments of opposite jerk reach
+   // the jerk times the square of their length
+   pProfile->endVel = MOTOR_PROFILE_SPEED_TO_VEL(speed);
+   jerk = pProfile->endVel / ((int64_t)MOTOR_PROFILE_JERK_TICKS * MOTOR_PROFILE_JERK_TICKS);
+
+   pProfile->numSegs = 0;
+   motor_profile_add_seg(pProfile, MOTOR_PROFILE_JERK_TICKS, jerk);
+   motor_profile_add_seg(pProfile, MOTOR_PROFILE_JERK_TICKS, -jerk);
+
+   motor_profile_rewind(pProfile);
+
+   return E_OK;
+}
+
+void motor_profile_advance(MotorProfileType *pProfile)
+{
+   pProfile->pos += pProfile->vel;
+
+   if (pProfile->segIdx >= pProfile->numSegs)
+   {
+      return;
+   }
+
+   pProfile->vel += pProfile->acc;
+   pProfile->acc += pProfile->seg[pProfile->segIdx].jerk;
+
+   if (0 == --pProfile->ticksLeft)
+   {
+      pProfile->segIdx++;
+      if (pProfile->segIdx < pProfile->numSegs)
+      {
+         pProfile->ticksLeft = pProfile->seg[pProfile->segIdx].ticks;
+      }
+      else
+      {
+         // past the table the reference keeps the end speed
+         pProfile->vel = pProfile->endVel;
+         pProfile->acc = 0;
+      }
+   }
+}
+
+static void motor_profile_add_seg(MotorProfileType *pProfile, uint32_t ticks, int64_t jerk)
+{
+   if ((0 == ticks) || (pProfile->numSegs >= MOTOR_PROFILE_MAX_SEGS))
+   {
+      return;
+   }
+
+   pProfile->seg[pProfile->numSegs].ticks = ticks;
+   pProfile->seg[pProfile->numSegs].jerk = jerk;
+   pProfile->numSegs++;
+}
+
+static int64_t motor_profile_distance(const MotorProfileType *pProfile)
+{
+   int64_t pos = 0, vel = 0, acc = 0;
+   int64_t n, jerk;
+   uint32_t i;
+
+   // the sums of the updates of motor_profile_advance over every segment
+   for (i = 0; i < pProfile->numSegs; i++)
+   {
+      n = pProfile->seg[i].ticks;
+      jerk = pProfile->seg[i].jerk;
+      pos += n * vel + acc * ((n * (n - 1)) / 2) + jerk * ((n * (n - 1) * (n - 2)) / 6);
+      vel += n * acc + jerk * ((n * (n - 1)) / 2);
+      acc += n * jerk;
+   }
+
+   return pos;
+}
+
+static void motor_profile_rewind(MotorProfileType *pProfile)
+{
+   pProfile->segIdx = 0;
+   pProfile->ticksLeft = pProfile->seg[0].ticks;
+   pProfile->pos = 0;
+   pProfile->vel = 0;
+   pProfile->acc = 0;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,149 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       motor_profile.h
+//!
+//!   \brief      Motor motion profile generator header file
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _MOTOR_PROFILE_H
+#define  _MOTOR_PROFILE_H 1
+
+//********************************************************************
+//! @addtogroup motor_drv_imp
+//!   @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define MOTOR_PROFILE_SHIFT      (32)  /**< Fractional bits of the profile position, speed, acceleration and jerk */
+#define MOTOR_PROFILE_MAX_SEGS   (5)   /**< Max number of segments of a profile */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+/**
+ * @brief Segment of a profile: the jerk is constant along it
+ *
+ */
+typedef struct motor_profile_seg_tag
+{
+   uint32_t ticks;                              /**< length of the segment in control periods */
+   int64_t jerk;                                /**< jerk in steps per control period cubed */
+} MotorProfileSegType;
+
+/**
+ * @brief Motion profile: the segment table and the reference it gives.
+ *        The position, speed and acceleration are in steps and control
+ *        periods, with #MOTOR_PROFILE_SHIFT fractional bits.
+ *
+ */
+typedef struct motor_profile_tag
+{
+   MotorProfileSegType seg[MOTOR_PROFILE_MAX_SEGS]; /**< segment table */
+   uint32_t numSegs;                            /**< segments in the table */
+   int64_t endVel;                              /**< speed kept after the last segment */
+
+   uint32_t segIdx;                             /**< segment being run */
+   uint32_t ticksLeft;                          /**< control periods left in the segment */
+   int64_t pos;                                 /**< position reference from the start of the move */
+   int64_t vel;                                 /**< speed reference */
+   int64_t acc;                                 /**< acceleration reference */
+} MotorProfileType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+/**
+ * @brief Plan a move of a distance in a time with the speed following a
+ *        shape. The speed starts and ends at 0 and the acceleration
+ *        changes with a limited jerk. Past the end the reference keeps
+ *        moving at #MOTOR_DRV_PROFILE_END_SPEED, so the move always
+ *        covers its distance.
+ *
+ * @param pProfile pointer to the profile to plan
+ * @param shape    shape of the speed along the move
+ * @param distance distance of the move in steps
+ * @param ticks    duration of the move in control periods
+ *
+ * @return #E_OK if the profile was planned\n
+ *         #E_ERROR if the shape is unknown or the distance is not positive
+ */
+StatusType motor_profile_plan(MotorProfileType *pProfile, MotorShapeType shape, int32_t distance, uint32_t ticks);
+
+/**
+ * @brief Plan a move at a speed. The speed ramps up with a limited jerk
+ *        and is kept until the distance is covered, or until stopped if
+ *        the distance is not positive.
+ *
+ * @param pProfile pointer to the profile to plan
+ * @param distance distance of the move in steps, negative to never stop
+ * @param speed    speed of the move in steps/s
+ *
+ * @return #E_OK if the profile was planned\n
+ *         #E_ERROR if the speed is not positive
+ */
+StatusType motor_profile_plan_speed(MotorProfileType *pProfile, int32_t distance, int32_t speed);
+
+/**
+ * @brief Advance the reference of a profile by a control period
+ *
+ * @param pProfile pointer to the profile
+ *
+ * @return none
+ */
+void motor_profile_advance(MotorProfileType *pProfile);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _MOTOR_PROFILE_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
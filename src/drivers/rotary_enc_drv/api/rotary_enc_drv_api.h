@@ -91,6 +91,17 @@ extern void RotaryEncDrv_IRQHandler(void);
  */
 extern int32_t RotaryEncDrv_GetPosition(void);
 
+/**
+ * @brief Get the current position and the time of the step that reached it.
+ *        Both are read together, so the position can be differentiated
+ *        with the step times from an interrupt.
+ *
+ * @param pTimestamp returns the high resolution timestamp of the last step
+ *
+ * @return The current position
+ */
+extern int32_t RotaryEncDrv_GetStep(uint32_t *pTimestamp);
+
 /**
  * @brief Get the current position of the system. 
  *        Mainly used to set the position 0 as the current position
@@ -41,6 +41,7 @@
 #include "standard.h"
 #include "stm32f1xx_hal.h"
 #include "logger_api.h"
+#include "profiler_api.h"
 #include "mavg4.h"
 
 //********************************************************************
@@ -71,6 +72,7 @@ typedef struct encoder_data_tag
    volatile int32_t position;
    volatile uint32_t encATimestamp;
    volatile uint32_t encBTimestamp;
+   volatile uint32_t stepTimestamp;
    volatile uint32_t timePeriod;
    volatile uint32_t intCounter;
    volatile uint32_t speed;
@@ -109,6 +111,7 @@ StatusType RotaryEncDrv_Init(void)
    encoderData.position = 0;
    encoderData.encATimestamp = 0;
    encoderData.encBTimestamp = 0;
+   encoderData.stepTimestamp = 0;
    encoderData.timePeriod = 0;
    encoderData.intCounter = 0;
    encoderData.lastIntCounter = 0;
@@ -223,6 +226,8 @@ void RotaryEncDrv_IRQHandler(void)
    }
 
    // it's our interrupt!!
+   PROF_BEGIN(PROF_ROTARY_ENC_IRQ);
+
    // retrieve the pin that generated the interrupt
    encPin = (encAEXTI != 0)? IOGetPinNumberFromPinID(ROTARY_ENC_DRV_INPUT_A) : IOGetPinNumberFromPinID(ROTARY_ENC_DRV_INPUT_B);
    // we clear the interrupt flag
@@ -263,6 +268,8 @@ void RotaryEncDrv_IRQHandler(void)
       encoderData.encBTimestamp = counter;
    }
 
+   encoderData.stepTimestamp = counter;
+
    timePeriod = (encoderData.encATimestamp > encoderData.encBTimestamp)?
          encoderData.encATimestamp - encoderData.encBTimestamp:
          encoderData.encBTimestamp - encoderData.encATimestamp;
@@ -270,6 +277,7 @@ void RotaryEncDrv_IRQHandler(void)
    encoderData.timePeriod = (encoderData.timePeriod * 4UL + timePeriod) / 5;
    encoderData.intCounter++;
 
+   PROF_END(PROF_ROTARY_ENC_IRQ);
 
    //Logger_WriteLine("Encoder", "p=%d;T=%lu;s=%lu", encoderData.position, encoderData.timePeriod, speed);
 }
@@ -279,6 +287,21 @@ int32_t RotaryEncDrv_GetPosition(void)
    return encoderData.position;
 }
 
+int32_t RotaryEncDrv_GetStep(uint32_t *pTimestamp)
+{
+   int32_t position;
+   uint32_t primask;
+
+   // the position and its timestamp must come from the same step
+   primask = __get_PRIMASK();
+   __disable_irq();
+   position = encoderData.position;
+   *pTimestamp = encoderData.stepTimestamp;
+   __set_PRIMASK(primask);
+
+   return position;
+}
+
 uint32_t RotaryEncDrv_GetSpeed(void)
 {
    return (encoderData.timePeriod == 0)? 0: PULSE_INTERVAL_TO_DEGPERSEC(encoderData.timePeriod);
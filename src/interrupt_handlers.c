@@ -47,6 +47,10 @@
 #include "logger_api.h"
 #include "adc_drv_api.h"
 #include "dflow_meter_drv_api.h"
+#include "flow_meter_drv_conf.h"
+#include "flow_meter_drv_api.h"
+#include "i2c_drv_api.h"
+#include "trace_api.h"
 
 //*****************************************************************************/
 //! \addtogroup
@@ -92,7 +96,8 @@
   */
 void NMI_Handler(void)
 {
-
+   TRACE_IRQ_ENTER(NonMaskableInt_IRQn);
+   TRACE_IRQ_EXIT(NonMaskableInt_IRQn);
 }
 
 /**
@@ -102,6 +107,7 @@ void HardFault_Handler(void)
 {
    static volatile uint32_t cont;
 
+   TRACE_IRQ_ENTER(HardFault_IRQn);
    cont = 0;
 
    //for debuggin we loop here.
@@ -115,6 +121,8 @@ void HardFault_Handler(void)
   */
 void MemManage_Handler(void)
 {
+   TRACE_IRQ_ENTER(MemoryManagement_IRQn);
+
    //for debuggin we loop here.
       //make sure that for the release version you restart the system
   while (1)
@@ -126,6 +134,8 @@ void MemManage_Handler(void)
   */
 void BusFault_Handler(void)
 {
+   TRACE_IRQ_ENTER(BusFault_IRQn);
+
    //for debuggin we loop here.
       //make sure that for the release version you restart the system
   while (1)
@@ -137,6 +147,8 @@ void BusFault_Handler(void)
   */
 void UsageFault_Handler(void)
 {
+   TRACE_IRQ_ENTER(UsageFault_IRQn);
+
    //for debuggin we loop here.
       //make sure that for the release version you restart the system
   while (1)
@@ -148,7 +160,8 @@ void UsageFault_Handler(void)
   */
 void SVC_Handler(void)
 {
-
+   TRACE_IRQ_ENTER(SVCall_IRQn);
+   TRACE_IRQ_EXIT(SVCall_IRQn);
 }
 
 /**
@@ -156,7 +169,8 @@ void SVC_Handler(void)
   */
 void DebugMon_Handler(void)
 {
-
+   TRACE_IRQ_ENTER(DebugMonitor_IRQn);
+   TRACE_IRQ_EXIT(DebugMonitor_IRQn);
 }
 
 /**
@@ -164,7 +178,8 @@ void DebugMon_Handler(void)
   */
 void PendSV_Handler(void)
 {
-
+   TRACE_IRQ_ENTER(PendSV_IRQn);
+   TRACE_IRQ_EXIT(PendSV_IRQn);
 }
 
 /**
@@ -172,7 +187,9 @@ void PendSV_Handler(void)
   */
 void SysTick_Handler(void)
 {
+  TRACE_IRQ_ENTER(SysTick_IRQn);
   HAL_IncTick();
+  TRACE_IRQ_EXIT(SysTick_IRQn);
 }
 
 /******************************************************************************/
@@ -187,15 +204,31 @@ void SysTick_Handler(void)
   */
 void DMA1_Channel1_IRQHandler(void)
 {
+  TRACE_IRQ_ENTER(DMA1_Channel1_IRQn);
   ADCDrv_DMAIRQHandler();
+  TRACE_IRQ_EXIT(DMA1_Channel1_IRQn);
 }
 
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+/**
+  * @brief This function handles DMA1 channel2 global interrupt.
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  TRACE_IRQ_ENTER(DMA1_Channel2_IRQn);
+  FlowMeterDrv_DMAIRQHandler();
+  TRACE_IRQ_EXIT(DMA1_Channel2_IRQn);
+}
+#endif
+
 /**IOWritePinID(IO_DBG_LED, IO_OFF);
   * @brief This function handles DMA1 channel4 global interrupt.
   */
 void DMA1_Channel4_IRQHandler(void)
 {
+  TRACE_IRQ_ENTER(DMA1_Channel4_IRQn);
   USARTDrv_DMATxIRQHandler();
+  TRACE_IRQ_EXIT(DMA1_Channel4_IRQn);
 }
 
 /**
@@ -203,7 +236,9 @@ void DMA1_Channel4_IRQHandler(void)
   */
 void DMA1_Channel5_IRQHandler(void)
 {
+  TRACE_IRQ_ENTER(DMA1_Channel5_IRQn);
   USARTDrv_DMARxIRQHandler();
+  TRACE_IRQ_EXIT(DMA1_Channel5_IRQn);
 }
 
 /**
@@ -211,9 +246,11 @@ void DMA1_Channel5_IRQHandler(void)
   */
 void TIM1_UP_IRQHandler(void)
 {
+   TRACE_IRQ_ENTER(TIM1_UP_IRQn);
    //IOWritePinID(IO_DBG_LED, IO_ON);
    ClockDrv_IRQHandler();
    //IOWritePinID(IO_DBG_LED, IO_OFF);
+   TRACE_IRQ_EXIT(TIM1_UP_IRQn);
 }
 
 /**
@@ -221,7 +258,9 @@ void TIM1_UP_IRQHandler(void)
   */
 void TIM1_CC_IRQHandler(void)
 {
+   TRACE_IRQ_ENTER(TIM1_CC_IRQn);
    ClockDrv_CCIRQHandler();
+   TRACE_IRQ_EXIT(TIM1_CC_IRQn);
 }
 
 /**
@@ -229,9 +268,19 @@ void TIM1_CC_IRQHandler(void)
   */
 void TIM2_IRQHandler(void)
 {
-
+   TRACE_IRQ_ENTER(TIM2_IRQn);
    MotorDrv_IRQHandler();
+   TRACE_IRQ_EXIT(TIM2_IRQn);
+}
 
+/**
+  * @brief This function handles TIM4 global interrupt.
+  */
+void TIM4_IRQHandler(void)
+{
+   TRACE_IRQ_ENTER(TIM4_IRQn);
+   I2CDrv_TimerIRQHandler();
+   TRACE_IRQ_EXIT(TIM4_IRQn);
 }
 
 /**
@@ -239,7 +288,9 @@ void TIM2_IRQHandler(void)
   */
 void USART1_IRQHandler(void)
 {
+   TRACE_IRQ_ENTER(USART1_IRQn);
    USARTDrv_IRQHandler();
+   TRACE_IRQ_EXIT(USART1_IRQn);
 }
 
 /**
@@ -247,9 +298,11 @@ void USART1_IRQHandler(void)
   */
 void EXTI15_10_IRQHandler(void)
 {
+   TRACE_IRQ_ENTER(EXTI15_10_IRQn);
    RotaryEncDrv_IRQHandler();
    //FlowMeterDrv_IRQHandler();
    MotorDrv_HomeIRQHandler();
+   TRACE_IRQ_EXIT(EXTI15_10_IRQn);
 }
 
 /**
@@ -257,17 +310,23 @@ void EXTI15_10_IRQHandler(void)
   */
 void EXTI9_5_IRQHandler(void)
 {
+   TRACE_IRQ_ENTER(EXTI9_5_IRQn);
    //MotorDrv_HomeIRQHandler();
+   TRACE_IRQ_EXIT(EXTI9_5_IRQn);
 }
 
 void I2C2_EV_IRQHandler(void)
 {
-   DFlowMeterDrv_IRQEvHandler();
+   TRACE_IRQ_ENTER(I2C2_EV_IRQn);
+   I2CDrv_EvIRQHandler(I2C_DRV_BUS_SENSORS);
+   TRACE_IRQ_EXIT(I2C2_EV_IRQn);
 }
 
 void I2C2_ER_IRQHandler(void)
 {
-   DFlowMeterDrv_IRQErHandler();
+   TRACE_IRQ_ENTER(I2C2_ER_IRQn);
+   I2CDrv_ErIRQHandler(I2C_DRV_BUS_SENSORS);
+   TRACE_IRQ_EXIT(I2C2_ER_IRQn);
 }
 
 
@@ -47,12 +47,17 @@
 #include "logger_api.h"
 #include "adc_drv_api.h"
 //#include "motor_manager_api.h"
+#include "i2c_drv_api.h"
 #include "dflow_meter_drv_api.h"
+#include "flow_meter_drv_conf.h"
+#include "flow_meter_drv_api.h"
 #include "ventilator_manager_api.h"
 #include "keyboard_drv_api.h"
 #include "display_drv_api.h"
 #include "hmi_api.h"
 #include "system_monitor_api.h"
+#include "profiler_api.h"
+#include "trace_api.h"
 #include "power_manager_api.h"
 
 //********************************************************************
@@ -102,6 +107,8 @@ int main(void)
 {
   //first init system monitor
   SystemMonitor_Init();
+  Profiler_Init();
+  Trace_Init();
 
   // init board
   Board_Init();
@@ -117,7 +124,11 @@ int main(void)
 
   MotorDrv_Init();
   RotaryEncDrv_Init();
+  I2CDrv_Init();
   DFlowMeterDrv_Init();
+#ifdef FLOW_METER_DRV_TIMER_CAPTURE
+  FlowMeterDrv_Init();
+#endif
 
   PowerMgr_Init();
   VentilatorMgr_Init();
@@ -39,6 +39,8 @@
 // Include header files                                              
 //********************************************************************
 #include "standard.h"
+#include "trace_api.h"
+#define FsmOnTran(me_, targ_)    TRACE_FSM_TRAN(TRACE_FSM_ALARM_MGR, targ_)
 #include "fsm.h"
 #include "logger_api.h"
 
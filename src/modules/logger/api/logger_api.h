@@ -43,6 +43,8 @@
 //********************************************************************
 //#define LOG_CONF_NO_LOGS
 #define LOG_CONF_VERBOSE
+// format the lines on the target instead of sending binary records
+//#define LOG_CONF_TEXT
 
 #define DEBUG_ADC_DRV      1
 #define DEBUG_MOTOR        1
@@ -84,12 +86,56 @@
                                                 }                          \
                                              } while(0)
 
+// msg has a single %s, filled with text built at run time
+#define LOG_PRINT_TEXT(enable, tag, msg, text)  do                            \
+                                                {                             \
+                                                   if (enable)                \
+                                                   {                          \
+                                                      LOG_TEXT(tag, msg, text); \
+                                                   }                          \
+                                                } while(0)
+
+// Binary records, decoded on the host with the firmware ELF file. All
+// the words are little endian:
+//   header     LOGGER_RECORD_SYNC | type << 8 | length << 16
+//   timestamp  Logger_GetTimestamp()
+//   id         address of the tag and message strings, "tag\0msg"
+//   payload    LOGGER_RECORD_FORMAT: length argument words
+//              LOGGER_RECORD_TEXT: length text bytes, padded to a word
+// The strings live in the LOGGER_FMT_SECTION section, which is not
+// loaded on the target. The arguments are passed as 32 bits words: a
+// %s argument is decoded from the ELF file, so it must point to a
+// constant string; text built at run time goes with LOG_PRINT_TEXT.
+#define LOGGER_RECORD_SYNC       (0xA5)
+#define LOGGER_RECORD_FORMAT     (0)
+#define LOGGER_RECORD_TEXT       (1)
+#define LOGGER_RECORD_HEADER     (3)      // words
+#define LOGGER_MAX_ARGS          (16)
+#define LOGGER_MAX_TEXT          (128)    // bytes
+#define LOGGER_FMT_SECTION       ".logfmt"
+
+#define LOG_NUM_ARGS(arg...)     LOG_NUM_ARGS_(0 , ##arg, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_NUM_ARGS_(z, a1, a2, a3, a4, a5, a6, a7, a8, a9, a10, a11, a12, a13, a14, a15, a16, n, more...) n
+
+#define LOG_RECORD(tag, msg, arg...)   ({                                                                   \
+                                          static const char logFmt[]                                        \
+                                             __attribute__((section(LOGGER_FMT_SECTION), used)) = tag "\0" msg; \
+                                          Logger_WriteRecord(logFmt, LOG_NUM_ARGS(arg) , ##arg);             \
+                                       })
+
+#define LOG_TEXT_RECORD(tag, msg, text)   ({                                                                   \
+                                             static const char logFmt[]                                        \
+                                                __attribute__((section(LOGGER_FMT_SECTION), used)) = tag "\0" msg; \
+                                             Logger_WriteText(logFmt, text);                                   \
+                                          })
+
 
 #if defined(LOG_CONF_NO_LOGS)
    #define LOG_ERR(tag, arg...)
    #define LOG_INFO(tag, arg...)
    #define LOG_VER(tag, arg...)
-#else
+   #define LOG_TEXT(tag, msg, text) (0)
+#elif defined(LOG_CONF_TEXT)
    #define LOG_ERR(tag, arg...)     Logger_WriteLine(tag , ##arg)
    #define LOG_INFO(tag, arg...)    Logger_WriteLine(tag , ##arg)
    #if defined(LOG_CONF_VERBOSE)
@@ -97,6 +143,16 @@
    #else
       #define LOG_VER(tag, arg...)
    #endif
+   #define LOG_TEXT(tag, msg, text) Logger_WriteLine(tag, msg, text)
+#else
+   #define LOG_ERR(tag, arg...)     LOG_RECORD(tag , ##arg)
+   #define LOG_INFO(tag, arg...)    LOG_RECORD(tag , ##arg)
+   #if defined(LOG_CONF_VERBOSE)
+      #define LOG_VER(tag, arg...)  LOG_RECORD(tag , ##arg)
+   #else
+      #define LOG_VER(tag, arg...)
+   #endif
+   #define LOG_TEXT(tag, msg, text) LOG_TEXT_RECORD(tag, msg, text)
 #endif
 
 //********************************************************************
@@ -113,6 +169,8 @@
 // Remember to use extern modifier
 extern uint32_t Logger_Init();
 extern uint32_t Logger_WriteLine(char *tag, char *msg, ...);
+extern uint32_t Logger_WriteRecord(const char *id, uint32_t count, ...);
+extern uint32_t Logger_WriteText(const char *id, const char *text);
 extern void Logger_DMACpltCallback(void);
 
 #endif // _LOGGER_API_H
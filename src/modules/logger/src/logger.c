@@ -29,7 +29,11 @@
 //!
 //!   \brief      This is the logger module.
 //!
-//!               This module implements a logging to.
+//!               This module implements a logging to. The lines are
+//!               queued in a ring sent by the USART DMA. By default a
+//!               line is a binary record with the id of its strings and
+//!               the raw arguments, formatted on the host by log2text;
+//!               with LOG_CONF_TEXT they are formatted here.
 //!
 //!   \author     Esteban G. Pupillo
 //!
@@ -41,9 +45,11 @@
 // Include header files                                              
 //********************************************************************
 #include "standard.h"
+#include "stm32f1xx_hal.h"
 #include "string.h"
 #include <stdarg.h>
 #include <stdio.h>
+#include "profiler_api.h"
 
 //********************************************************************
 //! \addtogroup 
@@ -85,6 +91,8 @@ static uint32_t logGetAvailableBytes(void);
 static uint32_t logGetAvailableLinearBytes(void);
 static uint32_t logStartDMATransaction(void);
 static uint32_t logGetFreeBytes(void);
+static uint32_t logWriteLine(char *tag, char *msg, va_list args);
+static uint32_t logWrite(const void *data, uint32_t size);
 
 //********************************************************************
 // ROM Const Variables With File Level Scope
@@ -126,58 +134,62 @@ void Logger_Update(void)
 uint32_t Logger_WriteLine(char *tag, char *msg, ...)
 {
    va_list args;
-   va_start(args, msg);
-   volatile LogType *this = &loggerData;
-   size_t totalLen;
-   uint32_t freeBytes, bytesToWrite, bytesToCopy;
-   char debug[128];
+   uint32_t written;
+   PROF_BEGIN(PROF_LOGGER_WRITE);
 
-   if (!loggerData.isInitialized)
-      return 0;
+   va_start(args, msg);
+   written = logWriteLine(tag, msg, args);
+   va_end(args);
 
-   freeBytes = logGetFreeBytes();
-#ifdef LOGGER_DEBUG
-   totalLen = snprintf(debug, 128, "[bF=%ld, bA=%ld, wP=%p, rP=%p]%s: ",freeBytes,
-         logGetAvailableBytes(), this->writePtr, this->readPtr, tag);
-#else
-   totalLen = snprintf(debug, 128, "[%010lu]%s: ",Logger_GetTimestamp(), tag);
-#endif
+   PROF_END(PROF_LOGGER_WRITE);
+   return written;
+}
 
-   totalLen += vsnprintf(debug + totalLen, 128 - totalLen, msg, args);
-   if (totalLen < 128)
-   {
-      debug[totalLen++] = '\n';
-      debug[totalLen++] = '\r';
-   }
+uint32_t Logger_WriteRecord(const char *id, uint32_t count, ...)
+{
+   uint32_t record[LOGGER_RECORD_HEADER + LOGGER_MAX_ARGS];
+   va_list args;
+   uint32_t i, written;
+   PROF_BEGIN(PROF_LOGGER_WRITE);
 
-   bytesToWrite = (freeBytes < totalLen)? freeBytes : totalLen;
+   record[0] = LOGGER_RECORD_SYNC | (LOGGER_RECORD_FORMAT << 8) | (count << 16);
+   record[1] = Logger_GetTimestamp();
+   record[2] = (uint32_t)id;
 
-   if ((bytesToWrite == 0) || (bytesToWrite < totalLen))
+   // every argument fits a word
+   va_start(args, count);
+   for (i = 0; i < count; i++)
    {
-      snprintf(debug, 128, "no space");
-      return 0;
+      record[LOGGER_RECORD_HEADER + i] = va_arg(args, uint32_t);
    }
+   va_end(args);
 
-   bytesToCopy = ((LOGGER_BUFFER_SIZE - (uint32_t)(this->writePtr-this->buffer)) < bytesToWrite)?
-         (LOGGER_BUFFER_SIZE - (uint32_t)(this->writePtr-this->buffer)): bytesToWrite;
-   memcpy((uint8_t*)this->writePtr, debug, bytesToCopy);
-   this->writePtr += bytesToCopy;
-   bytesToWrite -= bytesToCopy;
+   written = logWrite(record, (LOGGER_RECORD_HEADER + count) * sizeof(uint32_t));
 
-   if (bytesToWrite > 0)
-   {
-      memcpy((uint8_t*)this->buffer, &debug[bytesToCopy], bytesToWrite);
-      this->writePtr = this->buffer + bytesToWrite;
-   }
+   PROF_END(PROF_LOGGER_WRITE);
+   return written;
+}
 
-   if (this->writePtr >= (this->buffer+LOGGER_BUFFER_SIZE))
+uint32_t Logger_WriteText(const char *id, const char *text)
+{
+   uint32_t record[LOGGER_RECORD_HEADER + LOGGER_MAX_TEXT / sizeof(uint32_t)];
+   uint32_t length, written;
+   PROF_BEGIN(PROF_LOGGER_WRITE);
+
+   length = strnlen(text, LOGGER_MAX_TEXT);
+   record[0] = LOGGER_RECORD_SYNC | (LOGGER_RECORD_TEXT << 8) | (length << 16);
+   record[1] = Logger_GetTimestamp();
+   record[2] = (uint32_t)id;
+   if (0 != (length & 3))
    {
-      this->writePtr = this->buffer;
+      record[LOGGER_RECORD_HEADER + length / sizeof(uint32_t)] = 0;
    }
+   memcpy(&record[LOGGER_RECORD_HEADER], text, length);
 
-   logStartDMATransaction();
+   written = logWrite(record, (LOGGER_RECORD_HEADER * sizeof(uint32_t)) + ((length + 3) & ~3UL));
 
-   return bytesToCopy + bytesToWrite;
+   PROF_END(PROF_LOGGER_WRITE);
+   return written;
 }
 
 void Logger_DMACpltCallback(void)
@@ -285,6 +297,78 @@ static uint32_t logGetFreeBytes(void)
    return size;
 }
 
+static uint32_t logWriteLine(char *tag, char *msg, va_list args)
+{
+   size_t totalLen;
+   char debug[128];
+
+   if (!loggerData.isInitialized)
+      return 0;
+
+#ifdef LOGGER_DEBUG
+   totalLen = snprintf(debug, 128, "[bF=%ld, bA=%ld, wP=%p, rP=%p]%s: ",logGetFreeBytes(),
+         logGetAvailableBytes(), loggerData.writePtr, loggerData.readPtr, tag);
+#else
+   totalLen = snprintf(debug, 128, "[%010lu]%s: ",Logger_GetTimestamp(), tag);
+#endif
+
+   totalLen += vsnprintf(debug + totalLen, 128 - totalLen, msg, args);
+   if (totalLen < 128)
+   {
+      debug[totalLen++] = '\n';
+      debug[totalLen++] = '\r';
+   }
+
+   return logWrite(debug, totalLen);
+}
+
+static uint32_t logWrite(const void *data, uint32_t size)
+{
+   volatile LogType *this = &loggerData;
+   uint32_t freeBytes, bytesToCopy, primask;
+
+   if (!loggerData.isInitialized)
+      return 0;
+
+   // a line is never split by another one written from an interrupt
+   primask = __get_PRIMASK();
+   __disable_irq();
+
+   // the ring is never filled up: a full ring would look empty
+   freeBytes = logGetFreeBytes();
+   if (freeBytes <= size)
+   {
+      __set_PRIMASK(primask);
+      return 0;
+   }
+
+   bytesToCopy = ((LOGGER_BUFFER_SIZE - (uint32_t)(this->writePtr-this->buffer)) < size)?
+         (LOGGER_BUFFER_SIZE - (uint32_t)(this->writePtr-this->buffer)): size;
+   memcpy((uint8_t*)this->writePtr, data, bytesToCopy);
+   this->writePtr += bytesToCopy;
+
+   if (bytesToCopy < size)
+   {
+      memcpy((uint8_t*)this->buffer, (const uint8_t*)data + bytesToCopy, size - bytesToCopy);
+      this->writePtr = this->buffer + (size - bytesToCopy);
+   }
+
+   if (this->writePtr >= (this->buffer+LOGGER_BUFFER_SIZE))
+   {
+      this->writePtr = this->buffer;
+   }
+
+   __set_PRIMASK(primask);
+
+   // a transfer in progress sends the new bytes when it ends
+   if (0 == this->status)
+   {
+      logStartDMATransaction();
+   }
+
+   return size;
+}
+
 
 
 
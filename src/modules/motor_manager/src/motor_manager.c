@@ -39,11 +39,12 @@
 // Include header files                                              
 //********************************************************************
 #include "standard.h"
+#include "trace_api.h"
+#define FsmOnTran(me_, targ_)    TRACE_FSM_TRAN(TRACE_FSM_MOTOR_MGR, targ_)
 #include "fsm.h"
 #include "logger_api.h"
 //#include "lpf.h"
-#define ARM_MATH_CM3  // Use ARM Cortex M3
-#include <arm_math.h>    // Include CMSIS header
+#include "pid_api.h"
 #include "adc_drv_api.h"
 
 //********************************************************************
@@ -93,7 +94,7 @@ typedef struct hmi_fsm_tag
 typedef struct motor_mgr_tag
 {
    MotorMgrFsmType   motorFsm;
-   arm_pid_instance_q15 pid;
+   PidType pid;
    uint32_t speedSetpoint;
    int32_t distanceSetpoint;
    uint32_t pauseTimeout;
@@ -113,6 +114,21 @@ static void motor_mgr_fsm_up(MotorMgrFsmType *me, Event const *e);
 //********************************************************************
 // ROM Const Variables With File Level Scope
 //********************************************************************
+// speed controller, in PWM % per speed unit
+static const PidConfigType motor_mgr_pid_config =
+{
+   .kp = 1.0f,
+   .ki = 0.2f,
+   .kd = 0.1f,
+   .beta = 1.0f,
+   .kt = 0.0f,
+   .derivShift = 0,
+   .antiWindup = PID_ANTI_WINDUP_CONDITIONAL,
+   .inputRange = 1024,
+   .outputRange = 100,
+   .outMin = 0,
+   .outMax = 100,
+};
 
 //********************************************************************
 // Static Variables and Const Variables With File Level Scope
@@ -124,15 +140,7 @@ static MotorMgrType motor_mgr_data;
 //********************************************************************
 StatusType MotorManager_Init(void)
 {
-   float32_t coef;
-
-   coef = 0.10f;
-   arm_float_to_q15(&coef, &motor_mgr_data.pid.Kp, 1);
-   coef = 0.02f;
-   arm_float_to_q15(&coef, &motor_mgr_data.pid.Ki, 1);
-   coef = 0.01f;
-   arm_float_to_q15(&coef, &motor_mgr_data.pid.Kd, 1);
-   arm_pid_init_q15(&motor_mgr_data.pid, 1);
+   Pid_Init(&motor_mgr_data.pid, &motor_mgr_pid_config);
 
    motor_mgr_data.speedSetpoint = 10;
    motor_mgr_data.distanceSetpoint = 400;
@@ -185,12 +193,7 @@ void MotorManager_UpdatePosAndSpeed(int32_t pos, int32_t deltaPos, uint32_t spee
 
 StatusType MotorManager_SetPIDParameters(float32_t kp, float32_t ki, float32_t kd)
 {
-   arm_float_to_q15(&kp, &motor_mgr_data.pid.Kp, 1);
-   arm_float_to_q15(&ki, &motor_mgr_data.pid.Ki, 1);
-   arm_float_to_q15(&kd, &motor_mgr_data.pid.Kd, 1);
-   arm_pid_init_q15(&motor_mgr_data.pid, 1);
-
-   return E_OK;
+   return Pid_SetGains(&motor_mgr_data.pid, kp, ki, kd);
 }
 
 StatusType MotorManager_SetSetpoint(uint32_t speed, uint32_t distance, uint32_t pauseTimeout)
@@ -214,20 +217,20 @@ static void motor_mgr_fsm_initial(MotorMgrFsmType *me, Event const *e)
    switch (e->sig)
    {
       case ENTRY_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "ini", "entry");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "ini", "entry");
          me->lastTimestamp = ticks;
          me->curDriveLvl = 0;
          MotorManager_SetMotorState(MOTOR_MGR_MOTOR_STOP, 0);
          break;
 
       case START_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "ini", "start");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "ini", "start");
 
          FsmTran(me, motor_mgr_fsm_down);
          break;
 
       case EXIT_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "ini", "exit");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "ini", "exit");
          break;
       case TICK_SIG:
          //Logger_WriteLine("Motor", "s=%s", "ini");
@@ -242,8 +245,8 @@ static void motor_mgr_fsm_down(MotorMgrFsmType *me, Event const *e)
    switch (e->sig)
    {
       case ENTRY_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "down", "entry");
-         arm_pid_reset_q15(&motor_mgr_data.pid);
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "down", "entry");
+         Pid_Reset(&motor_mgr_data.pid, 0);
          me->lastTimestamp = ticks;
          me->lastPosition = 0; //MotorManager_getMotorPosition();
          me->curDriveLvl = 12;
@@ -253,19 +256,11 @@ static void motor_mgr_fsm_down(MotorMgrFsmType *me, Event const *e)
       case UPDATE_POS_SIG: {
          int16_t speed = (int16_t)evt->speed;
          int32_t error = motor_mgr_data.speedSetpoint - speed;
-         error = (0x7FFF * error) / ((int32_t)motor_mgr_data.speedSetpoint);
-
-         int32_t errF = arm_pid_q15(&motor_mgr_data.pid, (q15_t)error);
-
-         errF = (errF * 50) / 16384;
-         Logger_WriteLine(LOG_TAG, "s=%lu;e=%lu;p=%d;s=%lu;e=%d;c=%d", 1, evt->sig, evt->pos, evt->speed, error, errF);
-
          int32_t newDriveLvl;
-         newDriveLvl = 12 + errF;
-         if (newDriveLvl < 0)
-            newDriveLvl = 0;
-         if (newDriveLvl > 100)
-            newDriveLvl = 100;
+
+         // the controller corrects the starting drive level
+         newDriveLvl = Pid_Update(&motor_mgr_data.pid, motor_mgr_data.speedSetpoint, speed, 12);
+         LOG_INFO(LOG_TAG, "s=%lu;e=%lu;p=%d;s=%lu;e=%d;c=%d", 1, evt->sig, evt->pos, evt->speed, error, newDriveLvl);
 
          if (newDriveLvl != me->curDriveLvl)
             MotorManager_SetMotorState(MOTOR_MGR_MOTOR_RUN_DOWN, newDriveLvl);
@@ -281,11 +276,11 @@ static void motor_mgr_fsm_down(MotorMgrFsmType *me, Event const *e)
          break;
       }
       case STOP_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "down", "stop");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "down", "stop");
          FsmTran(me, motor_mgr_fsm_initial);
          break;
       case EXIT_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "down", "exit");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "down", "exit");
          break;
       case TICK_SIG:
 
@@ -299,18 +294,18 @@ static void motor_mgr_fsm_pause(MotorMgrFsmType *me, Event const *e)
    switch (e->sig)
    {
       case ENTRY_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "pause", "entry");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "pause", "entry");
          me->lastTimestamp = ticks;
          MotorManager_SetMotorState(MOTOR_MGR_MOTOR_BRAKE, 0);
          break;
 
       case STOP_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "pause", "stop");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "pause", "stop");
          FsmTran(me, motor_mgr_fsm_initial);
          break;
 
       case EXIT_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "pause", "exit");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "pause", "exit");
          break;
 
       case TICK_SIG:
@@ -337,14 +332,14 @@ static void motor_mgr_fsm_up(MotorMgrFsmType *me, Event const *e)
    switch (e->sig)
    {
       case ENTRY_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "up", "entry");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "up", "entry");
          me->lastTimestamp = ticks;
          //me->lastPosition = MotorManager_getMotorPosition();
          MotorManager_SetMotorState(MOTOR_MGR_MOTOR_RUN_UP, 80);
          break;
 
       case UPDATE_POS_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s;p=%d;s=%lu", "up", "updatePos", evt->pos, evt->speed);
+         LOG_INFO(LOG_TAG, "s=%s;e=%s;p=%d;s=%lu", "up", "updatePos", evt->pos, evt->speed);
          if ((me->lastPosition - evt->pos) >= 5)
          {
             me->nextDir = MOTOR_MGR_MOTOR_RUN_DOWN;
@@ -352,11 +347,11 @@ static void motor_mgr_fsm_up(MotorMgrFsmType *me, Event const *e)
          }
          break;
       case STOP_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "up", "stop");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "up", "stop");
          FsmTran(me, motor_mgr_fsm_initial);
          break;
       case EXIT_SIG:
-         Logger_WriteLine(LOG_TAG, "s=%s;e=%s", "up", "exit");
+         LOG_INFO(LOG_TAG, "s=%s;e=%s", "up", "exit");
          break;
       case TICK_SIG:
          //Logger_WriteLine("Motor", "s=%s", "ini");
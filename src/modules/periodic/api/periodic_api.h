@@ -90,6 +90,35 @@ extern void Periodic_Init(void);
  */
 extern void Periodic_Start(void);
 
+/**
+ * Gets the longest time spent running the handlers of a time slot.
+ * Slots are numbered inside the longest period, so every slot runs the
+ * same handlers each time.
+ *
+ * @param slot Slot number, from 0 to 2^#PERIODIC_HYPERPERIOD_SHIFT - 1
+ * @param pLoad Where the time in microseconds is returned
+ *
+ * @return E_OK if the load was returned, E_ERROR if the slot is invalid
+ */
+extern StatusType Periodic_GetSlotLoad(uint32_t slot, uint32_t *pLoad);
+
+/**
+ * Gets the number of time slots elapsed since the start, including the
+ * missed ones. As the slots have absolute deadlines, this number times
+ * #PERIODIC_MIN_TIMESLOT is the time since the start.
+ *
+ * @return the number of slots
+ */
+extern uint32_t Periodic_GetSlotCount(void);
+
+/**
+ * Gets the number of time slots skipped because the previous ones
+ * overran their deadline
+ *
+ * @return the number of missed slots
+ */
+extern uint32_t Periodic_GetMissedSlots(void);
+
 //********************************************************************
 //
 // Close the Doxygen group.
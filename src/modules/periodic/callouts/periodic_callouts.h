@@ -81,6 +81,21 @@ void Periodic_OnProcessingStart(void);
  */
 void Periodic_OnProcessingStop(void);
 
+/**
+ * Gets a timestamp in microseconds, used to measure the slots load
+ *
+ * @return the timestamp
+ */
+uint32_t Periodic_GetHighResTimestamp(void);
+
+/**
+ * Informs that time slots were skipped because the previous slot
+ * overran its deadline
+ *
+ * @param missed Number of slots skipped
+ */
+void Periodic_OnSlotsMissed(uint32_t missed);
+
 /**
  * Callout called when the base slot timeout has elapsed 1 time
  * The count is reset after this callout is called
@@ -47,6 +47,26 @@
 //********************************************************************
 
 #define PERIODIC_MIN_TIMESLOT	                    (5) /**< Base time slot in ms */
+#define PERIODIC_HYPERPERIOD_SHIFT               (7) /**< Slots of the longest period, as a power of 2 */
+
+/**
+ * Periodic tasks: X(handler, period, phase)
+ *  - handler: callout to execute
+ *  - period: in time slots, a power of 2 up to 2^#PERIODIC_HYPERPERIOD_SHIFT
+ *  - phase: slot of the period the handler runs in
+ *
+ * The group with a period of 2^k slots runs in phase 2^(k-1), so no two
+ * groups but the 1x one share a slot and the load is spread evenly.
+ */
+#define PERIODIC_TASKS_CFG \
+   X(Periodic_handler_1x,     1,  0) \
+   X(Periodic_handler_2x,     2,  1) \
+   X(Periodic_handler_4x,     4,  2) \
+   X(Periodic_handler_8x,     8,  4) \
+   X(Periodic_handler_16x,   16,  8) \
+   X(Periodic_handler_32x,   32, 16) \
+   X(Periodic_handler_64x,   64, 32) \
+   X(Periodic_handler_128x, 128, 64)
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
@@ -34,6 +34,18 @@
  * It works with a base time slot to start processing the triggers,
  * and each trigger timeout must be a multiple of this base time slot.
  *
+ * The handlers are listed in #PERIODIC_TASKS_CFG with their period and
+ * phase. Giving every rate group its own phase keeps the slow handlers
+ * from running in the same slot, so the worst slot is not the sum of
+ * all of them. The longest time spent in every slot is kept and can be
+ * read with #Periodic_GetSlotLoad.
+ *
+ * Every slot has an absolute deadline, #PERIODIC_MIN_TIMESLOT after the
+ * previous one, and the core sleeps in WFI until it is reached. A slot
+ * that overruns doesn't move the following deadlines: the slots that
+ * can't start in time are skipped, counted and reported through
+ * #Periodic_OnSlotsMissed.
+ *
  * @startuml
  *
  * @enduml
@@ -39,6 +39,7 @@
 // Include header files
 //********************************************************************
 #include "standard.h"
+#include "stm32f1xx_hal.h"
 #include "logger_api.h"
 
 //********************************************************************
@@ -56,32 +57,48 @@
 //********************************************************************
 // Constant and Macro Definitions using #define
 //********************************************************************
+#define PERIODIC_HYPERPERIOD     (1UL << PERIODIC_HYPERPERIOD_SHIFT)
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
 //********************************************************************
+typedef struct periodic_task_tag
+{
+   void (*handler)(void);
+   uint8_t mask;        // period - 1
+   uint8_t phase;
+} PeriodicTaskType;
+
+typedef struct periodic_data_tag
+{
+   uint32_t slots;                                 // slots elapsed, run or missed
+   uint32_t missedSlots;
+   uint16_t slotLoad[PERIODIC_HYPERPERIOD];        // longest time in every slot, in us
+} PeriodicDataType;
 
 //********************************************************************
 // Function Prototypes for Private Functions with File Level Scope
 //********************************************************************
 static void periodic_task(void);
+static void periodic_init(void);
 
 //********************************************************************
 // ROM Const Variables With File Level Scope
 //********************************************************************
+#define X(a,b,c) { a, (b) - 1, (c) },
+static const PeriodicTaskType periodic_tasks[] = { PERIODIC_TASKS_CFG };
+#undef X
+
+// the period must be a power of 2 not longer than the hyperperiod and
+// the phase must be inside the period
+#define X(a,b,c) && (0 == ((b) & ((b) - 1))) && ((b) <= PERIODIC_HYPERPERIOD) && ((c) < (b))
+typedef char periodic_tasks_cfg_check[(1 PERIODIC_TASKS_CFG)? 1 : -1];
+#undef X
 
 //********************************************************************
 // Static Variables and Const Variables With File Level Scope
 //********************************************************************
-static void periodic_init(void);
-static void periodic_1x(void);
-static void periodic_2x(void);
-static void periodic_4x(void);
-static void periodic_8x(void);
-static void periodic_16x(void);
-static void periodic_32x(void);
-static void periodic_64x(void);
-static void periodic_128x(void);
+static PeriodicDataType periodicData;
 
 //********************************************************************
 // Function Definitions
@@ -110,6 +127,28 @@ void Periodic_Start(void)
    periodic_task();
 }
 
+StatusType Periodic_GetSlotLoad(uint32_t slot, uint32_t *pLoad)
+{
+   if ((slot >= PERIODIC_HYPERPERIOD) || (NULL == pLoad))
+   {
+      return E_ERROR;
+   }
+
+   *pLoad = periodicData.slotLoad[slot];
+
+   return E_OK;
+}
+
+uint32_t Periodic_GetSlotCount(void)
+{
+   return periodicData.slots;
+}
+
+uint32_t Periodic_GetMissedSlots(void)
+{
+   return periodicData.missedSlots;
+}
+
 //********************************************************************
 //
 //! Periodic module task
@@ -123,48 +162,62 @@ void Periodic_Start(void)
 //********************************************************************
 static void periodic_task(void)
 {
-   uint8_t slice = 0;
-   uint32_t lastTicks = 0;
+   uint32_t slice = 0;
+   uint32_t next;
+   uint32_t start, load, late, i;
 
    // Initialize required data
    periodic_init();
+   next = HAL_GetTick() + PERIODIC_MIN_TIMESLOT;
 
    // Task loop
    for (;;)
    {
-      // Delay task
-	   if ((HAL_GetTick() - lastTicks) >= PERIODIC_MIN_TIMESLOT)
-	   {
-	      lastTicks = HAL_GetTick();
-		   slice++;
-
-		   Periodic_OnProcessingStart();
-
-		   periodic_1x();
-
-		   if ((0x01 & slice) == 0x01)
-			   periodic_2x();
-
-		   if ((0x03 & slice) == 0x03)
-			   periodic_4x();
-
-		   if ((0x07 & slice) == 0x07)
-			   periodic_8x();
-
-		   if ((0x0F & slice) == 0x0F)
-			   periodic_16x();
-
-		   if ((0x1F & slice) == 0x1F)
-			   periodic_32x();
-
-		   if ((0x3F & slice) == 0x3F)
-			   periodic_64x();
-
-		   if ((0x7F & slice) == 0x7F)
-			   periodic_128x();
-
-		   Periodic_OnProcessingStop();
-	   }
+      // Sleep until the slot deadline. The interrupts are masked while
+      // checking it, so a tick taken before the WFI still wakes it up.
+      __disable_irq();
+      if ((int32_t)(HAL_GetTick() - next) < 0)
+      {
+         __WFI();
+         __enable_irq();
+         continue;
+      }
+      __enable_irq();
+
+      // the deadlines are absolute: the slots that can't start in time
+      // are skipped and an overrun doesn't move the following ones
+      late = (HAL_GetTick() - next) / PERIODIC_MIN_TIMESLOT;
+      next += (late + 1) * PERIODIC_MIN_TIMESLOT;
+      periodicData.slots += late + 1;
+      slice = (slice + late + 1) & (PERIODIC_HYPERPERIOD - 1);
+      if (late > 0)
+      {
+         periodicData.missedSlots += late;
+         Periodic_OnSlotsMissed(late);
+      }
+
+      Periodic_OnProcessingStart();
+      start = Periodic_GetHighResTimestamp();
+
+      for (i = 0; i < Num_Elems(periodic_tasks); i++)
+      {
+         if ((slice & periodic_tasks[i].mask) == periodic_tasks[i].phase)
+         {
+            periodic_tasks[i].handler();
+         }
+      }
+
+      load = Periodic_GetHighResTimestamp() - start;
+      if (load > UINT16_MAX)
+      {
+         load = UINT16_MAX;
+      }
+      if (load > periodicData.slotLoad[slice])
+      {
+         periodicData.slotLoad[slice] = (uint16_t)load;
+      }
+
+      Periodic_OnProcessingStop();
    }
    //we should never get here!
 }
@@ -172,63 +225,14 @@ static void periodic_task(void)
 // Periodic call init
 static void periodic_init(void)
 {
+   uint32_t i;
 
-}
-
-// 1X periodic task (16ms)
-static void periodic_1x(void)
-{
-   // call application specific handler
-   Periodic_handler_1x();
-}
-
-// 2X periodic task
-static void periodic_2x(void)
-{
-  // call application specific handler
-  Periodic_handler_2x();
-}
-
-// 4X periodic task
-static void periodic_4x(void)
-{
-   // call application specific handler
-   Periodic_handler_4x();
-}
-
-// 8X periodic task
-static void periodic_8x(void)
-{
-   // call application specific handler
-   Periodic_handler_8x();
-}
-
-// 16X periodic task
-static void periodic_16x(void)
-{
-   // call application specific handler
-   Periodic_handler_16x();
-}
-
-// 32X periodic task
-static void periodic_32x(void)
-{
-   // call application specific handler
-   Periodic_handler_32x();
-}
-
-// 64X periodic task
-static void periodic_64x(void)
-{
-   // call application specific handler
-   Periodic_handler_64x();
-}
-
-// 128X periodic task
-static void periodic_128x(void)
-{
-   // call application specific handler
-   Periodic_handler_128x();
+   periodicData.slots = 0;
+   periodicData.missedSlots = 0;
+   for (i = 0; i < PERIODIC_HYPERPERIOD; i++)
+   {
+      periodicData.slotLoad[i] = 0;
+   }
 }
 
 //********************************************************************
@@ -0,0 +1,194 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   @file                pid_api.h
+//!
+//!   @brief               PID controller APIs header file
+//!
+//!   @author              agent
+//!
+//!   @date                17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _PID_API_H
+#define  _PID_API_H 1
+
+#define ARM_MATH_CM3  // Use ARM Cortex M3
+#include "arm_math.h"
+
+//********************************************************************
+//! @addtogroup pid_api
+//! @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+/**
+ * Integrator anti-windup methods
+ */
+typedef enum
+{
+   PID_ANTI_WINDUP_NONE = 0,        /**< The integral is only limited by the q31 range */
+   PID_ANTI_WINDUP_CONDITIONAL,     /**< The integral stops while the output is saturated in the error direction */
+   PID_ANTI_WINDUP_BACK_CALC,       /**< Conditional integration, and the saturation excess is fed back to the integral */
+} PidAntiWindupType;
+
+/**
+ * Controller configuration.
+ * The gains are in output units per input unit; the input and output
+ * units are the ones the loop passes to #Pid_Update
+ */
+typedef struct pid_config_tag
+{
+   float32_t kp;                    /**< Proportional gain */
+   float32_t ki;                    /**< Integral gain, per sample */
+   float32_t kd;                    /**< Derivative gain, times a sample */
+   float32_t beta;                  /**< Setpoint weight of the proportional term, 0.0 to 1.0 */
+   float32_t kt;                    /**< Back calculation gain, fraction of the saturation excess removed from the integral every sample */
+   uint32_t derivShift;             /**< Derivative filter time constant, 2^derivShift samples. 0 disables the filter */
+   PidAntiWindupType antiWindup;    /**< Anti-windup method */
+   int32_t inputRange;              /**< Setpoint and measurement full scale, in input units */
+   int32_t outputRange;             /**< Output full scale, in output units */
+   int32_t outMin;                  /**< Minimum output, in output units */
+   int32_t outMax;                  /**< Maximum output, in output units */
+} PidConfigType;
+
+/**
+ * Gain in q31 with an exponent: gain = mant * 2^(shift - 31)
+ */
+typedef struct pid_gain_tag
+{
+   q31_t mant;
+   uint32_t shift;
+} PidGainType;
+
+/**
+ * Controller instance. The fields are private to the module
+ */
+typedef struct pid_tag
+{
+   PidConfigType cfg;
+   PidGainType kp, ki, kd, kt;
+   q31_t beta;
+   q31_t inScale;                   // q31 per input unit
+   q31_t outScale;                  // q31 per output unit
+   q31_t outMin, outMax;
+   q31_t integral;
+   q31_t derivative;                // filtered measurement change, sign inverted
+   q31_t setpoint;                  // last normalized setpoint
+   q31_t measurement;               // last normalized measurement
+   q31_t output;                    // last saturated output
+   Bool first;
+} PidType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+/**
+ * Initializes a controller. The integral starts at 0
+ *
+ * @param pPid Controller
+ * @param pConfig Configuration, copied into the controller
+ *
+ * @return StatusType #E_OK if no error occurred\n
+ *                    #E_ERROR if the ranges or the limits are not valid
+ */
+extern StatusType Pid_Init(PidType *pPid, const PidConfigType *pConfig);
+
+/**
+ * Restarts a controller. The derivative and the setpoint history are
+ * cleared, and the integral is loaded with the output the loop should
+ * start from, so taking over from a fixed drive does not bump it
+ *
+ * @param pPid Controller
+ * @param output Initial integral, in output units
+ */
+extern void Pid_Reset(PidType *pPid, int32_t output);
+
+/**
+ * Runs the controller for one sample
+ *
+ * @param pPid Controller
+ * @param setpoint Setpoint, in input units
+ * @param measurement Measured value, in input units
+ * @param feedForward Output added to the controller terms before the
+ *        limits, in output units
+ *
+ * @return Output, in output units, within the configured limits
+ */
+extern int32_t Pid_Update(PidType *pPid, int32_t setpoint, int32_t measurement, int32_t feedForward);
+
+/**
+ * Changes the gains of a running controller. The integral absorbs the
+ * change of the proportional and derivative terms, so the output does
+ * not jump. It can be called while an interrupt runs #Pid_Update
+ *
+ * @param pPid Controller
+ * @param kp Proportional gain
+ * @param ki Integral gain
+ * @param kd Derivative gain
+ *
+ * @return StatusType #E_OK if no error occurred\n
+ *                    #E_ERROR if a gain can't be represented
+ */
+extern StatusType Pid_SetGains(PidType *pPid, float32_t kp, float32_t ki, float32_t kd);
+
+/**
+ * Gets the gains of a controller
+ *
+ * @param pPid Controller
+ * @param kp Proportional gain
+ * @param ki Integral gain
+ * @param kd Derivative gain
+ */
+extern void Pid_GetGains(PidType *pPid, float32_t *kp, float32_t *ki, float32_t *kd);
+
+//********************************************************************
+// Close the Doxygen group.
+//! @}
+//********************************************************************
+#endif // _PID_API_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+// 
+//
+//********************************************************************
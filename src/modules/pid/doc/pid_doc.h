@@ -0,0 +1,73 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @defgroup pid PID controller
+ * @brief PID controller module documentation.
+ *
+ * The PID controller is shared by the control loops of the firmware: the
+ * pressure loop of the ventilator manager and the speed loops of the
+ * motor driver and the motor manager. Every loop owns a #PidType and
+ * passes its setpoint and measurement in its own units; the gains are
+ * given in output units per input unit, so they don't depend on the
+ * setpoint.
+ *
+ * The signals are normalized to q31 of the input and output ranges of
+ * the configuration, and every gain is a q31 mantissa with an exponent,
+ * so small integral gains keep their resolution. The products are done
+ * in 64 bits and saturated, and no division is done per sample.
+ *
+ * The output is the sum of:
+ * - the proportional term on the weighted error, beta * setpoint -
+ *   measurement, so a lower beta softens the response to setpoint
+ *   steps without changing the response to disturbances.
+ * - the integral term.
+ * - the derivative term on the measurement, through a first order filter
+ *   with a time constant of 2^derivShift samples.
+ * - the feed-forward given by the loop.
+ *
+ * The sum is limited to the configured output range. While it is out of
+ * the range the integral does not grow further in that direction
+ * (conditional integration), and with back calculation a fraction kt of
+ * the excess is also taken back from the integral every sample, so the
+ * loop recovers as soon as the error changes sign.
+ *
+ * #Pid_SetGains changes the gains of a running controller and loads the
+ * integral with the change of the proportional and derivative terms, so
+ * the output does not jump. #Pid_Reset loads the integral with the
+ * output the loop should start from.
+ *
+ * The host simulation checks the step response of the pressure loop
+ * against the plant model with the option -S.
+ *
+ * @{
+ *
+ * @defgroup pid_api Module API Interface
+ * @brief PID controller module API functions
+ *
+ * @defgroup pid_imp Module Implementation
+ * @brief PID controller implementation
+ * @}
+ */
@@ -0,0 +1,293 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       pid.c
+//!
+//!   \brief      This is the PID controller module implementation file.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup pid_imp
+//! @{
+//********************************************************************
+
+#include "pid_api.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define PID_Q31_ONE              (2147483648.0f)
+
+// the largest gain exponent, the gains must stay below 2^30
+#define PID_MAX_GAIN_SHIFT       (30)
+
+#define PID_MAX_DERIV_SHIFT      (16)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static StatusType pid_gain_from_float(float32_t gain, float32_t scale, PidGainType *pGain);
+static float32_t pid_gain_to_float(const PidGainType *pGain, float32_t scale);
+static inline q31_t pid_sat(int64_t value);
+static inline q31_t pid_mul(const PidGainType *pGain, q31_t value);
+static inline q31_t pid_scale(int32_t value, q31_t scale);
+static inline q31_t pid_weighted_error(PidType *pPid);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType Pid_Init(PidType *pPid, const PidConfigType *pConfig)
+{
+   if ((NULL == pPid) || (NULL == pConfig) ||
+       (pConfig->inputRange <= 0) || (pConfig->outputRange <= 0) ||
+       (pConfig->outMin > pConfig->outMax) ||
+       (pConfig->outMin < -pConfig->outputRange) || (pConfig->outMax > pConfig->outputRange) ||
+       (pConfig->beta < 0.0f) || (pConfig->beta > 1.0f) ||
+       (pConfig->kt < 0.0f) || (pConfig->kt > 1.0f) ||
+       (pConfig->derivShift > PID_MAX_DERIV_SHIFT))
+   {
+      return E_ERROR;
+   }
+
+   pPid->cfg = *pConfig;
+   pPid->inScale = INT32_MAX / pConfig->inputRange;
+   pPid->outScale = INT32_MAX / pConfig->outputRange;
+   pPid->outMin = pid_scale(pConfig->outMin, pPid->outScale);
+   pPid->outMax = pid_scale(pConfig->outMax, pPid->outScale);
+   pPid->beta = (pConfig->beta >= 1.0f) ? INT32_MAX : (q31_t)(pConfig->beta * PID_Q31_ONE);
+
+   if ((E_OK != pid_gain_from_float(pConfig->kt, 1.0f, &pPid->kt)) ||
+       (E_OK != pid_gain_from_float(pConfig->kp, (float32_t)pConfig->inputRange / pConfig->outputRange, &pPid->kp)) ||
+       (E_OK != pid_gain_from_float(pConfig->ki, (float32_t)pConfig->inputRange / pConfig->outputRange, &pPid->ki)) ||
+       (E_OK != pid_gain_from_float(pConfig->kd, (float32_t)pConfig->inputRange / pConfig->outputRange, &pPid->kd)))
+   {
+      return E_ERROR;
+   }
+
+   Pid_Reset(pPid, 0);
+
+   return E_OK;
+}
+
+void Pid_Reset(PidType *pPid, int32_t output)
+{
+   pPid->integral = pid_scale(output, pPid->outScale);
+   pPid->derivative = 0;
+   pPid->setpoint = 0;
+   pPid->measurement = 0;
+   pPid->output = pPid->integral;
+   pPid->first = TRUE;
+}
+
+int32_t Pid_Update(PidType *pPid, int32_t setpoint, int32_t measurement, int32_t feedForward)
+{
+   q31_t sp = pid_scale(setpoint, pPid->inScale);
+   q31_t y = pid_scale(measurement, pPid->inScale);
+   q31_t error = pid_sat((int64_t)sp - y);
+   q31_t delta, sum, out, increment;
+
+   if (pPid->first)
+   {
+      pPid->measurement = y;
+      pPid->first = FALSE;
+   }
+
+   // The derivative acts on the measurement only, so a setpoint step
+   // does not kick the output. The first order filter keeps the sensor
+   // noise out of the drive.
+   delta = pid_sat((int64_t)pPid->measurement - y);
+   pPid->derivative += (q31_t)(((int64_t)delta - pPid->derivative) >> pPid->cfg.derivShift);
+   pPid->setpoint = sp;
+   pPid->measurement = y;
+
+   sum = pid_sat((int64_t)pid_mul(&pPid->kp, pid_weighted_error(pPid)) +
+                 pid_mul(&pPid->kd, pPid->derivative) + pPid->integral +
+                 pid_scale(feedForward, pPid->outScale));
+   out = sum;
+   if (out > pPid->outMax)
+      out = pPid->outMax;
+   if (out < pPid->outMin)
+      out = pPid->outMin;
+
+   increment = pid_mul(&pPid->ki, error);
+   if (PID_ANTI_WINDUP_NONE != pPid->cfg.antiWindup)
+   {
+      // don't integrate further into the saturation
+      if (((sum > pPid->outMax) && (increment > 0)) || ((sum < pPid->outMin) && (increment < 0)))
+         increment = 0;
+
+      // and take back part of the excess
+      if (PID_ANTI_WINDUP_BACK_CALC == pPid->cfg.antiWindup)
+         increment = pid_sat((int64_t)increment + pid_mul(&pPid->kt, out - sum));
+   }
+   pPid->integral = pid_sat((int64_t)pPid->integral + increment);
+   pPid->output = out;
+
+   return (int32_t)(((int64_t)out * pPid->cfg.outputRange + (1L << 30)) >> 31);
+}
+
+StatusType Pid_SetGains(PidType *pPid, float32_t kp, float32_t ki, float32_t kd)
+{
+   float32_t scale = (float32_t)pPid->cfg.inputRange / pPid->cfg.outputRange;
+   PidGainType newKp, newKi, newKd;
+   q31_t error, before, after;
+   uint32_t primask;
+
+   if ((E_OK != pid_gain_from_float(kp, scale, &newKp)) ||
+       (E_OK != pid_gain_from_float(ki, scale, &newKi)) ||
+       (E_OK != pid_gain_from_float(kd, scale, &newKd)))
+   {
+      return E_ERROR;
+   }
+
+   // the interrupt may be running the controller
+   primask = __get_PRIMASK();
+   __disable_irq();
+
+   // the integral takes the difference of the proportional and
+   // derivative terms, so the output continues from where it was
+   error = pid_weighted_error(pPid);
+   before = pid_sat((int64_t)pid_mul(&pPid->kp, error) + pid_mul(&pPid->kd, pPid->derivative));
+   after = pid_sat((int64_t)pid_mul(&newKp, error) + pid_mul(&newKd, pPid->derivative));
+   pPid->integral = pid_sat((int64_t)pPid->integral + before - after);
+
+   pPid->kp = newKp;
+   pPid->ki = newKi;
+   pPid->kd = newKd;
+   pPid->cfg.kp = kp;
+   pPid->cfg.ki = ki;
+   pPid->cfg.kd = kd;
+
+   __set_PRIMASK(primask);
+
+   return E_OK;
+}
+
+void Pid_GetGains(PidType *pPid, float32_t *kp, float32_t *ki, float32_t *kd)
+{
+   float32_t scale = (float32_t)pPid->cfg.inputRange / pPid->cfg.outputRange;
+
+   *kp = pid_gain_to_float(&pPid->kp, scale);
+   *ki = pid_gain_to_float(&pPid->ki, scale);
+   *kd = pid_gain_to_float(&pPid->kd, scale);
+}
+
+static StatusType pid_gain_from_float(float32_t gain, float32_t scale, PidGainType *pGain)
+{
+   float32_t mant = gain * scale;
+   uint32_t shift = 0;
+
+   // the smallest exponent that keeps the mantissa below 1.0
+   while (((mant >= 1.0f) || (mant <= -1.0f)) && (shift < PID_MAX_GAIN_SHIFT))
+   {
+      mant *= 0.5f;
+      shift++;
+   }
+   if ((mant >= 1.0f) || (mant <= -1.0f))
+   {
+      return E_ERROR;
+   }
+
+   pGain->mant = (q31_t)(mant * PID_Q31_ONE);
+   pGain->shift = shift;
+
+   return E_OK;
+}
+
+static float32_t pid_gain_to_float(const PidGainType *pGain, float32_t scale)
+{
+   return ((float32_t)pGain->mant / PID_Q31_ONE) * (float32_t)(1UL << pGain->shift) / scale;
+}
+
+static inline q31_t pid_sat(int64_t value)
+{
+   if (value > INT32_MAX)
+      return INT32_MAX;
+   if (value < -INT32_MAX)
+      return -INT32_MAX;
+
+   return (q31_t)value;
+}
+
+static inline q31_t pid_mul(const PidGainType *pGain, q31_t value)
+{
+   return pid_sat(((int64_t)pGain->mant * value) >> (31 - pGain->shift));
+}
+
+static inline q31_t pid_scale(int32_t value, q31_t scale)
+{
+   return pid_sat((int64_t)value * scale);
+}
+
+static inline q31_t pid_weighted_error(PidType *pPid)
+{
+   return pid_sat((((int64_t)pPid->beta * pPid->setpoint) >> 31) - pPid->measurement);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,154 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   @file                profiler_api.h
+//!
+//!   @brief               profiler APIs header file
+//!
+//!   @author              agent
+//!
+//!   @date                17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _PROFILER_API_H
+#define  _PROFILER_API_H 1
+
+#include "profiler_conf.h"
+
+//********************************************************************
+//! @addtogroup profiler_api
+//! @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#if (0 != PROFILER_ENABLED)
+
+/**
+ * Starts measuring a probe. It declares a local variable, so it must be
+ * used where a declaration is allowed and matched by #PROF_END in the
+ * same block
+ */
+#define PROF_BEGIN(id)     uint32_t prof_start_##id = PROFILER_GET_TICKS()
+
+/**
+ * Stops measuring a probe and adds the time to its statistics
+ */
+#define PROF_END(id)       Profiler_Add((id), PROFILER_GET_TICKS() - prof_start_##id)
+
+#else
+
+#define PROF_BEGIN(id)     do { } while(0)
+#define PROF_END(id)       do { } while(0)
+
+#endif
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+/**
+ * Profiler probes
+ */
+typedef enum
+{
+#undef X
+#define X(a,b) a,
+   PROFILER_PROBES_CFG
+#undef X
+   PROF_NUM
+} ProfilerProbeType;
+
+/**
+ * Statistics of a probe, in time base ticks
+ */
+typedef struct
+{
+   uint32_t count;            /**< Executions measured */
+   uint32_t min;              /**< Shortest execution */
+   uint32_t max;              /**< Longest execution */
+   uint64_t sum;              /**< Total time */
+} ProfilerStatsType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+/**
+ * Initializes the profiler.
+ * It starts the time base and clears every probe
+ */
+extern void Profiler_Init(void);
+
+/**
+ * Adds a measurement to a probe. Use #PROF_END instead
+ *
+ * @param probe Probe measured
+ * @param ticks Time measured in time base ticks
+ */
+extern void Profiler_Add(ProfilerProbeType probe, uint32_t ticks);
+
+/**
+ * Gets the statistics of a probe
+ *
+ * @param probe Probe to read
+ * @param pStats Where the statistics are returned
+ *
+ * @return #E_OK if the statistics were returned\n
+ *         #E_ERROR if the probe is invalid
+ */
+extern StatusType Profiler_GetStats(ProfilerProbeType probe, ProfilerStatsType *pStats);
+
+/**
+ * Reports the statistics of every probe through #Profiler_OnProbeReport
+ */
+extern void Profiler_Report(void);
+
+/**
+ * Clears the statistics of every probe
+ */
+extern void Profiler_Reset(void);
+
+//********************************************************************
+// Close the Doxygen group.
+//! @}
+//********************************************************************
+#endif // _PROFILER_API_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+// 
+//
+//********************************************************************
@@ -0,0 +1,86 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   @file                profiler_callouts.h
+//!
+//!   @brief               profiler callouts header file
+//!
+//!   @author              agent
+//!
+//!   @date                17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _PROFILER_CALLOUTS_H
+#define  _PROFILER_CALLOUTS_H 1
+
+//********************************************************************
+//! @addtogroup profiler_callouts
+//! @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+/**
+ * Reports the statistics of a probe.
+ * This function is called for every probe by #Profiler_Report
+ *
+ * @param name Probe name
+ * @param pStats Probe statistics, in time base ticks
+ */
+extern void Profiler_OnProbeReport(const char *name, const ProfilerStatsType *pStats);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _PROFILER_CALLOUTS_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+// 
+//
+//********************************************************************
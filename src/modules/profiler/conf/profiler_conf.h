@@ -0,0 +1,110 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   @file                profiler_conf.h
+//!
+//!   @brief               profiler configuration header file
+//!
+//!   @author              agent
+//!
+//!   @date                17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _PROFILER_CONF_H
+#define  _PROFILER_CONF_H 1
+
+//********************************************************************
+//! @addtogroup profiler_conf
+//! @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+/**
+ * Enables the profiler probes.
+ * When it is 0 #PROF_BEGIN and #PROF_END compile to nothing
+ */
+#define PROFILER_ENABLED                     (1)
+
+/**
+ * Defines the profiler time base, a free running 32 bits counter.
+ * The DWT cycle counter is used unless the platform provides another one
+ */
+#ifndef PROFILER_GET_TICKS
+#define PROFILER_GET_TICKS()                 (DWT->CYCCNT)
+#endif
+
+/**
+ * Defines the number of time base ticks in a microsecond
+ */
+#ifndef PROFILER_TICKS_PER_US
+#define PROFILER_TICKS_PER_US                (SystemCoreClock / 1000000UL)
+#endif
+
+/**
+ * Defines the profiler probes: X(id, name)
+ */
+#define PROFILER_PROBES_CFG \
+   X(PROF_ADC_DMA_IRQ,        "adcirq")   \
+   X(PROF_ROTARY_ENC_IRQ,     "encirq")   \
+   X(PROF_CLOCK_CC_IRQ,       "clkirq")   \
+   X(PROF_MOTOR_CTRL,         "motctl")   \
+   X(PROF_LOGGER_WRITE,       "logwr")    \
+   X(PROF_BIQUAD,             "biquad")
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _PROFILER_CONF_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+// 
+//
+//********************************************************************
@@ -0,0 +1,61 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @defgroup profiler Profiler
+ * @brief Profiler module documentation.
+ *
+ * The profiler measures the execution time of interrupt handlers and hot
+ * functions with the core cycle counter, at a resolution the 1us high
+ * resolution timestamp can't give.
+ *
+ * The probes are listed in #PROFILER_PROBES_CFG and the code to measure is
+ * enclosed between #PROF_BEGIN and #PROF_END. Every probe keeps the number
+ * of executions, the minimum, the maximum and the total time. The table is
+ * statically allocated and the measurement only takes two reads of the
+ * counter and a short critical section.
+ *
+ * When #PROFILER_ENABLED is 0 the probes compile to nothing. The time base
+ * is the DWT cycle counter; a platform can provide another one defining
+ * #PROFILER_GET_TICKS and #PROFILER_TICKS_PER_US, like the host simulation
+ * does with the host clock.
+ *
+ * #Profiler_Report reports every probe through #Profiler_OnProbeReport.
+ *
+ * @{
+ *
+ * @defgroup profiler_conf Module Configuration
+ * @brief Profiler module configuration parameters
+ *
+ * @defgroup profiler_api Module API Interface
+ * @brief Profiler module API functions
+ *
+ * @defgroup profiler_callouts Module Callouts
+ * @brief Profiler callout functions
+ *
+ * @defgroup profiler_imp Module Implementation
+ * @brief Profiler implementation
+ * @}
+ */
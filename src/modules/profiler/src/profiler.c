@@ -0,0 +1,175 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       profiler.c
+//!
+//!   \brief      This is the profiler module implementation file.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files                                              
+//********************************************************************
+#include <string.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup profiler_imp
+//! @{
+//********************************************************************
+
+#include "profiler_conf.h"
+#include "profiler_api.h"
+#include "profiler_callouts.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+static const char * const profilerProbeNames[PROF_NUM] =
+{
+#undef X
+#define X(a,b) b,
+   PROFILER_PROBES_CFG
+#undef X
+};
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static ProfilerStatsType profilerStats[PROF_NUM];
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void Profiler_Init(void)
+{
+   // start the cycle counter
+   CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+   DWT->CYCCNT = 0;
+   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+   Profiler_Reset();
+}
+
+void Profiler_Add(ProfilerProbeType probe, uint32_t ticks)
+{
+   ProfilerStatsType *pStats;
+   uint32_t primask;
+
+   if (probe >= PROF_NUM)
+      return;
+
+   pStats = &profilerStats[probe];
+
+   // probes are added from interrupts and from the main loop
+   primask = __get_PRIMASK();
+   __disable_irq();
+
+   if ((0 == pStats->count) || (ticks < pStats->min))
+      pStats->min = ticks;
+   if (ticks > pStats->max)
+      pStats->max = ticks;
+   pStats->sum += ticks;
+   pStats->count++;
+
+   __set_PRIMASK(primask);
+}
+
+StatusType Profiler_GetStats(ProfilerProbeType probe, ProfilerStatsType *pStats)
+{
+   uint32_t primask;
+
+   if ((probe >= PROF_NUM) || (NULL == pStats))
+      return E_ERROR;
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+   *pStats = profilerStats[probe];
+   __set_PRIMASK(primask);
+
+   return E_OK;
+}
+
+void Profiler_Report(void)
+{
+   ProfilerStatsType stats;
+   uint32_t i;
+
+   for (i = 0; i < PROF_NUM; i++)
+   {
+      if (E_OK == Profiler_GetStats((ProfilerProbeType)i, &stats))
+         Profiler_OnProbeReport(profilerProbeNames[i], &stats);
+   }
+}
+
+void Profiler_Reset(void)
+{
+   uint32_t primask;
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+   memset(profilerStats, 0, sizeof(profilerStats));
+   __set_PRIMASK(primask);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+// 
+//
+//********************************************************************
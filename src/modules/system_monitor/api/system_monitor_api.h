@@ -36,7 +36,9 @@
 //********************************************************************
 
 #ifndef  _SYSTEM_MONITOR_API_H
-#define  _SYSTEMO_MONITOR_API_H 1
+#define  _SYSTEM_MONITOR_API_H 1
+
+#include "system_monitor_conf.h"
 
 //********************************************************************
 //! @addtogroup system_monitor_api
@@ -50,6 +52,30 @@
 //********************************************************************
 // Enumerations and Structures and Typedefs
 //********************************************************************
+/**
+ * Execution time probes
+ */
+typedef enum
+{
+#undef X
+#define X(a,b) a,
+   SYSTEM_MONITOR_PROBES_CFG
+#undef X
+   SMON_PROBE_NUM
+} SystemMonitorProbeType;
+
+/**
+ * Execution time statistics of a probe, in microseconds
+ */
+typedef struct
+{
+   uint32_t count;                                       /**< Executions measured */
+   uint32_t min;                                         /**< Shortest execution time */
+   uint32_t max;                                         /**< Longest execution time */
+   uint32_t mean;                                        /**< Mean execution time */
+   uint32_t deadlineMisses;                              /**< Executions ended after the slot deadline */
+   uint16_t hist[SYSTEM_MONITOR_PROBE_HIST_BINS];        /**< log2 histogram of the execution times */
+} SystemMonitorProbeStatsType;
 
 //********************************************************************
 // Global Variable extern Declarations
@@ -92,6 +118,45 @@ extern void SystemMonitor_StartUserTime(void);
  */
 extern void SystemMonitor_StopUserTime(void);
 
+/**
+ * Starts measuring the execution time of a probe.
+ * Probes can be nested, every probe keeps its own start time
+ *
+ * @param probe Probe to start
+ */
+extern void SystemMonitor_StartProbe(SystemMonitorProbeType probe);
+
+/**
+ * Stops measuring the execution time of a probe and adds it to the
+ * probe statistics
+ *
+ * @param probe Probe to stop
+ */
+extern void SystemMonitor_StopProbe(SystemMonitorProbeType probe);
+
+/**
+ * Gets the execution time statistics of a probe
+ *
+ * @param probe Probe to read
+ * @param pStats Where the statistics are returned
+ *
+ * @return #E_OK if the statistics were returned\n
+ *         #E_ERROR if the probe is invalid
+ */
+extern StatusType SystemMonitor_GetProbeStats(SystemMonitorProbeType probe, SystemMonitorProbeStatsType *pStats);
+
+/**
+ * Requests a report of every probe statistics.
+ * The probes are reported one by one from #SystemMonitor_Update through
+ * #SystemMonitor_OnProbeReport
+ */
+extern void SystemMonitor_ReportProbes(void);
+
+/**
+ * Clears the statistics of every probe
+ */
+extern void SystemMonitor_ResetProbes(void);
+
 //********************************************************************
 // Close the Doxygen group.
 //! @}
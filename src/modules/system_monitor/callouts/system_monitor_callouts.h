@@ -76,6 +76,15 @@ extern uint32_t SystemMonitor_GetHighResTimestamp(void);
  */
 extern void SystemMonitor_OnFreeStackSizeLow(uint32_t freeStack);
 
+/**
+ * Reports the execution time statistics of a probe.
+ * This function is called for every probe after #SystemMonitor_ReportProbes
+ *
+ * @param name Probe name
+ * @param pStats Probe statistics
+ */
+extern void SystemMonitor_OnProbeReport(const char *name, const SystemMonitorProbeStatsType *pStats);
+
 /**
  * Informs when a new CPU usage report is available.
  * This functions is called at the time interval defined
@@ -69,6 +69,48 @@
  */
 #define SYSTEM_MONITOR_CPU_USAGE_REPORT_PERIOD (1000) //ms
 
+/**
+ * Defines the time available to the code run in a periodic time slot.
+ * A probe that stops later than this after the slot started counts a
+ * deadline miss. This value is expressed in microseconds
+ */
+#define SYSTEM_MONITOR_SLOT_DEADLINE         (5000) //us
+
+/**
+ * Defines the number of bins of the execution time histograms.
+ * Bin 0 counts the times under 1us, bin i the times from 2^(i-1) to
+ * 2^i - 1 us and the last bin every longer time
+ */
+#define SYSTEM_MONITOR_PROBE_HIST_BINS       (12)
+
+/**
+ * Defines the execution time probes: X(id, name)
+ * The first ones measure the periodic handlers of every rate group, the
+ * rest the module calls inside them
+ */
+#define SYSTEM_MONITOR_PROBES_CFG \
+   X(SMON_PROBE_1X,           "1x")       \
+   X(SMON_PROBE_2X,           "2x")       \
+   X(SMON_PROBE_4X,           "4x")       \
+   X(SMON_PROBE_8X,           "8x")       \
+   X(SMON_PROBE_16X,          "16x")      \
+   X(SMON_PROBE_32X,          "32x")      \
+   X(SMON_PROBE_64X,          "64x")      \
+   X(SMON_PROBE_128X,         "128x")     \
+   X(SMON_PROBE_ADC_DRV,      "adc")      \
+   X(SMON_PROBE_MOTOR_DRV,    "motor")    \
+   X(SMON_PROBE_USART_DRV,    "usart")    \
+   X(SMON_PROBE_VENT_MGR,     "vmgr")     \
+   X(SMON_PROBE_ALARM_MGR,    "amgr")     \
+   X(SMON_PROBE_ADC_DBG,      "adcdbg")   \
+   X(SMON_PROBE_ROTARY_ENC,   "enc")      \
+   X(SMON_PROBE_DFLOW_METER,  "dflow")    \
+   X(SMON_PROBE_FLOW_METER,   "fmeter")   \
+   X(SMON_PROBE_POWER_MGR,    "pmgr")     \
+   X(SMON_PROBE_SYS_MONITOR,  "smon")     \
+   X(SMON_PROBE_TRACE,        "trace")    \
+   X(SMON_PROBE_KEYBOARD,     "kbd")
+
 //********************************************************************
 // Enumerations and Structures and Typedefs
 //********************************************************************
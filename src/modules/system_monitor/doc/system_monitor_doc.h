@@ -29,9 +29,10 @@
  *
  * The System Monitor is responsible for doing the overall system health
  * evaluation.
- * Current implementation provides two major functionalities:
+ * Current implementation provides three major functionalities:
  * - Stack usage
  * - CPU usage statistics
+ * - Execution time probes
  *
  * # Usage
  * In order to use this module you have to know in advance the memory region of
@@ -44,6 +45,9 @@
  * - #SYSTEM_MONITOR_STACK_REGION_SIZE
  * - #SYSTEM_MONITOR_MIN_FREE_STACK_SIZE
  * - #SYSTEM_MONITOR_CPU_USAGE_REPORT_PERIOD
+ * - #SYSTEM_MONITOR_SLOT_DEADLINE
+ * - #SYSTEM_MONITOR_PROBE_HIST_BINS
+ * - #SYSTEM_MONITOR_PROBES_CFG
  *
  * Call the function #SystemMonitor_Init as soon as possible in your software
  * entry point. Since this module monitors the stack usage is desirable that you
@@ -61,6 +65,13 @@
  * Therefore, the platform shall decide what is going to computed as user time
  * and is responsible of calling to the above mentioned functions
  *
+ * The code to measure is wrapped with #SystemMonitor_StartProbe and
+ * #SystemMonitor_StopProbe. Every probe keeps the minimum, maximum and mean
+ * execution time, a log2 histogram of the times and the number of times it
+ * ended later than #SYSTEM_MONITOR_SLOT_DEADLINE after the user time started.
+ * #SystemMonitor_ReportProbes reports the probes one per
+ * #SystemMonitor_Update call and #SystemMonitor_ResetProbes clears them.
+ *
  * # Callouts
  * This module needs the user to implement the function
  * #SystemMonitor_GetHighResTimestamp.
@@ -68,6 +79,7 @@
  * The module reports the corresponding information by calling to the functions:
  * - #SystemMonitor_OnFreeStackSizeLow
  * - #SystemMonitor_OnCPUUsageReport
+ * - #SystemMonitor_OnProbeReport
  *
  * The user shall implement those functions to get the information out of this
  * module
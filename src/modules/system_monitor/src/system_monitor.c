@@ -59,9 +59,22 @@
 //********************************************************************
 #define LOG_TAG   "SMON"
 
+#define SYSTEM_MONITOR_NO_REPORT     (SMON_PROBE_NUM)
+
 //********************************************************************
 // Enumerations and Structures and Typedefs
 //********************************************************************
+typedef struct system_monitor_probe_data_tag
+{
+   uint32_t start;
+   uint32_t count;
+   uint64_t sum;
+   uint16_t min;
+   uint16_t max;
+   uint16_t deadlineMisses;
+   uint16_t hist[SYSTEM_MONITOR_PROBE_HIST_BINS];
+}SystemMonitorProbeDataType;
+
 typedef struct system_monitor_data_tag
 {
    uint32_t stackUsage;
@@ -69,16 +82,26 @@ typedef struct system_monitor_data_tag
    uint32_t stopCPUUserTimestamp;
    uint32_t CPUUserTime;
    uint32_t lastCPUUsageReport;
+   SystemMonitorProbeDataType probes[SMON_PROBE_NUM];
+   uint32_t reportProbe;                     // next probe to report
 }SystemMonitorDataType;
 //********************************************************************
 // Function Prototypes for Private Functions with File Level Scope
 //********************************************************************
 static inline void system_monitor_fill_stack(void);
 static inline void system_monitor_check_free_stack(void);
+static inline uint16_t system_monitor_saturate(uint32_t value);
 
 //********************************************************************
 // ROM Const Variables With File Level Scope
 //********************************************************************
+static const char * const system_monitor_probe_names[] =
+{
+#undef X
+#define X(a,b) b,
+   SYSTEM_MONITOR_PROBES_CFG
+#undef X
+};
 
 //********************************************************************
 // Static Variables and Const Variables With File Level Scope
@@ -99,6 +122,8 @@ StatusType SystemMonitor_Init(void)
 
    systemMonitorData.CPUUserTime = 0;
    systemMonitorData.lastCPUUsageReport = 0;
+   systemMonitorData.reportProbe = SYSTEM_MONITOR_NO_REPORT;
+   SystemMonitor_ResetProbes();
 
    return E_OK;
 }
@@ -123,6 +148,16 @@ void SystemMonitor_Update(void)
       systemMonitorData.CPUUserTime = 0;
       systemMonitorData.lastCPUUsageReport = timestamp;
    }
+
+   //one probe per update, so the report doesn't fill the log
+   if (systemMonitorData.reportProbe < SMON_PROBE_NUM)
+   {
+      SystemMonitorProbeStatsType stats;
+
+      SystemMonitor_GetProbeStats(systemMonitorData.reportProbe, &stats);
+      SystemMonitor_OnProbeReport(system_monitor_probe_names[systemMonitorData.reportProbe], &stats);
+      systemMonitorData.reportProbe++;
+   }
 }
 
 void SystemMonitor_StartUserTime(void)
@@ -140,6 +175,103 @@ void SystemMonitor_StopUserTime(void)
    systemMonitorData.CPUUserTime += delta;
 }
 
+void SystemMonitor_StartProbe(SystemMonitorProbeType probe)
+{
+   if (probe < SMON_PROBE_NUM)
+   {
+      systemMonitorData.probes[probe].start = SystemMonitor_GetHighResTimestamp();
+   }
+}
+
+void SystemMonitor_StopProbe(SystemMonitorProbeType probe)
+{
+   SystemMonitorProbeDataType *p;
+   uint32_t timestamp, delta, bin;
+
+   if (probe >= SMON_PROBE_NUM)
+   {
+      return;
+   }
+
+   timestamp = SystemMonitor_GetHighResTimestamp();
+   p = &systemMonitorData.probes[probe];
+   delta = timestamp - p->start;
+
+   p->count++;
+   p->sum += delta;
+   if (delta < p->min)
+   {
+      p->min = system_monitor_saturate(delta);
+   }
+   if (delta > p->max)
+   {
+      p->max = system_monitor_saturate(delta);
+   }
+
+   // bin i holds the times from 2^(i-1) to 2^i - 1
+   bin = (0 == delta)? 0 : 32 - __builtin_clz(delta);
+   if (bin >= SYSTEM_MONITOR_PROBE_HIST_BINS)
+   {
+      bin = SYSTEM_MONITOR_PROBE_HIST_BINS - 1;
+   }
+   p->hist[bin] = system_monitor_saturate(p->hist[bin] + 1);
+
+   if ((timestamp - systemMonitorData.startCPUUserTimestamp) > SYSTEM_MONITOR_SLOT_DEADLINE)
+   {
+      p->deadlineMisses = system_monitor_saturate(p->deadlineMisses + 1);
+   }
+}
+
+StatusType SystemMonitor_GetProbeStats(SystemMonitorProbeType probe, SystemMonitorProbeStatsType *pStats)
+{
+   SystemMonitorProbeDataType *p;
+   uint32_t i;
+
+   if ((probe >= SMON_PROBE_NUM) || (NULL == pStats))
+   {
+      return E_ERROR;
+   }
+
+   p = &systemMonitorData.probes[probe];
+   pStats->count = p->count;
+   pStats->min = (0 == p->count)? 0 : p->min;
+   pStats->max = p->max;
+   pStats->mean = (0 == p->count)? 0 : (uint32_t)(p->sum / p->count);
+   pStats->deadlineMisses = p->deadlineMisses;
+   for (i = 0; i < SYSTEM_MONITOR_PROBE_HIST_BINS; i++)
+   {
+      pStats->hist[i] = p->hist[i];
+   }
+
+   return E_OK;
+}
+
+void SystemMonitor_ReportProbes(void)
+{
+   systemMonitorData.reportProbe = 0;
+}
+
+void SystemMonitor_ResetProbes(void)
+{
+   uint32_t i, j;
+
+   // the start times are kept, the running probes are measured
+   for (i = 0; i < SMON_PROBE_NUM; i++)
+   {
+      SystemMonitorProbeDataType *p = &systemMonitorData.probes[i];
+
+      p->count = 0;
+      p->sum = 0;
+      p->min = UINT16_MAX;
+      p->max = 0;
+      p->deadlineMisses = 0;
+      for (j = 0; j < SYSTEM_MONITOR_PROBE_HIST_BINS; j++)
+      {
+         p->hist[j] = 0;
+      }
+   }
+}
+
 static inline void system_monitor_fill_stack(void)
 {
    volatile uint32_t var = 0;
@@ -154,6 +286,11 @@ static inline void system_monitor_fill_stack(void)
    }
 }
 
+static inline uint16_t system_monitor_saturate(uint32_t value)
+{
+   return (value > UINT16_MAX)? UINT16_MAX : (uint16_t)value;
+}
+
 static inline void system_monitor_check_free_stack(void)
 {
    uint32_t *pStart = (uint32_t*) SYSTEM_MONITOR_BASE_STACK_ADDRESS;
@@ -0,0 +1,164 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   @file                trace_api.h
+//!
+//!   @brief               trace APIs header file
+//!
+//!   @author              agent
+//!
+//!   @date                17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _TRACE_API_H
+#define  _TRACE_API_H 1
+
+#include "trace_conf.h"
+
+//********************************************************************
+//! @addtogroup trace_api
+//! @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#if (0 != TRACE_ENABLED)
+
+/**
+ * Records an event
+ */
+#define TRACE_EVENT(id, arg, data)     Trace_Event((id), (uint8_t)(arg), (uint16_t)(data))
+
+#else
+
+#define TRACE_EVENT(id, arg, data)     do { } while(0)
+
+#endif
+
+/**
+ * Records the entry and the exit of an exception handler.
+ * The argument is the exception number, the IRQ number plus 16
+ */
+#define TRACE_IRQ_ENTER(irqn)          TRACE_EVENT(TRACE_EV_IRQ_ENTER, (irqn) + 16, 0)
+#define TRACE_IRQ_EXIT(irqn)           TRACE_EVENT(TRACE_EV_IRQ_EXIT, (irqn) + 16, 0)
+
+/**
+ * Records a state machine transition.
+ * The data is the low half of the target state function address
+ */
+#define TRACE_FSM_TRAN(fsm, targ)      TRACE_EVENT(TRACE_EV_FSM_TRAN, (fsm), (uintptr_t)(targ))
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+/**
+ * Trace events
+ */
+typedef enum
+{
+#undef X
+#define X(a,b) a,
+   TRACE_EVENTS_CFG
+#undef X
+   TRACE_EV_NUM
+} TraceEventIdType;
+
+/**
+ * State machines traced
+ */
+typedef enum
+{
+#undef X
+#define X(a,b) a,
+   TRACE_FSMS_CFG
+#undef X
+   TRACE_FSM_NUM
+} TraceFsmType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+// Remember to use extern modifier
+/**
+ * Initializes the trace.
+ * It starts the time base and starts recording every event
+ */
+extern void Trace_Init(void);
+
+/**
+ * Writes the dump of a frozen trace to the log.
+ * This function should be called periodically
+ */
+extern void Trace_Update(void);
+
+/**
+ * Records an event. Use #TRACE_EVENT instead
+ *
+ * @param id Event
+ * @param arg Event argument
+ * @param data Event data
+ */
+extern void Trace_Event(TraceEventIdType id, uint8_t arg, uint16_t data);
+
+/**
+ * Stops recording and starts the dump of the recorded events.
+ * Nothing is done if the trace is already frozen
+ */
+extern void Trace_Freeze(void);
+
+/**
+ * Clears the trace and starts recording again
+ */
+extern void Trace_Arm(void);
+
+/**
+ * Selects the events recorded
+ *
+ * @param mask Bit mask of the events recorded, bit n is event n
+ */
+extern void Trace_SetFilter(uint32_t mask);
+
+//********************************************************************
+// Close the Doxygen group.
+//! @}
+//********************************************************************
+#endif // _TRACE_API_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+// 
+//
+//********************************************************************
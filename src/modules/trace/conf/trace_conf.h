@@ -0,0 +1,134 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   @file                trace_conf.h
+//!
+//!   @brief               trace configuration header file
+//!
+//!   @author              agent
+//!
+//!   @date                17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _TRACE_CONF_H
+#define  _TRACE_CONF_H 1
+
+//********************************************************************
+//! @addtogroup trace_conf
+//! @{
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+/**
+ * Enables the trace events.
+ * When it is 0 #TRACE_EVENT compiles to nothing
+ */
+#define TRACE_ENABLED                        (1)
+
+/**
+ * Defines the trace buffer size as 2^TRACE_BUFFER_SHIFT events of 8 bytes
+ */
+#define TRACE_BUFFER_SHIFT                   (7)
+
+/**
+ * Defines the number of events written in every dump line
+ */
+#define TRACE_EVENTS_PER_LINE                (6)
+
+/**
+ * Defines the number of dump lines written in every #Trace_Update call
+ */
+#define TRACE_LINES_PER_UPDATE               (4)
+
+/**
+ * Defines the trace time base, a free running 32 bits counter
+ */
+#ifndef TRACE_GET_TIMESTAMP
+#define TRACE_GET_TIMESTAMP()                (DWT->CYCCNT)
+#endif
+
+/**
+ * Defines the number of time base ticks in a microsecond
+ */
+#ifndef TRACE_TICKS_PER_US
+#define TRACE_TICKS_PER_US                   (SystemCoreClock / 1000000UL)
+#endif
+
+/**
+ * Defines the trace events: X(id, name)
+ */
+#define TRACE_EVENTS_CFG \
+   X(TRACE_EV_IRQ_ENTER,      "irq enter")   \
+   X(TRACE_EV_IRQ_EXIT,       "irq exit")    \
+   X(TRACE_EV_SLOT_START,     "slot start")  \
+   X(TRACE_EV_SLOT_STOP,      "slot stop")   \
+   X(TRACE_EV_FSM_TRAN,       "fsm")         \
+   X(TRACE_EV_ADC_TRIGGER,    "trigger")     \
+   X(TRACE_EV_SLOTS_MISSED,   "overrun")
+
+/**
+ * Defines the state machines traced: X(id, name)
+ */
+#define TRACE_FSMS_CFG \
+   X(TRACE_FSM_VENTILATOR,    "ventilator")  \
+   X(TRACE_FSM_MOTOR_MGR,     "motor_mgr")   \
+   X(TRACE_FSM_MOTOR_DRV,     "motor_drv")   \
+   X(TRACE_FSM_ALARM_MGR,     "alarm_mgr")
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _TRACE_CONF_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+// 
+//
+//********************************************************************
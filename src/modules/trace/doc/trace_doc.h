@@ -0,0 +1,73 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @defgroup trace Trace
+ * @brief Trace module documentation.
+ *
+ * The trace records what the firmware does in time order: the entry and
+ * exit of every interrupt handler, the start and stop of the periodic
+ * slots, the state machine transitions, the ADC trigger firings and the
+ * missed slots. It shows how the interrupts interleave with the slots,
+ * which counters and execution time statistics can't.
+ *
+ * Every event takes 8 bytes: the cycle counter, the event, an 8 bits
+ * argument and 16 bits of data. The events are kept in a ring buffer of
+ * 2^#TRACE_BUFFER_SHIFT events, so the trace holds the last events
+ * recorded. There are far more events than the debug USART can send, so
+ * the trace works like a flight recorder: it records until it is frozen,
+ * and then #Trace_Update writes the frozen events to the log, a few lines
+ * at a time, and the logger sends them with the USART DMA. The trace is
+ * frozen when a periodic slot is missed or on request, and it records
+ * again after #Trace_Arm.
+ *
+ * The dump lines are tagged "trc": "b;n=events;f=ticks per us;" starts a
+ * dump, "d=" lines carry the events in hex and "e;" ends it. Every event
+ * is written as the timestamp (8 digits), the event (2 digits), the
+ * argument (2 digits) and the data (4 digits). The host tool trace2json
+ * turns a log into a Chrome trace that Perfetto or chrome://tracing can
+ * show. The state machine transitions carry the low half of the address
+ * of the new state, which the tool turns into its name with the symbol
+ * table of the firmware.
+ *
+ * When #TRACE_ENABLED is 0 the events compile to nothing. #Trace_SetFilter
+ * selects the events recorded at run time; leaving out the interrupts
+ * makes the same buffer cover a much longer time.
+ *
+ * @{
+ *
+ * @defgroup trace_conf Module Configuration
+ * @brief Trace module configuration parameters
+ *
+ * @defgroup trace_api Module API Interface
+ * @brief Trace module API functions
+ *
+ * @defgroup trace_callouts Module Callouts
+ * @brief Trace callout functions
+ *
+ * @defgroup trace_imp Module Implementation
+ * @brief Trace implementation
+ * @}
+ */
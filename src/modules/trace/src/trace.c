@@ -0,0 +1,267 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       trace.c
+//!
+//!   \brief      This is the trace module implementation file.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files                                              
+//********************************************************************
+#include <stdio.h>
+#include "standard.h"
+#include "stm32f1xx_hal.h"
+
+//********************************************************************
+//! @addtogroup trace_imp
+//! @{
+//********************************************************************
+
+#include "trace_conf.h"
+#include "trace_api.h"
+#include "trace_callouts.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define TRACE_BUFFER_EVENTS      (1UL << TRACE_BUFFER_SHIFT)
+
+// hex digits of an event
+#define TRACE_EVENT_DIGITS       (16)
+
+#define TRACE_LINE_SIZE          (TRACE_EVENTS_PER_LINE * TRACE_EVENT_DIGITS + 4)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct trace_record_tag
+{
+   uint32_t timestamp;
+   uint8_t id;
+   uint8_t arg;
+   uint16_t data;
+}TraceRecordType;
+
+// the record must stay 8 bytes long
+typedef char trace_record_size_check[(8 == sizeof(TraceRecordType)) ? 1 : -1];
+
+typedef enum
+{
+   TRACE_RECORDING = 0,
+   TRACE_DUMP_BEGIN,
+   TRACE_DUMP_EVENTS,
+   TRACE_DUMP_END,
+   TRACE_STOPPED
+}TraceStateType;
+
+typedef struct trace_data_tag
+{
+   TraceRecordType buffer[TRACE_BUFFER_EVENTS];
+   uint32_t head;                   // events recorded
+   uint32_t filter;
+   uint32_t dumpPos;                // next event to dump
+   volatile TraceStateType state;
+}TraceDataType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static Bool trace_dump_line(void);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static TraceDataType traceData;
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void Trace_Init(void)
+{
+   // start the cycle counter
+   CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+   DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+   traceData.filter = UINT32_MAX;
+   Trace_Arm();
+}
+
+void Trace_Update(void)
+{
+   uint32_t i;
+
+   for (i = 0; i < TRACE_LINES_PER_UPDATE; i++)
+   {
+      if ((TRACE_RECORDING == traceData.state) || (TRACE_STOPPED == traceData.state))
+         break;
+
+      // the same line is written again if the log is full
+      if (!trace_dump_line())
+         break;
+   }
+}
+
+void Trace_Event(TraceEventIdType id, uint8_t arg, uint16_t data)
+{
+   TraceRecordType *pRecord;
+   uint32_t primask;
+
+   if (0 == (traceData.filter & (1UL << id)))
+      return;
+
+   // events are recorded from interrupts and from the main loop
+   primask = __get_PRIMASK();
+   __disable_irq();
+
+   if (TRACE_RECORDING == traceData.state)
+   {
+      pRecord = &traceData.buffer[traceData.head & (TRACE_BUFFER_EVENTS - 1)];
+      pRecord->timestamp = TRACE_GET_TIMESTAMP();
+      pRecord->id = (uint8_t)id;
+      pRecord->arg = arg;
+      pRecord->data = data;
+      traceData.head++;
+   }
+
+   __set_PRIMASK(primask);
+}
+
+void Trace_Freeze(void)
+{
+   uint32_t primask;
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+
+   if (TRACE_RECORDING == traceData.state)
+   {
+      // the oldest events were overwritten
+      traceData.dumpPos = (traceData.head > TRACE_BUFFER_EVENTS) ? traceData.head - TRACE_BUFFER_EVENTS : 0;
+      traceData.state = TRACE_DUMP_BEGIN;
+   }
+
+   __set_PRIMASK(primask);
+}
+
+void Trace_Arm(void)
+{
+   uint32_t primask;
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+   traceData.head = 0;
+   traceData.dumpPos = 0;
+   traceData.state = TRACE_RECORDING;
+   __set_PRIMASK(primask);
+}
+
+void Trace_SetFilter(uint32_t mask)
+{
+   traceData.filter = mask;
+}
+
+static Bool trace_dump_line(void)
+{
+   char line[TRACE_LINE_SIZE];
+   uint32_t pos, count, i;
+
+   switch (traceData.state)
+   {
+      case TRACE_DUMP_BEGIN:
+         snprintf(line, sizeof(line), "b;n=%lu;f=%lu;", (unsigned long)(traceData.head - traceData.dumpPos),
+               (unsigned long)TRACE_TICKS_PER_US);
+         if (!Trace_OnDumpLine(line))
+            return FALSE;
+
+         traceData.state = (traceData.dumpPos < traceData.head) ? TRACE_DUMP_EVENTS : TRACE_DUMP_END;
+         break;
+
+      case TRACE_DUMP_EVENTS:
+         count = traceData.head - traceData.dumpPos;
+         if (count > TRACE_EVENTS_PER_LINE)
+            count = TRACE_EVENTS_PER_LINE;
+
+         pos = snprintf(line, sizeof(line), "d=");
+         for (i = 0; i < count; i++)
+         {
+            TraceRecordType *pRecord = &traceData.buffer[(traceData.dumpPos + i) & (TRACE_BUFFER_EVENTS - 1)];
+
+            pos += snprintf(&line[pos], sizeof(line) - pos, "%08lx%02x%02x%04x", (unsigned long)pRecord->timestamp,
+                  pRecord->id, pRecord->arg, pRecord->data);
+         }
+         if (!Trace_OnDumpLine(line))
+            return FALSE;
+
+         traceData.dumpPos += count;
+         if (traceData.dumpPos >= traceData.head)
+            traceData.state = TRACE_DUMP_END;
+         break;
+
+      case TRACE_DUMP_END:
+         if (!Trace_OnDumpLine("e;"))
+            return FALSE;
+
+         traceData.state = TRACE_STOPPED;
+         break;
+
+      default:
+         break;
+   }
+
+   return TRUE;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+// 
+//
+//********************************************************************
@@ -48,6 +48,7 @@
 //********************************************************************
 // Constant and Macro Definitions using #define
 //********************************************************************
+#define VENTILATOR_MGR_ANGLE_SHIFT   (8)   /**< Fractional bits of the finger angles */
 
 //********************************************************************
 // Enumerations and Structures and Typedefs
@@ -76,6 +77,16 @@ typedef enum ventilator_mgr_control_mode_tag
    VENTILATOR_MGR_PRESSURE_CONTROL,/**< Ventilator runs using pressue control */
 } VentilatorMgrModeControlType;
 
+/**
+ * Inspiratory flow shapes in volume control.
+ */
+typedef enum ventilator_mgr_flow_shape_tag
+{
+   VENTILATOR_MGR_FLOW_SQUARE,       /**< Constant flow along the inhale */
+   VENTILATOR_MGR_FLOW_DECELERATING, /**< Flow ramping down from a peak at the start of the inhale */
+   VENTILATOR_MGR_FLOW_SINE,         /**< Flow following half a sine wave */
+} VentilatorMgrFlowShapeType;
+
 //********************************************************************
 // Global Variable extern Declarations
 //********************************************************************
@@ -253,6 +264,27 @@ extern StatusType VentilatorMgr_SetInspiratoryPressure(uint32_t inspPressure);
  */
 extern StatusType VentilatorMgr_GetInspiratoryPressure(uint32_t *inspPressure);
 
+/**
+ * Sets the inspiratory flow shape used in volume control.
+ * The new value will be used on the next respiratory cycle
+ *
+ * @param shape Flow shape
+ *
+ * @return #E_OK if the parameter is valid\n
+ *         #E_ERROR if the parameter is invalid
+ */
+extern StatusType VentilatorMgr_SetFlowShape(VentilatorMgrFlowShapeType shape);
+
+/**
+ * Gets current inspiratory flow shape.
+ *
+ * @param shape Pointer to store the flow shape
+ *
+ * @return #E_OK if no error occurred\n
+ *         #E_ERROR if an error occurred
+ */
+extern StatusType VentilatorMgr_GetFlowShape(VentilatorMgrFlowShapeType *shape);
+
 /**
  * Sets minimum tidal volume threshold.
  * if the delivered volume is lower than the value provided an error condition
@@ -505,13 +537,44 @@ extern StatusType VentilatorMgr_Update(void);
  */
 extern void VentilatorMgr_onMoveComplete(void);
 
+/**
+ * Notifies a new finger position.
+ * The delivered volume is estimated from it with the tidal volume
+ * to finger angle table. It should be called on every encoder sample.
+ *
+ * @param angle finger angle from the home position in
+ *              1/2^#VENTILATOR_MGR_ANGLE_SHIFT degrees
+ */
+extern void VentilatorMgr_onFingerPosition(int32_t angle);
+
+/**
+ * Gets the volume delivered estimated from the last finger position.
+ *
+ * @param volInML pointer to return the volume in milliliters
+ *
+ * @return #E_OK if the value is valid\n
+ *         #E_ERROR if an error occurred
+ */
+extern StatusType VentilatorMgr_GetEstimatedVolume(uint32_t *volInML);
+
+/**
+ * Runs the pressure control loop with a new filtered pressure sample.
+ * It shall be called from the interrupt that produces the samples. While
+ * the loop is running it applies the new drive level through
+ * #VentilatorMgr_WriteDriveLevel.
+ *
+ * @param pressure filtered pressure in mmH2O
+ */
+extern void VentilatorMgr_OnPressureSample(int32_t pressure);
+
 /**
  * Sets the PID parameters of the control system.
- * These parameters are only applicable when using the pressure control
+ * These parameters are only applicable when using the pressure control.
+ * A running inhale continues from the drive level it had
  *
- * @param kp proportional constant. Range [-1.0, 1.0)
- * @param ki integral constant. Range [-1.0, 1.0)
- * @param kd derivative constant. Range [-1.0, 1.0)
+ * @param kp proportional constant in PWM % per mmH2O
+ * @param ki integral constant in PWM % per mmH2O and ms
+ * @param kd derivative constant in PWM % per mmH2O change in a ms
  *
  * @return #E_OK if the update was successful\n
  *         #E_ERROR if an error occurred
@@ -522,9 +585,9 @@ extern StatusType VentilatorMgr_SetPIDParameters(float32_t kp, float32_t ki, flo
  * Gets the PID parameters of the control system.
  * These parameters are only applicable when using the pressure control
  *
- * @param Kp pointer to return proportional constant. Range [-1.0, 1.0)
- * @param ki pointer to return integral constant. Range [-1.0, 1.0)
- * @param kd pointer to derivative constant. Range [-1.0, 1.0)
+ * @param Kp pointer to return proportional constant in PWM % per mmH2O
+ * @param ki pointer to return integral constant in PWM % per mmH2O and ms
+ * @param kd pointer to derivative constant in PWM % per mmH2O change in a ms
  *
  * @return #E_OK if the update was successful\n
  *         #E_ERROR if an error occurred
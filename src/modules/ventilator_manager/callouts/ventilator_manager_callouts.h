@@ -213,6 +213,30 @@ extern StatusType VentilatorMgr_ModuleInit(void);
  */
 extern StatusType VentilatorMgr_SetMotorState(VentilatorMotorStateType state, int32_t distance, int32_t speed);
 
+/**
+ * Compress the AMBU bag a distance in a time, with the flow following a shape.
+ * This function is called at the start of the inhale in volume control
+ *
+ * @param distance distance to travel expressed in deg
+ * @param timeMillis time to travel the distance in ms
+ * @param shape shape of the flow along the inhale
+ * @return #E_OK if no errors occurred\n
+ *         #E_ERROR if an error occurred
+ */
+extern StatusType VentilatorMgr_CompressInTime(int32_t distance, uint32_t timeMillis, VentilatorMgrFlowShapeType shape);
+
+/**
+ * Apply a new drive level to the mechanical finger motor, compressing.
+ * This function is called by the pressure control loop from the interrupt
+ * that calls #VentilatorMgr_OnPressureSample, so it shall write the motor
+ * output without waiting.
+ *
+ * @param driveLevel drive level (PWM %)
+ * @return #E_OK if no errors occurred\n
+ *         #E_ERROR if the motor is not running at a drive level
+ */
+extern StatusType VentilatorMgr_WriteDriveLevel(int32_t driveLevel);
+
 /**
  * Informs when there is a change in the #VentilatorManager state.
  * This function is called every time there is a change in the internal state
@@ -129,6 +129,12 @@
  */
 #define VENTILATOR_MGR_DEFAULT_TVOLUME      (300)
 
+/**
+ * Initial inspiratory flow shape in volume control.
+ * This value is used when the system powered up
+ */
+#define VENTILATOR_MGR_DEFAULT_FLOW_SHAPE   (VENTILATOR_MGR_FLOW_SQUARE)
+
 /**
  * Default Plateau measurement time expressed in milliseconds
  * This value define when the pressure is sampled when looking
@@ -235,6 +241,59 @@
  */
 #define VENTILATOR_MGR_DOOR_INPUT_PIN       (IO_DOOR_SENSOR)
 
+/**
+ * Points of the volume table resampled from #VENTILATOR_MGR_VOL_DEG_TABLE,
+ * one for every finger degree starting at 0. Past the last point the
+ * last segment is extended.
+ */
+#define VENTILATOR_MGR_VOL_TABLE_POINTS     (48)
+
+/**
+ * Volume step of the index used to find a volume in the resampled
+ * table, as a power of 2 in milliliters. Volumes past the last step use
+ * the last entry.
+ */
+#define VENTILATOR_MGR_VOL_INDEX_SHIFT      (5)
+
+/**
+ * Entries of the volume index, covering up to
+ * #VENTILATOR_MGR_VOL_INDEX_POINTS << #VENTILATOR_MGR_VOL_INDEX_SHIFT ml
+ */
+#define VENTILATOR_MGR_VOL_INDEX_POINTS     (32)
+
+/**
+ * Default gains of the pressure control loop, in drive level (PWM %) per
+ * mmH2O of error. The loop runs on every filtered pressure sample, so the
+ * integral gain is per ms.
+ */
+#define VENTILATOR_MGR_PRESSURE_KP          (0.1f)
+#define VENTILATOR_MGR_PRESSURE_KI          (0.001f)
+#define VENTILATOR_MGR_PRESSURE_KD          (0.0f)
+
+/**
+ * Setpoint weight of the proportional term of the pressure control loop.
+ * The inhale starts with the full setpoint step, half of it is enough to
+ * get the bellows moving
+ */
+#define VENTILATOR_MGR_PRESSURE_BETA        (0.5f)
+
+/**
+ * Back calculation gain of the pressure control loop: fraction of the
+ * drive level over the limits taken back from the integral every sample
+ */
+#define VENTILATOR_MGR_PRESSURE_KT          (0.05f)
+
+/**
+ * Max drive level (PWM %) applied by the pressure control loop
+ */
+#define VENTILATOR_MGR_PRESSURE_MAX_DRIVE   (40)
+
+/**
+ * Drive level (PWM %) the pressure control loop starts every inhale
+ * from, so the integral term does not have to build it from 0
+ */
+#define VENTILATOR_MGR_PRESSURE_START_DRIVE (6)
+
 
 
 //********************************************************************
@@ -246,7 +305,10 @@
  * in Degrees
  *
  * This table will be used to interpolate the required tidal volume
- * to finger degrees
+ * to finger degrees, and the finger position to the delivered volume.
+ * Both columns shall increase, and the angles shall be in the range
+ * of #VENTILATOR_MGR_VOL_TABLE_POINTS. Below the first point and past
+ * the last one the first and last segments are extended.
  *
  * The input format is: X([vol_in_ml], [angle_in_deg])
  */
@@ -30,6 +30,26 @@
  * The Ventilator Manager is responsible of controlling the mechanical
  * finger based on the breathing parameters
  *
+ * Every change of the settings is validated as a complete set and the
+ * breath timings and motion targets are calculated with integer math.
+ * A set that can not be met is rejected and the previous one is kept.
+ * The state machine takes a copy of the last accepted set when it
+ * enters INHALE, so a breath always runs with a single set.
+ *
+ * The volume to finger angle table is resampled at init to one point
+ * per degree, so an angle converts to a volume with a shift and a
+ * volume converts to an angle through a small index of the table. The
+ * finger position from the encoder gives an estimate of the volume
+ * delivered, read with #VentilatorMgr_GetEstimatedVolume.
+ *
+ * In pressure control the inspiratory pressure loop runs on every
+ * filtered pressure sample, from the ADC interrupt through
+ * #VentilatorMgr_OnPressureSample, and writes the drive level straight
+ * to the motor PWM. The state machine starts the loop at INHALE, moves
+ * its setpoint on every tick and stops it before leaving INHALE.
+ * The loop is a #PidType from the pid module working in mmH2O and PWM
+ * percent, with setpoint weighting and back calculation anti-windup.
+ *
  * @startuml
  *
  * [*] --> IDLE
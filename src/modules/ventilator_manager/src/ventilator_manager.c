@@ -39,6 +39,8 @@
 // Include header files                                              
 //********************************************************************
 #include "standard.h"
+#include "trace_api.h"
+#define FsmOnTran(me_, targ_)    TRACE_FSM_TRAN(TRACE_FSM_VENTILATOR, targ_)
 #include "fsm.h"
 #include "logger_api.h"
 #define ARM_MATH_CM3  // Use ARM Cortex M3
@@ -54,6 +56,9 @@
 #include "ventilator_manager_conf.h"
 #include "ventilator_manager_api.h"
 #include "ventilator_manager_callouts.h"
+#include "ventilator_params.h"
+#include "ventilator_volume.h"
+#include "ventilator_pressure.h"
 
 //********************************************************************
 // File level pragmas
@@ -82,18 +87,6 @@ typedef enum ventilator_pressure_trigger_id_tag
    VENTILATOR_PRESSURE_TRIGGER_UNDERPRESSURE,
 }VentilatorPressureTriggerIdType;
 
-typedef enum ventilator_par_mode_tag
-{
-   VENTILATOR_PARAMS_IERATIO_SET,
-   VENTILATOR_PARAMS_INSPTIME_SET,
-} VentilatorParamsMode;
-
-typedef struct vol2deg_table_tag
-{
-   uint32_t volumeML;
-   uint32_t deg;
-} VolumeToDegType;
-
 typedef struct ventilator_mgr_fsm_evt_tag
 {
    Signal sig;
@@ -104,16 +97,10 @@ typedef struct ventilator_fsm_tag
 {
    State state__; /* the current state */
    uint32_t lastTimestamp;
-   uint32_t currentDistance;
-   uint32_t currentInSpeed;
-   uint32_t currentExSpeed;
-   uint32_t currentPauseTime;
-   uint32_t currentInTime;
-   uint32_t currentExTime;
+   VentilatorParamsType params;   // parameters of the breath in progress
    int32_t currentInPressure;
    int32_t initialPressure;
    uint32_t currentMaxInTime;
-   uint32_t currentMaxExTime;
    uint32_t currentMaxTidalVol;
    uint32_t currentMinTidalVol;
    uint32_t lastInhaleTimestamp;
@@ -127,24 +114,13 @@ typedef struct ventilator_fsm_tag
 
 typedef struct ventilator_mgr_tag
 {
-   VentilatorMgrModeControlType controlMode;
    VentilatorMgrFsmType fsm;
-   VentilatorParamsMode paramMode;
-
-   // input parameters
-   uint32_t respRateBPM;
-   uint32_t tidalVolumeML;
-   uint32_t ieRatio;
-   uint32_t inspPressure;
-
-   // calculated parameters
-   uint32_t respPeriodMillis;
-   uint32_t inspiratoryTimeMillis;
-   uint32_t pltTimeMillis;
-   uint32_t expirationTimeMillis;
-   uint32_t distanceInDeg;
-   uint32_t inhaleSpeed;
-   uint32_t exhaleSpeed;
+
+   // last accepted parameter set, taken by the FSM at the next inhale
+   VentilatorParamsType params;
+
+   // volume estimated from the finger position
+   uint32_t estimatedVolume;
 
    // error conditions
    uint32_t maxTidalVolume;
@@ -158,9 +134,6 @@ typedef struct ventilator_mgr_tag
 
    // pressure triggers
    VentilatorMgrPressureTrigType pressureTriggers[VENTILATOR_MGR_PRESSURE_MAX_TRIGGERS];
-
-   // pid control when using pressure-control
-   arm_pid_instance_q15 pid;
 }VentilatorMgrType;
 
 //********************************************************************
@@ -168,10 +141,7 @@ typedef struct ventilator_mgr_tag
 //********************************************************************
 static void ventilator_mgr_on_overpressure_trigger(VentilatorMgrPressureTrigType* trigger, int32_t value);
 static void ventilator_mgr_on_underpressure_trigger(VentilatorMgrPressureTrigType* trigger, int32_t value);
-static StatusType ventilator_mgr_calc_params_from_ie(void);
-static StatusType ventilator_mgr_calc_params_from_tin(void);
-static StatusType ventilator_mgr_calc_params(void);
-static StatusType ventilator_mgr_vol2deg(uint32_t vol, uint32_t *deg);
+static StatusType ventilator_mgr_apply_settings(const VentilatorParamsSettingsType *pSettings);
 static void ventilator_mgr_fsm_init(void);
 static void ventilator_mgr_fsm_initial(VentilatorMgrFsmType *me, Event const *e);
 static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e);
@@ -179,18 +149,12 @@ static void ventilator_mgr_fsm_plateau(VentilatorMgrFsmType *me, Event const *e)
 static void ventilator_mgr_fsm_pause(VentilatorMgrFsmType *me, Event const *e);
 static void ventilator_mgr_fsm_exhale(VentilatorMgrFsmType *me, Event const *e);
 
-static void ventilator_mgr_do_pressure_control(VentilatorMgrFsmType *me);
+static void ventilator_mgr_update_pressure_setpoint(VentilatorMgrFsmType *me);
 
 //********************************************************************
 // ROM Const Variables With File Level Scope
 //********************************************************************
 
-static const VolumeToDegType volToDegTable[] = {
-#undef X
-#define X(a,b) {a, b},
-      VENTILATOR_MGR_VOL_DEG_TABLE
-};
-
 //********************************************************************
 // Static Variables and Const Variables With File Level Scope
 //********************************************************************
@@ -204,17 +168,25 @@ static VentilatorMgrType ventilatorMgrData;
 StatusType VentilatorMgr_Init(void)
 {
    StatusType err = E_OK;
+   VentilatorParamsSettingsType settings;
 
-   //ventilatorMgrData.controlMode = VENTILATOR_MGR_VOLUME_CONTROL;
-   ventilatorMgrData.controlMode = VENTILATOR_MGR_PRESSURE_CONTROL;
+   //settings.controlMode = VENTILATOR_MGR_VOLUME_CONTROL;
+   settings.controlMode = VENTILATOR_MGR_PRESSURE_CONTROL;
 
-   ventilatorMgrData.respRateBPM = VENTILATOR_MGR_DEFAULT_BPM; //10;
-   ventilatorMgrData.tidalVolumeML = VENTILATOR_MGR_DEFAULT_TVOLUME; //300;
-   ventilatorMgrData.ieRatio = VENTILATOR_MGR_DEFAULT_IE_RATIO; //100;
-   ventilatorMgrData.inspiratoryTimeMillis = 1000;
-   ventilatorMgrData.paramMode = VENTILATOR_PARAMS_INSPTIME_SET;
-   ventilatorMgrData.pltTimeMillis = VENTILATOR_MGR_HOLD_TIME_MILLIS;
-   ventilatorMgrData.inspPressure = 200;
+   settings.respRateBPM = VENTILATOR_MGR_DEFAULT_BPM; //10;
+   settings.tidalVolumeML = VENTILATOR_MGR_DEFAULT_TVOLUME; //300;
+   settings.ieRatio = VENTILATOR_MGR_DEFAULT_IE_RATIO; //100;
+   settings.inspiratoryTimeMillis = 1000;
+   settings.paramMode = VENTILATOR_PARAMS_INSPTIME_SET;
+   settings.pltTimeMillis = VENTILATOR_MGR_HOLD_TIME_MILLIS;
+   settings.inspPressure = 200;
+   settings.flowShape = VENTILATOR_MGR_DEFAULT_FLOW_SHAPE;
+
+   err = ventilator_volume_init();
+   if (E_OK != err)
+   {
+      return err;
+   }
 
    ventilatorMgrData.maxPIP = VENTILATOR_MGR_MAX_PIP_THRESHOLD_MAX;
    ventilatorMgrData.minPIP = VENTILATOR_MGR_MIN_PIP_THRESHOLD_MIN;
@@ -225,7 +197,12 @@ StatusType VentilatorMgr_Init(void)
    ventilatorMgrData.maxBPMError = VENTILATOR_MGR_MAX_BPMERROR_THRESHOLD_MAX;
    ventilatorMgrData.minPIPPEEPDif = VENTILATOR_MGR_MIN_PIP_VS_PEEP_THRESHOLD_MAX;
 
-   ventilator_mgr_calc_params();
+   err = ventilator_mgr_apply_settings(&settings);
+   if (E_OK != err)
+   {
+      return err;
+   }
+   ventilator_pressure_init();
    ventilator_mgr_fsm_init();
 
    //module init callout
@@ -259,39 +236,21 @@ StatusType VentilatorMgr_Init(void)
       return err;
    }
 
-   //init pid controller
-   float32_t coef;
-   coef = 0.27f;
-   arm_float_to_q15(&coef, &ventilatorMgrData.pid.Kp, 1);
-   coef = 0.0023f;
-   arm_float_to_q15(&coef, &ventilatorMgrData.pid.Ki, 1);
-   coef = 0.00f;
-   arm_float_to_q15(&coef, &ventilatorMgrData.pid.Kd, 1);
-   arm_pid_init_q15(&ventilatorMgrData.pid, 1);
-
    return err;
 }
 
 StatusType VentialtorMgr_SetControlMode(VentilatorMgrModeControlType mode)
 {
-   StatusType err;
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
+
    if (ventilatorMgrData.fsm.state__ != (void *) ventilator_mgr_fsm_initial)
    {
       return E_ERROR;
    }
 
-   switch(mode)
-   {
-      case VENTILATOR_MGR_PRESSURE_CONTROL:
-      case VENTILATOR_MGR_VOLUME_CONTROL:
-         ventilatorMgrData.controlMode = mode;
-         err = E_OK;
-         break;
-      default:
-         err = E_ERROR;
-         break;
-   }
-   return err;
+   // the breath timings depend on the control mode
+   settings.controlMode = mode;
+   return ventilator_mgr_apply_settings(&settings);
 }
 
 StatusType VentilatorMgr_GetControlMode(VentilatorMgrModeControlType *mode)
@@ -299,75 +258,70 @@ StatusType VentilatorMgr_GetControlMode(VentilatorMgrModeControlType *mode)
    if (NULL == mode)
       return E_ERROR;
 
-   *mode = ventilatorMgrData.controlMode;
+   *mode = ventilatorMgrData.params.settings.controlMode;
    return E_OK;
 }
 
 StatusType VentilatorMgr_SetParametersWithIERatio(uint32_t bpm, uint32_t volInML, uint32_t ieRatio)
 {
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
    StatusType err;
 
-   err = VentilatorMgr_SetRespiratoryRate(bpm);
-   if (E_ERROR == err)
-      return err;
-
-   err = VentilatorMgr_SetTidalVolume(volInML);
-   if (E_ERROR == err)
-      return err;
+   // the whole set is validated at once so it is either taken or left as it was
+   settings.respRateBPM = bpm;
+   settings.tidalVolumeML = volInML;
+   settings.ieRatio = ieRatio;
+   settings.paramMode = VENTILATOR_PARAMS_IERATIO_SET;
 
-   err = VentilatorMgr_SetIERatio(ieRatio);
+   err = ventilator_mgr_apply_settings(&settings);
    if (E_ERROR == err)
       return err;
 
    LOG_PRINT_INFO(DEBUG_VENT_MGR, LOG_TAG, "T=%lu;it=%lu;et=%lu;d=%lu;is=%lu;es=%lu",
-         ventilatorMgrData.respPeriodMillis,
-         ventilatorMgrData.inspiratoryTimeMillis,
-         ventilatorMgrData.expirationTimeMillis,
-         ventilatorMgrData.distanceInDeg,
-         ventilatorMgrData.inhaleSpeed,
-         ventilatorMgrData.exhaleSpeed);
+         ventilatorMgrData.params.respPeriodMillis,
+         ventilatorMgrData.params.inspiratoryTimeMillis,
+         ventilatorMgrData.params.expirationTimeMillis,
+         ventilatorMgrData.params.distanceInDeg,
+         ventilatorMgrData.params.inhaleSpeed,
+         ventilatorMgrData.params.exhaleSpeed);
 
    return E_OK;
 }
 
 StatusType VentilatorMgr_SetParametersWithInspTime(uint32_t bpm, uint32_t volInML, uint32_t inspTimeMillis)
 {
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
    StatusType err;
 
-   err = VentilatorMgr_SetRespiratoryRate(bpm);
-   if (E_ERROR == err)
-      return err;
-
-   err = VentilatorMgr_SetTidalVolume(volInML);
-   if (E_ERROR == err)
-      return err;
+   // the whole set is validated at once so it is either taken or left as it was
+   settings.respRateBPM = bpm;
+   settings.tidalVolumeML = volInML;
+   settings.inspiratoryTimeMillis = inspTimeMillis;
+   settings.paramMode = VENTILATOR_PARAMS_INSPTIME_SET;
 
-   err = VentilatorMgr_SetInspiratoryTime(inspTimeMillis);
+   err = ventilator_mgr_apply_settings(&settings);
    if (E_ERROR == err)
       return err;
 
    LOG_PRINT_INFO(DEBUG_VENT_MGR, LOG_TAG, "T=%lu;it=%lu;et=%lu;d=%lu;is=%lu;es=%lu",
-         ventilatorMgrData.respPeriodMillis,
-         ventilatorMgrData.inspiratoryTimeMillis,
-         ventilatorMgrData.expirationTimeMillis,
-         ventilatorMgrData.distanceInDeg,
-         ventilatorMgrData.inhaleSpeed,
-         ventilatorMgrData.exhaleSpeed);
+         ventilatorMgrData.params.respPeriodMillis,
+         ventilatorMgrData.params.inspiratoryTimeMillis,
+         ventilatorMgrData.params.expirationTimeMillis,
+         ventilatorMgrData.params.distanceInDeg,
+         ventilatorMgrData.params.inhaleSpeed,
+         ventilatorMgrData.params.exhaleSpeed);
 
    return E_OK;
 }
 
 StatusType VentilatorMgr_SetRespiratoryRate(uint32_t bpm)
 {
-   if ((VENTILATOR_MGR_BPM_MIN > bpm) || (VENTILATOR_MGR_BPM_MAX < bpm))
-   {
-      //value out of range
-      return E_ERROR;
-   }
-   // update internal setting and calculate new set of parameters
-   ventilatorMgrData.respRateBPM = bpm;
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
 
-   return ventilator_mgr_calc_params();
+   // calculate a new set of parameters, it is only taken if it is valid
+   settings.respRateBPM = bpm;
+
+   return ventilator_mgr_apply_settings(&settings);
 }
 
 StatusType VentilatorMgr_GetRespiratoryRate(uint32_t* bpm)
@@ -375,21 +329,18 @@ StatusType VentilatorMgr_GetRespiratoryRate(uint32_t* bpm)
    if (NULL == bpm)
       return E_ERROR;
 
-   *bpm = ventilatorMgrData.respRateBPM;
+   *bpm = ventilatorMgrData.params.settings.respRateBPM;
    return E_OK;
 }
 
 StatusType VentilatorMgr_SetTidalVolume(uint32_t volInML)
 {
-   if ((VENTILATOR_MGR_TIDAL_VOLUME_MIN > volInML) || (VENTILATOR_MGR_TIDAL_VOLUME_MAX < volInML))
-   {
-      //value out of range
-      return E_ERROR;
-   }
-   // update internal setting and calculate new set of parameters
-   ventilatorMgrData.tidalVolumeML = volInML;
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
 
-   return ventilator_mgr_calc_params();
+   // calculate a new set of parameters, it is only taken if it is valid
+   settings.tidalVolumeML = volInML;
+
+   return ventilator_mgr_apply_settings(&settings);
 }
 
 StatusType VentilatorMgr_GetTidalVolume(uint32_t *volInML)
@@ -397,22 +348,19 @@ StatusType VentilatorMgr_GetTidalVolume(uint32_t *volInML)
    if (NULL == volInML)
       return E_ERROR;
 
-   *volInML = ventilatorMgrData.tidalVolumeML;
+   *volInML = ventilatorMgrData.params.settings.tidalVolumeML;
    return E_OK;
 }
 
 StatusType VentilatorMgr_SetIERatio(uint32_t ieRatio)
 {
-   if ((VENTILATOR_MGR_IE_RATIO_MIN > ieRatio) || (VENTILATOR_MGR_IE_RATIO_MAX < ieRatio))
-   {
-      //value out of range
-      return E_ERROR;
-   }
-   // update internal setting and calculate new set of parameters
-   ventilatorMgrData.ieRatio = ieRatio;
-   ventilatorMgrData.paramMode = VENTILATOR_PARAMS_IERATIO_SET;
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
+
+   // calculate a new set of parameters, it is only taken if it is valid
+   settings.ieRatio = ieRatio;
+   settings.paramMode = VENTILATOR_PARAMS_IERATIO_SET;
 
-   return ventilator_mgr_calc_params();
+   return ventilator_mgr_apply_settings(&settings);
 }
 
 StatusType VentilatorMgr_GetIERatio(uint32_t *ieRatio)
@@ -420,23 +368,19 @@ StatusType VentilatorMgr_GetIERatio(uint32_t *ieRatio)
    if (NULL == ieRatio)
       return E_ERROR;
 
-   *ieRatio = ventilatorMgrData.ieRatio;
+   *ieRatio = ventilatorMgrData.params.ieRatio;
    return E_OK;
 }
 
 StatusType VentilatorMgr_SetInspiratoryTime(uint32_t inspTimeMillis)
 {
-   if ((VENTILATOR_MGR_INSP_TIME_MIN_MILLIS > inspTimeMillis) || (VENTILATOR_MGR_INSP_TIME_MAX_MILLIS < inspTimeMillis))
-   {
-      //value out of range
-      return E_ERROR;
-   }
-   // update internal setting and calculate new set of parameters
-   ventilatorMgrData.inspiratoryTimeMillis = inspTimeMillis;
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
 
-   ventilatorMgrData.paramMode = VENTILATOR_PARAMS_INSPTIME_SET;
+   // calculate a new set of parameters, it is only taken if it is valid
+   settings.inspiratoryTimeMillis = inspTimeMillis;
+   settings.paramMode = VENTILATOR_PARAMS_INSPTIME_SET;
 
-   return ventilator_mgr_calc_params();
+   return ventilator_mgr_apply_settings(&settings);
 }
 
 StatusType VentilatorMgr_GetInspiratoryTime(uint32_t *inspTimeMillis)
@@ -444,21 +388,18 @@ StatusType VentilatorMgr_GetInspiratoryTime(uint32_t *inspTimeMillis)
    if (NULL == inspTimeMillis)
       return E_ERROR;
 
-   *inspTimeMillis = ventilatorMgrData.inspiratoryTimeMillis;
+   *inspTimeMillis = ventilatorMgrData.params.inspiratoryTimeMillis;
    return E_OK;
 }
 
 StatusType VentilatorMgr_SetPlateauTime(uint32_t pltTimeMillis)
 {
-   if ((VENTILATOR_MGR_PLT_TIME_MIN_MILLIS > pltTimeMillis) || (VENTILATOR_MGR_PLT_TIME_MAX_MILLIS < pltTimeMillis))
-   {
-      //value out of range
-      return E_ERROR;
-   }
-   // update internal setting and calculate new set of parameters
-   ventilatorMgrData.pltTimeMillis = pltTimeMillis;
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
+
+   // calculate a new set of parameters, it is only taken if it is valid
+   settings.pltTimeMillis = pltTimeMillis;
 
-   return ventilator_mgr_calc_params();
+   return ventilator_mgr_apply_settings(&settings);
 }
 
 StatusType VentilatorMgr_GetPlateauTime(uint32_t *pltTimeMillis)
@@ -466,21 +407,18 @@ StatusType VentilatorMgr_GetPlateauTime(uint32_t *pltTimeMillis)
    if (NULL == pltTimeMillis)
       return E_ERROR;
 
-   *pltTimeMillis = ventilatorMgrData.pltTimeMillis;
+   *pltTimeMillis = ventilatorMgrData.params.settings.pltTimeMillis;
    return E_OK;
 }
 
 StatusType VentilatorMgr_SetInspiratoryPressure(uint32_t inspPressure)
 {
-   if ((VENTILATOR_MGR_INSP_PRESSURE_MIN > inspPressure) || (VENTILATOR_MGR_INSP_PRESSURE_MAX < inspPressure))
-   {
-      //value out of range
-      return E_ERROR;
-   }
-   // update internal setting and calculate new set of parameters
-   ventilatorMgrData.inspPressure = inspPressure;
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
 
-   return ventilator_mgr_calc_params();
+   // calculate a new set of parameters, it is only taken if it is valid
+   settings.inspPressure = inspPressure;
+
+   return ventilator_mgr_apply_settings(&settings);
 }
 
 StatusType VentilatorMgr_GetInspiratoryPressure(uint32_t *inspPressure)
@@ -488,7 +426,26 @@ StatusType VentilatorMgr_GetInspiratoryPressure(uint32_t *inspPressure)
    if (NULL == inspPressure)
       return E_ERROR;
 
-   *inspPressure = ventilatorMgrData.inspPressure;
+   *inspPressure = ventilatorMgrData.params.settings.inspPressure;
+   return E_OK;
+}
+
+StatusType VentilatorMgr_SetFlowShape(VentilatorMgrFlowShapeType shape)
+{
+   VentilatorParamsSettingsType settings = ventilatorMgrData.params.settings;
+
+   // calculate a new set of parameters, it is only taken if it is valid
+   settings.flowShape = shape;
+
+   return ventilator_mgr_apply_settings(&settings);
+}
+
+StatusType VentilatorMgr_GetFlowShape(VentilatorMgrFlowShapeType *shape)
+{
+   if (NULL == shape)
+      return E_ERROR;
+
+   *shape = ventilatorMgrData.params.settings.flowShape;
    return E_OK;
 }
 
@@ -739,16 +696,36 @@ void VentilatorMgr_onMoveComplete(void)
    FsmDispatch(&ventilatorMgrData.fsm, &evt);
 }
 
+void VentilatorMgr_onFingerPosition(int32_t angle)
+{
+   ventilatorMgrData.estimatedVolume = ventilator_volume_from_deg(angle);
+}
 
-StatusType VentilatorMgr_SetPIDParameters(float32_t kp, float32_t ki, float32_t kd)
+void VentilatorMgr_OnPressureSample(int32_t pressure)
 {
-   arm_float_to_q15(&kp, &ventilatorMgrData.pid.Kp, 1);
-   arm_float_to_q15(&ki, &ventilatorMgrData.pid.Ki, 1);
-   arm_float_to_q15(&kd, &ventilatorMgrData.pid.Kd, 1);
-   arm_pid_init_q15(&ventilatorMgrData.pid, 1);
+   int32_t driveLevel;
+
+   if (ventilator_pressure_update(pressure, &driveLevel))
+   {
+      VentilatorMgr_WriteDriveLevel(driveLevel);
+   }
+}
+
+StatusType VentilatorMgr_GetEstimatedVolume(uint32_t *volInML)
+{
+   if (NULL == volInML)
+      return E_ERROR;
+
+   *volInML = ventilatorMgrData.estimatedVolume;
    return E_OK;
 }
 
+
+StatusType VentilatorMgr_SetPIDParameters(float32_t kp, float32_t ki, float32_t kd)
+{
+   return ventilator_pressure_set_pid(kp, ki, kd);
+}
+
 StatusType VentilatorMgr_GetPIDParameters(float32_t *kp, float32_t *ki, float32_t *kd)
 {
    if ((NULL == kp) || (NULL == ki) || (NULL == kd))
@@ -756,9 +733,7 @@ StatusType VentilatorMgr_GetPIDParameters(float32_t *kp, float32_t *ki, float32_
       return E_ERROR;
    }
 
-   arm_q15_to_float(&ventilatorMgrData.pid.Kp, kp, 1);
-   arm_q15_to_float(&ventilatorMgrData.pid.Ki, ki, 1);
-   arm_q15_to_float(&ventilatorMgrData.pid.Kd, kd, 1);
+   ventilator_pressure_get_pid(kp, ki, kd);
 
    return E_OK;
 }
@@ -780,144 +755,10 @@ void ventilator_mgr_on_underpressure_trigger(VentilatorMgrPressureTrigType* trig
    FsmDispatch(&ventilatorMgrData.fsm, &evt);
 }
 
-static StatusType ventilator_mgr_calc_params(void)
-{
-   return (ventilatorMgrData.paramMode == VENTILATOR_PARAMS_IERATIO_SET)?
-         ventilator_mgr_calc_params_from_ie():
-         ventilator_mgr_calc_params_from_tin();
-}
-static StatusType ventilator_mgr_calc_params_from_ie(void)
-{
-   StatusType err = E_ERROR;
-   uint32_t periodMillis;
-   uint32_t tinMillis;
-   uint32_t texMillis;
-   uint32_t distanceInDeg, inhaleSpeed, exhaleSpeed;
-
-   // calculate internal parameters based on ventilator settings
-   periodMillis = (60 * 1e3) / ventilatorMgrData.respRateBPM;
-   if (((periodMillis * 100) / (100 + ventilatorMgrData.ieRatio)) < ventilatorMgrData.pltTimeMillis)
-   {
-      return E_ERROR;
-   }
-   if (VENTILATOR_MGR_VOLUME_CONTROL == ventilatorMgrData.controlMode)
-   {
-      tinMillis = (periodMillis * 100) / (100 + ventilatorMgrData.ieRatio) - ventilatorMgrData.pltTimeMillis;
-      texMillis = periodMillis - (tinMillis + ventilatorMgrData.pltTimeMillis);
-   }
-   else
-   {
-      tinMillis = (periodMillis * 100) / (100 + ventilatorMgrData.ieRatio);
-      texMillis = periodMillis - (tinMillis);
-   }
-
-   err = ventilator_mgr_vol2deg(ventilatorMgrData.tidalVolumeML, &distanceInDeg);
-   if (err != E_OK)
-   {
-      return E_ERROR;
-   }
-
-   inhaleSpeed = (distanceInDeg * 1e3) / tinMillis;
-   exhaleSpeed = (distanceInDeg * 1e3) / texMillis;
-
-   // update internal variables;
-   ventilatorMgrData.respPeriodMillis = periodMillis;
-   ventilatorMgrData.inspiratoryTimeMillis = tinMillis;
-   ventilatorMgrData.expirationTimeMillis = texMillis;
-   ventilatorMgrData.distanceInDeg = distanceInDeg;
-   ventilatorMgrData.inhaleSpeed = inhaleSpeed;
-   ventilatorMgrData.exhaleSpeed = exhaleSpeed;
-
-   return E_OK;
-}
-
-// this functions calculates operation parameters from:
-// RespiratoryRate, inspiratoryTime and TidalVolulme
-static StatusType ventilator_mgr_calc_params_from_tin(void)
-{
-   StatusType err = E_ERROR;
-   uint32_t periodMillis;
-   uint32_t ieRatio;
-   uint32_t texMillis;
-   uint32_t distanceInDeg, inhaleSpeed, exhaleSpeed;
-
-   // calculate internal parameters based on ventilator settings
-   periodMillis = (60 * 1e3) / ventilatorMgrData.respRateBPM;
-   //tinMillis = periodMillis / (1 + ventilatorMgrData.ieRatio) - VENTILATOR_MGR_HOLD_TIME_MILLIS;
-   if (periodMillis < (ventilatorMgrData.inspiratoryTimeMillis + ventilatorMgrData.pltTimeMillis))
-   {
-      return E_ERROR;
-   }
-
-   if (VENTILATOR_MGR_VOLUME_CONTROL == ventilatorMgrData.controlMode)
-   {
-      texMillis = periodMillis - (ventilatorMgrData.inspiratoryTimeMillis + ventilatorMgrData.pltTimeMillis);
-      ieRatio = (100 * texMillis) / (ventilatorMgrData.inspiratoryTimeMillis + ventilatorMgrData.pltTimeMillis);
-   }
-   else
-   {
-      texMillis = periodMillis - (ventilatorMgrData.inspiratoryTimeMillis);
-      ieRatio = (100 * texMillis) / (ventilatorMgrData.inspiratoryTimeMillis);
-   }
-
-   err = ventilator_mgr_vol2deg(ventilatorMgrData.tidalVolumeML, &distanceInDeg);
-   if (err != E_OK)
-   {
-      return E_ERROR;
-   }
-
-   inhaleSpeed = (distanceInDeg * 1e3) / ventilatorMgrData.inspiratoryTimeMillis;
-   exhaleSpeed = (distanceInDeg * 1e3) / texMillis;
-
-   // update internal variables;
-   ventilatorMgrData.respPeriodMillis = periodMillis;
-   ventilatorMgrData.expirationTimeMillis = texMillis;
-   ventilatorMgrData.ieRatio = ieRatio;
-   ventilatorMgrData.distanceInDeg = distanceInDeg;
-   ventilatorMgrData.inhaleSpeed = inhaleSpeed;
-   ventilatorMgrData.exhaleSpeed = exhaleSpeed;
-
-   return E_OK;
-}
-
-
-static StatusType ventilator_mgr_vol2deg(uint32_t vol, uint32_t *deg)
+static StatusType ventilator_mgr_apply_settings(const VentilatorParamsSettingsType *pSettings)
 {
-   uint32_t i, tableSize;
-   float deg_f;
-   const VolumeToDegType *eLow, *eHigh;
-
-   tableSize = sizeof(volToDegTable) / sizeof(volToDegTable[0]);
-
-   for (i = 0; i < tableSize; i++)
-   {
-      eHigh = &volToDegTable[i];
-
-      if (eHigh->volumeML >= vol)
-         break;
-   }
-
-   if (i > 0)
-   {
-      eLow = &volToDegTable[i-1];
-      deg_f = (1.0f * eLow->deg) + 1.0f * (vol - eLow->volumeML)*(eHigh->deg - eLow->deg) / (1.0f * (eHigh->volumeML - eLow->volumeML));
-      *deg = (uint32_t) deg_f;
-   }
-   else if (i == 0)
-   {
-      eLow = eHigh;
-      eHigh = &volToDegTable[i+1];
-      deg_f = (1.0f * eLow->deg) - 1.0f * (vol - eLow->volumeML)*(eHigh->deg - eLow->deg) / (1.0f * (eHigh->volumeML - eLow->volumeML));
-      *deg = (uint32_t) deg_f;
-   }
-   else if (i == tableSize)
-   {
-      eLow = &volToDegTable[i-2];
-      deg_f = (1.0f * eHigh->deg) + 1.0f * (vol - eHigh->volumeML)*(eHigh->deg - eLow->deg) / (1.0f *(eHigh->volumeML - eLow->volumeML));
-      *deg = (uint32_t) deg_f;
-   }
-
-   return E_OK;
+   // the FSM keeps running with its own copy until the next inhale
+   return ventilator_params_calc(pSettings, &ventilatorMgrData.params);
 }
 
 static void ventilator_mgr_fsm_init(void)
@@ -972,18 +813,12 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
          LOG_PRINT_INFO(DEBUG_VENT_MGR, LOG_TAG, "s=%s;e=%s", "inhale", "entry");
          me->lastTimestamp = ticks;
          // latch current parameters because they could change in the middle of the cycle
-         me->currentDistance = ventilatorMgrData.distanceInDeg;
-         me->currentInSpeed = ventilatorMgrData.inhaleSpeed;
-         me->currentExSpeed = ventilatorMgrData.exhaleSpeed;
-         me->currentPauseTime = ventilatorMgrData.pltTimeMillis - VENTILATOR_MGR_PLATEAU_MEAS_TIME;
-         me->currentMaxInTime = (ventilatorMgrData.inspiratoryTimeMillis * (100 + ventilatorMgrData.maxTIError)) / 100;
-         me->currentMaxExTime = (ventilatorMgrData.expirationTimeMillis * 110) / 100;
-         me->currentInTime = ventilatorMgrData.inspiratoryTimeMillis + 50;
-         me->currentExTime = ventilatorMgrData.expirationTimeMillis - 50;
+         me->params = ventilatorMgrData.params;
+         me->currentMaxInTime = (me->params.inspiratoryTimeMillis * (100 + ventilatorMgrData.maxTIError)) / 100;
          me->currentMinTidalVol = ventilatorMgrData.minTidalVolume;
          me->currentMaxTidalVol = ventilatorMgrData.maxTidalVolume;
          //me->currentInPressure = ADCDrv_GetValue(AIN_CH2,TRUE); //0; //ventilatorMgrData.inspPressure;
-         me->currentInPressure = ventilatorMgrData.inspPressure;
+         me->currentInPressure = me->params.settings.inspPressure;
          me->initialPressure = me->currentInPressure;
          me->phaseCompleted = FALSE;
          me->stopOnNextCycle = FALSE;
@@ -996,7 +831,7 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
             currentBPM += ((currentBPM % 10UL) > 5)? 10 : 0;
             currentBPM  = currentBPM / 10UL;
             // calculate relative error
-            errorBPM = (100 * ((int32_t)ventilatorMgrData.respRateBPM - (int32_t)currentBPM)) / ((int32_t)ventilatorMgrData.respRateBPM);
+            errorBPM = (100 * ((int32_t)me->params.settings.respRateBPM - (int32_t)currentBPM)) / ((int32_t)me->params.settings.respRateBPM);
             if ((errorBPM < (-ventilatorMgrData.maxBPMError)) ||
                   (errorBPM > ventilatorMgrData.maxBPMError))
             {
@@ -1057,17 +892,16 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
 
          VentilatorMgr_OnStateChange(VENTILATOR_MGR_STATE_INHALE);
 
-         if (VENTILATOR_MGR_VOLUME_CONTROL == ventilatorMgrData.controlMode)
+         if (VENTILATOR_MGR_VOLUME_CONTROL == me->params.settings.controlMode)
          {
-            VentilatorMgr_SetMotorState(VENTILATOR_MGR_MOTOR_COMPRESS_SPEED, me->currentDistance, me->currentInSpeed);
+            // the motor follows the flow shape over the inspiratory time
+            VentilatorMgr_CompressInTime(me->params.distanceInDeg, me->params.inspiratoryTimeMillis, me->params.settings.flowShape);
          }
          else
          {
-            //reset pid controller
-            arm_pid_reset_q15(&ventilatorMgrData.pid);
-
-            //start compressing
+            //start compressing, the drive level is set by the pressure loop
             VentilatorMgr_SetMotorState(VENTILATOR_MGR_MOTOR_COMPRESS_DRIVE, 40, 0);
+            ventilator_pressure_start(me->currentInPressure);
          }
          break;
       }
@@ -1082,7 +916,7 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
          break;
 
       case MOVE_CPLT_SIG:
-         if (VENTILATOR_MGR_VOLUME_CONTROL == ventilatorMgrData.controlMode)
+         if (VENTILATOR_MGR_VOLUME_CONTROL == me->params.settings.controlMode)
          {
             //the motor reached the final position. We store this event and we wait for the next tick
             //to see if we also met the required time
@@ -1097,7 +931,8 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
          break;
 
       case EXIT_SIG:
-         LOG_PRINT_INFO(DEBUG_VENT_MGR, LOG_TAG, "s=%s;e=%s", "inhale", "exit");
+         ventilator_pressure_stop();
+         LOG_PRINT_INFO(DEBUG_VENT_MGR, LOG_TAG, "s=%s;e=%s;ev=%lu", "inhale", "exit", ventilatorMgrData.estimatedVolume);
          break;
 
       case OVERPRESSURE_SIG:
@@ -1127,10 +962,10 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
 //            //door is open, inform the error and continue cycling
 //            VentilatorMgr_OnError(VENTILATOR_MGR_ERROR_DOOROPEN, NULL);
 //         }
-         if (VENTILATOR_MGR_VOLUME_CONTROL == ventilatorMgrData.controlMode)
+         if (VENTILATOR_MGR_VOLUME_CONTROL == me->params.settings.controlMode)
          {
             // check if we have completed this phase
-            if ((me->phaseCompleted) && ((ticks - me->lastTimestamp) > me->currentInTime))
+            if ((me->phaseCompleted) && ((ticks - me->lastTimestamp) > me->params.inTimeMillis))
             {
                VentilatorMgrPressureMeasStatsType pressure;
                //we reach the end of the inspiratory phase; measure PIP and go to plateau phase
@@ -1157,10 +992,10 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
          }
          else
          {
-            // we nee to run the pressure-control algorithm
-            ventilator_mgr_do_pressure_control(me);
+            // the pressure loop runs on every pressure sample, we only move its setpoint
+            ventilator_mgr_update_pressure_setpoint(me);
             // check if we have completed this phase
-            if ((ticks - me->lastTimestamp) > me->currentInTime)
+            if ((ticks - me->lastTimestamp) > me->params.inTimeMillis)
             {
                VentilatorMgrPressureMeasStatsType pressure;
                //we reach the end of the inspiratory phase; measure PIP and go to plateau phase
@@ -1175,6 +1010,7 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
 
                   me->lastPIP = pressure.max;
                }
+               ventilator_pressure_stop();
                VentilatorMgr_SetMotorState(VENTILATOR_MGR_MOTOR_BRAKE, 0, 0);
                FsmTran(me, ventilator_mgr_fsm_exhale);
             }
@@ -1187,46 +1023,24 @@ static void ventilator_mgr_fsm_inhale(VentilatorMgrFsmType *me, Event const *e)
    }
 }
 
-static void ventilator_mgr_do_pressure_control(VentilatorMgrFsmType *me)
+static void ventilator_mgr_update_pressure_setpoint(VentilatorMgrFsmType *me)
 {
-   int32_t pressure;
-   int32_t errorSignal, controlOut, newDriveLvl;
+   VentilatorPressureStateType loop;
    uint32_t ticks = HAL_GetTick();
 
-   // sample pressure signal
-   if (E_OK != VentilatorMgr_GetPressureMeasurement(&pressure))
-   {
-      return;
-   }
-
-   //calculate error signal
-   errorSignal = (me->currentInPressure - pressure) * 4;
-   errorSignal = (0x4000 * errorSignal)/ me->currentInPressure;
-   errorSignal = __SSAT(errorSignal,16);
-
-   controlOut = arm_pid_q15(&ventilatorMgrData.pid, (q15_t)errorSignal);
-   controlOut = (controlOut * 200) / 16384;
-
-   LOG_PRINT_INFO(DEBUG_MOTOR_DRV, "MotorDrv", "s=%lu;e=%lu;p=%d;s=%lu;e=%d;c=%d", 1, 0, me->currentInPressure, pressure, errorSignal, controlOut);
-
-   newDriveLvl = controlOut;
-   if (newDriveLvl < 0)
-      newDriveLvl = 0;
-   if (newDriveLvl > 40)
-      newDriveLvl = 40;
-
-   //update motor control
-   VentilatorMgr_SetMotorState(VENTILATOR_MGR_MOTOR_UPDATE_DRIVE, 40, newDriveLvl);
+   ventilator_pressure_get_state(&loop);
+   LOG_PRINT_INFO(DEBUG_MOTOR_DRV, "MotorDrv", "s=%lu;e=%lu;p=%d;s=%lu;e=%d;c=%d", 1, 0, loop.setpoint, loop.pressure, loop.error, loop.driveLevel);
 
    //create pressure ramp from current pressure to setpoint
    if (((ticks - me->lastTimestamp) < 350))
    {
-      me->currentInPressure = ((ventilatorMgrData.inspPressure - me->initialPressure)* ((ticks - me->lastTimestamp) - 0)) / 350 + me->initialPressure;
+      me->currentInPressure = ((me->params.settings.inspPressure - me->initialPressure)* ((ticks - me->lastTimestamp) - 0)) / 350 + me->initialPressure;
    }
    else
    {
-      me->currentInPressure = ventilatorMgrData.inspPressure;
+      me->currentInPressure = me->params.settings.inspPressure;
    }
+   ventilator_pressure_set_setpoint(me->currentInPressure);
 }
 
 
@@ -1355,7 +1169,7 @@ static void ventilator_mgr_fsm_pause(VentilatorMgrFsmType *me, Event const *e)
 //            //door is open, inform the error and continue cycling
 //            VentilatorMgr_OnError(VENTILATOR_MGR_ERROR_DOOROPEN, NULL);
 //         }
-         if ((ticks - me->lastTimestamp) > (me->currentPauseTime))
+         if ((ticks - me->lastTimestamp) > (me->params.pauseTimeMillis))
          {
             //we reach the end of the phase phase
             FsmTran(me, ventilator_mgr_fsm_exhale);
@@ -1433,7 +1247,7 @@ static void ventilator_mgr_fsm_exhale(VentilatorMgrFsmType *me, Event const *e)
 //            //door is open, inform the error and continue cycling
 //            VentilatorMgr_OnError(VENTILATOR_MGR_ERROR_DOOROPEN, NULL);
 //         }
-         if ((me->phaseCompleted) && ((ticks - me->lastTimestamp) > me->currentExTime))
+         if ((me->phaseCompleted) && ((ticks - me->lastTimestamp) > me->params.exTimeMillis))
          {
             VentilatorMgrPressureMeasStatsType pressure;
 
@@ -1450,7 +1264,7 @@ static void ventilator_mgr_fsm_exhale(VentilatorMgrFsmType *me, Event const *e)
             needTransition = TRUE;
          }
          // check if we haven't met the time to complete this phase
-         if ((!me->phaseCompleted) && ((ticks - me->lastTimestamp) > me->currentMaxExTime))
+         if ((!me->phaseCompleted) && ((ticks - me->lastTimestamp) > me->params.maxExTimeMillis))
          {
             //we havent met the inspiratory time we set an error and we try to continue cycling
             VentilatorMgr_OnError(VENTILATOR_MGR_ERROR_EXPTIMEEXCEEDED, (void *) AM_IF_MOTOR_ET_NOT_REACHED);
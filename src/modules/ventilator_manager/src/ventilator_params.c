@@ -0,0 +1,205 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       ventilator_params.c
+//!
+//!   \brief      Ventilator parameter engine. Turns the ventilation
+//!               settings into the breath timings and the motion
+//!               targets the ventilator manager FSM runs with. Only
+//!               integer math is used: the target has no FPU.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+
+//********************************************************************
+//! @addtogroup ventilator_manager_imp
+//!   @{
+//********************************************************************
+
+#include "ventilator_manager_conf.h"
+#include "ventilator_manager_api.h"
+#include "ventilator_params.h"
+#include "ventilator_volume.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+static StatusType ventilator_params_check_settings(const VentilatorParamsSettingsType *pSettings);
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType ventilator_params_calc(const VentilatorParamsSettingsType *pSettings, VentilatorParamsType *pParams)
+{
+   VentilatorParamsType params;
+   uint32_t periodMillis;
+   uint32_t inMillis;   // inspiratory time including the plateau in volume control
+   uint32_t tinMillis;
+   uint32_t texMillis;
+
+   if ((NULL == pSettings) || (NULL == pParams))
+      return E_ERROR;
+
+   if (E_OK != ventilator_params_check_settings(pSettings))
+      return E_ERROR;
+
+   periodMillis = VENTILATOR_PARAMS_MILLIS_PER_MIN / pSettings->respRateBPM;
+
+   if (VENTILATOR_PARAMS_IERATIO_SET == pSettings->paramMode)
+   {
+      inMillis = (periodMillis * 100) / (100 + pSettings->ieRatio);
+      if (inMillis < pSettings->pltTimeMillis)
+         return E_ERROR;
+
+      tinMillis = inMillis;
+      if (VENTILATOR_MGR_VOLUME_CONTROL == pSettings->controlMode)
+         tinMillis -= pSettings->pltTimeMillis;
+
+      texMillis = periodMillis - inMillis;
+      params.ieRatio = pSettings->ieRatio;
+   }
+   else
+   {
+      if (periodMillis < (pSettings->inspiratoryTimeMillis + pSettings->pltTimeMillis))
+         return E_ERROR;
+
+      tinMillis = pSettings->inspiratoryTimeMillis;
+      inMillis = tinMillis;
+      if (VENTILATOR_MGR_VOLUME_CONTROL == pSettings->controlMode)
+         inMillis += pSettings->pltTimeMillis;
+
+      texMillis = periodMillis - inMillis;
+      params.ieRatio = (100 * texMillis) / inMillis;
+   }
+
+   // the phases must last long enough for their end margins
+   if ((0 == tinMillis) || (VENTILATOR_PARAMS_EX_MARGIN_MILLIS >= texMillis))
+      return E_ERROR;
+
+   params.distanceInDeg = ventilator_volume_to_deg(pSettings->tidalVolumeML) >> VENTILATOR_MGR_ANGLE_SHIFT;
+   if (0 == params.distanceInDeg)
+      return E_ERROR;
+
+   params.settings = *pSettings;
+   params.respPeriodMillis = periodMillis;
+   params.inspiratoryTimeMillis = tinMillis;
+   params.expirationTimeMillis = texMillis;
+   params.inhaleSpeed = (params.distanceInDeg * 1000UL) / tinMillis;
+   params.exhaleSpeed = (params.distanceInDeg * 1000UL) / texMillis;
+   params.pauseTimeMillis = pSettings->pltTimeMillis - VENTILATOR_MGR_PLATEAU_MEAS_TIME;
+   params.inTimeMillis = tinMillis + VENTILATOR_PARAMS_IN_MARGIN_MILLIS;
+   params.exTimeMillis = texMillis - VENTILATOR_PARAMS_EX_MARGIN_MILLIS;
+   params.maxExTimeMillis = (texMillis * VENTILATOR_PARAMS_EX_MAX_PERCENT) / 100;
+
+   *pParams = params;
+
+   return E_OK;
+}
+
+static StatusType ventilator_params_check_settings(const VentilatorParamsSettingsType *pSettings)
+{
+   if ((VENTILATOR_MGR_VOLUME_CONTROL != pSettings->controlMode) &&
+       (VENTILATOR_MGR_PRESSURE_CONTROL != pSettings->controlMode))
+      return E_ERROR;
+
+   if ((VENTILATOR_MGR_BPM_MIN > pSettings->respRateBPM) || (VENTILATOR_MGR_BPM_MAX < pSettings->respRateBPM))
+      return E_ERROR;
+
+   if ((VENTILATOR_MGR_TIDAL_VOLUME_MIN > pSettings->tidalVolumeML) || (VENTILATOR_MGR_TIDAL_VOLUME_MAX < pSettings->tidalVolumeML))
+      return E_ERROR;
+
+   if ((VENTILATOR_MGR_PLT_TIME_MIN_MILLIS > pSettings->pltTimeMillis) || (VENTILATOR_MGR_PLT_TIME_MAX_MILLIS < pSettings->pltTimeMillis))
+      return E_ERROR;
+
+   if ((VENTILATOR_MGR_INSP_PRESSURE_MIN > pSettings->inspPressure) || (VENTILATOR_MGR_INSP_PRESSURE_MAX < pSettings->inspPressure))
+      return E_ERROR;
+
+   if (VENTILATOR_MGR_FLOW_SINE < pSettings->flowShape)
+      return E_ERROR;
+
+   switch (pSettings->paramMode)
+   {
+      case VENTILATOR_PARAMS_IERATIO_SET:
+         if ((VENTILATOR_MGR_IE_RATIO_MIN > pSettings->ieRatio) || (VENTILATOR_MGR_IE_RATIO_MAX < pSettings->ieRatio))
+            return E_ERROR;
+         break;
+      case VENTILATOR_PARAMS_INSPTIME_SET:
+         if ((VENTILATOR_MGR_INSP_TIME_MIN_MILLIS > pSettings->inspiratoryTimeMillis) ||
+             (VENTILATOR_MGR_INSP_TIME_MAX_MILLIS < pSettings->inspiratoryTimeMillis))
+            return E_ERROR;
+         break;
+      default:
+         return E_ERROR;
+   }
+
+   return E_OK;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
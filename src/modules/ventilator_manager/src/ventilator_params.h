@@ -0,0 +1,146 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       ventilator_params.h
+//!
+//!   \brief      ventilator parameter engine header file
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _VENTILATOR_PARAMS_H
+#define  _VENTILATOR_PARAMS_H 1
+
+//********************************************************************
+//! @addtogroup ventilator_manager_imp
+//!   @{
+//********************************************************************
+
+#include "ventilator_manager_api.h"
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define VENTILATOR_PARAMS_MILLIS_PER_MIN     (60000UL)  /**< Milliseconds in a minute */
+#define VENTILATOR_PARAMS_IN_MARGIN_MILLIS   (50)       /**< Wait added to the inspiratory time before leaving the phase */
+#define VENTILATOR_PARAMS_EX_MARGIN_MILLIS   (50)       /**< Time taken from the expiratory time to leave the phase early */
+#define VENTILATOR_PARAMS_EX_MAX_PERCENT     (110)      /**< Maximum expiratory time as a percentage of the set one */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+/**
+ * @brief  Parameter that sets the inspiratory time
+ *
+ */
+typedef enum ventilator_par_mode_tag
+{
+   VENTILATOR_PARAMS_IERATIO_SET,   /**< Inspiratory time taken from the respiratory rate and the IE ratio */
+   VENTILATOR_PARAMS_INSPTIME_SET,  /**< Inspiratory time set, the IE ratio is calculated */
+} VentilatorParamsMode;
+
+/**
+ * @brief  Ventilation settings as entered by the user
+ *
+ */
+typedef struct ventilator_params_settings_tag
+{
+   VentilatorMgrModeControlType controlMode; /**< Volume or pressure control */
+   VentilatorParamsMode paramMode;           /**< Which of ieRatio and inspiratoryTimeMillis is used */
+   uint32_t respRateBPM;                     /**< Respiratory rate in BPM */
+   uint32_t tidalVolumeML;                   /**< Tidal volume in ml */
+   uint32_t ieRatio;                         /**< IE ratio times 100, used with #VENTILATOR_PARAMS_IERATIO_SET */
+   uint32_t inspiratoryTimeMillis;           /**< Inspiratory time, used with #VENTILATOR_PARAMS_INSPTIME_SET */
+   uint32_t pltTimeMillis;                   /**< Plateau time in ms */
+   uint32_t inspPressure;                    /**< Inspiratory pressure in mmH2O for pressure control */
+   VentilatorMgrFlowShapeType flowShape;     /**< Inspiratory flow shape for volume control */
+} VentilatorParamsSettingsType;
+
+/**
+ * @brief  Complete parameter set calculated from the settings.
+ *         The FSM takes a copy at the start of every breath.
+ *
+ */
+typedef struct ventilator_params_tag
+{
+   VentilatorParamsSettingsType settings; /**< Settings the parameters come from */
+   uint32_t respPeriodMillis;             /**< Breath period */
+   uint32_t inspiratoryTimeMillis;        /**< Inspiratory time, without the plateau */
+   uint32_t expirationTimeMillis;         /**< Expiratory time */
+   uint32_t ieRatio;                      /**< IE ratio times 100 */
+   uint32_t distanceInDeg;                /**< Finger travel for the tidal volume */
+   uint32_t inhaleSpeed;                  /**< Compress speed in deg/s */
+   uint32_t exhaleSpeed;                  /**< Release speed in deg/s */
+   uint32_t pauseTimeMillis;              /**< Plateau wait before the pressure measurement */
+   uint32_t inTimeMillis;                 /**< Inspiratory phase end */
+   uint32_t exTimeMillis;                 /**< Expiratory phase end */
+   uint32_t maxExTimeMillis;              /**< Expiratory phase timeout */
+} VentilatorParamsType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+/**
+ * @brief Validate a complete set of settings and calculate the
+ *        breath timings and the motion targets with integer math.
+ *        The output is written only if the whole set is valid.
+ *
+ * @param pSettings settings to use
+ * @param pParams   parameter set receiving the result
+ *
+ * @return #E_OK if the settings are valid\n
+ *         #E_ERROR if a setting is out of range or the breath timings
+ *         can not be met
+ */
+StatusType ventilator_params_calc(const VentilatorParamsSettingsType *pSettings, VentilatorParamsType *pParams);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _VENTILATOR_PARAMS_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,203 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       ventilator_pressure.c
+//!
+//!   \brief      Pressure control loop. It runs on every filtered
+//!               pressure sample in the ADC interrupt, while the state
+//!               machine only starts it, moves its setpoint and stops
+//!               it.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+#include "pid_api.h"
+
+//********************************************************************
+//! @addtogroup ventilator_manager_imp
+//!   @{
+//********************************************************************
+
+#include "ventilator_manager_conf.h"
+#include "ventilator_manager_api.h"
+#include "ventilator_pressure.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+// full scale of the pressure and of the drive level
+#define VENTILATOR_PRESSURE_INPUT_RANGE   (2048)   // mmH2O
+#define VENTILATOR_PRESSURE_OUTPUT_RANGE  (100)    // PWM %
+
+// derivative filter time constant of 8 samples
+#define VENTILATOR_PRESSURE_DERIV_SHIFT   (3)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct ventilator_pressure_tag
+{
+   // written by the state machine, read by the interrupt
+   volatile Bool active;
+   volatile int32_t setpoint;
+
+   // written by the interrupt
+   volatile int32_t pressure;
+   volatile int32_t error;
+   volatile int32_t driveLevel;
+
+   PidType pid;
+} VentilatorPressureType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+static VentilatorPressureType pressureLoop;
+
+static const PidConfigType pressurePidConfig =
+{
+   .kp = VENTILATOR_MGR_PRESSURE_KP,
+   .ki = VENTILATOR_MGR_PRESSURE_KI,
+   .kd = VENTILATOR_MGR_PRESSURE_KD,
+   .beta = VENTILATOR_MGR_PRESSURE_BETA,
+   .kt = VENTILATOR_MGR_PRESSURE_KT,
+   .derivShift = VENTILATOR_PRESSURE_DERIV_SHIFT,
+   .antiWindup = PID_ANTI_WINDUP_BACK_CALC,
+   .inputRange = VENTILATOR_PRESSURE_INPUT_RANGE,
+   .outputRange = VENTILATOR_PRESSURE_OUTPUT_RANGE,
+   .outMin = 0,
+   .outMax = VENTILATOR_MGR_PRESSURE_MAX_DRIVE,
+};
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+void ventilator_pressure_init(void)
+{
+   pressureLoop.active = FALSE;
+   pressureLoop.setpoint = 0;
+   pressureLoop.pressure = 0;
+   pressureLoop.error = 0;
+   pressureLoop.driveLevel = 0;
+
+   Pid_Init(&pressureLoop.pid, &pressurePidConfig);
+}
+
+void ventilator_pressure_start(int32_t setpoint)
+{
+   // the interrupt does not touch the controller while it's stopped
+   pressureLoop.active = FALSE;
+   // the controller starts from the drive level that overcomes the friction
+   Pid_Reset(&pressureLoop.pid, VENTILATOR_MGR_PRESSURE_START_DRIVE);
+   pressureLoop.setpoint = setpoint;
+   pressureLoop.driveLevel = 0;
+   pressureLoop.active = TRUE;
+}
+
+void ventilator_pressure_stop(void)
+{
+   pressureLoop.active = FALSE;
+}
+
+void ventilator_pressure_set_setpoint(int32_t setpoint)
+{
+   pressureLoop.setpoint = setpoint;
+}
+
+Bool ventilator_pressure_update(int32_t pressure, int32_t *pDriveLevel)
+{
+   int32_t setpoint = pressureLoop.setpoint;
+   int32_t driveLevel;
+
+   if ((!pressureLoop.active) || (setpoint <= 0))
+   {
+      return FALSE;
+   }
+
+   driveLevel = Pid_Update(&pressureLoop.pid, setpoint, pressure, 0);
+
+   pressureLoop.pressure = pressure;
+   pressureLoop.error = setpoint - pressure;
+   pressureLoop.driveLevel = driveLevel;
+
+   *pDriveLevel = driveLevel;
+   return TRUE;
+}
+
+void ventilator_pressure_get_state(VentilatorPressureStateType *pState)
+{
+   pState->setpoint = pressureLoop.setpoint;
+   pState->pressure = pressureLoop.pressure;
+   pState->error = pressureLoop.error;
+   pState->driveLevel = pressureLoop.driveLevel;
+}
+
+StatusType ventilator_pressure_set_pid(float32_t kp, float32_t ki, float32_t kd)
+{
+   return Pid_SetGains(&pressureLoop.pid, kp, ki, kd);
+}
+
+void ventilator_pressure_get_pid(float32_t *kp, float32_t *ki, float32_t *kd)
+{
+   Pid_GetGains(&pressureLoop.pid, kp, ki, kd);
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
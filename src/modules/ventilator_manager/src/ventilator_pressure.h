@@ -0,0 +1,157 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       ventilator_pressure.h
+//!
+//!   \brief      pressure control loop header file
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _VENTILATOR_PRESSURE_H
+#define  _VENTILATOR_PRESSURE_H 1
+
+//********************************************************************
+//! @addtogroup ventilator_manager_imp
+//!   @{
+//********************************************************************
+
+#include "ventilator_manager_api.h"
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+/**
+ * Last step of the pressure control loop
+ */
+typedef struct ventilator_pressure_state_tag
+{
+   int32_t setpoint;          /**< pressure setpoint in mmH2O */
+   int32_t pressure;          /**< last pressure sample in mmH2O */
+   int32_t error;             /**< last error in mmH2O */
+   int32_t driveLevel;        /**< last drive level applied */
+} VentilatorPressureStateType;
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+/**
+ * @brief Stop the loop and set the default gains
+ */
+void ventilator_pressure_init(void);
+
+/**
+ * @brief Reset the controller and start controlling the pressure
+ *
+ * @param setpoint pressure setpoint in mmH2O, greater than 0
+ */
+void ventilator_pressure_start(int32_t setpoint);
+
+/**
+ * @brief Stop controlling the pressure. No drive level is produced
+ *        after it returns.
+ */
+void ventilator_pressure_stop(void);
+
+/**
+ * @brief Change the setpoint of the running loop
+ *
+ * @param setpoint pressure setpoint in mmH2O, greater than 0
+ */
+void ventilator_pressure_set_setpoint(int32_t setpoint);
+
+/**
+ * @brief Run a step of the loop with a new pressure sample. It is called
+ *        from the ADC interrupt.
+ *
+ * @param pressure filtered pressure in mmH2O
+ * @param pDriveLevel returns the drive level to apply, from 0 to
+ *                    #VENTILATOR_MGR_PRESSURE_MAX_DRIVE
+ *
+ * @return Bool TRUE if the loop is running and pDriveLevel was set
+ */
+Bool ventilator_pressure_update(int32_t pressure, int32_t *pDriveLevel);
+
+/**
+ * @brief Get the last step of the loop
+ *
+ * @param pState returns the setpoint, pressure, error and drive level
+ */
+void ventilator_pressure_get_state(VentilatorPressureStateType *pState);
+
+/**
+ * @brief Set the gains of the controller. A running loop continues
+ *        from the drive level it had.
+ *
+ * @param kp proportional gain in PWM % per mmH2O
+ * @param ki integral gain in PWM % per mmH2O and sample
+ * @param kd derivative gain in PWM % per mmH2O change in a sample
+ *
+ * @return StatusType #E_OK if no error occurred\n
+ *                    #E_ERROR if a gain is out of range
+ */
+StatusType ventilator_pressure_set_pid(float32_t kp, float32_t ki, float32_t kd);
+
+/**
+ * @brief Get the gains of the controller
+ *
+ * @param kp returns the proportional gain
+ * @param ki returns the integral gain
+ * @param kd returns the derivative gain
+ */
+void ventilator_pressure_get_pid(float32_t *kp, float32_t *ki, float32_t *kd);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _VENTILATOR_PRESSURE_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,203 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       ventilator_volume.c
+//!
+//!   \brief      Tidal volume to finger angle conversion. The volume
+//!               table is resampled at init to one point per finger
+//!               degree, so an angle finds its segment with a shift.
+//!               A small index over the volumes finds the segment of a
+//!               volume with a couple of comparisons at most.
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+//********************************************************************
+// Include header files
+//********************************************************************
+#include "standard.h"
+
+//********************************************************************
+//! @addtogroup ventilator_manager_imp
+//!   @{
+//********************************************************************
+
+#include "ventilator_manager_conf.h"
+#include "ventilator_manager_api.h"
+#include "ventilator_volume.h"
+
+//********************************************************************
+// File level pragmas
+//********************************************************************
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define VOL_TABLE_LAST_SEGMENT   (VENTILATOR_MGR_VOL_TABLE_POINTS - 2)
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+typedef struct vol2deg_table_tag
+{
+   uint32_t volumeML;
+   uint32_t deg;
+} VolumeToDegType;
+
+//********************************************************************
+// Function Prototypes for Private Functions with File Level Scope
+//********************************************************************
+
+//********************************************************************
+// ROM Const Variables With File Level Scope
+//********************************************************************
+static const VolumeToDegType volToDegTable[] = {
+#undef X
+#define X(a,b) {a, b},
+      VENTILATOR_MGR_VOL_DEG_TABLE
+};
+
+//********************************************************************
+// Static Variables and Const Variables With File Level Scope
+//********************************************************************
+// volume in 1/2^VENTILATOR_VOLUME_FRAC_SHIFT ml at every finger degree
+static int16_t volTable[VENTILATOR_MGR_VOL_TABLE_POINTS];
+
+// first segment of the volumes of every index step
+static uint8_t volIndex[VENTILATOR_MGR_VOL_INDEX_POINTS];
+
+//********************************************************************
+// Function Definitions
+//********************************************************************
+StatusType ventilator_volume_init(void)
+{
+   uint32_t tableSize = sizeof(volToDegTable) / sizeof(volToDegTable[0]);
+   uint32_t i, deg, seg;
+
+   if (tableSize < 2)
+      return E_ERROR;
+
+   for (i = 1; i < tableSize; i++)
+   {
+      if ((volToDegTable[i].volumeML <= volToDegTable[i-1].volumeML) ||
+          (volToDegTable[i].deg <= volToDegTable[i-1].deg))
+         return E_ERROR;
+   }
+
+   // resample the segments, extending the first and the last ones
+   seg = 0;
+   for (deg = 0; deg < VENTILATOR_MGR_VOL_TABLE_POINTS; deg++)
+   {
+      const VolumeToDegType *eLow, *eHigh;
+      int32_t num, den, vol;
+
+      while ((seg < (tableSize - 2)) && (volToDegTable[seg + 1].deg <= deg))
+         seg++;
+      eLow = &volToDegTable[seg];
+      eHigh = &volToDegTable[seg + 1];
+
+      num = ((int32_t)deg - (int32_t)eLow->deg) * (int32_t)(eHigh->volumeML - eLow->volumeML) * (1L << VENTILATOR_VOLUME_FRAC_SHIFT);
+      den = (int32_t)(eHigh->deg - eLow->deg);
+      // round to nearest
+      num += (num < 0) ? -(den / 2) : (den / 2);
+      vol = ((int32_t)eLow->volumeML << VENTILATOR_VOLUME_FRAC_SHIFT) + num / den;
+
+      if ((vol < INT16_MIN) || (vol > INT16_MAX))
+         return E_ERROR;
+      volTable[deg] = (int16_t)vol;
+   }
+
+   // last segment starting at or before every index step
+   seg = 0;
+   for (i = 0; i < VENTILATOR_MGR_VOL_INDEX_POINTS; i++)
+   {
+      int32_t vol = (int32_t)(i << (VENTILATOR_MGR_VOL_INDEX_SHIFT + VENTILATOR_VOLUME_FRAC_SHIFT));
+
+      while ((seg < VOL_TABLE_LAST_SEGMENT) && (volTable[seg + 1] <= vol))
+         seg++;
+      volIndex[i] = (uint8_t)seg;
+   }
+
+   return E_OK;
+}
+
+uint32_t ventilator_volume_to_deg(uint32_t volumeML)
+{
+   uint32_t step = volumeML >> VENTILATOR_MGR_VOL_INDEX_SHIFT;
+   int32_t vol = (int32_t)(volumeML << VENTILATOR_VOLUME_FRAC_SHIFT);
+   uint32_t seg;
+
+   if (vol <= volTable[0])
+      return 0;
+
+   if (step >= VENTILATOR_MGR_VOL_INDEX_POINTS)
+      step = VENTILATOR_MGR_VOL_INDEX_POINTS - 1;
+
+   seg = volIndex[step];
+   while ((seg < VOL_TABLE_LAST_SEGMENT) && (volTable[seg + 1] <= vol))
+      seg++;
+
+   return (seg << VENTILATOR_MGR_ANGLE_SHIFT) +
+          (((uint32_t)(vol - volTable[seg]) << VENTILATOR_MGR_ANGLE_SHIFT) / (uint32_t)(volTable[seg + 1] - volTable[seg]));
+}
+
+uint32_t ventilator_volume_from_deg(int32_t angle)
+{
+   int32_t seg, vol;
+
+   seg = (angle < 0) ? 0 : (angle >> VENTILATOR_MGR_ANGLE_SHIFT);
+   if (seg > VOL_TABLE_LAST_SEGMENT)
+      seg = VOL_TABLE_LAST_SEGMENT;
+
+   vol = volTable[seg] +
+         (((int32_t)(volTable[seg + 1] - volTable[seg]) * (angle - (seg << VENTILATOR_MGR_ANGLE_SHIFT))) >> VENTILATOR_MGR_ANGLE_SHIFT);
+
+   if (vol <= 0)
+      return 0;
+
+   return ((uint32_t)vol + (1UL << (VENTILATOR_VOLUME_FRAC_SHIFT - 1))) >> VENTILATOR_VOLUME_FRAC_SHIFT;
+}
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************
@@ -0,0 +1,111 @@
+/*
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Mirgor
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//********************************************************************
+//
+//!   \file       ventilator_volume.h
+//!
+//!   \brief      tidal volume to finger angle conversion header file
+//!
+//!   \author     agent
+//!
+//!   \date       17 Oct 2026
+//
+//********************************************************************
+
+#ifndef  _VENTILATOR_VOLUME_H
+#define  _VENTILATOR_VOLUME_H 1
+
+//********************************************************************
+//! @addtogroup ventilator_manager_imp
+//!   @{
+//********************************************************************
+
+#include "ventilator_manager_api.h"
+
+//********************************************************************
+// Constant and Macro Definitions using #define
+//********************************************************************
+#define VENTILATOR_VOLUME_FRAC_SHIFT   (4)   /**< Fractional bits of the volumes in the resampled table */
+
+//********************************************************************
+// Enumerations and Structures and Typedefs
+//********************************************************************
+
+//********************************************************************
+// Global Variable extern Declarations
+//********************************************************************
+
+//********************************************************************
+// Function Prototypes
+//********************************************************************
+
+/**
+ * @brief Resample #VENTILATOR_MGR_VOL_DEG_TABLE to one point per finger
+ *        degree and build the index used to look up volumes.
+ *        It shall be called before any other function of this file.
+ *
+ * @return #E_OK if the table is valid\n
+ *         #E_ERROR if it is not increasing or it does not fit
+ */
+StatusType ventilator_volume_init(void);
+
+/**
+ * @brief Finger angle that delivers a volume
+ *
+ * @param volumeML volume in ml
+ *
+ * @return angle from the home position in 1/2^#VENTILATOR_MGR_ANGLE_SHIFT
+ *         degrees, rounded down
+ */
+uint32_t ventilator_volume_to_deg(uint32_t volumeML);
+
+/**
+ * @brief Volume delivered with the finger at an angle
+ *
+ * @param angle angle from the home position in 1/2^#VENTILATOR_MGR_ANGLE_SHIFT
+ *              degrees
+ *
+ * @return volume in ml, 0 before the finger reaches the bag
+ */
+uint32_t ventilator_volume_from_deg(int32_t angle);
+
+//********************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//********************************************************************
+
+#endif // _VENTILATOR_VOLUME_H
+//********************************************************************
+//
+// Modification Record
+//
+//********************************************************************
+//
+//
+//
+//********************************************************************